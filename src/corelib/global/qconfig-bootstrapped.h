@@ -59,6 +59,7 @@
 #define QT_NO_GEOM_VARIANT
 #define QT_FEATURE_hijricalendar -1
 #define QT_FEATURE_icu -1
+#define QT_FEATURE_io_uring -1
 #define QT_FEATURE_islamiccivilcalendar -1
 #define QT_FEATURE_jalalicalendar -1
 #define QT_FEATURE_journald -1
@@ -1146,6 +1146,13 @@ qint64 QAbstractFileEngine::readLine(char *data, qint64 maxlen)
 
    \value UnMapExtension Whether the file engine provides the ability to
    unmap memory that was previously mapped.
+
+   \value QueuedWritesExtension Whether the file engine queues the data
+   passed to write(), and only waits for it to reach the file in flush().
+   This extension returns \c true if writes to the open file are queued;
+   QFileDevice then does not flush the engine when its write buffer is full.
+   The input and output arguments to extension() are ignored. This value was
+   added in Qt 6.6.
 */
 
 /*!
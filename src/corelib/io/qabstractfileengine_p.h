@@ -139,7 +139,8 @@ public:
         AtEndExtension,
         FastReadLineExtension,
         MapExtension,
-        UnMapExtension
+        UnMapExtension,
+        QueuedWritesExtension
     };
     class ExtensionOption
     {};
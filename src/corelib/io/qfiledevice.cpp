@@ -239,6 +239,30 @@ QString QFileDevice::fileName() const
     return QString();
 }
 
+/*!
+    \internal
+
+    Passes the contents of the write buffer to the file engine, without
+    asking the engine to flush its own buffers.
+*/
+bool QFileDevicePrivate::flushWriteBuffer()
+{
+    if (!writeBuffer.isEmpty()) {
+        qint64 size = writeBuffer.nextDataBlockSize();
+        qint64 written = fileEngine->write(writeBuffer.readPointer(), size);
+        if (written > 0)
+            writeBuffer.free(written);
+        if (written != size) {
+            QFileDevice::FileError err = fileEngine->error();
+            if (err == QFileDevice::UnspecifiedError)
+                err = QFileDevice::WriteError;
+            setError(err, fileEngine->errorString());
+            return false;
+        }
+    }
+    return true;
+}
+
 /*!
     Flushes any buffered data to the file. Returns \c true if successful;
     otherwise returns \c false.
@@ -251,19 +275,8 @@ bool QFileDevice::flush()
         return false;
     }
 
-    if (!d->writeBuffer.isEmpty()) {
-        qint64 size = d->writeBuffer.nextDataBlockSize();
-        qint64 written = d->fileEngine->write(d->writeBuffer.readPointer(), size);
-        if (written > 0)
-            d->writeBuffer.free(written);
-        if (written != size) {
-            QFileDevice::FileError err = d->fileEngine->error();
-            if (err == QFileDevice::UnspecifiedError)
-                err = QFileDevice::WriteError;
-            d->setError(err, d->fileEngine->errorString());
-            return false;
-        }
-    }
+    if (!d->flushWriteBuffer())
+        return false;
 
     if (!d->fileEngine->flush()) {
         QFileDevice::FileError err = d->fileEngine->error();
@@ -507,9 +520,13 @@ qint64 QFileDevice::writeData(const char *data, qint64 len)
     d->lastWasWrite = true;
     bool buffered = !(d->openMode & Unbuffered);
 
-    // Flush buffered data if this read will overflow.
+    // Flush buffered data if this read will overflow. An engine that queues
+    // its writes only gets the buffered data, so that the writes overlap.
     if (buffered && (d->writeBuffer.size() + len) > d->writeBufferChunkSize) {
-        if (!flush())
+        const bool queued =
+                d->fileEngine->supportsExtension(QAbstractFileEngine::QueuedWritesExtension)
+                && d->fileEngine->extension(QAbstractFileEngine::QueuedWritesExtension);
+        if (!(queued ? d->flushWriteBuffer() : flush()))
             return -1;
     }
 
@@ -48,6 +48,7 @@ protected:
     virtual QAbstractFileEngine *engine() const;
 
     inline bool ensureFlushed() const;
+    bool flushWriteBuffer();
 
     bool putCharHelper(char c) override;
 
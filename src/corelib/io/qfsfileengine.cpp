@@ -169,6 +169,7 @@ ProcessOpenModeResult processOpenModeFlags(QIODevice::OpenMode openMode)
 QFSFileEngine::~QFSFileEngine()
 {
     Q_D(QFSFileEngine);
+    d->waitForPendingWrites();
     if (d->closeFileHandle) {
         if (d->fh) {
             fclose(d->fh);
@@ -367,9 +368,13 @@ bool QFSFileEnginePrivate::closeFdFh()
         return false;
 
     // Flush the file if it's buffered, and if the last flush didn't fail.
-    bool flushed = !fh || (!lastFlushFailed && q->flush());
+    bool flushed = fh ? !lastFlushFailed && q->flush() : waitForPendingWrites();
     bool closed = true;
     tried_stat = 0;
+#if QT_CONFIG(io_uring)
+    ioUringWriter.reset();
+    triedIoUring = false;
+#endif
 
     // Close the file if we created the handle.
     if (closeFileHandle) {
@@ -506,6 +511,7 @@ qint64 QFSFileEnginePrivate::posFdFh() const
 {
     if (fh)
         return qint64(QT_FTELL(fh));
+    waitForPendingWrites();
     return QT_LSEEK(fd, 0, SEEK_CUR);
 }
 
@@ -759,6 +765,11 @@ qint64 QFSFileEnginePrivate::writeFdFh(const char *data, qint64 len)
                 writtenBytes += result;
             } while (result == 0 ? errno == EINTR : writtenBytes < len);
 
+#if QT_CONFIG(io_uring)
+        } else if (fd != -1 && useIoUring()) {
+            // Unbuffered mode, queued to the thread's io_uring instance.
+            writtenBytes = qMax(ioUringWriter->write(data, len), qint64(0));
+#endif
         } else if (fd != -1) {
             // Unbuffered stdio mode.
 
@@ -788,6 +799,45 @@ qint64 QFSFileEnginePrivate::writeFdFh(const char *data, qint64 len)
     return writtenBytes;
 }
 
+#if QT_CONFIG(io_uring)
+/*!
+    \internal
+
+    Returns \c true if unbuffered writes to the file should be queued to the
+    io_uring instance of the current thread instead of being written
+    immediately. This is only done for regular files that we opened.
+*/
+bool QFSFileEnginePrivate::useIoUring()
+{
+    if (!triedIoUring) {
+        triedIoUring = true;
+        if (closeFileHandle)
+            ioUringWriter.reset(QIoUringFileWriter::create(fd));
+    }
+    return ioUringWriter != nullptr;
+}
+#endif
+
+/*!
+    \internal
+
+    Waits until the writes queued by writeFdFh() have reached the file.
+    Returns \c false and sets the error if any of them failed.
+*/
+bool QFSFileEnginePrivate::waitForPendingWrites() const
+{
+#if QT_CONFIG(io_uring)
+    if (ioUringWriter && !ioUringWriter->waitForWritten()) {
+        Q_Q(const QFSFileEngine);
+        const_cast<QFSFileEngine *>(q)->setError(errno == ENOSPC ? QFile::ResourceError
+                                                                 : QFile::WriteError,
+                                                 QSystemError::stdString());
+        return false;
+    }
+#endif
+    return true;
+}
+
 #ifndef QT_NO_FILESYSTEMITERATOR
 /*!
     \internal
@@ -856,6 +906,10 @@ bool QFSFileEngine::extension(Extension extension, const ExtensionOption *option
         const UnMapExtensionOption *options = (const UnMapExtensionOption*)option;
         return d->unmap(options->address);
     }
+#if QT_CONFIG(io_uring)
+    if (extension == QueuedWritesExtension)
+        return !d->fh && d->fd != -1 && d->useIoUring();
+#endif
 
     return false;
 }
@@ -874,6 +928,10 @@ bool QFSFileEngine::supportsExtension(Extension extension) const
         return true;
     if (extension == UnMapExtension || extension == MapExtension)
         return true;
+#if QT_CONFIG(io_uring)
+    if (extension == QueuedWritesExtension)
+        return true;
+#endif
     return false;
 }
 
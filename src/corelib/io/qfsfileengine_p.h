@@ -20,7 +20,11 @@
 #include <QtCore/private/qfilesystementry_p.h>
 #include <QtCore/private/qfilesystemmetadata_p.h>
 #include <qhash.h>
+#if QT_CONFIG(io_uring)
+#include <QtCore/private/qiouring_p.h>
+#endif
 
+#include <memory>
 #include <optional>
 
 #ifdef Q_OS_UNIX
@@ -176,6 +180,13 @@ public:
 #endif
     int fd;
 
+#if QT_CONFIG(io_uring)
+    std::unique_ptr<QIoUringFileWriter> ioUringWriter;
+    bool triedIoUring = false;
+    bool useIoUring();
+#endif
+    bool waitForPendingWrites() const;
+
     enum LastIOCommand
     {
         IOFlushCommand,
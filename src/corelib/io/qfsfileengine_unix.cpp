@@ -148,7 +148,7 @@ bool QFSFileEnginePrivate::nativeClose()
 */
 bool QFSFileEnginePrivate::nativeFlush()
 {
-    return fh ? flushFh() : fd != -1;
+    return fh ? flushFh() : fd != -1 && waitForPendingWrites();
 }
 
 /*!
@@ -158,6 +158,8 @@ bool QFSFileEnginePrivate::nativeFlush()
 bool QFSFileEnginePrivate::nativeSyncToDisk()
 {
     Q_Q(QFSFileEngine);
+    if (!waitForPendingWrites())
+        return false;
     int ret;
 #if defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
     EINTR_LOOP(ret, fdatasync(nativeHandle()));
@@ -267,6 +269,7 @@ bool QFSFileEnginePrivate::nativeSeek(qint64 pos)
 */
 int QFSFileEnginePrivate::nativeHandle() const
 {
+    waitForPendingWrites();
     return fh ? fileno(fh) : fd;
 }
 
@@ -508,6 +511,8 @@ bool QFSFileEngine::setSize(qint64 size)
 {
     Q_D(QFSFileEngine);
     bool ret = false;
+    if (!d->waitForPendingWrites())
+        return false;
     if (d->fd != -1)
         ret = QT_FTRUNCATE(d->fd, size) == 0;
     else if (d->fh)
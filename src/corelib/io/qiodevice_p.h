@@ -66,8 +66,10 @@ public:
         inline qint64 nextDataBlockSize() const { return (m_buf ? m_buf->nextDataBlockSize() : Q_INT64_C(0)); }
         inline const char *readPointer() const { return (m_buf ? m_buf->readPointer() : nullptr); }
         inline const char *readPointerAtPosition(qint64 pos, qint64 &length) const { Q_ASSERT(m_buf); return m_buf->readPointerAtPosition(pos, length); }
+        inline qsizetype dataBlocks(const char **data, qint64 *sizes, qsizetype maxCount) const { return (m_buf ? m_buf->dataBlocks(data, sizes, maxCount) : 0); }
         inline void free(qint64 bytes) { Q_ASSERT(m_buf); m_buf->free(bytes); }
         inline char *reserve(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserve(bytes); }
+        inline qsizetype reserveBlocks(qint64 bytes, char **data, qint64 *sizes) { Q_ASSERT(m_buf); return m_buf->reserveBlocks(bytes, data, sizes); }
         inline char *reserveFront(qint64 bytes) { Q_ASSERT(m_buf); return m_buf->reserveFront(bytes); }
         inline void truncate(qint64 pos) { Q_ASSERT(m_buf); m_buf->truncate(pos); }
         inline void chop(qint64 bytes) { Q_ASSERT(m_buf); m_buf->chop(bytes); }
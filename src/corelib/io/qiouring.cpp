@@ -0,0 +1,431 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qiouring_p.h"
+
+#include <qabstracteventdispatcher.h>
+#include <qmutex.h>
+#include <qsocketnotifier.h>
+#include <qthreadstorage.h>
+#include <private/qcore_unix_p.h>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    QIoUring is a per-thread io_uring instance through which QFSFileEngine
+    can write files without blocking in a system call for every write.
+
+    Writes are copied and queued. They are submitted to the kernel in one
+    io_uring_enter() call when the thread's event loop is about to block, or
+    immediately when the thread has no event dispatcher or when too much data
+    is queued. The writes of one file form a linked chain, which the kernel
+    executes in order at the current file position, like write() would.
+    Consecutive small writes are merged into one.
+    Completions are processed when the ring's file descriptor becomes readable
+    and whenever a QIoUringFileWriter waits for its writes. A file has at most
+    one chain in flight; writes queued meanwhile form the next chain.
+
+    The kernel cancels the rest of a chain after a short or failed write.
+    The remaining data is then written synchronously, so that the file
+    contents end up the same as with blocking writes.
+
+    Queued data becomes visible to other handles of the same file only after
+    QFile::flush() or any other operation that waits for the writes, which is
+    why the feature is used only if the QT_ENABLE_IO_URING environment variable
+    is set to a non-zero value and the kernel supports io_uring with writes
+    at the current file position (Linux 5.6).
+*/
+class QIoUring
+{
+    Q_DISABLE_COPY_MOVE(QIoUring)
+public:
+    static QIoUring *forCurrentThread();
+    QIoUring() = default;
+    ~QIoUring();
+
+    QMutex mutex;
+    std::vector<QIoUringFileWriter *> writers;
+    bool attachedToEventLoop = false;
+
+    void submitChain(QIoUringFileWriter *writer);
+    void submitAll();
+    void enter(unsigned minComplete);
+    void processCompletions();
+
+private:
+    bool init();
+    void finishChain(QIoUringFileWriter *writer);
+
+    int ringFd = -1;
+    void *ringMemory = MAP_FAILED;
+    size_t ringSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe *cqes = nullptr;
+    unsigned toSubmit = 0;
+
+    QSocketNotifier *notifier = nullptr;
+};
+
+// the maximum number of writes and bytes to queue before submitting them
+// without waiting for the event loop
+static constexpr qsizetype MaxQueuedWrites = 64;
+static constexpr qsizetype MaxQueuedBytes = 4 * 1024 * 1024;
+// the largest write that consecutive small writes are merged into
+static constexpr qsizetype MaxMergedWriteSize = 64 * 1024;
+
+Q_GLOBAL_STATIC(QThreadStorage<QIoUring *>, ringStorage)
+
+QIoUring *QIoUring::forCurrentThread()
+{
+    QThreadStorage<QIoUring *> *storage = ringStorage();
+    if (!storage)
+        return nullptr;
+    if (storage->hasLocalData())
+        return storage->localData();
+
+    QIoUring *ring = nullptr;
+    if (qEnvironmentVariableIntValue("QT_ENABLE_IO_URING")) {
+        ring = new QIoUring;
+        if (!ring->init()) {
+            delete ring;
+            ring = nullptr;
+        }
+    }
+    storage->setLocalData(ring);
+    return ring;
+}
+
+bool QIoUring::init()
+{
+    constexpr unsigned Entries = 256;
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, Entries, &params));
+    if (ringFd < 0)
+        return false; // not supported by the kernel, or not permitted
+    fcntl(ringFd, F_SETFD, FD_CLOEXEC);
+
+    constexpr unsigned RequiredFeatures =
+            IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_RW_CUR_POS;
+    if ((params.features & RequiredFeatures) != RequiredFeatures)
+        return false;
+
+    ringSize = qMax(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                    params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+    ringMemory = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+    if (ringMemory == MAP_FAILED)
+        return false;
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ringFd,
+                                            IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+        return false;
+
+    char *base = static_cast<char *>(ringMemory);
+    sqHead = reinterpret_cast<unsigned *>(base + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(base + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned *>(base + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    sqArray = reinterpret_cast<unsigned *>(base + params.sq_off.array);
+    cqHead = reinterpret_cast<unsigned *>(base + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(base + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(base + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(base + params.cq_off.cqes);
+
+    if (QAbstractEventDispatcher *dispatcher = QAbstractEventDispatcher::instance()) {
+        attachedToEventLoop = true;
+        notifier = new QSocketNotifier(ringFd, QSocketNotifier::Read);
+        QObject::connect(notifier, &QSocketNotifier::activated, notifier, [this] {
+            QMutexLocker locker(&mutex);
+            processCompletions();
+        });
+        QObject::connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, notifier, [this] {
+            QMutexLocker locker(&mutex);
+            submitAll();
+        });
+    }
+    return true;
+}
+
+QIoUring::~QIoUring()
+{
+    delete notifier;
+    {
+        QMutexLocker locker(&mutex);
+        for (QIoUringFileWriter *writer : writers) {
+            while (writer->inFlight || !writer->queued.empty()) {
+                if (!writer->inFlight)
+                    submitChain(writer);
+                enter(writer->inFlight ? 1 : 0);
+                processCompletions();
+            }
+            writer->ring = nullptr;
+        }
+        writers.clear();
+    }
+
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (ringMemory != MAP_FAILED)
+        munmap(ringMemory, ringSize);
+    if (ringFd != -1)
+        qt_safe_close(ringFd);
+}
+
+// Moves the first queued writes of the writer, which must not have a chain
+// in flight, to the submission queue as a linked chain.
+void QIoUring::submitChain(QIoUringFileWriter *writer)
+{
+    Q_ASSERT(writer->inFlight == 0);
+    if (writer->queued.empty())
+        return;
+
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) + writer->queued.size() > sqEntries) {
+        enter(0);
+        tail = *sqTail;
+    }
+    const size_t count = qMin(size_t(sqEntries - (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE))),
+                              writer->queued.size());
+    if (count == 0)
+        return;
+
+    // the items must not move while the kernel refers to them
+    writer->submitted.clear();
+    writer->submitted.reserve(count);
+    std::move(writer->queued.begin(), writer->queued.begin() + count,
+              std::back_inserter(writer->submitted));
+    writer->queued.erase(writer->queued.begin(), writer->queued.begin() + count);
+    writer->queuedBytes = 0;
+    for (const QIoUringFileWriter::Item &item : writer->queued)
+        writer->queuedBytes += item.data.size();
+
+    for (size_t i = 0; i < count; ++i) {
+        QIoUringFileWriter::Item &item = writer->submitted[i];
+        const unsigned index = tail & sqMask;
+        io_uring_sqe *sqe = &sqes[index];
+        *sqe = {};
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = writer->fd;
+        sqe->addr = quintptr(item.data.constData());
+        sqe->len = unsigned(item.data.size());
+        sqe->off = quint64(-1);     // at the current file position
+        sqe->user_data = quintptr(&item);
+        if (i + 1 < count)
+            sqe->flags = IOSQE_IO_LINK;
+        sqArray[index] = index;
+        ++tail;
+    }
+    __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+    toSubmit += unsigned(count);
+    writer->inFlight = qsizetype(count);
+}
+
+// Submits the queued writes of all files that have no chain in flight.
+void QIoUring::submitAll()
+{
+    for (QIoUringFileWriter *writer : writers) {
+        if (!writer->inFlight)
+            submitChain(writer);
+    }
+    if (toSubmit)
+        enter(0);
+}
+
+// Submits the entries in the submission queue and waits for at least
+// minComplete completions.
+void QIoUring::enter(unsigned minComplete)
+{
+    for (;;) {
+        const unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+        const int ret = int(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags,
+                                    nullptr, 0));
+        if (ret >= 0) {
+            toSubmit -= qMin(toSubmit, unsigned(ret));
+            if (!toSubmit || minComplete)
+                return;
+            continue;
+        }
+        if (errno == EINTR)
+            continue;
+        if (errno == EAGAIN || errno == EBUSY) {
+            // the completion queue is full; make room and try again
+            processCompletions();
+            continue;
+        }
+        qErrnoWarning("QIoUring: io_uring_enter() failed");
+        return;
+    }
+}
+
+void QIoUring::processCompletions()
+{
+    unsigned head = *cqHead;
+    const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    std::vector<QIoUringFileWriter *> finished;
+    for ( ; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes[head & cqMask];
+        auto item = reinterpret_cast<QIoUringFileWriter::Item *>(quintptr(cqe.user_data));
+        item->result = cqe.res;
+        if (--item->writer->inFlight == 0)
+            finished.push_back(item->writer);
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+    for (QIoUringFileWriter *writer : finished)
+        finishChain(writer);
+}
+
+static bool writeAll(int fd, const char *data, qint64 len)
+{
+    while (len > 0) {
+        const qint64 written = qt_safe_write(fd, data, len);
+        if (written < 0)
+            return false;
+        data += written;
+        len -= written;
+    }
+    return true;
+}
+
+// Checks the results of the completed chain, writing what the kernel did
+// not write because of a short write.
+void QIoUring::finishChain(QIoUringFileWriter *writer)
+{
+    for (const QIoUringFileWriter::Item &item : writer->submitted) {
+        if (writer->error)
+            break; // the rest of the data is lost
+        const qint64 size = item.data.size();
+        if (item.result == size)
+            continue;
+        const qint64 done = item.result == -ECANCELED ? 0 : item.result;
+        if (done < 0)
+            writer->error = -item.result;
+        else if (!writeAll(writer->fd, item.data.constData() + done, size - done))
+            writer->error = errno;
+    }
+    writer->submitted.clear();
+}
+
+/*!
+    \internal
+    \class QIoUringFileWriter
+
+    Writes to the file descriptor \a fd through the io_uring instance of the
+    current thread. Returns \nullptr if io_uring is not enabled or not
+    available, or if \a fd does not refer to a regular file.
+*/
+QIoUringFileWriter *QIoUringFileWriter::create(int fd)
+{
+    QT_STATBUF st;
+    if (QT_FSTAT(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return nullptr;
+    QIoUring *ring = QIoUring::forCurrentThread();
+    if (!ring)
+        return nullptr;
+
+    auto writer = new QIoUringFileWriter(ring, fd);
+    QMutexLocker locker(&ring->mutex);
+    ring->writers.push_back(writer);
+    return writer;
+}
+
+QIoUringFileWriter::~QIoUringFileWriter()
+{
+    waitForWritten();
+    if (ring) {
+        QMutexLocker locker(&ring->mutex);
+        ring->writers.erase(std::find(ring->writers.begin(), ring->writers.end(), this));
+    }
+}
+
+/*!
+    \internal
+
+    Queues \a len bytes from \a data to be written and returns \a len, or
+    returns -1 and sets errno if a previous write failed.
+*/
+qint64 QIoUringFileWriter::write(const char *data, qint64 len)
+{
+    if (!ring)
+        return writeAll(fd, data, len) ? len : -1;
+
+    QMutexLocker locker(&ring->mutex);
+    if (error) {
+        errno = std::exchange(error, 0);
+        return -1;
+    }
+
+    // small writes are merged so that they need only one submission entry
+    if (!queued.empty() && queued.back().data.size() + len <= MaxMergedWriteSize)
+        queued.back().data.append(data, len);
+    else
+        queued.push_back({ this, QByteArray(data, len), 0 });
+    queuedBytes += len;
+    if (!ring->attachedToEventLoop || qsizetype(queued.size()) >= MaxQueuedWrites
+            || queuedBytes >= MaxQueuedBytes) {
+        if (inFlight && queuedBytes >= MaxQueuedBytes) {
+            // don't let the queue grow without bounds
+            while (inFlight) {
+                ring->enter(1);
+                ring->processCompletions();
+            }
+        }
+        if (!inFlight) {
+            ring->submitChain(this);
+            ring->enter(0);
+        }
+    }
+    return len;
+}
+
+/*!
+    \internal
+
+    Waits until all queued writes have been completed. Returns false and
+    sets errno if any of them failed.
+*/
+bool QIoUringFileWriter::waitForWritten()
+{
+    if (!ring)
+        return true;
+
+    QMutexLocker locker(&ring->mutex);
+    while (inFlight || !queued.empty()) {
+        if (!inFlight)
+            ring->submitChain(this);
+        ring->enter(inFlight ? 1 : 0);
+        ring->processCompletions();
+    }
+    if (error) {
+        errno = std::exchange(error, 0);
+        return false;
+    }
+    return true;
+}
+
+bool QIoUringFileWriter::hasPendingWrites() const
+{
+    if (!ring)
+        return false;
+    QMutexLocker locker(&ring->mutex);
+    return inFlight || !queued.empty() || error;
+}
+
+QT_END_NAMESPACE
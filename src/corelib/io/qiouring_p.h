@@ -0,0 +1,61 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QIOURING_P_H
+#define QIOURING_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/qbytearray.h>
+
+#include <vector>
+
+QT_REQUIRE_CONFIG(io_uring);
+
+QT_BEGIN_NAMESPACE
+
+class QIoUring;
+
+class Q_AUTOTEST_EXPORT QIoUringFileWriter
+{
+    Q_DISABLE_COPY_MOVE(QIoUringFileWriter)
+public:
+    static QIoUringFileWriter *create(int fd);
+    ~QIoUringFileWriter();
+
+    qint64 write(const char *data, qint64 len);
+    bool waitForWritten();
+    bool hasPendingWrites() const;
+
+private:
+    friend class QIoUring;
+    QIoUringFileWriter(QIoUring *ring, int fd) : ring(ring), fd(fd) {}
+
+    struct Item {
+        QIoUringFileWriter *writer;
+        QByteArray data;
+        int result;
+    };
+
+    QIoUring *ring;
+    int fd;
+    int error = 0;                  // errno of the first failed write
+    qsizetype inFlight = 0;
+    qsizetype queuedBytes = 0;
+    std::vector<Item> submitted;    // the chain being processed by the kernel
+    std::vector<Item> queued;       // waiting for the chain to complete
+};
+
+QT_END_NAMESPACE
+
+#endif // QIOURING_P_H
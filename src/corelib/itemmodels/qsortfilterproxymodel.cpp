@@ -8,11 +8,18 @@
 #include <qdatetime.h>
 #include <qpair.h>
 #include <qstringlist.h>
+#include <qvarlengtharray.h>
 #include <private/qabstractitemmodel_p.h>
 #include <private/qabstractproxymodel_p.h>
 #include <private/qproperty_p.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthreadpool.h>
+#endif
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -77,6 +84,158 @@ private:
     const QSortFilterProxyModel *proxy_model;
 };
 
+// The sort key of a source item, used when parallelSortingEnabled is set. Values
+// that QAbstractItemModelPrivate::isVariantLessThan() compares as strings are
+// converted once, instead of on every comparison.
+struct QSortFilterProxyModelSortKey
+{
+    QVariant value;
+    QString text;
+    bool textual = false;
+
+    void setValue(QVariant &&v)
+    {
+        value = std::move(v);
+        switch (value.userType()) {
+        case QMetaType::UnknownType:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:
+        case QMetaType::QChar:
+        case QMetaType::QDate:
+        case QMetaType::QTime:
+        case QMetaType::QDateTime:
+            textual = false;
+            break;
+        default:
+            textual = true;
+            text = value.toString();
+            break;
+        }
+    }
+};
+
+// Same results as QAbstractItemModelPrivate::isVariantLessThan()
+class QSortFilterProxyModelSortKeyLessThan
+{
+public:
+    QSortFilterProxyModelSortKeyLessThan(Qt::CaseSensitivity cs, bool isLocaleAware)
+        : cs(cs), isLocaleAware(isLocaleAware) {}
+
+    bool operator()(const QSortFilterProxyModelSortKey &left,
+                    const QSortFilterProxyModelSortKey &right) const
+    {
+        if (!left.textual)
+            return QAbstractItemModelPrivate::isVariantLessThan(left.value, right.value,
+                                                                cs, isLocaleAware);
+        if (right.value.userType() == QMetaType::UnknownType)
+            return true;
+        if (right.textual)
+            return compare(left.text, right.text);
+        return compare(left.text, right.value.toString());
+    }
+
+private:
+    bool compare(const QString &left, const QString &right) const
+    {
+        return isLocaleAware ? left.localeAwareCompare(right) < 0
+                             : left.compare(right, cs) < 0;
+    }
+
+    Qt::CaseSensitivity cs;
+    bool isLocaleAware;
+};
+
+#if QT_CONFIG(thread)
+// Calls task(i) for each i in [0, count), on the global thread pool where
+// threads are available and on the calling thread otherwise.
+template <typename Task>
+static void runOnThreadPool(qsizetype count, const Task &task)
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    int started = 0;
+    for (qsizetype i = 1; i < count; ++i) {
+        if (pool->tryStart([&task, &done, i] { task(i); done.release(); }))
+            ++started;
+        else
+            task(i);
+    }
+    task(0);
+    done.acquire(started);
+}
+#endif
+
+// Stable sort that splits large ranges into one chunk per thread, sorts the
+// chunks concurrently and merges them pairwise.
+template <typename Iterator, typename Compare>
+static void parallelStableSort(Iterator begin, Iterator end, Compare lessThan)
+{
+#if QT_CONFIG(thread)
+    constexpr qsizetype MinimumChunkSize = 16 * 1024;
+    const qsizetype size = end - begin;
+    const qsizetype chunkCount = qMin(qsizetype(QThreadPool::globalInstance()->maxThreadCount()),
+                                      size / MinimumChunkSize);
+    if (chunkCount > 1) {
+        QVarLengthArray<Iterator, 32> bounds;
+        for (qsizetype i = 0; i < chunkCount; ++i)
+            bounds.append(begin + size * i / chunkCount);
+        bounds.append(end);
+
+        runOnThreadPool(chunkCount, [&](qsizetype i) {
+            std::stable_sort(bounds[i], bounds[i + 1], lessThan);
+        });
+        for (qsizetype width = 1; width < chunkCount; width *= 2) {
+            runOnThreadPool((chunkCount + 2 * width - 1) / (2 * width), [&](qsizetype i) {
+                const qsizetype first = i * 2 * width;
+                const qsizetype middle = qMin(first + width, chunkCount);
+                const qsizetype last = qMin(first + 2 * width, chunkCount);
+                if (middle < last)
+                    std::inplace_merge(bounds[first], bounds[middle], bounds[last], lessThan);
+            });
+        }
+        return;
+    }
+#endif
+    std::stable_sort(begin, end, lessThan);
+}
+
+#if QT_CONFIG(thread)
+// A filter pass run on worker threads when asynchronousFilteringEnabled is
+// set. The proxy model's thread copies the texts to match from the source
+// model one chunk of rows at a time, so that the workers never access the
+// model; a worker matches the chunk against a copy of the filter settings
+// and posts the accepted rows to the proxy, which then reads the next one.
+struct QSortFilterProxyModelFilterPass
+{
+    static constexpr int ChunkSize = 4096;
+
+    QRegularExpression regularExpression;
+    int column = -1;
+    int role = Qt::DisplayRole;
+    int textsPerRow = 1; // 0 if there is nothing to match
+    int rowCount = 0;
+
+    QAtomicInteger<bool> canceled = false;
+
+    // same as the default implementation of QSortFilterProxyModel::filterAcceptsRow(),
+    // for the row whose texts start at texts[row * textsPerRow]
+    bool acceptsRow(const QStringList &texts, int row) const
+    {
+        if (textsPerRow == 0)
+            return true;
+        for (int i = row * textsPerRow; i < (row + 1) * textsPerRow; ++i) {
+            if (texts.at(i).contains(regularExpression))
+                return true;
+        }
+        return false;
+    }
+};
+#endif
+
 
 //this struct is used to store what are the rows that are removed
 //between a call to rowsAboutToBeRemoved and rowsRemoved
@@ -166,6 +325,24 @@ public:
 
     void setDynamicSortFilterForwarder(bool enable) { q_func()->setDynamicSortFilter(enable); }
 
+    void setParallelSortingEnabledForwarder(bool enable)
+    {
+        q_func()->setParallelSortingEnabled(enable);
+    }
+    void parallelSortingEnabledChangedForwarder(bool enable)
+    {
+        emit q_func()->parallelSortingEnabledChanged(enable);
+    }
+
+    void setAsynchronousFilteringEnabledForwarder(bool enable)
+    {
+        q_func()->setAsynchronousFilteringEnabled(enable);
+    }
+    void asynchronousFilteringEnabledChangedForwarder(bool enable)
+    {
+        emit q_func()->asynchronousFilteringEnabledChanged(enable);
+    }
+
     void setFilterCaseSensitivityForwarder(Qt::CaseSensitivity cs)
     {
         q_func()->setFilterCaseSensitivity(cs);
@@ -223,6 +400,28 @@ public:
                                        &QSortFilterProxyModelPrivate::setDynamicSortFilterForwarder,
                                        true)
 
+    Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
+            QSortFilterProxyModelPrivate, bool, parallel_sorting,
+            &QSortFilterProxyModelPrivate::setParallelSortingEnabledForwarder,
+            &QSortFilterProxyModelPrivate::parallelSortingEnabledChangedForwarder, false)
+
+    Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
+            QSortFilterProxyModelPrivate, bool, async_filtering,
+            &QSortFilterProxyModelPrivate::setAsynchronousFilteringEnabledForwarder,
+            &QSortFilterProxyModelPrivate::asynchronousFilteringEnabledChangedForwarder, false)
+
+#if QT_CONFIG(thread)
+    std::shared_ptr<QSortFilterProxyModelFilterPass> filter_pass;
+    // released by each chunk of a filter pass when its worker is done
+    QSemaphore filter_passes_done;
+    int filter_passes_started = 0;
+
+    // set while default_filter_accepts_row() calls filterAcceptsRow()
+    enum class FilterProbe { None, Accept, Reject };
+    mutable FilterProbe filter_probe = FilterProbe::None;
+    mutable bool filter_probe_reached = false;
+#endif
+
     Q_OBJECT_COMPAT_PROPERTY_WITH_ARGS(
             QSortFilterProxyModelPrivate, Qt::CaseSensitivity, filter_casesensitive,
             &QSortFilterProxyModelPrivate::setFilterCaseSensitivityForwarder,
@@ -331,6 +530,9 @@ public:
     int find_source_sort_column() const;
     void sort_source_rows(QList<int> &source_rows,
                           const QModelIndex &source_parent) const;
+    void sort_source_rows_by_key(QList<int> &source_rows,
+                                 const QModelIndex &source_parent) const;
+    bool source_less_than(const QModelIndex &source_left, const QModelIndex &source_right) const;
     QList<QPair<int, QList<int>>> proxy_intervals_for_source_items_to_add(
         const QList<int> &proxy_to_source, const QList<int> &source_items,
         const QModelIndex &source_parent, Qt::Orientation orient) const;
@@ -365,6 +567,15 @@ public:
 
     void filter_about_to_be_changed(const QModelIndex &source_parent = QModelIndex());
     void filter_changed(Direction dir, const QModelIndex &source_parent = QModelIndex());
+    bool start_async_filter();
+#if QT_CONFIG(thread)
+    bool default_filter_accepts_row() const;
+    void filter_async_chunk(const std::shared_ptr<QSortFilterProxyModelFilterPass> &pass,
+                            int first);
+#endif
+    void cancel_async_filter(bool wait = false);
+    void async_filter_source_changed(const QModelIndex &source_parent, int first);
+    void apply_async_filter_chunk(int first, int last, const QList<int> &accepted_rows);
     QSet<int> handle_filter_changed(
         QList<int> &source_to_proxy, QList<int> &proxy_to_source,
         const QModelIndex &source_parent, Qt::Orientation orient);
@@ -391,6 +602,7 @@ static bool operator&(QSortFilterProxyModelPrivate::Direction a, QSortFilterProx
 void QSortFilterProxyModelPrivate::_q_sourceModelDestroyed()
 {
     QAbstractProxyModelPrivate::_q_sourceModelDestroyed();
+    cancel_async_filter(true);
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
 }
@@ -458,6 +670,8 @@ void QSortFilterProxyModelPrivate::remove_from_mapping(const QModelIndex &source
 
 void QSortFilterProxyModelPrivate::_q_clearMapping()
 {
+    cancel_async_filter();
+
     // store the persistent indexes
     QModelIndexPairList source_indexes = store_persistent_indexes();
 
@@ -679,7 +893,9 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     QList<int> &source_rows, const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
-    if (source_sort_column >= 0) {
+    if (source_sort_column >= 0 && parallel_sorting) {
+        sort_source_rows_by_key(source_rows, source_parent);
+    } else if (source_sort_column >= 0) {
         if (sort_order == Qt::AscendingOrder) {
             QSortFilterProxyModelLessThan lt(source_sort_column, source_parent, model, q);
             std::stable_sort(source_rows.begin(), source_rows.end(), lt);
@@ -692,6 +908,66 @@ void QSortFilterProxyModelPrivate::sort_source_rows(
     }
 }
 
+/*!
+  \internal
+
+  Sorts the given \a source_rows like sort_source_rows() does, but for
+  parallelSortingEnabled: the sort keys are read from the source model once,
+  and are then sorted using the default comparison of lessThan(), on
+  multiple threads for large lists.
+*/
+void QSortFilterProxyModelPrivate::sort_source_rows_by_key(
+    QList<int> &source_rows, const QModelIndex &source_parent) const
+{
+    const qsizetype count = source_rows.size();
+    if (count < 2)
+        return;
+
+    // the model may only be accessed from its own thread
+    QList<QSortFilterProxyModelSortKey> keys(count);
+    for (qsizetype i = 0; i < count; ++i) {
+        const QModelIndex index = model->index(source_rows.at(i), source_sort_column, source_parent);
+        keys[i].setValue(model->data(index, sort_role));
+    }
+
+    QList<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    const QSortFilterProxyModelSortKeyLessThan lessThan(sort_casesensitivity, sort_localeaware);
+    if (sort_order == Qt::AscendingOrder) {
+        parallelStableSort(order.begin(), order.end(), [&](int left, int right) {
+            return lessThan(keys.at(left), keys.at(right));
+        });
+    } else {
+        parallelStableSort(order.begin(), order.end(), [&](int left, int right) {
+            return lessThan(keys.at(right), keys.at(left));
+        });
+    }
+
+    const QList<int> unsorted = source_rows;
+    for (qsizetype i = 0; i < count; ++i)
+        source_rows[i] = unsorted.at(order.at(i));
+}
+
+/*!
+  \internal
+
+  Returns whether the item \a source_left sorts before \a source_right,
+  comparing them with lessThan() or, if parallelSortingEnabled is set, with
+  the default comparison.
+*/
+bool QSortFilterProxyModelPrivate::source_less_than(const QModelIndex &source_left,
+                                                    const QModelIndex &source_right) const
+{
+    if (!parallel_sorting)
+        return q_func()->lessThan(source_left, source_right);
+
+    QSortFilterProxyModelSortKey left;
+    QSortFilterProxyModelSortKey right;
+    left.setValue(model->data(source_left, sort_role));
+    right.setValue(model->data(source_right, sort_role));
+    return QSortFilterProxyModelSortKeyLessThan(sort_casesensitivity, sort_localeaware)(left, right);
+}
+
 /*!
   \internal
 
@@ -822,7 +1098,6 @@ QList<QPair<int, QList<int>>> QSortFilterProxyModelPrivate::proxy_intervals_for_
     const QList<int> &proxy_to_source, const QList<int> &source_items,
     const QModelIndex &source_parent, Qt::Orientation orient) const
 {
-    Q_Q(const QSortFilterProxyModel);
     QList<QPair<int, QList<int>>> proxy_intervals;
     if (source_items.isEmpty())
         return proxy_intervals;
@@ -845,7 +1120,7 @@ QList<QPair<int, QList<int>>> QSortFilterProxyModelPrivate::proxy_intervals_for_
             proxy_item = (proxy_low + proxy_high) / 2;
             if (compare) {
                 QModelIndex i2 = model->index(proxy_to_source.at(proxy_item), source_sort_column, source_parent);
-                if ((sort_order == Qt::AscendingOrder) ? q->lessThan(i1, i2) : q->lessThan(i2, i1))
+                if ((sort_order == Qt::AscendingOrder) ? source_less_than(i1, i2) : source_less_than(i2, i1))
                     proxy_high = proxy_item - 1;
                 else
                     proxy_low = proxy_item + 1;
@@ -868,7 +1143,7 @@ QList<QPair<int, QList<int>>> QSortFilterProxyModelPrivate::proxy_intervals_for_
                 int new_source_item = source_items.at(source_items_index);
                 if (compare) {
                     QModelIndex i2 = model->index(new_source_item, source_sort_column, source_parent);
-                    if ((sort_order == Qt::AscendingOrder) ? q->lessThan(i1, i2) : q->lessThan(i2, i1))
+                    if ((sort_order == Qt::AscendingOrder) ? source_less_than(i1, i2) : source_less_than(i2, i1))
                         break;
                 } else {
                     if (proxy_to_source.at(proxy_item) < new_source_item)
@@ -1280,6 +1555,12 @@ void QSortFilterProxyModelPrivate::filter_about_to_be_changed(const QModelIndex
 */
 void QSortFilterProxyModelPrivate::filter_changed(Direction dir, const QModelIndex &source_parent)
 {
+    if (!source_parent.isValid() && (dir & Direction::Rows)) {
+        cancel_async_filter();
+        if (dir == Direction::Rows && start_async_filter())
+            return;
+    }
+
     IndexMap::const_iterator it = source_index_mapping.constFind(source_parent);
     if (it == source_index_mapping.constEnd())
         return;
@@ -1361,6 +1642,216 @@ QSet<int> QSortFilterProxyModelPrivate::handle_filter_changed(
     return qListToSet(source_items_remove);
 }
 
+/*!
+  \internal
+
+  Starts filtering the rows of the root mapping on a worker thread, if
+  asynchronousFilteringEnabled is set and the current configuration allows
+  it. Returns false if the rows need to be filtered synchronously instead.
+*/
+bool QSortFilterProxyModelPrivate::start_async_filter()
+{
+#if QT_CONFIG(thread)
+    if (!async_filtering || filter_recursive)
+        return false;
+    IndexMap::const_iterator it = source_index_mapping.constFind(QModelIndex());
+    if (it == source_index_mapping.constEnd() || !it.value()->mapped_children.isEmpty())
+        return false;
+    const int row_count = model->rowCount();
+    if (row_count == 0 || !default_filter_accepts_row())
+        return false;
+
+    auto pass = std::make_shared<QSortFilterProxyModelFilterPass>();
+    pass->regularExpression = filter_regularexpression.value();
+    pass->column = filter_column;
+    pass->role = filter_role;
+    pass->rowCount = row_count;
+    if (pass->regularExpression.pattern().isEmpty()) {
+        pass->textsPerRow = 0;
+    } else {
+        const int column_count = model->columnCount();
+        if (pass->column == -1)
+            pass->textsPerRow = column_count;
+        else if (pass->column >= column_count)
+            pass->textsPerRow = 0; // the default filterAcceptsRow() accepts all rows
+    }
+    filter_pass = pass;
+    filter_async_chunk(pass, 0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+#if QT_CONFIG(thread)
+/*!
+  \internal
+
+  Returns true if filterAcceptsRow() is not reimplemented, or only passes
+  on the result of the default implementation, which is what the
+  asynchronous filter passes do. This is found out by calling it for the
+  first root row while the default implementation only records that it
+  was called and returns true, and then false.
+*/
+bool QSortFilterProxyModelPrivate::default_filter_accepts_row() const
+{
+    Q_Q(const QSortFilterProxyModel);
+    bool is_default = true;
+    for (FilterProbe probe : { FilterProbe::Accept, FilterProbe::Reject }) {
+        filter_probe = probe;
+        filter_probe_reached = false;
+        const bool accepted = q->filterAcceptsRow(0, QModelIndex());
+        is_default = is_default && filter_probe_reached
+                && accepted == (probe == FilterProbe::Accept);
+    }
+    filter_probe = FilterProbe::None;
+    return is_default;
+}
+
+/*!
+  \internal
+
+  Reads the texts of the chunk of root rows starting at \a first from the
+  source model and starts a worker that matches them for \a pass. When its
+  result has been applied, the next chunk is read, so that the proxy
+  model's thread gets back to its event loop in between.
+*/
+void QSortFilterProxyModelPrivate::filter_async_chunk(
+        const std::shared_ptr<QSortFilterProxyModelFilterPass> &pass, int first)
+{
+    Q_Q(QSortFilterProxyModel);
+    const int last = qMin(first + QSortFilterProxyModelFilterPass::ChunkSize, pass->rowCount);
+    QStringList texts;
+    if (pass->textsPerRow > 0) {
+        texts.reserve(qsizetype(last - first) * pass->textsPerRow);
+        for (int row = first; row < last; ++row) {
+            for (int i = 0; i < pass->textsPerRow; ++i) {
+                const QModelIndex index = model->index(row, pass->column == -1 ? i : pass->column);
+                texts.append(model->data(index, pass->role).toString());
+            }
+        }
+    }
+    ++filter_passes_started;
+
+    QThreadPool::globalInstance()->start([this, q, pass, first, last, texts] {
+        QList<int> accepted_rows;
+        for (int row = first; row < last; ++row) {
+            if ((row % 256) == 0 && pass->canceled.loadRelaxed())
+                break;
+            if (pass->acceptsRow(texts, row - first))
+                accepted_rows.append(row);
+        }
+        if (!pass->canceled.loadRelaxed()) {
+            QMetaObject::invokeMethod(q, [this, pass, first, last, accepted_rows] {
+                if (filter_pass != pass)
+                    return; // canceled while this was queued
+                if (last == pass->rowCount)
+                    filter_pass.reset();
+                apply_async_filter_chunk(first, last, accepted_rows);
+                if (filter_pass == pass)
+                    filter_async_chunk(pass, last);
+            }, Qt::QueuedConnection);
+        }
+        filter_passes_done.release();
+    });
+}
+#endif
+
+/*!
+  \internal
+
+  Cancels the running asynchronous filter pass, if any. If \a wait is true,
+  also waits for the workers of all passes started so far, including those
+  canceled before, to finish.
+*/
+void QSortFilterProxyModelPrivate::cancel_async_filter(bool wait)
+{
+#if QT_CONFIG(thread)
+    if (filter_pass) {
+        filter_pass->canceled.storeRelaxed(true);
+        filter_pass.reset();
+    }
+    if (wait && filter_passes_started > 0) {
+        filter_passes_done.acquire(filter_passes_started);
+        filter_passes_started = 0;
+    }
+#else
+    Q_UNUSED(wait);
+#endif
+}
+
+/*!
+  \internal
+
+  Called when rows of the source model are inserted, removed or changed,
+  starting with \a first. Restarts a running asynchronous filter pass if
+  it may have evaluated those rows already, so that no outdated results
+  are published; rows appended after the range of the pass are filtered
+  synchronously on insertion.
+*/
+void QSortFilterProxyModelPrivate::async_filter_source_changed(const QModelIndex &source_parent,
+                                                               int first)
+{
+#if QT_CONFIG(thread)
+    if (!filter_pass || source_parent.isValid() || first >= filter_pass->rowCount)
+        return;
+    cancel_async_filter();
+    if (!start_async_filter())
+        filter_changed(Direction::Rows);
+#else
+    Q_UNUSED(source_parent);
+    Q_UNUSED(first);
+#endif
+}
+
+/*!
+  \internal
+
+  Applies the result of an asynchronous filter pass for the source rows
+  from \a first to \a last (exclusive) of the root mapping: the sorted
+  \a accepted_rows are inserted if not already mapped, the other rows of
+  the chunk are removed.
+*/
+void QSortFilterProxyModelPrivate::apply_async_filter_chunk(int first, int last,
+                                                            const QList<int> &accepted_rows)
+{
+    IndexMap::const_iterator it = source_index_mapping.constFind(QModelIndex());
+    if (it == source_index_mapping.constEnd())
+        return;
+    Mapping *m = it.value();
+
+    QList<int> source_rows_remove;
+    QList<int> source_rows_insert;
+    auto accepted = accepted_rows.cbegin();
+    last = qMin(last, int(m->proxy_rows.size()));
+    for (int source_row = first; source_row < last; ++source_row) {
+        const bool is_accepted = accepted != accepted_rows.cend() && *accepted == source_row;
+        if (is_accepted)
+            ++accepted;
+        const bool is_mapped = m->proxy_rows.at(source_row) != -1;
+        if (is_mapped && !is_accepted)
+            source_rows_remove.append(source_row);
+        else if (!is_mapped && is_accepted)
+            source_rows_insert.append(source_row);
+    }
+    if (source_rows_remove.isEmpty() && source_rows_insert.isEmpty())
+        return;
+
+    remove_source_items(m->proxy_rows, m->source_rows, source_rows_remove, QModelIndex(),
+                        Qt::Vertical);
+    for (qsizetype i = m->mapped_children.size() - 1; i >= 0; --i) {
+        const QModelIndex source_child_index = m->mapped_children.at(i);
+        if (std::binary_search(source_rows_remove.cbegin(), source_rows_remove.cend(),
+                               source_child_index.row())) {
+            remove_from_mapping(source_child_index);
+            m->mapped_children.remove(i);
+        }
+    }
+    sort_source_rows(source_rows_insert, QModelIndex());
+    insert_source_items(m->proxy_rows, m->source_rows, source_rows_insert, QModelIndex(),
+                        Qt::Vertical);
+}
+
 bool QSortFilterProxyModelPrivate::needsReorder(const QList<int> &source_rows, const QModelIndex &source_parent) const
 {
     Q_Q(const QSortFilterProxyModel);
@@ -1375,13 +1866,13 @@ bool QSortFilterProxyModelPrivate::needsReorder(const QList<int> &source_rows, c
         if (proxyIndex.row() > 0) {
             const QModelIndex prevProxyIndex = q->sibling(proxyIndex.row() - 1, proxy_sort_column, proxyIndex);
             const QModelIndex prevSourceIndex = proxy_to_source(prevProxyIndex);
-            if (sort_order == Qt::AscendingOrder ? q->lessThan(sourceIndex, prevSourceIndex) : q->lessThan(prevSourceIndex, sourceIndex))
+            if (sort_order == Qt::AscendingOrder ? source_less_than(sourceIndex, prevSourceIndex) : source_less_than(prevSourceIndex, sourceIndex))
                 return true;
         }
         if (proxyIndex.row() < proxyRowCount - 1) {
             const QModelIndex nextProxyIndex = q->sibling(proxyIndex.row() + 1, proxy_sort_column, proxyIndex);
             const QModelIndex nextSourceIndex = proxy_to_source(nextProxyIndex);
-            if (sort_order == Qt::AscendingOrder ? q->lessThan(nextSourceIndex, sourceIndex) : q->lessThan(sourceIndex, nextSourceIndex))
+            if (sort_order == Qt::AscendingOrder ? source_less_than(nextSourceIndex, sourceIndex) : source_less_than(sourceIndex, nextSourceIndex))
                 return true;
         }
         return false;
@@ -1530,6 +2021,9 @@ void QSortFilterProxyModelPrivate::_q_sourceDataChanged(const QModelIndex &sourc
                                 source_rows_insert, source_parent, Qt::Vertical);
         }
     }
+
+    if (roles.isEmpty() || roles.contains(filter_role))
+        async_filter_source_changed(source_top_left.parent(), source_top_left.row());
 }
 
 void QSortFilterProxyModelPrivate::_q_sourceHeaderDataChanged(Qt::Orientation orientation,
@@ -1630,6 +2124,7 @@ void QSortFilterProxyModelPrivate::_q_sourceLayoutChanged(const QList<QPersisten
 
     // Optimize: We only actually have to clear the mapping related to the contents of
     // sourceParents, not everything.
+    cancel_async_filter();
     qDeleteAll(source_index_mapping);
     source_index_mapping.clear();
 
@@ -1683,6 +2178,7 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsInserted(
         source_items_inserted(source_parent, start, end, Qt::Vertical);
         if (update_source_sort_column() && dynamic_sortfilter) //previous call to update_source_sort_column may fail if the model has no column.
             sort();                      // now it should succeed so we need to make sure to sort again
+        async_filter_source_changed(source_parent, start);
         return;
     }
 
@@ -1717,6 +2213,7 @@ void QSortFilterProxyModelPrivate::_q_sourceRowsRemoved(
 {
     itemsBeingRemoved = QRowsRemoval();
     source_items_removed(source_parent, start, end, Qt::Vertical);
+    async_filter_source_changed(source_parent, start);
 
     if (filter_recursive) {
         // Find out if removing this visible row means that some ascendant
@@ -2015,6 +2512,7 @@ QSortFilterProxyModel::QSortFilterProxyModel(QObject *parent)
 QSortFilterProxyModel::~QSortFilterProxyModel()
 {
     Q_D(QSortFilterProxyModel);
+    d->cancel_async_filter(true);
     qDeleteAll(d->source_index_mapping);
     d->source_index_mapping.clear();
 }
@@ -2029,6 +2527,7 @@ void QSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
     if (sourceModel == d->model)
         return;
 
+    d->cancel_async_filter(true);
     beginResetModel();
 
     disconnect(d->model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QList<int>)),
@@ -3105,6 +3604,126 @@ QBindable<bool> QSortFilterProxyModel::bindableAutoAcceptChildRows()
     return QBindable<bool>(&d->accept_children);
 }
 
+/*!
+    \since 6.6
+    \property QSortFilterProxyModel::parallelSortingEnabled
+    \brief whether sorting reads the sort keys once and may use multiple
+    threads
+
+    By default, the proxy model sorts by calling lessThan() for each
+    comparison, which queries the source model for the data of both items
+    every time. When this property is true, the proxy model instead reads the
+    \l sortRole data of every item to be sorted once, and sorts those values.
+    Large lists are sorted concurrently on QThreadPool::globalInstance().
+    Rows inserted into the source model and rows whose data changed are still
+    moved into place individually, using a binary search.
+
+    In this mode, lessThan() is not called. The values are compared the way
+    the default implementation of lessThan() compares them, taking
+    \l sortCaseSensitivity and \l isSortLocaleAware into account. Do not
+    enable this property in subclasses that reimplement lessThan().
+
+    The default value is false.
+
+    \sa sortRole, sort()
+*/
+
+/*!
+    \since 6.6
+    \fn void QSortFilterProxyModel::parallelSortingEnabledChanged(bool parallelSortingEnabled)
+
+    \brief This signal is emitted when the value of the \a parallelSortingEnabled
+    property is changed.
+*/
+bool QSortFilterProxyModel::isParallelSortingEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->parallel_sorting;
+}
+
+void QSortFilterProxyModel::setParallelSortingEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->parallel_sorting.removeBindingUnlessInWrapper();
+    if (d->parallel_sorting == enable)
+        return;
+    d->parallel_sorting.setValueBypassingBindings(enable);
+    d->sort();
+    d->parallel_sorting.notify(); // also emits a signal
+}
+
+QBindable<bool> QSortFilterProxyModel::bindableParallelSortingEnabled()
+{
+    Q_D(QSortFilterProxyModel);
+    return QBindable<bool>(&d->parallel_sorting);
+}
+
+/*!
+    \since 6.6
+    \property QSortFilterProxyModel::asynchronousFilteringEnabled
+    \brief whether the top-level rows are filtered on a worker thread when
+    the filter changes
+
+    By default, changing the filter, for instance with
+    setFilterRegularExpression(), filters all rows of the source model before
+    the function returns. When this property is true, the top-level rows are
+    instead matched in chunks on a thread of QThreadPool::globalInstance(),
+    and the proxy model inserts and removes the rows of each chunk as its
+    result becomes available. Changing the filter again cancels the pass in
+    progress and starts a new one.
+
+    The texts to match are read from the source model in the proxy model's
+    thread one chunk of rows at a time, in between the results of the
+    worker threads, which never access the source model themselves. They
+    match the texts against \l filterRegularExpression, \l filterKeyColumn
+    and \l filterRole the way the default implementation of
+    filterAcceptsRow() does, so the rows of subclasses that reimplement
+    filterAcceptsRow() are always filtered synchronously.
+
+    Child rows, and all rows while \l recursiveFilteringEnabled is true, are
+    always filtered synchronously.
+
+    The default value is false.
+
+    \sa filterRegularExpression
+*/
+
+/*!
+    \since 6.6
+    \fn void QSortFilterProxyModel::asynchronousFilteringEnabledChanged(bool asynchronousFilteringEnabled)
+
+    \brief This signal is emitted when the value of the
+    \a asynchronousFilteringEnabled property is changed.
+*/
+bool QSortFilterProxyModel::isAsynchronousFilteringEnabled() const
+{
+    Q_D(const QSortFilterProxyModel);
+    return d->async_filtering;
+}
+
+void QSortFilterProxyModel::setAsynchronousFilteringEnabled(bool enable)
+{
+    Q_D(QSortFilterProxyModel);
+    d->async_filtering.removeBindingUnlessInWrapper();
+    if (d->async_filtering == enable)
+        return;
+    d->async_filtering.setValueBypassingBindings(enable);
+#if QT_CONFIG(thread)
+    if (!enable && d->filter_pass) {
+        // finish the pass in progress synchronously
+        d->cancel_async_filter(true);
+        d->filter_changed(QSortFilterProxyModelPrivate::Direction::Rows);
+    }
+#endif
+    d->async_filtering.notify(); // also emits a signal
+}
+
+QBindable<bool> QSortFilterProxyModel::bindableAsynchronousFilteringEnabled()
+{
+    Q_D(QSortFilterProxyModel);
+    return QBindable<bool>(&d->async_filtering);
+}
+
 /*!
    \since 4.3
 
@@ -3245,6 +3864,13 @@ bool QSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelIndex &
 {
     Q_D(const QSortFilterProxyModel);
 
+#if QT_CONFIG(thread)
+    if (d->filter_probe != QSortFilterProxyModelPrivate::FilterProbe::None) {
+        d->filter_probe_reached = true;
+        return d->filter_probe == QSortFilterProxyModelPrivate::FilterProbe::Accept;
+    }
+#endif
+
     if (d->filter_regularexpression.value().pattern().isEmpty())
         return true;
 
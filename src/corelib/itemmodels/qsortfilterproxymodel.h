@@ -46,6 +46,12 @@ class Q_CORE_EXPORT QSortFilterProxyModel : public QAbstractProxyModel
                BINDABLE bindableRecursiveFilteringEnabled)
     Q_PROPERTY(bool autoAcceptChildRows READ autoAcceptChildRows WRITE setAutoAcceptChildRows
                NOTIFY autoAcceptChildRowsChanged BINDABLE bindableAutoAcceptChildRows)
+    Q_PROPERTY(bool parallelSortingEnabled READ isParallelSortingEnabled
+               WRITE setParallelSortingEnabled NOTIFY parallelSortingEnabledChanged
+               BINDABLE bindableParallelSortingEnabled REVISION(6, 6))
+    Q_PROPERTY(bool asynchronousFilteringEnabled READ isAsynchronousFilteringEnabled
+               WRITE setAsynchronousFilteringEnabled NOTIFY asynchronousFilteringEnabledChanged
+               BINDABLE bindableAsynchronousFilteringEnabled REVISION(6, 6))
 
 public:
     explicit QSortFilterProxyModel(QObject *parent = nullptr);
@@ -101,6 +107,14 @@ public:
     void setAutoAcceptChildRows(bool accept);
     QBindable<bool> bindableAutoAcceptChildRows();
 
+    bool isParallelSortingEnabled() const;
+    void setParallelSortingEnabled(bool enable);
+    QBindable<bool> bindableParallelSortingEnabled();
+
+    bool isAsynchronousFilteringEnabled() const;
+    void setAsynchronousFilteringEnabled(bool enable);
+    QBindable<bool> bindableAsynchronousFilteringEnabled();
+
 public Q_SLOTS:
     void setFilterRegularExpression(const QString &pattern);
     void setFilterRegularExpression(const QRegularExpression &regularExpression);
@@ -168,6 +182,8 @@ Q_SIGNALS:
     void filterRoleChanged(int filterRole);
     void recursiveFilteringEnabledChanged(bool recursiveFilteringEnabled);
     void autoAcceptChildRowsChanged(bool autoAcceptChildRows);
+    Q_REVISION(6, 6) void parallelSortingEnabledChanged(bool parallelSortingEnabled);
+    Q_REVISION(6, 6) void asynchronousFilteringEnabledChanged(bool asynchronousFilteringEnabled);
 
 private:
     Q_DECLARE_PRIVATE(QSortFilterProxyModel)
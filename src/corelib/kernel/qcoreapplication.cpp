@@ -337,7 +337,7 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 qsizetype qGlobalPostedEventsCount()
 {
     const QPostEventList &l = QThreadData::current()->postEventList;
-    return l.size() - l.startOffset;
+    return l.size() - l.startOffset + (l.hasIncomingEvents() ? 1 : 0);
 }
 
 Q_CONSTINIT QAbstractEventDispatcher *QCoreApplicationPrivate::eventDispatcher = nullptr;
@@ -486,6 +486,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.mergeIncomingEvents();
         for (const QPostEvent &pe : std::as_const(thisThreadData->postEventList)) {
             if (pe.event) {
                 --pe.receiver->d_func()->postedEvents;
@@ -1559,6 +1560,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     if (!object) {
         locker.threadData = QThreadData::current();
         locker.locker = qt_unique_lock(locker.threadData->postEventList.mutex);
+        locker.threadData->postEventList.mergeIncomingEvents();
         return locker;
     }
 
@@ -1580,6 +1582,9 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
         }
     }
 
+    // keep the order in which events were posted
+    locker.threadData->postEventList.mergeIncomingEvents();
+
     Q_ASSERT(locker.threadData);
     return locker;
 }
@@ -1622,6 +1627,41 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+    // Queued meta calls are never compressed and make up most of the
+    // cross-thread traffic, so they don't need to take the mutex of the
+    // receiver's list (see QPostEventList).
+    if (priority == Qt::NormalEventPriority && event->type() == QEvent::MetaCall) {
+        auto &threadData = QObjectPrivate::get(receiver)->threadData;
+        std::unique_ptr<QIncomingPostEvent> node;
+        // synchronizes with the storeRelease in QObject::moveToThread
+        while (QThreadData *data = threadData.loadAcquire()) {
+            QPostEventList &list = data->postEventList;
+            if (!list.beginIncoming())
+                break; // the receiver is being moved, take the mutex
+            if (data != threadData.loadAcquire()) {
+                // moved to another thread in the meantime, follow it
+                list.endIncoming();
+                continue;
+            }
+
+            if (!node)
+                node.reset(new QIncomingPostEvent{ QPostEvent(receiver, event, priority), nullptr });
+            Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+            event->m_posted = true;
+            ++receiver->d_func()->postedEvents;
+
+            // only the first event pushed since the list was last merged
+            // needs to wake up the thread
+            if (list.pushIncoming(node.release())) {
+                QAbstractEventDispatcher *dispatcher = data->eventDispatcher.loadAcquire();
+                if (dispatcher)
+                    dispatcher->wakeUp();
+            }
+            list.endIncoming();
+            return;
+        }
+    }
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1774,6 +1814,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.mergeIncomingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1991,6 +2032,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.mergeIncomingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
@@ -0,0 +1,507 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qplatformdefs.h"
+
+#include "qcoreapplication.h"
+#include "qsocketnotifier.h"
+#include "qthread.h"
+
+#include "qeventdispatcher_epoll_p.h"
+#include <private/qthread_p.h>
+#include <private/qcoreapplication_p.h>
+#include <private/qcore_unix_p.h>
+
+#include <errno.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// Upper bound for the number of ready descriptors collected by a single
+// epoll_wait(). Anything beyond that stays queued in the kernel and is
+// reported on the next iteration, so this only limits the batch size.
+static constexpr int MaxEventsPerWait = 1024;
+
+static const char *socketType(QSocketNotifier::Type type)
+{
+    switch (type) {
+    case QSocketNotifier::Read:
+        return "Read";
+    case QSocketNotifier::Write:
+        return "Write";
+    case QSocketNotifier::Exception:
+        return "Exception";
+    }
+
+    Q_UNREACHABLE();
+}
+
+static uint32_t epollEvents(short pollEvents, QEventDispatcherEpoll::TriggerMode mode)
+{
+    uint32_t result = 0;
+    if (pollEvents & POLLIN)
+        result |= EPOLLIN;
+    if (pollEvents & POLLOUT)
+        result |= EPOLLOUT;
+    if (pollEvents & POLLPRI)
+        result |= EPOLLPRI;
+    if (mode == QEventDispatcherEpoll::EdgeTriggered)
+        result |= EPOLLET;
+    return result;
+}
+
+static int timespecToMsecsRoundedUp(const timespec &ts)
+{
+    // epoll_wait() only has millisecond resolution; never round down, or
+    // we would wake up just before a timer expires and spin until it does
+    const qint64 msecs = qint64(ts.tv_sec) * 1000 + (ts.tv_nsec + 999999) / 1000000;
+    return int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+}
+
+QEventDispatcherEpollPrivate::QEventDispatcherEpollPrivate(QEventDispatcherEpoll::TriggerMode mode)
+    : triggerMode(mode)
+{
+    if (Q_UNLIKELY(threadPipe.init() == false))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot continue without a thread pipe");
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (Q_UNLIKELY(epollFd == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot continue without an epoll instance: %s",
+               qPrintable(qt_error_string(errno)));
+
+    // the thread pipe is always level-triggered, QThreadPipe::check() drains it
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (Q_UNLIKELY(epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1))
+        qFatal("QEventDispatcherEpollPrivate(): Cannot watch the thread pipe: %s",
+               qPrintable(qt_error_string(errno)));
+}
+
+QEventDispatcherEpollPrivate::~QEventDispatcherEpollPrivate()
+{
+    if (epollFd != -1)
+        qt_safe_close(epollFd);
+
+    // cleanup timers
+    qDeleteAll(timerList);
+}
+
+void QEventDispatcherEpollPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+
+    if (pendingNotifiers.contains(notifier))
+        return;
+
+    pendingNotifiers << notifier;
+}
+
+int QEventDispatcherEpollPrivate::activateTimers()
+{
+    return timerList.activateTimers();
+}
+
+/*!
+    \internal
+
+    Brings the kernel interest set for \a fd from \a oldEvents to \a newEvents
+    (both in poll(2) notation). This is the only place where the interest set
+    changes, so enabling or disabling a notifier costs a single epoll_ctl()
+    instead of rebuilding the descriptor list on every iteration.
+*/
+void QEventDispatcherEpollPrivate::updateInterest(int fd, short oldEvents, short newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+    if (newEvents == 0) {
+        nonPollableFds.removeOne(fd);
+        // the descriptor may already be closed, in which case the kernel
+        // dropped it from the interest set by itself
+        if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr) == -1
+                && errno != EBADF && errno != ENOENT && errno != EPERM) {
+            qErrnoWarning("QEventDispatcherEpoll: epoll_ctl(EPOLL_CTL_DEL) failed for fd %d", fd);
+        }
+        return;
+    }
+
+    epoll_event ev = {};
+    ev.events = epollEvents(newEvents, triggerMode);
+    ev.data.fd = fd;
+
+    int op = oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    int ret = epoll_ctl(epollFd, op, fd, &ev);
+    if (ret == -1 && op == EPOLL_CTL_ADD && errno == EEXIST) {
+        // a previous descriptor with the same number was closed while still
+        // being watched through a dup()ed description
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    } else if (ret == -1 && op == EPOLL_CTL_MOD && errno == ENOENT) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    if (ret == -1 && errno == EPERM) {
+        // regular files and directories cannot be watched with epoll, but
+        // poll(2) reports them as always ready; emulate that
+        if (!nonPollableFds.contains(fd))
+            nonPollableFds.append(fd);
+    } else if (ret == -1) {
+        qErrnoWarning("QEventDispatcherEpoll: epoll_ctl() failed for fd %d", fd);
+    }
+}
+
+void QEventDispatcherEpollPrivate::markPendingSocketNotifiers(const epoll_event *events, int count)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        uint32_t flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      EPOLLIN  | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR },
+        { QSocketNotifier::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR }
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const epoll_event &ev = events[i];
+        if (ev.data.fd == threadPipe.fds[0])
+            continue;
+
+        auto it = socketNotifiers.constFind(ev.data.fd);
+        if (it == socketNotifiers.cend())
+            continue;
+
+        const QSocketNotifierSetUNIX &sn_set = it.value();
+        for (const auto &n : notifiers) {
+            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+            if (notifier && (ev.events & n.flags))
+                setSocketNotifierPending(notifier);
+        }
+    }
+
+    for (int fd : std::as_const(nonPollableFds)) {
+        auto it = socketNotifiers.constFind(fd);
+        if (it == socketNotifiers.cend())
+            continue;
+        for (QSocketNotifier *notifier : it.value().notifiers) {
+            if (notifier)
+                setSocketNotifierPending(notifier);
+        }
+    }
+}
+
+int QEventDispatcherEpollPrivate::activateSocketNotifiers()
+{
+    if (pendingNotifiers.isEmpty())
+        return 0;
+
+    int n_activated = 0;
+    QEvent event(QEvent::SockAct);
+
+    while (!pendingNotifiers.isEmpty()) {
+        QSocketNotifier *notifier = pendingNotifiers.takeFirst();
+        QCoreApplication::sendEvent(notifier, &event);
+        ++n_activated;
+    }
+
+    return n_activated;
+}
+
+/*!
+    \internal
+
+    Used when socket notifiers are excluded from processing: the interest set
+    cannot be masked temporarily, so wait on the thread pipe alone instead.
+*/
+int QEventDispatcherEpollPrivate::waitForThreadPipe(timespec *tm)
+{
+    pollfd pfd = threadPipe.prepare();
+    switch (qt_safe_poll(&pfd, 1, tm)) {
+    case -1:
+        qErrnoWarning("qt_safe_poll");
+        if (QT_CONFIG(poll_exit_on_error))
+            abort();
+        return 0;
+    case 0:
+        return 0;
+    default:
+        return threadPipe.check(pfd);
+    }
+}
+
+/*!
+    \class QEventDispatcherEpoll
+    \internal
+
+    \brief The QEventDispatcherEpoll class is an event dispatcher for Linux
+    that keeps the set of watched descriptors in the kernel.
+
+    QEventDispatcherUNIX rebuilds the array of descriptors passed to poll()
+    on every iteration of the event loop, which is linear in the number of
+    socket notifiers. This dispatcher registers a descriptor with epoll once
+    and only updates the kernel state when a notifier is enabled or disabled,
+    so the per-iteration cost depends on the number of ready descriptors.
+
+    It is selected by setting the \c QT_EVENT_DISPATCHER_EPOLL environment
+    variable to a non-zero value. A value of \c edge selects edge-triggered
+    notification, in which case a notifier is only activated again after new
+    data arrives, so the receiver has to consume everything that is available.
+*/
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QObject *parent)
+    : QEventDispatcherEpoll(LevelTriggered, parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(TriggerMode mode, QObject *parent)
+    : QAbstractEventDispatcher(*new QEventDispatcherEpollPrivate(mode), parent)
+{ }
+
+QEventDispatcherEpoll::QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent)
+    : QAbstractEventDispatcher(dd, parent)
+{ }
+
+QEventDispatcherEpoll::~QEventDispatcherEpoll()
+{ }
+
+QEventDispatcherEpoll::TriggerMode QEventDispatcherEpoll::triggerMode() const
+{
+    Q_D(const QEventDispatcherEpoll);
+    return d->triggerMode;
+}
+
+/*!
+    \internal
+
+    Returns \c true if the environment asks for this dispatcher to be used
+    and stores the requested trigger mode in \a mode.
+*/
+bool QEventDispatcherEpoll::isRequested(TriggerMode *mode)
+{
+    const QByteArray value = qgetenv("QT_EVENT_DISPATCHER_EPOLL").trimmed().toLower();
+    if (value.isEmpty() || value == "0")
+        return false;
+    if (mode)
+        *mode = (value == "edge") ? EdgeTriggered : LevelTriggered;
+    return true;
+}
+
+void QEventDispatcherEpoll::registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *obj)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1 || interval < 0 || !obj) {
+        qWarning("QEventDispatcherEpoll::registerTimer: invalid arguments");
+        return;
+    } else if (obj->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::registerTimer: timers cannot be started from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    d->timerList.registerTimer(timerId, interval, timerType, obj);
+}
+
+bool QEventDispatcherEpoll::unregisterTimer(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: invalid argument");
+        return false;
+    } else if (thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimer: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimer(timerId);
+}
+
+bool QEventDispatcherEpoll::unregisterTimers(QObject *object)
+{
+#ifndef QT_NO_DEBUG
+    if (!object) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: invalid argument");
+        return false;
+    } else if (object->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QEventDispatcherEpoll::unregisterTimers: timers cannot be stopped from another thread");
+        return false;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.unregisterTimers(object);
+}
+
+QList<QEventDispatcherEpoll::TimerInfo>
+QEventDispatcherEpoll::registeredTimers(QObject *object) const
+{
+    if (!object) {
+        qWarning("QEventDispatcherEpoll:registeredTimers: invalid argument");
+        return QList<TimerInfo>();
+    }
+
+    Q_D(const QEventDispatcherEpoll);
+    return d->timerList.registeredTimers(object);
+}
+
+int QEventDispatcherEpoll::remainingTime(int timerId)
+{
+#ifndef QT_NO_DEBUG
+    if (timerId < 1) {
+        qWarning("QEventDispatcherEpoll::remainingTime: invalid argument");
+        return -1;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    return d->timerList.timerRemainingTime(timerId);
+}
+
+void QEventDispatcherEpoll::registerSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifiers cannot be enabled from another thread");
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+    QSocketNotifierSetUNIX &sn_set = d->socketNotifiers[sockfd];
+
+    if (sn_set.notifiers[type] && sn_set.notifiers[type] != notifier)
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = notifier;
+    d->updateInterest(sockfd, oldEvents, sn_set.events());
+}
+
+void QEventDispatcherEpoll::unregisterSocketNotifier(QSocketNotifier *notifier)
+{
+    Q_ASSERT(notifier);
+    int sockfd = notifier->socket();
+    QSocketNotifier::Type type = notifier->type();
+#ifndef QT_NO_DEBUG
+    if (notifier->thread() != thread() || thread() != QThread::currentThread()) {
+        qWarning("QSocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.", sockfd);
+        return;
+    }
+#endif
+
+    Q_D(QEventDispatcherEpoll);
+
+    d->pendingNotifiers.removeOne(notifier);
+
+    auto i = d->socketNotifiers.find(sockfd);
+    if (i == d->socketNotifiers.end())
+        return;
+
+    QSocketNotifierSetUNIX &sn_set = i.value();
+
+    if (sn_set.notifiers[type] == nullptr)
+        return;
+
+    if (sn_set.notifiers[type] != notifier) {
+        qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
+                 Q_FUNC_INFO, sockfd, socketType(type));
+        return;
+    }
+
+    const short oldEvents = sn_set.events();
+    sn_set.notifiers[type] = nullptr;
+    d->updateInterest(sockfd, oldEvents, sn_set.events());
+
+    if (sn_set.isEmpty())
+        d->socketNotifiers.erase(i);
+}
+
+bool QEventDispatcherEpoll::processEvents(QEventLoop::ProcessEventsFlags flags)
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(0);
+
+    // we are awake, broadcast it
+    emit awake();
+
+    auto threadData = d->threadData.loadRelaxed();
+    QCoreApplicationPrivate::sendPostedEvents(nullptr, 0, threadData);
+
+    const bool include_timers = (flags & QEventLoop::X11ExcludeTimers) == 0;
+    const bool include_notifiers = (flags & QEventLoop::ExcludeSocketNotifiers) == 0;
+    const bool wait_for_events = (flags & QEventLoop::WaitForMoreEvents) != 0;
+
+    const bool canWait = (threadData->canWaitLocked()
+                          && !d->interrupt.loadRelaxed()
+                          && wait_for_events);
+
+    if (canWait)
+        emit aboutToBlock();
+
+    if (d->interrupt.loadRelaxed())
+        return false;
+
+    timespec *tm = nullptr;
+    timespec wait_tm = { 0, 0 };
+
+    if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
+        tm = &wait_tm;
+
+    int nevents = 0;
+
+    if (!include_notifiers) {
+        nevents += d->waitForThreadPipe(tm);
+    } else {
+        // descriptors that epoll cannot watch are always ready, don't block
+        const int timeout = !d->nonPollableFds.isEmpty() ? 0
+                          : tm ? timespecToMsecsRoundedUp(*tm) : -1;
+        d->readyEvents.resize(qMin(d->socketNotifiers.size() + 1, qsizetype(MaxEventsPerWait)));
+
+        int ready = epoll_wait(d->epollFd, d->readyEvents.data(), int(d->readyEvents.size()), timeout);
+        if (ready == -1 && errno != EINTR) {
+            qErrnoWarning("epoll_wait");
+            if (QT_CONFIG(poll_exit_on_error))
+                abort();
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            const epoll_event &ev = d->readyEvents.at(i);
+            if (ev.data.fd == d->threadPipe.fds[0]) {
+                pollfd pfd = d->threadPipe.prepare();
+                pfd.revents = (ev.events & EPOLLIN) ? POLLIN : 0;
+                nevents += d->threadPipe.check(pfd);
+            }
+        }
+
+        d->markPendingSocketNotifiers(d->readyEvents.constData(), qMax(ready, 0));
+        nevents += d->activateSocketNotifiers();
+    }
+
+    if (include_timers)
+        nevents += d->activateTimers();
+
+    // return true if we handled events, false otherwise
+    return (nevents > 0);
+}
+
+void QEventDispatcherEpoll::wakeUp()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->threadPipe.wakeUp();
+}
+
+void QEventDispatcherEpoll::interrupt()
+{
+    Q_D(QEventDispatcherEpoll);
+    d->interrupt.storeRelaxed(1);
+    wakeUp();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qeventdispatcher_epoll_p.cpp"
@@ -0,0 +1,106 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QEVENTDISPATCHER_EPOLL_P_H
+#define QEVENTDISPATCHER_EPOLL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "QtCore/qabstracteventdispatcher.h"
+#include "QtCore/qlist.h"
+#include "QtCore/qhash.h"
+#include "QtCore/qvarlengtharray.h"
+#include "private/qabstracteventdispatcher_p.h"
+#include "private/qeventdispatcher_unix_p.h"
+#include "private/qtimerinfo_unix_p.h"
+
+#include <sys/epoll.h>
+
+QT_REQUIRE_CONFIG(epoll);
+
+QT_BEGIN_NAMESPACE
+
+class QEventDispatcherEpollPrivate;
+
+class Q_CORE_EXPORT QEventDispatcherEpoll : public QAbstractEventDispatcher
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QEventDispatcherEpoll)
+
+public:
+    enum TriggerMode {
+        LevelTriggered,
+        EdgeTriggered
+    };
+
+    explicit QEventDispatcherEpoll(QObject *parent = nullptr);
+    explicit QEventDispatcherEpoll(TriggerMode mode, QObject *parent = nullptr);
+    ~QEventDispatcherEpoll();
+
+    TriggerMode triggerMode() const;
+
+    bool processEvents(QEventLoop::ProcessEventsFlags flags) override;
+
+    void registerSocketNotifier(QSocketNotifier *notifier) final;
+    void unregisterSocketNotifier(QSocketNotifier *notifier) final;
+
+    void registerTimer(int timerId, qint64 interval, Qt::TimerType timerType, QObject *object) final;
+    bool unregisterTimer(int timerId) final;
+    bool unregisterTimers(QObject *object) final;
+    QList<TimerInfo> registeredTimers(QObject *object) const final;
+
+    int remainingTime(int timerId) final;
+
+    void wakeUp() final;
+    void interrupt() final;
+
+    static bool isRequested(TriggerMode *mode = nullptr);
+
+protected:
+    QEventDispatcherEpoll(QEventDispatcherEpollPrivate &dd, QObject *parent = nullptr);
+};
+
+class Q_CORE_EXPORT QEventDispatcherEpollPrivate : public QAbstractEventDispatcherPrivate
+{
+    Q_DECLARE_PUBLIC(QEventDispatcherEpoll)
+
+public:
+    QEventDispatcherEpollPrivate(QEventDispatcherEpoll::TriggerMode mode);
+    ~QEventDispatcherEpollPrivate();
+
+    int activateTimers();
+
+    void updateInterest(int fd, short oldEvents, short newEvents);
+    void markPendingSocketNotifiers(const epoll_event *events, int count);
+    int activateSocketNotifiers();
+    void setSocketNotifierPending(QSocketNotifier *notifier);
+
+    int waitForThreadPipe(timespec *tm);
+
+    QThreadPipe threadPipe;
+    int epollFd = -1;
+    QEventDispatcherEpoll::TriggerMode triggerMode;
+
+    // the interest set is kept in the kernel; this only mirrors it so that
+    // readiness can be mapped back to the notifiers
+    QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
+    QList<QSocketNotifier *> pendingNotifiers;
+    QList<int> nonPollableFds;
+    QVarLengthArray<epoll_event, 64> readyEvents;
+
+    QTimerInfoList timerList;
+    QAtomicInt interrupt; // bool
+};
+
+QT_END_NAMESPACE
+
+#endif // QEVENTDISPATCHER_EPOLL_P_H
@@ -1658,6 +1658,10 @@ void QObject::moveToThread(QThread *targetThread)
     QOrderedMutexLocker locker(&currentData->postEventList.mutex,
                                &targetData->postEventList.mutex);
 
+    // make postEvent() wait for the mutex so that no event can be queued
+    // for the old thread while the posted events are being moved
+    currentData->postEventList.blockIncoming();
+
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
@@ -1672,6 +1676,7 @@ void QObject::moveToThread(QThread *targetThread)
         bindingStatus = threadPrivate->addObjectWithPendingBindingStatusChange(this);
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
+    currentData->postEventList.unblockIncoming();
 
     locker.unlock();
 
@@ -17,15 +17,45 @@
 
 #include <sys/times.h>
 
+#include <QtCore/qalgorithms.h>
+#include <QtCore/qvarlengtharray.h>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
 
 /*
- * Internal functions for manipulating timer data structures.  The
- * timerBitVec array is used for keeping track of timer identifiers.
+ * Internal functions for manipulating timer data structures.
  */
 
+// the millisecond tick of the wheel the given time falls into
+static inline qint64 wheelTickOf(const timespec &t)
+{
+    return qint64(t.tv_sec) * 1000 + t.tv_nsec / 1'000'000;
+}
+
+static inline void initLink(QTimerWheelLink *head)
+{
+    head->prev = head->next = head;
+}
+
+static inline bool isEmptyLink(const QTimerWheelLink *head)
+{
+    return head->next == head;
+}
+
+// moves all entries of the list headed by \a from to the end of \a to
+static void spliceLinks(QTimerWheelLink *from, QTimerWheelLink *to)
+{
+    if (isEmptyLink(from))
+        return;
+    from->next->prev = to->prev;
+    from->prev->next = to;
+    to->prev->next = from->next;
+    to->prev = from->prev;
+    initLink(from);
+}
+
 QTimerInfoList::QTimerInfoList()
 {
 #if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)
@@ -47,7 +77,12 @@ QTimerInfoList::QTimerInfoList()
     }
 #endif
 
-    firstTimerInfo = nullptr;
+    for (int level = 0; level < LevelCount; ++level) {
+        occupied[level] = 0;
+        for (QTimerWheelLink &head : wheel[level])
+            initLink(&head);
+    }
+    initLink(&expired);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -110,11 +145,19 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 */
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
-    // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    // repair all timers, then rebuild the wheel around the new time
+    QVarLengthArray<QTimerInfo *, 64> wheelTimers;
+    for (QTimerInfo *t : std::as_const(timersById)) {
         t->timeout = t->timeout + diff;
+        if (t->slot >= 0) {
+            unlink(t);
+            wheelTimers.append(t);
+        }
     }
+
+    wheelTick = wheelTickOf(currentTime);
+    for (QTimerInfo *t : std::as_const(wheelTimers))
+        timerInsert(t);
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -135,17 +178,141 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Links \a t into the list for \a slot, which is either an index into the
+  wheel (level * SlotCount + index) or -1 for the list of expired timers.
+*/
+void QTimerInfoList::link(QTimerInfo *t, int slot)
+{
+    QTimerWheelLink *head = &expired;
+    if (slot >= 0) {
+        head = &wheel[slot >> SlotBits][slot & SlotMask];
+        occupied[slot >> SlotBits] |= Q_UINT64_C(1) << (slot & SlotMask);
+    }
+    t->prev = head->prev;
+    t->next = head;
+    head->prev->next = t;
+    head->prev = t;
+    t->slot = slot;
+}
+
+void QTimerInfoList::unlink(QTimerInfo *t)
+{
+    t->prev->next = t->next;
+    t->next->prev = t->prev;
+    if (t->slot >= 0) {
+        const int level = t->slot >> SlotBits;
+        const int index = t->slot & SlotMask;
+        if (isEmptyLink(&wheel[level][index]))
+            occupied[level] &= ~(Q_UINT64_C(1) << index);
+    }
+    t->prev = t->next = nullptr;
+    t->slot = -1;
+}
+
+/*
+  insert timer info into the wheel, or the expired list if it is already due
 */
 void QTimerInfoList::timerInsert(QTimerInfo *ti)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
+    qint64 due = wheelTickOf(ti->timeout);
+    if (!(currentTime < ti->timeout) || due < wheelTick) {
+        // already due, or the wheel has already moved past this tick
+        link(ti, -1);
+        return;
+    }
+
+    // find the level whose range covers the timeout; timers beyond the
+    // range of the last level wait in its farthest slot and get
+    // redistributed when the wheel reaches that
+    const qint64 delta = due - wheelTick;
+    int level = 0;
+    while (level < LevelCount - 1 && delta >= (Q_INT64_C(1) << (SlotBits * (level + 1))))
+        ++level;
+    if (delta >= (Q_INT64_C(1) << (SlotBits * LevelCount)))
+        due = wheelTick + (Q_INT64_C(1) << (SlotBits * LevelCount)) - 1;
+
+    const int index = int((due >> (SlotBits * level)) & SlotMask);
+    link(ti, level * SlotCount + index);
+}
+
+/*
+  Redistributes the timers of the current slot of \a level, and of the levels
+  above it whose current slot changes at the same time, to lower levels.
+*/
+void QTimerInfoList::cascade(int level)
+{
+    for (; level < LevelCount; ++level) {
+        const int index = int((wheelTick >> (SlotBits * level)) & SlotMask);
+        QTimerWheelLink pending;
+        initLink(&pending);
+        spliceLinks(&wheel[level][index], &pending);
+        occupied[level] &= ~(Q_UINT64_C(1) << index);
+
+        while (!isEmptyLink(&pending)) {
+            QTimerInfo *t = static_cast<QTimerInfo *>(pending.next);
+            t->slot = -1;
+            unlink(t);
+            timerInsert(t);
+        }
+
+        if (index != 0)
+            break;
+    }
+}
+
+/*
+  Moves the wheel forward to the tick of \a now, moving all timers that have
+  expired on the way to the list of expired timers. The slot of the current
+  tick keeps the timers that are due later within the same millisecond.
+*/
+void QTimerInfoList::advanceTo(const timespec &now)
+{
+    const qint64 tick = wheelTickOf(now);
+    while (wheelTick < tick) {
+        const int index = int(wheelTick & SlotMask);
+        QTimerWheelLink *head = &wheel[0][index];
+        for (QTimerWheelLink *l = head->next; l != head; l = l->next)
+            static_cast<QTimerInfo *>(l)->slot = -1;
+        spliceLinks(head, &expired);
+        occupied[0] &= ~(Q_UINT64_C(1) << index);
+        ++wheelTick;
+
+        // nothing else is due on the lowest level, so skip ahead to the
+        // next slot of the upper levels in one go
+        if (occupied[0] == 0 && (wheelTick & SlotMask) != 0)
+            wheelTick = qMin((wheelTick | SlotMask) + 1, tick);
+        if ((wheelTick & SlotMask) == 0)
+            cascade(1);
+    }
+
+    if (wheelTick == tick) {
+        QTimerWheelLink *head = &wheel[0][wheelTick & SlotMask];
+        for (QTimerWheelLink *l = head->next; l != head; ) {
+            QTimerInfo *t = static_cast<QTimerInfo *>(l);
+            l = l->next;
+            if (!(now < t->timeout)) {
+                unlink(t);
+                link(t, -1);
+            }
+        }
+    }
+}
+
+void QTimerInfoList::removeTimer(QTimerInfo *t)
+{
+    unlink(t);
+    auto range = timersByObject.equal_range(t->obj);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it.value() == t) {
+            timersByObject.erase(it);
             break;
+        }
     }
-    insert(index+1, ti);
+    if (t == firstTimerInfo)
+        firstTimerInfo = nullptr;
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -357,13 +524,38 @@ bool QTimerInfoList::timerWait(timespec &tm)
     repairTimersIfNeeded();
 
     // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
+    const QTimerInfo *t = nullptr;
+    for (const QTimerWheelLink *l = expired.next; l != &expired; l = l->next) {
+        if (!static_cast<const QTimerInfo *>(l)->activateRef) {
+            t = static_cast<const QTimerInfo *>(l);
             break;
         }
     }
+    const bool expiredTimer = t != nullptr;
+
+    // The first non-empty slot of each level, counting from the wheel's
+    // current position, holds the earliest timers of that level. Above
+    // level 0, the current slot itself can only hold timers a full rotation
+    // ahead, so it comes last.
+    for (int level = 0; !expiredTimer && level < LevelCount; ++level) {
+        const QTimerInfo *first = nullptr;
+        const int current = int((wheelTick >> (SlotBits * level)) & SlotMask);
+        const int start = level ? (current + 1) & SlotMask : current;
+        quint64 bits = occupied[level];
+        bits = start ? (bits >> start) | (bits << (SlotCount - start)) : bits;
+        while (bits && !first) {
+            const int index = (start + int(qCountTrailingZeroBits(bits))) & SlotMask;
+            bits &= bits - 1;
+            const QTimerWheelLink *head = &wheel[level][index];
+            for (const QTimerWheelLink *l = head->next; l != head; l = l->next) {
+                const QTimerInfo *candidate = static_cast<const QTimerInfo *>(l);
+                if (!candidate->activateRef && (!first || candidate->timeout < first->timeout))
+                    first = candidate;
+            }
+        }
+        if (first && (!t || first->timeout < t->timeout))
+            t = first;
+    }
 
     if (!t)
       return false;
@@ -391,17 +583,15 @@ qint64 QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (const auto *t : std::as_const(*this)) {
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                using namespace std::chrono;
-                const auto dur = duration_cast<milliseconds>(seconds{tm.tv_sec} + nanoseconds{tm.tv_nsec});
-                return dur.count();
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timersById.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            using namespace std::chrono;
+            const auto dur = duration_cast<milliseconds>(seconds{tm.tv_sec} + nanoseconds{tm.tv_nsec});
+            return dur.count();
+        } else {
+            return 0;
         }
     }
 
@@ -420,8 +610,11 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     t->timerType = timerType;
     t->obj = object;
     t->activateRef = nullptr;
+    t->slot = -1;
 
     timespec expected = updateCurrentTime() + interval;
+    if (timersById.isEmpty())
+        wheelTick = wheelTickOf(currentTime);
 
     switch (timerType) {
     case Qt::PreciseTimer:
@@ -464,6 +657,8 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
     }
 
     timerInsert(t);
+    timersById.insert(timerId, t);
+    timersByObject.insert(object, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -478,40 +673,27 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timersById.take(timerId);
+    if (!t)
+        return false; // id not found
+    removeTimer(t);
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->obj == object) {
-            // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            // move back one so that we don't skip the new current item
-            --i;
-        }
+    const QList<QTimerInfo *> timers = timersByObject.values(object);
+    timersByObject.remove(object);
+    for (QTimerInfo *t : timers) {
+        timersById.remove(t->id);
+        unlink(t);
+        if (t == firstTimerInfo)
+            firstTimerInfo = nullptr;
+        if (t->activateRef)
+            *(t->activateRef) = nullptr;
+        delete t;
     }
     return true;
 }
@@ -519,15 +701,14 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < size(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    auto range = timersByObject.equal_range(object);
+    for (auto it = range.first; it != range.second; ++it) {
+        const QTimerInfo * const t = it.value();
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -540,42 +721,38 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
-    firstTimerInfo = nullptr;
+    int n_act = 0;
 
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
 
+    // Move the timers that have expired to the expired list. They stay
+    // there until they are sent, so that a nested event loop started by one
+    // of them still sees and activates the others.
+    advanceTo(currentTime);
+    int maxCount = 0;
+    for (const QTimerWheelLink *l = expired.next; l != &expired; l = l->next)
+        ++maxCount;
 
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
-    }
+    firstTimerInfo = nullptr;
 
     //fire the timers.
     while (maxCount--) {
-        if (isEmpty())
+        if (isEmptyLink(&expired))
             break;
 
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
-            break; // no timer has expired
-
-        if (!firstTimerInfo) {
+        // Timers that get rescheduled into the past while firing are
+        // appended to the expired list again; avoid sending the same timer
+        // multiple times
+        QTimerInfo *currentTimerInfo = static_cast<QTimerInfo *>(expired.next);
+        if (!firstTimerInfo)
             firstTimerInfo = currentTimerInfo;
-        } else if (firstTimerInfo == currentTimerInfo) {
-            // avoid sending the same timer multiple times
+        else if (firstTimerInfo == currentTimerInfo)
             break;
-        } else if (currentTimerInfo->interval <  firstTimerInfo->interval
-                   || currentTimerInfo->interval == firstTimerInfo->interval) {
-            firstTimerInfo = currentTimerInfo;
-        }
 
         // remove from list
-        removeFirst();
+        unlink(currentTimerInfo);
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -620,7 +797,6 @@ int QTimerInfoList::activateTimers()
         }
     }
 
-    firstTimerInfo = nullptr;
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
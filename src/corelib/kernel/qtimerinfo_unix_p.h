@@ -20,19 +20,27 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
 
 #include <sys/time.h> // struct timeval
 
 QT_BEGIN_NAMESPACE
 
+// links a timer into one of the slots of the timer wheel
+struct QTimerWheelLink {
+    QTimerWheelLink *prev;
+    QTimerWheelLink *next;
+};
+
 // internal timer info
-struct QTimerInfo {
+struct QTimerInfo : QTimerWheelLink {
     int id;           // - timer identifier
     Qt::TimerType timerType; // - timer type
     qint64 interval;     // - timer interval in milliseconds
     timespec timeout;  // - when to actually fire
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
+    int slot;         // - wheel slot the timer is linked into, or -1
 
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
@@ -41,7 +49,16 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+/*
+    QTimerInfoList keeps the timers of one event dispatcher in a hierarchical
+    timing wheel with a resolution of one millisecond, so that registering
+    and unregistering a timer doesn't depend on the number of timers. Level 0
+    holds the timers due within the next SlotCount milliseconds, one slot per
+    millisecond; each further level covers SlotCount times the range of the
+    previous one, and its slots are redistributed to the lower levels when
+    the wheel reaches them.
+*/
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -53,11 +70,38 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
-    // state variables used by activateTimers()
-    QTimerInfo *firstTimerInfo;
+public:
+    enum {
+        SlotBits = 6,
+        SlotCount = 1 << SlotBits,
+        SlotMask = SlotCount - 1,
+        LevelCount = 6              // 36 bits of milliseconds, about two years
+    };
+
+private:
+    // the millisecond tick the wheel is at; earlier slots have been processed
+    qint64 wheelTick = 0;
+    // bit n of occupied[level] is set if wheel[level][n] is non-empty
+    quint64 occupied[LevelCount];
+    QTimerWheelLink wheel[LevelCount][SlotCount];
+    // timers that have expired and are waiting to be activated
+    QTimerWheelLink expired;
+
+    // the timer activateTimers() stops at when it comes around again
+    QTimerInfo *firstTimerInfo = nullptr;
+
+    QHash<int, QTimerInfo *> timersById;
+    QMultiHash<QObject *, QTimerInfo *> timersByObject;
+
+    void link(QTimerInfo *t, int slot);
+    void unlink(QTimerInfo *t);
+    void cascade(int level);
+    void advanceTo(const timespec &now);
+    void removeTimer(QTimerInfo *t);
 
 public:
     QTimerInfoList();
+    Q_DISABLE_COPY(QTimerInfoList)
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -76,6 +120,14 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    bool isEmpty() const { return timersById.isEmpty(); }
+    qsizetype size() const { return timersById.size(); }
+
+    // iterates over all QTimerInfo, in no particular order
+    using const_iterator = QHash<int, QTimerInfo *>::const_iterator;
+    const_iterator begin() const { return timersById.cbegin(); }
+    const_iterator end() const { return timersById.cend(); }
 };
 
 QT_END_NAMESPACE
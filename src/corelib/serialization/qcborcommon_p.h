@@ -44,6 +44,39 @@ QT_WARNING_POP
 
 Q_DECLARE_TYPEINFO(CborValue, Q_PRIMITIVE_TYPE);
 
+class qfloat16;
+
+// Parses CBOR straight out of a memory buffer with the TinyCBOR parser that
+// QCborStreamReader uses, which is compiled only into qcborstreamreader.cpp.
+// Must not be copied, as the iterator refers to the parser.
+struct QCborBufferParser
+{
+    Q_DISABLE_COPY_MOVE(QCborBufferParser)
+    QCborBufferParser() = default;
+
+    CborError init(const char *begin, const char *end);
+    const char *nextByte() const { return reinterpret_cast<const char *>(it.source.ptr); }
+    bool isTag() const { return it.type == CborTagType; }
+
+    CborError advance();
+    CborError advanceFixed();
+    CborError skipTag();
+    CborError enterContainer(const char **firstElement) const;
+    CborError containerLength(size_t *len) const;
+    CborError beginStringIteration();
+    CborError nextStringChunk(const char **ptr, size_t *len);
+
+    CborError toInteger(qint64 *result) const;
+    CborError toUnsignedInteger(quint64 *result) const;
+    CborError toFloat16(qfloat16 *result) const;
+    CborError toFloat(float *result) const;
+    CborError toDouble(double *result) const;
+    CborError toTag(CborTag *result) const;
+
+    CborParser parser;
+    CborValue it;
+};
+
 QT_END_NAMESPACE
 
 #endif // QCBORCOMMON_P_H
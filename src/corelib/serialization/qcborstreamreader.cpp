@@ -21,11 +21,14 @@ static void qt_cbor_decoder_advance(void *token, size_t len);
 static void *qt_cbor_decoder_read(void *token, void *userptr, size_t offset, size_t len);
 static CborError qt_cbor_decoder_transfer_string(void *token, const void **userptr, size_t offset, size_t len);
 
-#define CBOR_PARSER_READER_CONTROL              1
-#define CBOR_PARSER_CAN_READ_BYTES_FUNCTION     qt_cbor_decoder_can_read
-#define CBOR_PARSER_ADVANCE_BYTES_FUNCTION      qt_cbor_decoder_advance
-#define CBOR_PARSER_TRANSFER_STRING_FUNCTION    qt_cbor_decoder_transfer_string
-#define CBOR_PARSER_READ_BYTES_FUNCTION         qt_cbor_decoder_read
+// The parser reads either through these functions, for QCborStreamReader, or
+// directly from memory, for QCborBufferParser.
+static const CborParserOperations qt_cbor_decoder_operations = {
+    qt_cbor_decoder_can_read,
+    qt_cbor_decoder_read,
+    qt_cbor_decoder_advance,
+    qt_cbor_decoder_transfer_string
+};
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_MSVC(4334) // '<<': result of 32-bit shift implicitly converted to 64 bits (was 64-bit shift intended?)
@@ -43,6 +46,87 @@ static CborError _cbor_value_dup_string(const CborValue *, void **, size_t *, Cb
     Q_UNREACHABLE_RETURN(CborErrorInternalError);
 }
 
+CborError QCborBufferParser::init(const char *begin, const char *end)
+{
+    return cbor_parser_init(reinterpret_cast<const uint8_t *>(begin), size_t(end - begin), 0,
+                            &parser, &it);
+}
+
+CborError QCborBufferParser::advance()
+{
+    return cbor_value_advance(&it);
+}
+
+CborError QCborBufferParser::advanceFixed()
+{
+    return cbor_value_advance_fixed(&it);
+}
+
+CborError QCborBufferParser::skipTag()
+{
+    return cbor_value_skip_tag(&it);
+}
+
+CborError QCborBufferParser::enterContainer(const char **firstElement) const
+{
+    CborValue inner;
+    CborError err = cbor_value_enter_container(&it, &inner);
+    *firstElement = reinterpret_cast<const char *>(cbor_value_get_next_byte(&inner));
+    return err;
+}
+
+CborError QCborBufferParser::containerLength(size_t *len) const
+{
+    return cbor_value_is_map(&it) ? cbor_value_get_map_length(&it, len)
+                                  : cbor_value_get_array_length(&it, len);
+}
+
+CborError QCborBufferParser::beginStringIteration()
+{
+    return cbor_value_begin_string_iteration(&it);
+}
+
+CborError QCborBufferParser::nextStringChunk(const char **ptr, size_t *len)
+{
+    return _cbor_value_get_string_chunk(&it, reinterpret_cast<const void **>(ptr), len, &it);
+}
+
+CborError QCborBufferParser::toInteger(qint64 *result) const
+{
+    int64_t value;
+    CborError err = cbor_value_get_int64(&it, &value);
+    *result = value;
+    return err;
+}
+
+CborError QCborBufferParser::toUnsignedInteger(quint64 *result) const
+{
+    uint64_t value;
+    CborError err = cbor_value_get_uint64(&it, &value);
+    *result = value;
+    return err;
+}
+
+CborError QCborBufferParser::toFloat16(qfloat16 *result) const
+{
+    return cbor_value_get_half_float(&it, result);
+}
+
+CborError QCborBufferParser::toFloat(float *result) const
+{
+    return cbor_value_get_float(&it, result);
+}
+
+CborError QCborBufferParser::toDouble(double *result) const
+{
+    return cbor_value_get_double(&it, result);
+}
+
+CborError QCborBufferParser::toTag(CborTag *result) const
+{
+    return cbor_value_get_tag(&it, result);
+}
+
 // confirm our constants match TinyCBOR's
 static_assert(int(QCborStreamReader::UnsignedInteger) == CborIntegerType);
 static_assert(int(QCborStreamReader::ByteString) == CborByteStringType);
@@ -565,7 +649,7 @@ public:
         }
 
         preread();
-        if (CborError err = cbor_parser_init_reader(nullptr, &parser, &currentElement, this))
+        if (CborError err = cbor_parser_init_reader(&qt_cbor_decoder_operations, &parser, &currentElement, this))
             handleError(err);
         else
             lastError = { QCborError::NoError };
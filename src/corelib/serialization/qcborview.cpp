@@ -0,0 +1,622 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qcborview.h"
+
+#define CBOR_NO_ENCODER_API
+#define CBOR_NO_PARSER_API
+#include <private/qcborcommon_p.h>
+
+#include <qcborvalue.h>
+#include <qfloat16.h>
+
+QT_BEGIN_NAMESPACE
+
+// the value returned for missing map keys and out-of-range array indices,
+// like QCborValue does
+static const char undefinedValue = char(0xf7);
+
+// Returns the position following the element starting at ptr, including the
+// element a tag applies to, or nullptr if the element is malformed.
+static const char *skipElement(const char *ptr, const char *end)
+{
+    QCborBufferParser p;
+    if (!ptr || ptr == end || p.init(ptr, end) != CborNoError || p.skipTag() != CborNoError
+            || p.advance() != CborNoError)
+        return nullptr;
+    return p.nextByte();
+}
+
+// Calls f for each chunk of the string starting at data; a string of known
+// length has exactly one chunk. Returns false if the string is malformed.
+template <typename Func> static bool forEachStringChunk(QByteArrayView data, Func f)
+{
+    QCborBufferParser p;
+    if (data.isEmpty() || p.init(data.begin(), data.end()) != CborNoError
+            || p.beginStringIteration() != CborNoError)
+        return false;
+    for (;;) {
+        const char *ptr;
+        size_t len;
+        CborError err = p.nextStringChunk(&ptr, &len);
+        if (err == CborErrorNoMoreStringChunks)
+            return true;
+        if (err != CborNoError)
+            return false;
+        f(QByteArrayView(ptr, qsizetype(len)));
+    }
+}
+
+/*!
+   \class QCborView
+   \inmodule QtCore
+   \ingroup cbor
+   \ingroup qtserialization
+   \reentrant
+   \since 6.6
+
+   \brief The QCborView class is a read-only, lazily decoded view of a CBOR
+   value stored in a memory buffer.
+
+   QCborValue::fromCbor() decodes the entire input and copies every element
+   into its own containers before any of it can be accessed. For large
+   inputs of which only a few elements are needed, such as a file mapped into
+   memory with QFile::map(), QCborView avoids that cost: it decodes nothing up
+   front and locates the requested elements directly in the buffer, only when
+   they are accessed. Strings and byte arrays of known length are returned as
+   QUtf8StringView and QByteArrayView objects that point into the buffer.
+
+   \code
+   QFile file(fileName);
+   if (!file.open(QIODevice::ReadOnly))
+       return;
+   const uchar *data = file.map(0, file.size());
+   const QCborView root = QCborView::fromCbor(QByteArrayView(data, file.size()));
+   const QUtf8StringView name = root["settings"_L1]["name"_L1].toStringView();
+   \endcode
+
+   QCborView does not own the data. The buffer must stay valid and unchanged
+   for as long as the view, any view obtained from it and any string view
+   returned by it are in use.
+
+   Accessing an array element by index or a map value by key scans the
+   container from its beginning, skipping over the preceding elements without
+   decoding them. To visit all elements, iterate with begin() and end()
+   instead. Map iterators return the value of each pair from value() and
+   operator*(), and the key from key().
+
+   Like QCborValue, value() and at() return a view of the \c undefined simple
+   type if the key or index is not present. A malformed element produces a
+   view for which isInvalid() returns true. QCborView does not validate the
+   data in advance: corruption in parts of the buffer that are never accessed
+   goes unnoticed, and text strings are not checked for UTF-8 validity.
+
+   \sa QCborValue, QCborStreamReader
+*/
+
+/*!
+   \typedef QCborView::Type
+
+   An alias for QCborStreamReader::Type, which describes the type of the
+   element the view refers to.
+*/
+
+/*!
+   \typedef QCborView::const_iterator
+
+   A synonym for QCborView::ConstIterator.
+*/
+
+/*!
+   \fn QCborView::QCborView()
+
+   Constructs an invalid view.
+
+   \sa fromCbor(), isInvalid()
+*/
+
+/*!
+   Returns a view of the first CBOR element in \a data. Only the header of
+   that element, and of the element it tags if it is a tag, is decoded. If it
+   is malformed, this function returns an invalid view and, if \a error is
+   not null, stores the error in it, along with the offset in \a data of the
+   header that failed to decode.
+
+   The view does not copy \a data, which must remain valid while the view is
+   in use.
+
+   \sa rawData(), toCborValue()
+*/
+QCborView QCborView::fromCbor(QByteArrayView data, QCborParserError *error)
+{
+    QCborBufferParser p;
+    CborError err = CborErrorUnexpectedEOF;
+    qsizetype offset = 0;
+    if (!data.isEmpty()) {
+        err = p.init(data.begin(), data.end());
+        if (!err && p.isTag())
+            err = p.skipTag();
+        if (err)
+            offset = p.nextByte() - data.begin();
+    }
+    if (error) {
+        error->offset = err ? offset : 0;
+        error->error = QCborError{ err ? QCborError::Code(int(err)) : QCborError::NoError };
+    }
+    return err ? QCborView() : QCborView(data);
+}
+
+/*!
+   \fn QCborView::Type QCborView::type() const
+
+   Returns the type of the element this view refers to, or
+   QCborStreamReader::Invalid if the view is invalid.
+*/
+
+/*!
+   Returns true if the element is a string, byte array, array or map whose
+   length is encoded in its header, false if it has indefinite length or is
+   of any other type. Strings of indefinite length are stored in chunks and
+   cannot be returned by toStringView() or toByteArrayView().
+*/
+bool QCborView::isLengthKnown() const noexcept
+{
+    switch (type()) {
+    case QCborStreamReader::ByteArray:
+    case QCborStreamReader::String:
+    case QCborStreamReader::Array:
+    case QCborStreamReader::Map:
+        return (uchar(m_data.front()) & 0x1f) != 0x1f;
+    default:
+        return false;
+    }
+}
+
+/*!
+   Returns the value of this integer element, or \a defaultValue if the
+   element is not an integer. Unsigned integers larger than
+   \c{std::numeric_limits<qint64>::max()} wrap around, like in
+   QCborStreamReader::toInteger().
+*/
+qint64 QCborView::toInteger(qint64 defaultValue) const
+{
+    QCborBufferParser p;
+    qint64 result;
+    if (!isInteger() || p.init(m_data.begin(), m_data.end()) != CborNoError
+            || p.toInteger(&result) != CborNoError)
+        return defaultValue;
+    return result;
+}
+
+/*!
+   Returns the value of this floating point element, converting half and
+   single precision numbers and integers to \c double. Returns
+   \a defaultValue if the element is not a number.
+*/
+double QCborView::toDouble(double defaultValue) const
+{
+    QCborBufferParser p;
+    if (!isValid() || p.init(m_data.begin(), m_data.end()) != CborNoError)
+        return defaultValue;
+
+    switch (type()) {
+    case QCborStreamReader::UnsignedInteger: {
+        quint64 u;
+        if (p.toUnsignedInteger(&u) == CborNoError)
+            return double(u);
+        break;
+    }
+    case QCborStreamReader::NegativeInteger:
+        return double(toInteger(0));
+    case QCborStreamReader::Float16: {
+        qfloat16 f;
+        if (p.toFloat16(&f) == CborNoError)
+            return double(f);
+        break;
+    }
+    case QCborStreamReader::Float: {
+        float f;
+        if (p.toFloat(&f) == CborNoError)
+            return double(f);
+        break;
+    }
+    case QCborStreamReader::Double: {
+        double d;
+        if (p.toDouble(&d) == CborNoError)
+            return d;
+        break;
+    }
+    default:
+        break;
+    }
+    return defaultValue;
+}
+
+/*!
+   \fn bool QCborView::toBool(bool defaultValue) const
+
+   Returns true for the \c true simple type, false for \c false and
+   \a defaultValue for anything else.
+*/
+
+/*!
+   Returns the simple type of this element, or \a defaultValue if it is not
+   a simple type. \c false, \c true, \c null and \c undefined are simple
+   types.
+*/
+QCborSimpleType QCborView::toSimpleType(QCborSimpleType defaultValue) const noexcept
+{
+    // TinyCBOR has dedicated types for false, true, null and undefined, so
+    // decode the header directly
+    if (!isSimpleType())
+        return defaultValue;
+    const uchar additional = uchar(m_data.front()) & 0x1f;
+    if (additional < 24)
+        return QCborSimpleType(additional);
+    if (m_data.size() < 2)
+        return defaultValue;
+    return QCborSimpleType(uchar(m_data.at(1)));
+}
+
+/*!
+   Returns the tag number of this tag element, or \a defaultValue if it is
+   not a tag.
+
+   \sa taggedValue()
+*/
+QCborTag QCborView::tag(QCborTag defaultValue) const
+{
+    QCborBufferParser p;
+    CborTag t;
+    if (!isTag() || p.init(m_data.begin(), m_data.end()) != CborNoError
+            || p.toTag(&t) != CborNoError)
+        return defaultValue;
+    return QCborTag(t);
+}
+
+/*!
+   Returns a view of the element this tag applies to, or an invalid view if
+   this element is not a tag.
+
+   \sa tag()
+*/
+QCborView QCborView::taggedValue() const
+{
+    QCborBufferParser p;
+    if (!isTag() || p.init(m_data.begin(), m_data.end()) != CborNoError
+            || p.advanceFixed() != CborNoError)
+        return QCborView();
+    return QCborView(QByteArrayView(p.nextByte(), m_data.end()));
+}
+
+/*!
+   Returns a view of the contents of this byte array element, pointing into
+   the underlying buffer. Returns an empty view if the element is not a byte
+   array or if its length is not known.
+
+   \sa toByteArray(), isLengthKnown()
+*/
+QByteArrayView QCborView::toByteArrayView() const
+{
+    QByteArrayView result;
+    if (isByteArray() && isLengthKnown())
+        forEachStringChunk(m_data, [&](QByteArrayView chunk) { result = chunk; });
+    return result;
+}
+
+/*!
+   Returns a view of the contents of this text string element, pointing into
+   the underlying buffer. Returns an empty view if the element is not a text
+   string or if its length is not known. The contents are not validated.
+
+   \sa toString(), isLengthKnown()
+*/
+QUtf8StringView QCborView::toStringView() const
+{
+    QByteArrayView result;
+    if (isString() && isLengthKnown())
+        forEachStringChunk(m_data, [&](QByteArrayView chunk) { result = chunk; });
+    return QUtf8StringView(result.data(), result.size());
+}
+
+/*!
+   Returns a copy of the contents of this byte array element, including
+   those stored in chunks, or \a defaultValue if the element is not a byte
+   array or is malformed.
+
+   \sa toByteArrayView()
+*/
+QByteArray QCborView::toByteArray(const QByteArray &defaultValue) const
+{
+    QByteArray result("");
+    if (!isByteArray()
+            || !forEachStringChunk(m_data, [&](QByteArrayView chunk) { result += chunk; }))
+        return defaultValue;
+    return result;
+}
+
+/*!
+   Returns the contents of this text string element decoded from UTF-8,
+   including those stored in chunks, or \a defaultValue if the element is not
+   a text string or is malformed.
+
+   \sa toStringView()
+*/
+QString QCborView::toString(const QString &defaultValue) const
+{
+    QUtf8StringView contents;
+    QByteArray chunked;
+    const auto append = [&](QByteArrayView chunk) {
+        if (contents.isNull()) {
+            contents = QUtf8StringView(chunk);
+        } else {
+            if (chunked.isNull())
+                chunked = QByteArrayView(contents).toByteArray();
+            chunked += chunk;
+            contents = QUtf8StringView(chunked);
+        }
+    };
+    if (!isString() || !forEachStringChunk(m_data, append))
+        return defaultValue;
+
+    QString result = contents.toString();
+    if (result.isNull())
+        result = QLatin1StringView("");
+    return result;
+}
+
+/*!
+   Returns the number of elements in this array, or the number of key/value
+   pairs in this map. If the length is not known, the elements are counted.
+   Returns -1 if the element is not a container or is malformed.
+*/
+qsizetype QCborView::size() const
+{
+    if (!isContainer())
+        return -1;
+
+    QCborBufferParser p;
+    if (p.init(m_data.begin(), m_data.end()) != CborNoError)
+        return -1;
+    if (isLengthKnown()) {
+        size_t len;
+        return p.containerLength(&len) ? -1 : qsizetype(len);
+    }
+
+    qsizetype count = 0;
+    for (ConstIterator it = begin(); it != end(); ++it)
+        ++count;
+    return count;
+}
+
+/*!
+   Returns a view of the element at index \a i of this array. Returns a view
+   of the \c undefined simple type if the index is out of range and an
+   invalid view if this element is not an array.
+
+   \sa value(), begin()
+*/
+QCborView QCborView::at(qsizetype i) const
+{
+    if (!isArray())
+        return QCborView();
+    if (i < 0)
+        return QCborView(QByteArrayView(&undefinedValue, 1));
+
+    ConstIterator it = begin();
+    for ( ; i && it != end(); --i)
+        ++it;
+    return it == end() ? QCborView(QByteArrayView(&undefinedValue, 1)) : it.value();
+}
+
+template <typename KeyMatcher> QCborView QCborView::findValue(KeyMatcher matches) const
+{
+    if (!isMap())
+        return QCborView();
+    for (ConstIterator it = begin(); it != end(); ++it) {
+        if (matches(it.key()))
+            return it.value();
+    }
+    return QCborView(QByteArrayView(&undefinedValue, 1));
+}
+
+static bool stringKeyEquals(const QCborView &key, QAnyStringView str)
+{
+    if (!key.isString())
+        return false;
+    if (key.isLengthKnown())
+        return QAnyStringView::equal(key.toStringView(), str);
+    return QAnyStringView::equal(key.toString(), str);
+}
+
+/*!
+   Returns a view of the value associated with the integer \a key in this
+   map. Returns a view of the \c undefined simple type if the key is not
+   present and an invalid view if this element is not a map.
+
+   String keys are compared without being copied out of the buffer.
+
+   \sa at(), begin()
+*/
+QCborView QCborView::value(qint64 key) const
+{
+    return findValue([key](const QCborView &k) { return k.isInteger() && k.toInteger() == key; });
+}
+
+/*!
+   \overload
+*/
+QCborView QCborView::value(QLatin1StringView key) const
+{
+    return findValue([key](const QCborView &k) { return stringKeyEquals(k, key); });
+}
+
+/*!
+   \overload
+*/
+QCborView QCborView::value(QStringView key) const
+{
+    return findValue([key](const QCborView &k) { return stringKeyEquals(k, key); });
+}
+
+/*!
+   \overload
+*/
+QCborView QCborView::value(QUtf8StringView key) const
+{
+    return findValue([key](const QCborView &k) { return stringKeyEquals(k, key); });
+}
+
+/*!
+   Returns an iterator to the first element of this array or the first pair
+   of this map. Returns an iterator equal to end() if this element is not a
+   container.
+*/
+QCborView::ConstIterator QCborView::begin() const
+{
+    ConstIterator result;
+    QCborBufferParser p;
+    const char *first;
+    if (!isContainer() || p.init(m_data.begin(), m_data.end()) != CborNoError
+            || p.enterContainer(&first) != CborNoError)
+        return result;
+
+    result.ptr = first;
+    result.end = m_data.end();
+    result.isMap = isMap();
+    result.remaining = -1;
+    if (isLengthKnown()) {
+        size_t len = 0;
+        p.containerLength(&len);
+        result.remaining = qint64(len);
+    }
+    result.findValue();
+    return result;
+}
+
+/*!
+   \fn QCborView::ConstIterator QCborView::end() const
+
+   Returns an iterator past the last element of this array or map.
+*/
+
+/*!
+   \fn QCborView::ConstIterator QCborView::constBegin() const
+
+   Same as begin().
+*/
+
+/*!
+   \fn QCborView::ConstIterator QCborView::constEnd() const
+
+   Same as end().
+*/
+
+/*!
+   Returns the encoded bytes of this element, including all of its contents.
+   This requires scanning the element. Returns an empty view if the element
+   is malformed.
+*/
+QByteArrayView QCborView::rawData() const
+{
+    const char *next = skipElement(m_data.begin(), m_data.end());
+    return next ? QByteArrayView(m_data.begin(), next) : QByteArrayView();
+}
+
+/*!
+   Decodes this element in its entirety into a QCborValue, copying all of
+   its contents.
+
+   \sa QCborValue::fromCbor()
+*/
+QCborValue QCborView::toCborValue() const
+{
+    const QByteArrayView raw = rawData();
+    if (raw.isEmpty())
+        return QCborValue(QCborValue::Invalid);
+    return QCborValue::fromCbor(QByteArray::fromRawData(raw.data(), raw.size()));
+}
+
+/*!
+   \class QCborView::ConstIterator
+   \inmodule QtCore
+   \since 6.6
+
+   \brief The QCborView::ConstIterator class iterates over the elements of a
+   CBOR array or over the key/value pairs of a CBOR map in a QCborView.
+
+   Advancing the iterator skips over the current element without decoding
+   it.
+*/
+
+/*!
+   \fn QCborView::ConstIterator::ConstIterator()
+
+   Constructs an iterator that compares equal to QCborView::end().
+*/
+
+/*!
+   \fn QCborView QCborView::ConstIterator::operator*() const
+
+   Same as value().
+*/
+
+/*!
+   \fn QCborView::ConstIterator QCborView::ConstIterator::operator++(int)
+
+   Advances the iterator to the next element and returns an iterator to the
+   previous one.
+*/
+
+/*!
+   Returns the key of the current pair if iterating over a map, or an
+   invalid view if iterating over an array.
+*/
+QCborView QCborView::ConstIterator::key() const
+{
+    if (!isMap || atEnd())
+        return QCborView();
+    return QCborView(QByteArrayView(ptr, end));
+}
+
+/*!
+   Returns the current element if iterating over an array, or the value of
+   the current pair if iterating over a map.
+*/
+QCborView QCborView::ConstIterator::value() const
+{
+    if (atEnd())
+        return QCborView();
+    return QCborView(QByteArrayView(isMap ? valuePtr : ptr, end));
+}
+
+/*!
+   Advances the iterator to the next element and returns it. If the data is
+   malformed, the iterator becomes equal to QCborView::end().
+*/
+QCborView::ConstIterator &QCborView::ConstIterator::operator++()
+{
+    ptr = skipElement(isMap ? valuePtr : ptr, end);
+    if (remaining > 0)
+        --remaining;
+    findValue();
+    return *this;
+}
+
+bool QCborView::ConstIterator::atEnd() const noexcept
+{
+    if (!ptr || remaining == 0)
+        return true;
+    return remaining < 0 && (ptr == end || uchar(*ptr) == 0xff);
+}
+
+void QCborView::ConstIterator::findValue()
+{
+    if (!isMap || atEnd())
+        return;
+    valuePtr = skipElement(ptr, end);
+    if (!valuePtr || valuePtr == end || uchar(*valuePtr) == 0xff)
+        ptr = nullptr;      // key without a value
+}
+
+QT_END_NAMESPACE
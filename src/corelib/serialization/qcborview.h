@@ -0,0 +1,161 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QCBORVIEW_H
+#define QCBORVIEW_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qcborcommon.h>
+#include <QtCore/qcborstreamreader.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qutf8stringview.h>
+
+QT_REQUIRE_CONFIG(cborstreamreader);
+
+/* X11 headers use these values too, but as defines */
+#if defined(False) && defined(True)
+#  undef True
+#  undef False
+#endif
+
+QT_BEGIN_NAMESPACE
+
+class QCborValue;
+struct QCborParserError;
+
+class Q_CORE_EXPORT QCborView
+{
+public:
+    using Type = QCborStreamReader::Type;
+
+    class Q_CORE_EXPORT ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = qsizetype;
+        using value_type = QCborView;
+        using pointer = const QCborView *;
+        using reference = QCborView;
+
+        constexpr ConstIterator() noexcept = default;
+
+        QCborView key() const;
+        QCborView value() const;
+        QCborView operator*() const         { return value(); }
+
+        ConstIterator &operator++();
+        ConstIterator operator++(int)       { ConstIterator copy = *this; ++*this; return copy; }
+
+        friend bool operator==(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        {
+            const bool lhsAtEnd = lhs.atEnd();
+            const bool rhsAtEnd = rhs.atEnd();
+            return lhsAtEnd || rhsAtEnd ? lhsAtEnd == rhsAtEnd : lhs.ptr == rhs.ptr;
+        }
+        friend bool operator!=(const ConstIterator &lhs, const ConstIterator &rhs) noexcept
+        { return !(lhs == rhs); }
+
+    private:
+        friend class QCborView;
+        bool atEnd() const noexcept;
+        void findValue();
+
+        const char *ptr = nullptr;          // current element (the key, for maps)
+        const char *valuePtr = nullptr;     // maps only: the value of the current pair
+        const char *end = nullptr;
+        qint64 remaining = 0;               // -1 if the container has indefinite length
+        bool isMap = false;
+    };
+    using const_iterator = ConstIterator;
+
+    constexpr QCborView() noexcept = default;
+    static QCborView fromCbor(QByteArrayView data, QCborParserError *error = nullptr);
+
+    Type type() const noexcept
+    { return m_data.isEmpty() ? QCborStreamReader::Invalid : typeFromByte(uchar(m_data.front())); }
+    bool isValid() const noexcept           { return !isInvalid(); }
+    bool isInvalid() const noexcept         { return type() == QCborStreamReader::Invalid; }
+    bool isUnsignedInteger() const noexcept { return type() == QCborStreamReader::UnsignedInteger; }
+    bool isNegativeInteger() const noexcept { return type() == QCborStreamReader::NegativeInteger; }
+    bool isInteger() const noexcept         { return isUnsignedInteger() || isNegativeInteger(); }
+    bool isByteArray() const noexcept       { return type() == QCborStreamReader::ByteArray; }
+    bool isString() const noexcept          { return type() == QCborStreamReader::String; }
+    bool isArray() const noexcept           { return type() == QCborStreamReader::Array; }
+    bool isMap() const noexcept             { return type() == QCborStreamReader::Map; }
+    bool isContainer() const noexcept       { return isArray() || isMap(); }
+    bool isTag() const noexcept             { return type() == QCborStreamReader::Tag; }
+    bool isSimpleType() const noexcept      { return type() == QCborStreamReader::SimpleType; }
+    bool isFloat16() const noexcept         { return type() == QCborStreamReader::Float16; }
+    bool isFloat() const noexcept           { return type() == QCborStreamReader::Float; }
+    bool isDouble() const noexcept          { return type() == QCborStreamReader::Double; }
+    bool isSimpleType(QCborSimpleType st) const noexcept
+    { return isSimpleType() && toSimpleType() == st; }
+    bool isFalse() const noexcept           { return isSimpleType(QCborSimpleType::False); }
+    bool isTrue() const noexcept            { return isSimpleType(QCborSimpleType::True); }
+    bool isBool() const noexcept            { return isFalse() || isTrue(); }
+    bool isNull() const noexcept            { return isSimpleType(QCborSimpleType::Null); }
+    bool isUndefined() const noexcept       { return isSimpleType(QCborSimpleType::Undefined); }
+
+    bool isLengthKnown() const noexcept;
+
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    double toDouble(double defaultValue = 0) const;
+    bool toBool(bool defaultValue = false) const noexcept
+    { return isBool() ? isTrue() : defaultValue; }
+    QCborSimpleType toSimpleType(QCborSimpleType defaultValue = QCborSimpleType::Undefined) const noexcept;
+    QCborTag tag(QCborTag defaultValue = QCborTag(-1)) const;
+    QCborView taggedValue() const;
+
+    QByteArrayView toByteArrayView() const;
+    QUtf8StringView toStringView() const;
+    QByteArray toByteArray(const QByteArray &defaultValue = {}) const;
+    QString toString(const QString &defaultValue = {}) const;
+
+    qsizetype size() const;
+    QCborView at(qsizetype i) const;
+    QCborView value(qint64 key) const;
+    QCborView value(QLatin1StringView key) const;
+    QCborView value(QStringView key) const;
+    QCborView value(QUtf8StringView key) const;
+    QCborView operator[](qsizetype i) const         { return isMap() ? value(qint64(i)) : at(i); }
+    QCborView operator[](QLatin1StringView key) const { return value(key); }
+    QCborView operator[](QStringView key) const     { return value(key); }
+    QCborView operator[](QUtf8StringView key) const { return value(key); }
+
+    ConstIterator begin() const;
+    ConstIterator end() const                       { return ConstIterator(); }
+    ConstIterator constBegin() const                { return begin(); }
+    ConstIterator constEnd() const                  { return end(); }
+
+    QByteArrayView rawData() const;
+    QCborValue toCborValue() const;
+
+private:
+    explicit QCborView(QByteArrayView data) noexcept : m_data(data) {}
+    static constexpr Type typeFromByte(uchar initialByte) noexcept
+    {
+        const uchar majorType = initialByte & 0xe0;
+        if (majorType != QCborStreamReader::SimpleType)
+            return Type(majorType);
+        const uchar additional = initialByte & 0x1f;
+        if (additional <= 24)
+            return QCborStreamReader::SimpleType;
+        if (additional <= 27)
+            return Type(initialByte);
+        return QCborStreamReader::Invalid;
+    }
+    template <typename KeyMatcher> QCborView findValue(KeyMatcher matches) const;
+
+    // starts with this element and extends to the end of the enclosing data
+    QByteArrayView m_data;
+};
+
+QT_END_NAMESPACE
+
+#if defined(QT_X11_DEFINES_FOUND)
+#  define True  1
+#  define False 0
+#endif
+
+#endif // QCBORVIEW_H
@@ -11,6 +11,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 #include <private/qtools_p.h>
 
 //#define PARSER_DEBUG
@@ -47,6 +48,7 @@ using namespace QtMiscUtils;
 #define JSONERR_DEEP_NEST   QT_TRANSLATE_NOOP("QJsonParseError", "too deeply nested document")
 #define JSONERR_DOC_LARGE   QT_TRANSLATE_NOOP("QJsonParseError", "too large document")
 #define JSONERR_GARBAGEEND  QT_TRANSLATE_NOOP("QJsonParseError", "garbage at the end of the document")
+#define JSONERR_PREMATURE   QT_TRANSLATE_NOOP("QJsonParseError", "premature end of document")
 
 /*!
     \class QJsonParseError
@@ -82,6 +84,9 @@ using namespace QtMiscUtils;
     \value DeepNesting              The JSON document is too deeply nested for the parser to parse it
     \value DocumentTooLarge         The JSON document is too large for the parser to parse it
     \value GarbageAtEnd             The parsed document contains additional garbage characters at the end
+    \value PrematureEndOfDocument   The data ended before the current value was complete. This
+                                    error is only reported by QJsonStreamReader and is recoverable
+                                    by supplying more data. (since 6.6)
 
 */
 
@@ -157,6 +162,9 @@ QString QJsonParseError::errorString() const
     case GarbageAtEnd:
         sz = JSONERR_GARBAGEEND;
         break;
+    case PrematureEndOfDocument:
+        sz = JSONERR_PREMATURE;
+        break;
     }
 #ifndef QT_BOOTSTRAPPED
     return QCoreApplication::translate("QJsonParseError", sz);
@@ -237,9 +245,131 @@ enum {
     EndObject = 0x7d,
     NameSeparator = 0x3a,
     ValueSeparator = 0x2c,
-    Quote = 0x22
+    Quote = 0x22,
+    Backslash = 0x5c
 };
 
+/*
+    Helpers for skipping over runs of bytes that the parser does not need to
+    look at one by one: insignificant whitespace between tokens, and the
+    US-ASCII characters of a string that are neither a quote nor a backslash.
+    Each returns a pointer to the first byte in [ptr, end) that does not
+    belong to such a run, or end.
+
+    The vector versions only process whole blocks and leave the remainder to
+    the scalar loop.
+*/
+static inline bool isJsonSpace(uchar c)
+{
+    return c == Space || c == Tab || c == LineFeed || c == Return;
+}
+
+static inline bool isPlainStringChar(uchar c)
+{
+    return c != Quote && c != Backslash && c < 0x80;
+}
+
+#ifdef __SSE2__
+static const char *skipSpace_sse2(const char *ptr, const char *end)
+{
+    const __m128i space = _mm_set1_epi8(Space);
+    const __m128i tab = _mm_set1_epi8(Tab);
+    const __m128i lineFeed = _mm_set1_epi8(LineFeed);
+    const __m128i cr = _mm_set1_epi8(Return);
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space),
+                                                     _mm_cmpeq_epi8(data, tab)),
+                                        _mm_or_si128(_mm_cmpeq_epi8(data, lineFeed),
+                                                     _mm_cmpeq_epi8(data, cr)));
+        const uint mask = ~uint(_mm_movemask_epi8(ws)) & 0xffffu;
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+    return ptr;
+}
+
+static const char *skipPlainString_sse2(const char *ptr, const char *end)
+{
+    const __m128i quote = _mm_set1_epi8(Quote);
+    const __m128i backslash = _mm_set1_epi8(Backslash);
+    for ( ; end - ptr >= 16; ptr += 16) {
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                             _mm_cmpeq_epi8(data, backslash));
+        // the sign bit flags the bytes that aren't US-ASCII
+        const uint mask = uint(_mm_movemask_epi8(_mm_or_si128(special, data)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+    return ptr;
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+static const char * QT_FUNCTION_TARGET(AVX2) skipSpace_avx2(const char *ptr, const char *end)
+{
+    const __m256i space = _mm256_set1_epi8(Space);
+    const __m256i tab = _mm256_set1_epi8(Tab);
+    const __m256i lineFeed = _mm256_set1_epi8(LineFeed);
+    const __m256i cr = _mm256_set1_epi8(Return);
+    for ( ; end - ptr >= 32; ptr += 32) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        const __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, space),
+                                                           _mm256_cmpeq_epi8(data, tab)),
+                                           _mm256_or_si256(_mm256_cmpeq_epi8(data, lineFeed),
+                                                           _mm256_cmpeq_epi8(data, cr)));
+        const uint mask = ~uint(_mm256_movemask_epi8(ws));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+    return ptr;
+}
+
+static const char * QT_FUNCTION_TARGET(AVX2) skipPlainString_avx2(const char *ptr, const char *end)
+{
+    const __m256i quote = _mm256_set1_epi8(Quote);
+    const __m256i backslash = _mm256_set1_epi8(Backslash);
+    for ( ; end - ptr >= 32; ptr += 32) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote),
+                                                _mm256_cmpeq_epi8(data, backslash));
+        const uint mask = uint(_mm256_movemask_epi8(_mm256_or_si256(special, data)));
+        if (mask)
+            return ptr + qCountTrailingZeroBits(mask);
+    }
+    return ptr;
+}
+#endif
+
+static const char *skipSpace(const char *ptr, const char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        ptr = skipSpace_avx2(ptr, end);
+#endif
+#ifdef __SSE2__
+    ptr = skipSpace_sse2(ptr, end);
+#endif
+    while (ptr < end && isJsonSpace(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+static const char *skipPlainString(const char *ptr, const char *end)
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        ptr = skipPlainString_avx2(ptr, end);
+#endif
+#ifdef __SSE2__
+    ptr = skipPlainString_sse2(ptr, end);
+#endif
+    while (ptr < end && isPlainStringChar(*ptr))
+        ++ptr;
+    return ptr;
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -253,16 +383,10 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    // most tokens are not preceded by whitespace at all
+    if (json < end && uchar(*json) > Space)
+        return true;
+    json = skipSpace(json, end);
     return (json < end);
 }
 
@@ -859,6 +983,10 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        json = skipPlainString(json, end);
+        if (json >= end)
+            break;
+
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -901,6 +1029,13 @@ bool Parser::parseString()
 
     QString ucs4;
     while (json < end) {
+        const char *plain = json;
+        json = skipPlainString(json, end);
+        if (json != plain)
+            ucs4.append(QLatin1StringView(plain, json - plain));
+        if (json >= end)
+            break;
+
         char32_t ch = 0;
         if (*json == '"')
             break;
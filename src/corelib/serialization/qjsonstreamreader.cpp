@@ -0,0 +1,937 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamreader.h"
+
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+#include <private/qtools_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QtMiscUtils;
+using namespace Qt::StringLiterals;
+
+// how much we read from the device at a time, and the maximum size of the
+// chunks returned by readString()
+static constexpr qsizetype ReadChunkSize = 64 * 1024;
+
+static inline bool isJsonSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool isNumberChar(char c)
+{
+    return isAsciiDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static inline bool addHexDigit(char digit, char32_t *result)
+{
+    *result <<= 4;
+    if (digit >= '0' && digit <= '9')
+        *result |= (digit - '0');
+    else if (digit >= 'a' && digit <= 'f')
+        *result |= (digit - 'a') + 10;
+    else if (digit >= 'A' && digit <= 'F')
+        *result |= (digit - 'A') + 10;
+    else
+        return false;
+    return true;
+}
+
+// Returns the start of a UTF-8 multibyte sequence at the end of [begin, end)
+// that is missing some of its continuation bytes, or end if there is none.
+static const char *incompleteUtf8Tail(const char *begin, const char *end)
+{
+    const char *p = end;
+    int continuations = 0;
+    while (p != begin && continuations < 3 && (uchar(p[-1]) & 0xc0) == 0x80) {
+        --p;
+        ++continuations;
+    }
+    if (p == begin)
+        return end;
+
+    const uchar lead = uchar(p[-1]);
+    const int needed = lead >= 0xf0 ? 3 : lead >= 0xe0 ? 2 : lead >= 0xc0 ? 1 : 0;
+    return needed > continuations ? p - 1 : end;
+}
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum Phase : quint8 {
+        ExpectFirst,    // just entered, nothing read yet
+        ExpectValue,    // objects only: read a key, the value follows
+        AfterValue      // read a complete element (arrays) or key/value pair (objects)
+    };
+    struct Container {
+        QJsonStreamReader::Type type;
+        Phase phase;
+    };
+
+    QJsonStreamReaderPrivate(QIODevice *device) : device(device) {}
+    QJsonStreamReaderPrivate(const QByteArray &data) : buffer(data) {}
+
+    bool fetchMore();
+    bool ensure(qsizetype n);
+    bool inputFinished() const
+    {
+        return !device || (!device->isSequential() && device->atEnd());
+    }
+    void discardConsumed();
+    void elementConsumed();
+    bool skip();
+    void reset();
+
+    void setError(QJsonParseError::ParseError error, qsizetype at)
+    {
+        lastError = error;
+        errorOffset = bufferOffset + pos + at;
+    }
+    void clearRecoverableError()
+    {
+        if (lastError == QJsonParseError::PrematureEndOfDocument)
+            lastError = QJsonParseError::NoError;
+    }
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;          // current position in buffer
+    qint64 bufferOffset = 0;    // stream offset of buffer[0]
+    qsizetype endOffset = 0;    // distance from pos to the bracket ending the current container
+    bool containerEnd = false;  // whether that bracket was found
+
+    QVarLengthArray<Container, 16> containers;
+
+    QJsonParseError::ParseError lastError = QJsonParseError::NoError;
+    qint64 errorOffset = 0;
+
+    // state of next() while skipping over strings and containers, kept so
+    // that it can resume once more data is available
+    bool skipping = false;
+    bool skipInString = false;
+    bool skipEscape = false;
+    int skipDepth = 0;
+
+    // the high surrogate that ended the text readString() decoded so far,
+    // held back so that the low surrogate comes out in the same chunk
+    char16_t pendingHighSurrogate = 0;
+};
+
+bool QJsonStreamReaderPrivate::fetchMore()
+{
+    if (!device)
+        return false;
+
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + ReadChunkSize);
+    const qint64 n = device->read(buffer.data() + oldSize, ReadChunkSize);
+    buffer.resize(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+// Makes sure there are at least n bytes past pos in the buffer, reading from
+// the device if necessary. Never moves data already in the buffer.
+bool QJsonStreamReaderPrivate::ensure(qsizetype n)
+{
+    while (buffer.size() - pos < n) {
+        if (!fetchMore())
+            return false;
+    }
+    return true;
+}
+
+void QJsonStreamReaderPrivate::discardConsumed()
+{
+    // only data we read from a device is dropped, and only once enough of it
+    // accumulated to be worth the move
+    if (!device || pos < qMin(buffer.size(), ReadChunkSize))
+        return;
+    buffer.remove(0, pos);
+    bufferOffset += pos;
+    pos = 0;
+}
+
+void QJsonStreamReaderPrivate::elementConsumed()
+{
+    if (containers.isEmpty())
+        return;
+    Container &c = containers.last();
+    if (c.type == QJsonStreamReader::Object && c.phase != ExpectValue)
+        c.phase = ExpectValue;
+    else
+        c.phase = AfterValue;
+}
+
+// Advances pos past the end of the string or container being skipped. The
+// brackets are only counted, not matched against each other.
+bool QJsonStreamReaderPrivate::skip()
+{
+    for (;;) {
+        const char *const begin = buffer.constData();
+        const char *const end = begin + buffer.size();
+        const char *p = begin + pos;
+        while (p != end) {
+            const char c = *p++;
+            if (skipInString) {
+                if (skipEscape) {
+                    skipEscape = false;
+                } else if (c == '\\') {
+                    skipEscape = true;
+                } else if (c == '"') {
+                    skipInString = false;
+                    if (skipDepth == 0) {
+                        pos = p - begin;
+                        return true;
+                    }
+                }
+            } else if (c == '"') {
+                skipInString = true;
+            } else if (c == '[' || c == '{') {
+                ++skipDepth;
+            } else if (c == ']' || c == '}') {
+                if (--skipDepth == 0) {
+                    pos = p - begin;
+                    return true;
+                }
+            }
+        }
+
+        pos = buffer.size();
+        discardConsumed();
+        if (!fetchMore())
+            return false;
+    }
+}
+
+void QJsonStreamReaderPrivate::reset()
+{
+    buffer.clear();
+    pos = 0;
+    bufferOffset = 0;
+    endOffset = 0;
+    containerEnd = false;
+    containers.clear();
+    lastError = QJsonParseError::NoError;
+    errorOffset = 0;
+    skipping = false;
+    skipInString = false;
+    skipEscape = false;
+    skipDepth = 0;
+    pendingHighSurrogate = 0;
+}
+
+/*!
+   \class QJsonStreamReader
+   \inmodule QtCore
+   \ingroup json
+   \ingroup qtserialization
+   \reentrant
+   \since 6.6
+
+   \brief The QJsonStreamReader class is a pull parser for JSON, operating
+   on either a QByteArray or a QIODevice.
+
+   QJsonStreamReader decodes JSON text one element at a time, without ever
+   building a document tree. It is suited for data that is too large to be
+   kept in memory as a QJsonDocument, for data that arrives incrementally,
+   such as from a network connection, and for streams of concatenated JSON
+   values, like newline-delimited JSON (NDJSON). At the top level, the reader
+   accepts any sequence of JSON values separated by whitespace.
+
+   The API mirrors QCborStreamReader: type() and the \c{is} functions report
+   the current element, the \c{to} functions return scalar values,
+   readString() returns string contents in chunks and next() advances to the
+   following element. Arrays and objects are entered with enterContainer()
+   and left with leaveContainer(). Inside an object, each member is reported
+   as a string element for the key followed by the element for the value.
+
+   For example, the following reads the \c name member of every object in
+   an NDJSON stream:
+
+   \code
+   QJsonStreamReader reader(device);
+   while (reader.hasNext()) {
+       if (!reader.isObject()) {
+           reader.next();
+           continue;
+       }
+       reader.enterContainer();
+       while (reader.hasNext()) {
+           const QString key = reader.readAllString();
+           if (key == "name"_L1 && reader.isString())
+               names << reader.readAllString();
+           else
+               reader.next();
+       }
+       reader.leaveContainer();
+   }
+   if (reader.lastError().error != QJsonParseError::NoError)
+       qWarning() << reader.lastError().errorString();
+   \endcode
+
+   When the data is incomplete, the reader reports the
+   QJsonParseError::PrematureEndOfDocument error. This error is recoverable:
+   after more data was added with addData() or became available on the
+   device, call reparse() to resume from where the reader stopped. When
+   readString() was the function that failed, it can also simply be called
+   again.
+
+   At the top level, reaching the end of the available data is not an error:
+   hasNext() returns false. If more data may follow, call reparse() once it
+   is available.
+
+   Numbers are only complete once a character following them was seen.
+   The end of the data terminates a number only at the top level, and only
+   when the reader operates on a QByteArray or on a random-access device
+   that is at its end.
+
+   \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+   \enum QJsonStreamReader::Type
+
+   This enum describes the type of the current element.
+
+   \value Null          The JSON \c null value.
+   \value Bool          \c true or \c false.
+   \value Integer       A number without fractional part that fits a qint64.
+   \value Double        Any other number.
+   \value String        A string, or the key of an object member.
+   \value Array         An array.
+   \value Object        An object.
+   \value Invalid       No element: the end of a container or of the data was
+                        reached, or an error occurred.
+*/
+
+/*!
+   \enum QJsonStreamReader::StringResultCode
+
+   This enum is returned by readString() and indicates what status the
+   parsing is in.
+
+   \value EndOfString           The parsing for the string is complete, with no error.
+   \value Ok                    The function returned data; there was no error.
+   \value Error                 Parsing failed with an error.
+*/
+
+/*!
+   \class QJsonStreamReader::StringResult
+   \inmodule QtCore
+
+   This class is returned by readString() to return a chunk of the string
+   and the status of the parsing.
+
+   \sa readString()
+*/
+
+/*!
+   \variable QJsonStreamReader::StringResult::data
+
+   Contains the actual data from the string if \l status is \c Ok.
+*/
+
+/*!
+   \variable QJsonStreamReader::StringResult::status
+
+   Contains the status of the attempt of reading the string from the stream.
+*/
+
+/*!
+   Constructs a QJsonStreamReader with no data. Use addData() or setDevice()
+   to supply some.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate(QByteArray()))
+{
+}
+
+/*!
+   \overload
+
+   Creates a QJsonStreamReader object that parses the \a len bytes of JSON
+   text starting at \a data. The data is copied.
+*/
+QJsonStreamReader::QJsonStreamReader(const char *data, qsizetype len)
+    : QJsonStreamReader(QByteArray(data, len))
+{
+}
+
+/*!
+   \overload
+
+   Creates a QJsonStreamReader object that parses the JSON text in \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate(data))
+{
+    preparse();
+}
+
+/*!
+   \overload
+
+   Creates a QJsonStreamReader object that reads JSON text from \a device as
+   it is needed. The device must be open for reading.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : d(new QJsonStreamReaderPrivate(device))
+{
+    preparse();
+}
+
+/*!
+   Destroys this QJsonStreamReader object.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+   Sets the source of data to \a device, resetting the decoder to its
+   initial state.
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->reset();
+    d->device = device;
+    preparse();
+}
+
+/*!
+   Returns the QIODevice that was set with either setDevice() or the
+   QJsonStreamReader constructor. If this object was reading from a
+   QByteArray, this function returns \nullptr instead.
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+   Adds \a data to the buffer being parsed. This function cannot be used
+   when the reader operates on a QIODevice.
+
+   After adding data, call reparse() if the current element was incomplete.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    addData(data.constData(), data.size());
+}
+
+/*!
+   \overload
+
+   Adds the \a len bytes starting at \a data to the buffer being parsed.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    if (d->device) {
+        qWarning("QJsonStreamReader: addData() with device()");
+        return;
+    }
+    if (d->pos == d->buffer.size()) {
+        // nothing left to parse, start over
+        d->bufferOffset += d->pos;
+        d->buffer.clear();
+        d->pos = 0;
+    }
+    d->buffer.append(data, len);
+}
+
+/*!
+   Resumes parsing after more data was made available, when the previous
+   attempt failed with QJsonParseError::PrematureEndOfDocument. At the top
+   level, this also checks whether another value followed the last one.
+*/
+void QJsonStreamReader::reparse()
+{
+    d->clearRecoverableError();
+    if (d->skipping)
+        next();
+    else if (type_ == Invalid)
+        preparse();
+}
+
+/*!
+   Clears the decoder state and the data, resetting the reader to the state
+   it had when it was default-constructed. The device is kept.
+*/
+void QJsonStreamReader::clear()
+{
+    setDevice(d->device);
+}
+
+/*!
+   Returns the last error in decoding the stream, if any. The offset of the
+   error is relative to the beginning of the stream.
+*/
+QJsonParseError QJsonStreamReader::lastError() const
+{
+    QJsonParseError error;
+    error.error = d->lastError;
+    error.offset = d->lastError == QJsonParseError::NoError ? -1 : int(d->errorOffset);
+    return error;
+}
+
+/*!
+   Returns the offset in the input stream of the element currently being
+   parsed. For strings, this is the position up to which the contents were
+   read.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    return d->bufferOffset + d->pos;
+}
+
+/*!
+   Returns the number of containers that this stream has entered with
+   enterContainer() but not yet left.
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+   Returns the type of the container that is the parent of the current
+   element, or QJsonStreamReader::Invalid at the top level.
+*/
+QJsonStreamReader::Type QJsonStreamReader::parentContainerType() const
+{
+    return d->containers.isEmpty() ? Invalid : d->containers.last().type;
+}
+
+/*!
+   Returns true if there are more elements to be decoded in the current
+   container or, at the top level, in the data. Returns false at the end of a
+   container, at the end of the data and if an error occurred.
+*/
+bool QJsonStreamReader::hasNext() const noexcept
+{
+    return type_ != Invalid;
+}
+
+/*!
+   Advances the stream to the next element, skipping over the contents of
+   strings and containers that were not read. Returns true on success and
+   false if an error occurred.
+
+   \sa lastError(), leaveContainer()
+*/
+bool QJsonStreamReader::next()
+{
+    if (!d->skipping) {
+        if (type_ == Invalid)
+            return false;
+        if (type_ == String) {
+            d->skipping = true;
+            d->skipInString = true;
+            d->skipEscape = false;
+            d->skipDepth = 0;
+            d->pendingHighSurrogate = 0;
+        } else if (type_ == Array || type_ == Object) {
+            d->skipping = true;
+            d->skipInString = false;
+            d->skipEscape = false;
+            d->skipDepth = 1;
+        }
+    }
+
+    d->clearRecoverableError();
+    if (d->lastError != QJsonParseError::NoError)
+        return false;
+
+    if (d->skipping) {
+        if (!d->skip()) {
+            d->setError(QJsonParseError::PrematureEndOfDocument, 0);
+            return false;
+        }
+        d->skipping = false;
+    }
+
+    d->elementConsumed();
+    preparse();
+    return d->lastError == QJsonParseError::NoError;
+}
+
+/*!
+   Enters the array or object that is the current element. The first element
+   inside it becomes the current one. Returns true on success.
+
+   \sa leaveContainer(), isContainer()
+*/
+bool QJsonStreamReader::enterContainer()
+{
+    Q_ASSERT(isContainer());
+    d->containers.append({ Type(type_), QJsonStreamReaderPrivate::ExpectFirst });
+    preparse();
+    return d->lastError == QJsonParseError::NoError;
+}
+
+/*!
+   Leaves the container that was entered with enterContainer(), skipping
+   any elements that were not read yet, and advances to the element that
+   follows it. Returns true on success.
+
+   \sa enterContainer(), containerDepth()
+*/
+bool QJsonStreamReader::leaveContainer()
+{
+    Q_ASSERT(!d->containers.isEmpty());
+    d->clearRecoverableError();
+    if (type_ == Invalid && !d->skipping && !d->containerEnd)
+        preparse();
+    while (hasNext()) {
+        if (!next())
+            return false;
+    }
+    if (d->lastError != QJsonParseError::NoError)
+        return false;
+
+    d->pos += d->endOffset + 1;
+    d->containers.removeLast();
+    d->elementConsumed();
+    preparse();
+    return d->lastError == QJsonParseError::NoError;
+}
+
+/*!
+   Reads the string contents until the end of the string or of the available
+   data, and returns them as a chunk with status \c Ok. Once the whole string
+   was read, the next call returns an empty result with status
+   \c EndOfString and advances to the next element. Chunks never split a
+   UTF-8 sequence, an escape sequence or a surrogate pair.
+
+   If the data ends before the string does and no contents could be read,
+   the result status is \c Error with QJsonParseError::PrematureEndOfDocument,
+   and this function can be called again once more data is available.
+
+   \sa readAllString(), isString()
+*/
+QJsonStreamReader::StringResult<QString> QJsonStreamReader::_readString_helper()
+{
+    StringResult<QString> result;
+    d->clearRecoverableError();
+    if (d->lastError != QJsonParseError::NoError)
+        return result;
+
+    QString out;
+    if (d->pendingHighSurrogate) {
+        out.append(QChar(d->pendingHighSurrogate));
+        d->pendingHighSurrogate = 0;
+    }
+    // a high surrogate alone is not a chunk, unless the string ends after it
+    const auto isIncomplete = [&out] { return out.size() == 1 && out.back().isHighSurrogate(); };
+    for (;;) {
+        d->discardConsumed();
+        const char *const begin = d->buffer.constData() + d->pos;
+        const char *const end = d->buffer.constData() + d->buffer.size();
+        const char *p = begin;
+        while (p != end && *p != '"' && *p != '\\')
+            ++p;
+
+        const char *runEnd = p == end ? incompleteUtf8Tail(begin, end) : p;
+        if (runEnd != begin) {
+            const QByteArrayView run(begin, runEnd - begin);
+            if (!QUtf8::isValidUtf8(run).isValidUtf8) {
+                d->setError(QJsonParseError::IllegalUTF8String, 0);
+                return result;
+            }
+            const qsizetype oldSize = out.size();
+            out.resize(oldSize + run.size());
+            QChar *outEnd = QUtf8::convertToUnicode(out.data() + oldSize, run);
+            out.truncate(outEnd - out.constData());
+            d->pos += run.size();
+        }
+
+        if (p != end && *p == '"') {
+            if (!out.isEmpty())
+                break;
+            ++d->pos;
+            result.status = EndOfString;
+            d->elementConsumed();
+            preparse();
+            return result;
+        }
+
+        if (p != end) {
+            // escape sequence
+            Q_ASSERT(*p == '\\');
+            if (d->ensure(2)) {
+                const char *esc = d->buffer.constData() + d->pos + 1;
+                char32_t ch = 0;
+                qsizetype len = 2;
+                switch (*esc) {
+                case '"':   ch = '"'; break;
+                case '\\':  ch = '\\'; break;
+                case '/':   ch = '/'; break;
+                case 'b':   ch = 0x8; break;
+                case 'f':   ch = 0xc; break;
+                case 'n':   ch = 0xa; break;
+                case 'r':   ch = 0xd; break;
+                case 't':   ch = 0x9; break;
+                case 'u':
+                    len = 6;
+                    if (!d->ensure(len)) {
+                        len = 0;
+                        break;
+                    }
+                    esc = d->buffer.constData() + d->pos + 2;
+                    for (int i = 0; i < 4; ++i) {
+                        if (!addHexDigit(esc[i], &ch)) {
+                            d->setError(QJsonParseError::IllegalEscapeSequence, 0);
+                            return result;
+                        }
+                    }
+                    break;
+                default:
+                    // not strict, just like QJsonDocument::fromJson()
+                    if (uchar(*esc) >= 0x80) {
+                        d->setError(QJsonParseError::IllegalEscapeSequence, 0);
+                        return result;
+                    }
+                    ch = uchar(*esc);
+                    break;
+                }
+                if (len) {
+                    out.append(QChar(char16_t(ch)));
+                    d->pos += len;
+                    if (out.size() < ReadChunkSize)
+                        continue;
+                    break;
+                }
+            }
+        } else if (out.size() < ReadChunkSize && d->fetchMore()) {
+            continue;
+        }
+
+        // need more data
+        if (!out.isEmpty() && !isIncomplete())
+            break;
+        if (d->fetchMore())
+            continue;
+        if (isIncomplete())
+            d->pendingHighSurrogate = out.back().unicode();
+        d->setError(QJsonParseError::PrematureEndOfDocument, 0);
+        return result;
+    }
+
+    // unless the string ends here, the low surrogate follows in the next chunk
+    if (out.size() > 1 && out.back().isHighSurrogate()
+        && (d->pos == d->buffer.size() || d->buffer.at(d->pos) != '"')) {
+        d->pendingHighSurrogate = out.back().unicode();
+        out.chop(1);
+    }
+
+    result.data = std::move(out);
+    result.status = Ok;
+    return result;
+}
+
+/*!
+   Reads the current string element in its entirety and advances to the next
+   element. Returns a null QString if an error occurred.
+
+   \sa readString()
+*/
+QString QJsonStreamReader::readAllString()
+{
+    QString str;
+    for (;;) {
+        StringResult<QString> r = readString();
+        if (r.status == Error)
+            return QString();
+        if (r.status == EndOfString)
+            break;
+        str += r.data;
+    }
+    if (str.isNull())
+        str = QLatin1StringView("");
+    return str;
+}
+
+/*!
+   \internal
+
+   Determines the type of the element at the current position and, for
+   scalars, decodes its value. If there is not enough data, the reader's
+   position is left unchanged so that a later call can start over.
+*/
+void QJsonStreamReader::preparse()
+{
+    d->discardConsumed();
+    type_ = Invalid;
+    d->containerEnd = false;
+    if (d->lastError != QJsonParseError::NoError)
+        return;
+
+    qsizetype i = 0;    // relative to d->pos until the element is committed
+    char c = 0;
+    auto peek = [&]() {
+        for (;; ++i) {
+            if (!d->ensure(i + 1))
+                return false;
+            c = d->buffer.at(d->pos + i);
+            if (!isJsonSpace(c))
+                return true;
+        }
+    };
+    auto premature = [&]() { d->setError(QJsonParseError::PrematureEndOfDocument, i); };
+
+    if (d->containers.isEmpty()) {
+        if (!peek()) {
+            // end of the data, not an error at the top level
+            d->pos += i;
+            return;
+        }
+    } else {
+        const QJsonStreamReaderPrivate::Container &container = d->containers.last();
+        const bool isObject = container.type == Object;
+        const char closing = isObject ? '}' : ']';
+        if (!peek())
+            return premature();
+
+        switch (container.phase) {
+        case QJsonStreamReaderPrivate::AfterValue:
+            if (c == closing) {
+                d->endOffset = i;
+                d->containerEnd = true;
+                return;
+            }
+            if (c != ',') {
+                return d->setError(isObject ? QJsonParseError::UnterminatedObject
+                                            : QJsonParseError::MissingValueSeparator, i);
+            }
+            ++i;
+            if (!peek())
+                return premature();
+            if (c == closing)
+                return d->setError(QJsonParseError::MissingObject, i);
+            if (isObject && c != '"')
+                return d->setError(QJsonParseError::UnterminatedObject, i);
+            break;
+
+        case QJsonStreamReaderPrivate::ExpectFirst:
+            if (c == closing) {
+                d->endOffset = i;
+                d->containerEnd = true;
+                return;
+            }
+            if (isObject && c != '"')
+                return d->setError(QJsonParseError::UnterminatedObject, i);
+            break;
+
+        case QJsonStreamReaderPrivate::ExpectValue:
+            if (c != ':')
+                return d->setError(QJsonParseError::MissingNameSeparator, i);
+            ++i;
+            if (!peek())
+                return premature();
+            break;
+        }
+    }
+
+    auto literal = [&](QLatin1StringView name) {
+        if (!d->ensure(i + name.size())) {
+            premature();
+            return false;
+        }
+        if (QLatin1StringView(d->buffer.constData() + d->pos + i, name.size()) != name) {
+            d->setError(QJsonParseError::IllegalValue, i);
+            return false;
+        }
+        d->pos += i + name.size();
+        return true;
+    };
+
+    switch (c) {
+    case '"':
+        d->pos += i + 1;
+        type_ = String;
+        return;
+    case '[':
+        d->pos += i + 1;
+        type_ = Array;
+        return;
+    case '{':
+        d->pos += i + 1;
+        type_ = Object;
+        return;
+    case 'n':
+        if (literal("null"_L1))
+            type_ = Null;
+        return;
+    case 't':
+        if (literal("true"_L1)) {
+            value.b = true;
+            type_ = Bool;
+        }
+        return;
+    case 'f':
+        if (literal("false"_L1)) {
+            value.b = false;
+            type_ = Bool;
+        }
+        return;
+    case ']':
+    case '}':
+        return d->setError(QJsonParseError::MissingObject, i);
+    default:
+        break;
+    }
+
+    if (c != '-' && !isAsciiDigit(c))
+        return d->setError(QJsonParseError::IllegalValue, i);
+
+    // numbers
+    qsizetype j = i;
+    bool isInt = true;
+    for (;; ++j) {
+        if (!d->ensure(j + 1)) {
+            // inside a container, a number is always followed by something
+            if (d->containers.isEmpty() && d->inputFinished())
+                break;
+            return premature();
+        }
+        const char ch = d->buffer.at(d->pos + j);
+        if (!isNumberChar(ch))
+            break;
+        if (ch == '.' || ch == 'e' || ch == 'E')
+            isInt = false;
+    }
+
+    const QByteArray number = QByteArray::fromRawData(d->buffer.constData() + d->pos + i, j - i);
+    if (isInt) {
+        bool ok;
+        value.i = number.toLongLong(&ok);
+        if (ok) {
+            d->pos += j;
+            type_ = Integer;
+            return;
+        }
+    }
+
+    bool ok;
+    const double dbl = number.toDouble(&ok);
+    if (!ok)
+        return d->setError(QJsonParseError::IllegalNumber, i);
+
+    d->pos += j;
+    if (convertDoubleTo(dbl, &value.i)) {
+        type_ = Integer;
+    } else {
+        value.d = dbl;
+        type_ = Double;
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,110 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum Type : quint8 {
+        Null,
+        Bool,
+        Integer,
+        Double,
+        String,
+        Array,
+        Object,
+
+        Invalid = 0xff
+    };
+    Q_ENUM(Type)
+
+    enum StringResultCode {
+        EndOfString = 0,
+        Ok = 1,
+        Error = -1
+    };
+    Q_ENUM(StringResultCode)
+    template <typename Container> struct StringResult {
+        Container data;
+        StringResultCode status = Error;
+    };
+
+    QJsonStreamReader();
+    QJsonStreamReader(const char *data, qsizetype len);
+    explicit QJsonStreamReader(const QByteArray &data);
+    explicit QJsonStreamReader(QIODevice *device);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setDevice(QIODevice *device);
+    QIODevice *device() const;
+    void addData(const QByteArray &data);
+    void addData(const char *data, qsizetype len);
+    void reparse();
+    void clear();
+
+    QJsonParseError lastError() const;
+
+    qint64 currentOffset() const;
+
+    bool isValid() const        { return !isInvalid(); }
+
+    int containerDepth() const;
+    QJsonStreamReader::Type parentContainerType() const;
+    bool hasNext() const noexcept Q_DECL_PURE_FUNCTION;
+    bool next();
+
+    Type type() const           { return QJsonStreamReader::Type(type_); }
+    bool isNull() const         { return type() == Null; }
+    bool isBool() const         { return type() == Bool; }
+    bool isTrue() const         { return isBool() && value.b; }
+    bool isFalse() const        { return isBool() && !value.b; }
+    bool isInteger() const      { return type() == Integer; }
+    bool isDouble() const       { return type() == Double; }
+    bool isString() const       { return type() == String; }
+    bool isArray() const        { return type() == Array; }
+    bool isObject() const       { return type() == Object; }
+    bool isInvalid() const      { return type() == Invalid; }
+
+    bool isContainer() const    { return isArray() || isObject(); }
+    bool enterContainer();
+    bool leaveContainer();
+
+    StringResult<QString> readString()  { Q_ASSERT(isString()); return _readString_helper(); }
+    QString readAllString();
+
+    bool toBool() const         { Q_ASSERT(isBool()); return value.b; }
+    qint64 toInteger() const    { Q_ASSERT(isInteger()); return value.i; }
+    double toDouble() const     { Q_ASSERT(isDouble() || isInteger()); return isInteger() ? double(value.i) : value.d; }
+
+private:
+    void preparse();
+    StringResult<QString> _readString_helper();
+
+    friend QJsonStreamReaderPrivate;
+    union {
+        bool b;
+        qint64 i;
+        double d;
+    } value = {};
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+    quint8 type_ = Invalid;
+    quint8 reserved[3] = {};
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
@@ -0,0 +1,373 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qjsonstreamwriter.h"
+
+#include <qcborvalue.h>
+#include <qiodevice.h>
+#include <qjsonvalue.h>
+#include <qlocale.h>
+#include <qvarlengtharray.h>
+
+#include <private/qjsonwriter_p.h>
+#include <private/qnumeric_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// output is handed to the device once this much accumulated
+static constexpr qsizetype FlushThreshold = 16 * 1024;
+
+class QJsonStreamWriterPrivate
+{
+public:
+    enum ContainerType : quint8 { Array, Object };
+    struct Container {
+        ContainerType type;
+        bool empty;
+        bool expectKey;     // objects only
+    };
+
+    QJsonStreamWriterPrivate(QIODevice *device) : device(device) {}
+    QJsonStreamWriterPrivate(QByteArray *data) : data(data) {}
+
+    QByteArray &output() { return data ? *data : buffer; }
+    bool prefix(bool isString);
+    void valueWritten();
+    bool endContainer(ContainerType type, char closing);
+    bool flush();
+
+    QIODevice *device = nullptr;
+    QByteArray *data = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<Container, 16> containers;
+    bool hasError = false;
+};
+
+// Writes the separator that goes before a value or key. Returns false if
+// nothing may be written, because of this or of an earlier error.
+bool QJsonStreamWriterPrivate::prefix(bool isString)
+{
+    if (hasError)
+        return false;
+    if (containers.isEmpty())
+        return true;
+
+    Container &c = containers.last();
+    QByteArray &out = output();
+    if (c.type == Object) {
+        if (c.expectKey) {
+            if (!isString) {
+                hasError = true;
+                return false;
+            }
+            if (!c.empty)
+                out += ',';
+        } else {
+            out += ':';
+        }
+        c.expectKey = !c.expectKey;
+    } else if (!c.empty) {
+        out += ',';
+    }
+    c.empty = false;
+    return true;
+}
+
+// Called after a complete value was written
+void QJsonStreamWriterPrivate::valueWritten()
+{
+    if (containers.isEmpty()) {
+        // top-level values go one per line, so the output is valid NDJSON
+        output() += '\n';
+        flush();
+    } else if (buffer.size() >= FlushThreshold) {
+        flush();
+    }
+}
+
+bool QJsonStreamWriterPrivate::endContainer(ContainerType type, char closing)
+{
+    if (hasError || containers.isEmpty() || containers.last().type != type)
+        return false;
+    if (type == Object && !containers.last().expectKey)
+        return false;       // a key without a value
+    containers.removeLast();
+    output() += closing;
+    valueWritten();
+    return true;
+}
+
+bool QJsonStreamWriterPrivate::flush()
+{
+    if (!device || buffer.isEmpty())
+        return true;
+    const qint64 written = device->write(buffer);
+    buffer.clear();
+    if (written < 0)
+        hasError = true;
+    return written >= 0;
+}
+
+/*!
+   \class QJsonStreamWriter
+   \inmodule QtCore
+   \ingroup json
+   \ingroup qtserialization
+   \reentrant
+   \since 6.6
+
+   \brief The QJsonStreamWriter class is a simple JSON encoder operating on a
+   one-way stream.
+
+   This class can be used to write JSON text directly to a QByteArray or a
+   QIODevice, one element at a time, without building a QJsonDocument first.
+   The output is compact. Each top-level value is followed by a newline, so
+   writing several of them produces newline-delimited JSON (NDJSON).
+
+   Arrays are written by calling startArray(), appending the elements and
+   calling endArray(). Objects work the same way with startObject() and
+   endObject(), where the appended elements alternate between the key, which
+   must be a string, and the value.
+
+   \code
+   QJsonStreamWriter writer(&file);
+   for (const Record &record : records) {
+       writer.startObject();
+       writer.append("id"_L1);
+       writer.append(record.id);
+       writer.append("name"_L1);
+       writer.append(record.name);
+       writer.endObject();
+   }
+   \endcode
+
+   QJsonStreamWriter does not check that the output is a valid JSON text
+   beyond the pairing of keys and values and of the start and end of
+   containers. Appending anything but a string where an object key is
+   expected is an error: it is not written, and hasError() returns true.
+
+   \sa QJsonStreamReader, QJsonDocument, QCborStreamWriter
+*/
+
+/*!
+   Creates a QJsonStreamWriter object that will write the stream to \a
+   device. The device must already be opened for writing. Output is buffered
+   and handed to the device after each top-level value, when enough of it
+   accumulated and when flush() is called.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : d(new QJsonStreamWriterPrivate(device))
+{
+}
+
+/*!
+   Creates a QJsonStreamWriter object that will append the stream to \a data.
+   All streaming is done immediately to the byte array.
+
+   QJsonStreamWriter does not take ownership of \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : d(new QJsonStreamWriterPrivate(data))
+{
+}
+
+/*!
+   Destroys this QJsonStreamWriter object, flushing any buffered output to the
+   device.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+   Replaces the device or byte array that this QJsonStreamWriter object is
+   writing to with \a device. Any buffered output is flushed to the previous
+   device first.
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->data = nullptr;
+}
+
+/*!
+   Returns the QIODevice that this QJsonStreamWriter object is writing to,
+   or \nullptr if it is writing to a QByteArray.
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+   Appends the integer \a i to the stream.
+*/
+void QJsonStreamWriter::append(qint64 i)
+{
+    if (!d->prefix(false))
+        return;
+    d->output() += QByteArray::number(i);
+    d->valueWritten();
+}
+
+/*!
+   \overload
+
+   Appends the floating point number \a d to the stream, in its shortest
+   exact representation. Infinities and NaN cannot be represented in JSON
+   and are written as \c null, like QJsonDocument::toJson() does.
+*/
+void QJsonStreamWriter::append(double d)
+{
+    if (!this->d->prefix(false))
+        return;
+    if (qIsFinite(d))
+        this->d->output() += QByteArray::number(d, 'g', QLocale::FloatingPointShortest);
+    else
+        this->d->output() += "null";
+    this->d->valueWritten();
+}
+
+/*!
+   \overload
+
+   Appends the boolean value \a b to the stream.
+*/
+void QJsonStreamWriter::append(bool b)
+{
+    if (!d->prefix(false))
+        return;
+    d->output() += b ? "true" : "false";
+    d->valueWritten();
+}
+
+/*!
+   \overload
+
+   Appends the Latin-1 string \a str to the stream as a JSON string, or as
+   the key of an object member.
+*/
+void QJsonStreamWriter::append(QLatin1StringView str)
+{
+    append(QStringView(QString(str)));
+}
+
+/*!
+   \overload
+
+   Appends the string \a str to the stream as a JSON string, or as the key of
+   an object member.
+*/
+void QJsonStreamWriter::append(QStringView str)
+{
+    if (!d->prefix(true))
+        return;
+    QByteArray &out = d->output();
+    out += '"';
+    out += QJsonPrivate::Writer::escapedString(str);
+    out += '"';
+    d->valueWritten();
+}
+
+/*!
+   \overload
+
+   Appends \a value to the stream, including the contents of arrays and
+   objects. An undefined value is written as \c null.
+*/
+void QJsonStreamWriter::append(const QJsonValue &value)
+{
+    if (!d->prefix(value.isString()))
+        return;
+    QJsonPrivate::Writer::valueToJson(QCborValue::fromJsonValue(value), d->output(), 0, true);
+    d->valueWritten();
+}
+
+/*!
+   \fn void QJsonStreamWriter::append(std::nullptr_t)
+   \overload
+
+   Appends a \c null value to the stream.
+
+   \sa appendNull()
+*/
+
+/*!
+   Appends a \c null value to the stream.
+*/
+void QJsonStreamWriter::appendNull()
+{
+    if (!d->prefix(false))
+        return;
+    d->output() += "null";
+    d->valueWritten();
+}
+
+/*!
+   Starts an array. The elements appended after this call are its contents,
+   until endArray() is called.
+*/
+void QJsonStreamWriter::startArray()
+{
+    if (!d->prefix(false))
+        return;
+    d->output() += '[';
+    d->containers.append({ QJsonStreamWriterPrivate::Array, true, false });
+}
+
+/*!
+   Terminates the array started by the last call to startArray(). Returns
+   false if the innermost open container is not an array.
+*/
+bool QJsonStreamWriter::endArray()
+{
+    return d->endContainer(QJsonStreamWriterPrivate::Array, ']');
+}
+
+/*!
+   Starts an object. The elements appended after this call alternate between
+   keys and values, until endObject() is called.
+*/
+void QJsonStreamWriter::startObject()
+{
+    if (!d->prefix(false))
+        return;
+    d->output() += '{';
+    d->containers.append({ QJsonStreamWriterPrivate::Object, true, true });
+}
+
+/*!
+   Terminates the object started by the last call to startObject(). Returns
+   false if the innermost open container is not an object or if the last key
+   appended has no value.
+*/
+bool QJsonStreamWriter::endObject()
+{
+    return d->endContainer(QJsonStreamWriterPrivate::Object, '}');
+}
+
+/*!
+   Returns \c true if writing failed, either because a value other than a
+   string was appended where an object key was expected, or because writing
+   to the device failed.
+
+   The error status is never reset. After an error, nothing more is written,
+   and endArray() and endObject() return false.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->hasError;
+}
+
+/*!
+   Hands all buffered output to the device. Returns false if writing to the
+   device failed. Does nothing when writing to a QByteArray.
+*/
+bool QJsonStreamWriter::flush()
+{
+    return d->flush();
+}
+
+QT_END_NAMESPACE
@@ -13,6 +13,7 @@
 
 #include "qthread_p.h"
 #include "private/qcoreapplication_p.h"
+#include "private/qsimd_p.h"
 
 #include <limits>
 
@@ -40,6 +41,53 @@ void QPostEventList::addEvent(const QPostEvent &ev)
     }
 }
 
+/*!
+    \internal
+
+    Moves the events that were posted without holding the mutex into the
+    sorted list, in the order in which they were posted. The mutex must be
+    locked.
+*/
+void QPostEventList::mergeIncomingEvents()
+{
+    QIncomingPostEvent *node = incoming.exchange(nullptr, std::memory_order_acquire);
+    if (!node)
+        return;
+
+    // the stack has the most recently posted event on top
+    QIncomingPostEvent *reversed = nullptr;
+    while (node) {
+        QIncomingPostEvent *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+
+    while (reversed) {
+        QIncomingPostEvent *next = reversed->next;
+        addEvent(reversed->event);
+        delete reversed;
+        reversed = next;
+    }
+}
+
+/*!
+    \internal
+
+    Makes postEvent() take the mutex for this list until unblockIncoming() is
+    called, and waits for the posters that are already pushing incoming events
+    to finish. Used by QObject::moveToThread() so that no event can be pushed
+    onto the old thread's list after the posted events have been moved. The
+    mutex must be locked.
+*/
+void QPostEventList::blockIncoming()
+{
+    incomingBlocked.store(true);
+    while (incomingProducers.load() != 0)
+        qYieldCpu();
+    mergeIncomingEvents();
+}
+
 
 /*
   QThreadData
@@ -81,6 +129,7 @@ QThreadData::~QThreadData()
     thread.storeRelease(nullptr);
     delete t;
 
+    postEventList.mergeIncomingEvents();
     for (int i = 0; i < postEventList.size(); ++i) {
         const QPostEvent &pe = postEventList.at(i);
         if (pe.event) {
@@ -56,9 +56,23 @@ inline bool operator<(const QPostEvent &first, const QPostEvent &second)
     return first.priority > second.priority;
 }
 
+// Node of the lock-free queue of incoming events, see QPostEventList
+struct QIncomingPostEvent
+{
+    QPostEvent event;
+    QIncomingPostEvent *next;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 // It's used in a virtual in QCoreApplication, so ELFVERSION:ignore-next
+//
+// Events of normal priority that are never compressed can also be posted
+// without taking the mutex: they are pushed onto a lock-free stack of
+// incoming events, which the thread owning the list merges into the sorted
+// list (mergeIncomingEvents()) whenever it takes the mutex to look at it.
+// Since merging happens before any event is added with the mutex held, the
+// order in which events were posted is preserved.
 class QPostEventList : public QList<QPostEvent>
 {
 public:
@@ -76,7 +90,38 @@ public:
 
     void addEvent(const QPostEvent &ev);
 
+    // lock-free posting; a producer calls beginIncoming(), and only if that
+    // returns true pushIncoming() followed by endIncoming()
+    bool beginIncoming() noexcept
+    {
+        incomingProducers.fetch_add(1);
+        if (Q_LIKELY(!incomingBlocked.load()))
+            return true;
+        endIncoming();
+        return false;
+    }
+    void endIncoming() noexcept { incomingProducers.fetch_sub(1, std::memory_order_release); }
+    bool pushIncoming(QIncomingPostEvent *node) noexcept
+    {
+        node->next = incoming.load(std::memory_order_relaxed);
+        while (!incoming.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+        }
+        return node->next == nullptr;
+    }
+    bool hasIncomingEvents() const noexcept
+    { return incoming.load(std::memory_order_acquire) != nullptr; }
+
+    // the following require the mutex to be locked
+    void mergeIncomingEvents();
+    void blockIncoming();
+    void unblockIncoming() noexcept { incomingBlocked.store(false); }
+
 private:
+    std::atomic<QIncomingPostEvent *> incoming = nullptr;
+    std::atomic<int> incomingProducers = 0;
+    std::atomic<bool> incomingBlocked = false;
+
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
     using QList<QPostEvent>::insert;
@@ -307,7 +352,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncomingEvents();
     }
 
 private:
@@ -24,11 +24,20 @@ public:
     void run() override;
     void registerThreadInactive();
 
+    QRunnable *takeLocalTask();
+
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // Tasks started from within this thread while work stealing is enabled.
+    // Only this thread pushes; it pops from the back, thieves from the front.
+    QMutex localMutex;
+    QList<QRunnable *> localQueue;
 };
 
+Q_CONSTINIT static thread_local QThreadPoolThread *currentPoolThread = nullptr;
+
 /*
     QThreadPool private class.
 */
@@ -48,6 +57,7 @@ QThreadPoolThread::QThreadPoolThread(QThreadPoolPrivate *manager)
 */
 void QThreadPoolThread::run()
 {
+    currentPoolThread = this;
     QMutexLocker locker(&manager->mutex);
     for(;;) {
         QRunnable *r = runnable;
@@ -55,27 +65,32 @@ void QThreadPoolThread::run()
 
         do {
             if (r) {
-                // If autoDelete() is false, r might already be deleted after run(), so check status now.
-                const bool del = r->autoDelete();
-
-                // run the task
                 locker.unlock();
+                do {
+                    // If autoDelete() is false, r might already be deleted after run(), so check status now.
+                    const bool del = r->autoDelete();
+
+                    // run the task
 #ifndef QT_NO_EXCEPTIONS
-                try {
+                    try {
 #endif
-                    r->run();
+                        r->run();
 #ifndef QT_NO_EXCEPTIONS
-                } catch (...) {
-                    qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
-                             "This is not supported, exceptions thrown in worker threads must be\n"
-                             "caught before control returns to Qt Concurrent.");
-                    registerThreadInactive();
-                    throw;
-                }
+                    } catch (...) {
+                        qWarning("Qt Concurrent has caught an exception thrown from a worker thread.\n"
+                                 "This is not supported, exceptions thrown in worker threads must be\n"
+                                 "caught before control returns to Qt Concurrent.");
+                        registerThreadInactive();
+                        throw;
+                    }
 #endif
 
-                if (del)
-                    delete r;
+                    if (del)
+                        delete r;
+
+                    // tasks spawned by the one that just finished run first,
+                    // without going through the pool's lock
+                } while ((r = takeLocalTask()));
                 locker.relock();
             }
 
@@ -83,9 +98,12 @@ void QThreadPoolThread::run()
             if (manager->tooManyThreadsActive())
                 break;
 
-            // all work is done, time to wait for more
-            if (manager->queue.isEmpty())
+            if (manager->queue.isEmpty()) {
+                // all work is done, unless another thread has tasks to spare
+                if ((r = manager->stealTask(this)))
+                    continue;
                 break;
+            }
 
             QueuePage *page = manager->queue.first();
             r = page->pop();
@@ -131,6 +149,17 @@ void QThreadPoolThread::registerThreadInactive()
         manager->noActiveThreads.wakeAll();
 }
 
+/*
+    \internal
+
+    Takes the most recently queued task from this thread's local queue.
+*/
+QRunnable *QThreadPoolThread::takeLocalTask()
+{
+    QMutexLocker locker(&localMutex);
+    return localQueue.isEmpty() ? nullptr : localQueue.takeLast();
+}
+
 
 /*
     \internal
@@ -198,6 +227,99 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
 }
 
+/*
+    \internal
+
+    Queues \a task on the calling thread's local queue, if work stealing is
+    enabled and the calling thread is a worker of this pool. Only tasks with
+    the default priority are eligible; anything else must be ordered in the
+    shared queue. Returns \c true if the task was queued.
+
+    Called without holding the pool's mutex.
+*/
+bool QThreadPoolPrivate::tryEnqueueLocalTask(QRunnable *task, int priority)
+{
+    if (priority != 0 || !workStealing.load(std::memory_order_relaxed))
+        return false;
+
+    QThreadPoolThread *self = currentPoolThread;
+    if (!self || self->manager != this)
+        return false;
+
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&self->localMutex);
+        wasEmpty = self->localQueue.isEmpty();
+        self->localQueue.append(task);
+    }
+
+    // Get an idle thread to come and steal; each successful thief wakes up
+    // the next one, so we don't need to do this for every task.
+    if (wasEmpty) {
+        QMutexLocker locker(&mutex);
+        startThief();
+    }
+    return true;
+}
+
+/*
+    \internal
+
+    Takes the oldest task from the local queue of some thread other than
+    \a thief. Must be called with the pool's mutex held.
+*/
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *victim : std::as_const(allThreads)) {
+        if (victim == thief)
+            continue;
+
+        QMutexLocker locker(&victim->localMutex);
+        if (victim->localQueue.isEmpty())
+            continue;
+
+        QRunnable *task = victim->localQueue.takeFirst();
+        const bool moreToSteal = !victim->localQueue.isEmpty();
+        locker.unlock();
+
+        if (moreToSteal)
+            startThief();
+        return task;
+    }
+    return nullptr;
+}
+
+/*
+    \internal
+
+    Wakes up or starts a thread without a task, so that it can look for work
+    in the other threads' local queues. Must be called with the pool's mutex
+    held.
+*/
+bool QThreadPoolPrivate::startThief()
+{
+    if (areAllThreadsActive())
+        return false;
+
+    if (!waitingThreads.isEmpty()) {
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+        return true;
+    }
+
+    if (!expiredThreads.isEmpty()) {
+        QThreadPoolThread *thread = expiredThreads.dequeue();
+        Q_ASSERT(thread->runnable == nullptr);
+        ++activeThreads;
+        thread->wait();
+        Q_ASSERT(thread->isFinished());
+        thread->start(threadPriority);
+        return true;
+    }
+
+    startThread();
+    return true;
+}
+
 int QThreadPoolPrivate::activeThreadCount() const
 {
     return (allThreads.size()
@@ -240,7 +362,6 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
     auto thread = std::make_unique<QThreadPoolThread>(this);
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
@@ -321,6 +442,19 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+
+    for (QThreadPoolThread *thread : std::as_const(allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        const QList<QRunnable *> localQueue = std::exchange(thread->localQueue, {});
+        localLocker.unlock();
+        for (QRunnable *r : localQueue) {
+            if (r->autoDelete()) {
+                locker.unlock();
+                delete r;
+                locker.relock();
+            }
+        }
+    }
 }
 
 /*!
@@ -358,6 +492,12 @@ bool QThreadPool::tryTake(QRunnable *runnable)
         }
     }
 
+    for (QThreadPoolThread *thread : std::as_const(d->allThreads)) {
+        QMutexLocker localLocker(&thread->localMutex);
+        if (thread->localQueue.removeOne(runnable))
+            return true;
+    }
+
     return false;
 }
 
@@ -510,6 +650,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->tryEnqueueLocalTask(runnable, priority))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -742,6 +885,43 @@ QThread::Priority QThreadPool::threadPriority() const
     return d->threadPriority;
 }
 
+/*! \property QThreadPool::workStealingEnabled
+    \brief whether tasks started from worker threads are queued per thread.
+
+    By default, every task that cannot be started right away is added to a
+    single queue shared by all threads of the pool. When many small tasks are
+    started from within the pool's own threads, for example by recursive or
+    divide-and-conquer algorithms, that queue and the mutex guarding it can
+    become a bottleneck.
+
+    If this property is \c true, start() called from one of the pool's
+    threads with the default priority adds the task to a queue owned by the
+    calling thread instead. A thread runs the most recently added task of its
+    own queue first, and threads that run out of work take the oldest tasks
+    from the queues of other threads. Tasks with a non-default priority, and
+    tasks started from threads outside the pool, still go through the shared
+    queue and keep their ordering.
+
+    Tasks in per-thread queues run before tasks in the shared queue on that
+    thread, regardless of their priority.
+
+    The default value is \c false.
+
+    \since 6.6
+    \sa start()
+*/
+void QThreadPool::setWorkStealingEnabled(bool enabled)
+{
+    Q_D(QThreadPool);
+    d->workStealing.store(enabled, std::memory_order_relaxed);
+}
+
+bool QThreadPool::isWorkStealingEnabled() const
+{
+    Q_D(const QThreadPool);
+    return d->workStealing.load(std::memory_order_relaxed);
+}
+
 /*!
     Releases a thread previously reserved by a call to reserveThread().
 
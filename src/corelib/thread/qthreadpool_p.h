@@ -24,6 +24,8 @@
 #include "QtCore/qqueue.h"
 #include "private/qobject_p.h"
 
+#include <atomic>
+
 QT_REQUIRE_CONFIG(thread);
 
 QT_BEGIN_NAMESPACE
@@ -118,6 +120,9 @@ public:
 
     bool tryStart(QRunnable *task);
     void enqueueTask(QRunnable *task, int priority = 0);
+    bool tryEnqueueLocalTask(QRunnable *task, int priority);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    bool startThief();
     int activeThreadCount() const;
 
     void tryToStartMoreThreads();
@@ -150,6 +155,7 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+    std::atomic<bool> workStealing = false;
 };
 
 QT_END_NAMESPACE
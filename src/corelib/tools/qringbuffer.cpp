@@ -71,6 +71,27 @@ const char *QRingBuffer::readPointerAtPosition(qint64 pos, qint64 &length) const
     return nullptr;
 }
 
+/*!
+    \internal
+
+    Stores pointers to the first \a maxCount blocks of data in the buffer,
+    in order, in \a data and their sizes in \a sizes, for a gathering write.
+    Returns the number of blocks stored.
+*/
+qsizetype QRingBuffer::dataBlocks(const char **data, qint64 *sizes, qsizetype maxCount) const
+{
+    qsizetype count = 0;
+    for (const QRingChunk &chunk : buffers) {
+        if (count == maxCount)
+            break;
+        if (chunk.size() == 0)
+            continue;
+        data[count] = chunk.data();
+        sizes[count++] = chunk.size();
+    }
+    return count;
+}
+
 void QRingBuffer::free(qint64 bytes)
 {
     Q_ASSERT(bytes <= bufferSize);
@@ -129,6 +150,40 @@ char *QRingBuffer::reserve(qint64 bytes)
     return buffers.last().data() + tail;
 }
 
+/*!
+    \internal
+
+    Allocate data at buffer tail like reserve(), for a scattering read: the
+    space left in the last block is used before a new block is allocated,
+    so the \a bytes may be split in two blocks. Stores pointers to them in
+    \a data and their sizes in \a sizes, which must have room for two
+    entries, and returns the number of blocks.
+*/
+qsizetype QRingBuffer::reserveBlocks(qint64 bytes, char **data, qint64 *sizes)
+{
+    Q_ASSERT(bytes > 0 && bytes < MaxByteArraySize);
+
+    qsizetype count = 0;
+    if (bufferSize != 0 && basicBlockSize != 0 && !buffers.constLast().isShared()) {
+        QRingChunk &chunk = buffers.last();
+        const qint64 available = qMin(bytes, qint64(chunk.available()));
+        if (available > 0) {
+            const qsizetype tail = chunk.size();
+            chunk.grow(available);
+            bufferSize += available;
+            data[0] = chunk.data() + tail;
+            sizes[0] = available;
+            count = 1;
+            bytes -= available;
+        }
+    }
+    if (bytes > 0) {
+        data[count] = reserve(bytes);
+        sizes[count++] = bytes;
+    }
+    return count;
+}
+
 /*!
     \internal
 
@@ -157,8 +157,10 @@ public:
     }
 
     Q_CORE_EXPORT const char *readPointerAtPosition(qint64 pos, qint64 &length) const;
+    Q_CORE_EXPORT qsizetype dataBlocks(const char **data, qint64 *sizes, qsizetype maxCount) const;
     Q_CORE_EXPORT void free(qint64 bytes);
     Q_CORE_EXPORT char *reserve(qint64 bytes);
+    Q_CORE_EXPORT qsizetype reserveBlocks(qint64 bytes, char **data, qint64 *sizes);
     Q_CORE_EXPORT char *reserveFront(qint64 bytes);
 
     inline void truncate(qint64 pos) {
@@ -466,6 +466,7 @@ bool Decoder::decodeLiteralField(const BitPattern &fieldType, BitIStream &inputS
                 handleStreamError(inputStream);
                 return false;
             }
+            name = FieldLookupTable::internedName(name);
         } else {
             if (!lookupTable.fieldName(index, &name))
                 return false;
@@ -13,6 +13,8 @@
 
 QT_BEGIN_NAMESPACE
 
+using namespace Qt::StringLiterals;
+
 namespace HPack
 {
 
@@ -409,75 +411,86 @@ void FieldLookupTable::setMaxDynamicTableSize(quint32 size)
 
 // This data is from the HPACK's specs and it's quite conveniently sorted,
 // except ... 'accept' is in the wrong position, see how we handle it below.
+// The strings are literals: copying them does not allocate or even touch
+// a reference count, so they are cheap to hand out for every header.
 const std::vector<HeaderField> &FieldLookupTable::staticPart()
 {
     static std::vector<HeaderField> table = {
-    {":authority", ""},
-    {":method", "GET"},
-    {":method", "POST"},
-    {":path", "/"},
-    {":path", "/index.html"},
-    {":scheme", "http"},
-    {":scheme", "https"},
-    {":status", "200"},
-    {":status", "204"},
-    {":status", "206"},
-    {":status", "304"},
-    {":status", "400"},
-    {":status", "404"},
-    {":status", "500"},
-    {"accept-charset", ""},
-    {"accept-encoding", "gzip, deflate"},
-    {"accept-language", ""},
-    {"accept-ranges", ""},
-    {"accept", ""},
-    {"access-control-allow-origin", ""},
-    {"age", ""},
-    {"allow", ""},
-    {"authorization", ""},
-    {"cache-control", ""},
-    {"content-disposition", ""},
-    {"content-encoding", ""},
-    {"content-language", ""},
-    {"content-length", ""},
-    {"content-location", ""},
-    {"content-range", ""},
-    {"content-type", ""},
-    {"cookie", ""},
-    {"date", ""},
-    {"etag", ""},
-    {"expect", ""},
-    {"expires", ""},
-    {"from", ""},
-    {"host", ""},
-    {"if-match", ""},
-    {"if-modified-since", ""},
-    {"if-none-match", ""},
-    {"if-range", ""},
-    {"if-unmodified-since", ""},
-    {"last-modified", ""},
-    {"link", ""},
-    {"location", ""},
-    {"max-forwards", ""},
-    {"proxy-authenticate", ""},
-    {"proxy-authorization", ""},
-    {"range", ""},
-    {"referer", ""},
-    {"refresh", ""},
-    {"retry-after", ""},
-    {"server", ""},
-    {"set-cookie", ""},
-    {"strict-transport-security", ""},
-    {"transfer-encoding", ""},
-    {"user-agent", ""},
-    {"vary", ""},
-    {"via", ""},
-    {"www-authenticate", ""}
+    {":authority"_ba, ""_ba},
+    {":method"_ba, "GET"_ba},
+    {":method"_ba, "POST"_ba},
+    {":path"_ba, "/"_ba},
+    {":path"_ba, "/index.html"_ba},
+    {":scheme"_ba, "http"_ba},
+    {":scheme"_ba, "https"_ba},
+    {":status"_ba, "200"_ba},
+    {":status"_ba, "204"_ba},
+    {":status"_ba, "206"_ba},
+    {":status"_ba, "304"_ba},
+    {":status"_ba, "400"_ba},
+    {":status"_ba, "404"_ba},
+    {":status"_ba, "500"_ba},
+    {"accept-charset"_ba, ""_ba},
+    {"accept-encoding"_ba, "gzip, deflate"_ba},
+    {"accept-language"_ba, ""_ba},
+    {"accept-ranges"_ba, ""_ba},
+    {"accept"_ba, ""_ba},
+    {"access-control-allow-origin"_ba, ""_ba},
+    {"age"_ba, ""_ba},
+    {"allow"_ba, ""_ba},
+    {"authorization"_ba, ""_ba},
+    {"cache-control"_ba, ""_ba},
+    {"content-disposition"_ba, ""_ba},
+    {"content-encoding"_ba, ""_ba},
+    {"content-language"_ba, ""_ba},
+    {"content-length"_ba, ""_ba},
+    {"content-location"_ba, ""_ba},
+    {"content-range"_ba, ""_ba},
+    {"content-type"_ba, ""_ba},
+    {"cookie"_ba, ""_ba},
+    {"date"_ba, ""_ba},
+    {"etag"_ba, ""_ba},
+    {"expect"_ba, ""_ba},
+    {"expires"_ba, ""_ba},
+    {"from"_ba, ""_ba},
+    {"host"_ba, ""_ba},
+    {"if-match"_ba, ""_ba},
+    {"if-modified-since"_ba, ""_ba},
+    {"if-none-match"_ba, ""_ba},
+    {"if-range"_ba, ""_ba},
+    {"if-unmodified-since"_ba, ""_ba},
+    {"last-modified"_ba, ""_ba},
+    {"link"_ba, ""_ba},
+    {"location"_ba, ""_ba},
+    {"max-forwards"_ba, ""_ba},
+    {"proxy-authenticate"_ba, ""_ba},
+    {"proxy-authorization"_ba, ""_ba},
+    {"range"_ba, ""_ba},
+    {"referer"_ba, ""_ba},
+    {"refresh"_ba, ""_ba},
+    {"retry-after"_ba, ""_ba},
+    {"server"_ba, ""_ba},
+    {"set-cookie"_ba, ""_ba},
+    {"strict-transport-security"_ba, ""_ba},
+    {"transfer-encoding"_ba, ""_ba},
+    {"user-agent"_ba, ""_ba},
+    {"vary"_ba, ""_ba},
+    {"via"_ba, ""_ba},
+    {"www-authenticate"_ba, ""_ba}
     };
 
     return table;
 }
 
+QByteArray FieldLookupTable::internedName(const QByteArray &name)
+{
+    const auto &table = staticPart();
+    const auto pos = findInStaticPart(HeaderField(name, QByteArray()), CompareMode::nameOnly);
+    if (pos != table.end() && pos->name == name)
+        return pos->name;
+    return name;
+}
+
 std::vector<HeaderField>::const_iterator FieldLookupTable::findInStaticPart(const HeaderField &field, CompareMode mode)
 {
     const auto &table = staticPart();
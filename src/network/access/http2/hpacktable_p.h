@@ -138,6 +138,9 @@ public:
     void setMaxDynamicTableSize(quint32 size);
 
     static const std::vector<HeaderField> &staticPart();
+    // Returns the equal name from the static part if there is one,
+    // so that the data of common names is shared, else 'name':
+    static QByteArray internedName(const QByteArray &name);
 
 private:
     // Table's maximum size is controlled
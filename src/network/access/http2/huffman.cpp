@@ -7,6 +7,7 @@
 #include <QtCore/qbytearray.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 
 QT_BEGIN_NAMESPACE
@@ -50,6 +51,14 @@ namespace HPack
     http://commandlinefanatic.com/cgi-bin/showarticle.cgi?article=art007
     or just google "Efficient Huffman Decoding".
     Also see comments below about 'filling holes'.
+
+    Walking these tables for every symbol is still slow, so in front of
+    them we have a 'lookahead' table, indexed by the next lookaheadBits bits
+    of the input. Its entries hold the symbols whose codes fit into these
+    bits, up to maxLookaheadSymbols (two) of them, so that typical header
+    strings are decoded with one lookup for every two octets. Only symbols
+    with long codes and the last bits of a string go through the prefix
+    tables.
 */
 
 namespace
@@ -349,7 +358,7 @@ quint64 huffman_encoded_bit_length(QByteArrayView inputData)
 {
     quint64 bitLength = 0;
     for (int i = 0, e = inputData.size(); i < e; ++i)
-        bitLength += staticHuffmanCodeTable[int(inputData[i])].bitLength;
+        bitLength += staticHuffmanCodeTable[uchar(inputData[i])].bitLength;
 
     return bitLength;
 }
@@ -455,54 +464,113 @@ HuffmanDecoder::HuffmanDecoder()
             }
         }
     }
+
+    // Finally, the lookahead table: for every value of the next
+    // lookaheadBits bits, the symbols whose codes fit into them.
+    lookaheadTable.resize(1 << lookaheadBits);
+    for (quint32 i = 0; i < lookaheadTable.size(); ++i) {
+        LookaheadEntry &lookahead = lookaheadTable[i];
+        quint32 chunk = i << (32 - lookaheadBits);
+        quint32 bitsLeft = lookaheadBits;
+        while (lookahead.symbolCount < maxLookaheadSymbols) {
+            const PrefixTableEntry entry = findEntry(chunk);
+            if (!entry.bitLength || entry.bitLength > bitsLeft || entry.byteValue == 256)
+                break;
+            lookahead.symbols[lookahead.symbolCount++] = uchar(entry.byteValue);
+            lookahead.bitLength += entry.bitLength;
+            chunk <<= entry.bitLength;
+            bitsLeft -= entry.bitLength;
+        }
+    }
 }
 
 bool HuffmanDecoder::decodeStream(BitIStream &inputStream, QByteArray &outputBuffer)
+{
+    // Every symbol takes at least minCodeLength bits, so we can decode
+    // into the buffer directly and shrink it to the real size at the end.
+    // The lookahead entries are copied as a whole, hence the extra space.
+    const qsizetype oldSize = outputBuffer.size();
+    const quint64 maxSize = (inputStream.bitLength() - inputStream.streamOffset()) / minCodeLength;
+    outputBuffer.resize(oldSize + qsizetype(maxSize) + maxLookaheadSymbols);
+    char *const begin = outputBuffer.data() + oldSize;
+    char *dst = begin;
+
+    const bool result = decodeStream(inputStream, dst);
+    Q_ASSERT(dst - begin <= qsizetype(maxSize));
+    outputBuffer.truncate(oldSize + (dst - begin));
+    return result;
+}
+
+bool HuffmanDecoder::decodeStream(BitIStream &inputStream, char *&dst)
 {
     while (true) {
+        // Decode as much as we can from the next 64 bits with
+        // the lookahead table first:
+        quint64 bits = 0;
+        const quint64 readBits = inputStream.peekBits(inputStream.streamOffset(), 64, &bits);
+        quint64 usedBits = 0;
+        while (readBits - usedBits >= lookaheadBits) {
+            const LookaheadEntry &entry = lookaheadTable[bits << usedBits >> (64 - lookaheadBits)];
+            if (!entry.symbolCount)
+                break;
+            std::memcpy(dst, entry.symbols, maxLookaheadSymbols);
+            dst += entry.symbolCount;
+            usedBits += entry.bitLength;
+        }
+        inputStream.skipBits(usedBits);
+
+        // Then one symbol via the prefix tables, either its
+        // code is too long or we are at the end of the string:
         quint32 chunk = 0;
-        const quint32 readBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
-        if (!readBits)
+        const quint32 chunkBits = inputStream.peekBits(inputStream.streamOffset(), 32, &chunk);
+        if (!chunkBits)
             return !inputStream.hasMoreBits();
 
-        if (readBits < minCodeLength) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+        if (chunkBits < minCodeLength) {
+            inputStream.skipBits(chunkBits);
+            return padding_is_valid(chunk, chunkBits);
         }
 
-        quint32 tableIndex = 0;
-        const PrefixTable *table = &prefixTables[tableIndex];
-        quint32 entryIndex = chunk >> (32 - table->indexLength);
-        PrefixTableEntry entry = tableEntry(*table, entryIndex);
+        const PrefixTableEntry entry = findEntry(chunk);
 
-        while (true) {
-            if (entry.nextTable == tableIndex)
-                break;
-
-            tableIndex = entry.nextTable;
-            table = &prefixTables[tableIndex];
-            entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
-            entry = tableEntry(*table, entryIndex);
-        }
-
-        if (entry.bitLength > readBits) {
-            inputStream.skipBits(readBits);
-            return padding_is_valid(chunk, readBits);
+        if (entry.bitLength > chunkBits) {
+            inputStream.skipBits(chunkBits);
+            return padding_is_valid(chunk, chunkBits);
         }
 
         if (!entry.bitLength || entry.byteValue == 256) {
             //EOS (256) == compression error (HPACK).
-            inputStream.skipBits(readBits);
+            inputStream.skipBits(chunkBits);
             return false;
         }
 
-        outputBuffer.append(entry.byteValue);
+        *dst++ = char(entry.byteValue);
         inputStream.skipBits(entry.bitLength);
     }
 
     return false;
 }
 
+PrefixTableEntry HuffmanDecoder::findEntry(quint32 chunk) const
+{
+    quint32 tableIndex = 0;
+    const PrefixTable *table = &prefixTables[tableIndex];
+    quint32 entryIndex = chunk >> (32 - table->indexLength);
+    PrefixTableEntry entry = tableEntry(*table, entryIndex);
+
+    while (true) {
+        if (entry.nextTable == tableIndex)
+            break;
+
+        tableIndex = entry.nextTable;
+        table = &prefixTables[tableIndex];
+        entryIndex = chunk << table->prefixLength >> (32 - table->indexLength);
+        entry = tableEntry(*table, entryIndex);
+    }
+
+    return entry;
+}
+
 quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
 {
     PrefixTable newTable{prefix, index};
@@ -514,7 +582,7 @@ quint32 HuffmanDecoder::addTable(quint32 prefix, quint32 index)
     return quint32(prefixTables.size() - 1);
 }
 
-PrefixTableEntry HuffmanDecoder::tableEntry(const PrefixTable &table, quint32 index)
+PrefixTableEntry HuffmanDecoder::tableEntry(const PrefixTable &table, quint32 index) const
 {
     Q_ASSERT(index < table.size());
     return tableData[table.offset + index];
@@ -98,6 +98,19 @@ struct PrefixTableEntry
     quint32 byteValue;
 };
 
+// Lookahead entries hold up to maxLookaheadSymbols symbols, whose
+// codes take 'bitLength' bits in total. An entry without symbols
+// means the code of the next symbol is longer than the lookahead.
+
+enum { lookaheadBits = 12, maxLookaheadSymbols = 2 };
+
+struct LookaheadEntry
+{
+    quint8 bitLength = 0;
+    quint8 symbolCount = 0;
+    uchar symbols[maxLookaheadSymbols] = {};
+};
+
 class BitIStream;
 
 class HuffmanDecoder
@@ -114,12 +127,16 @@ public:
     bool decodeStream(BitIStream &inputStream, QByteArray &outputBuffer);
 
 private:
+    bool decodeStream(BitIStream &inputStream, char *&dst);
+    PrefixTableEntry findEntry(quint32 chunk) const;
+
     quint32 addTable(quint32 prefixLength, quint32 indexLength);
-    PrefixTableEntry tableEntry(const PrefixTable &table, quint32 index);
+    PrefixTableEntry tableEntry(const PrefixTable &table, quint32 index) const;
     void setTableEntry(const PrefixTable &table, quint32 index, const PrefixTableEntry &entry);
 
     std::vector<PrefixTable> prefixTables;
     std::vector<PrefixTableEntry> tableData;
+    std::vector<LookaheadEntry> lookaheadTable;
     quint32 minCodeLength;
 };
 
@@ -41,6 +41,8 @@ QT_BEGIN_NAMESPACE
       \li The server push. Allows to enable or disable server push. Sent
          as 'SETTINGS_ENABLE_PUSH' parameter in the initial 'SETTINGS'
          frame.
+      \li Adaptive flow control. Allows the session and stream windows to
+         grow beyond their configured sizes when they limit the throughput.
     \endlist
 
     The QHttp2Configuration class also controls if the header compression
@@ -69,6 +71,7 @@ public:
     bool pushEnabled = false;
     // TODO: for now those two below are noop.
     bool huffmanCompressionEnabled = true;
+    bool adaptiveFlowControlEnabled = false;
 };
 
 /*!
@@ -81,6 +84,7 @@ public:
         \li Window size for connection-level flow control is 65535 octets
         \li Window size for stream-level flow control is 65535 octets
         \li Frame size is 16384 octets
+        \li Adaptive flow control is disabled
     \endlist
 */
 QHttp2Configuration::QHttp2Configuration()
@@ -166,6 +170,38 @@ bool QHttp2Configuration::huffmanCompressionEnabled() const
     return d->huffmanCompressionEnabled;
 }
 
+/*!
+    \since 6.6
+
+    If \a enable is \c true, QNetworkAccessManager estimates the
+    bandwidth-delay product of the connection while receiving data, by
+    measuring how much data arrives during the round trip of a 'PING' frame.
+    When the receive windows turn out to be the bottleneck, the session and
+    stream windows are grown to twice that estimate, up to 16 MiB.
+
+    The sizes set with setSessionReceiveWindowSize() and
+    setStreamReceiveWindowSize() are then used as the initial sizes. Windows
+    never shrink below them. Disabled by default.
+
+    \sa adaptiveFlowControlEnabled
+*/
+void QHttp2Configuration::setAdaptiveFlowControlEnabled(bool enable)
+{
+    d->adaptiveFlowControlEnabled = enable;
+}
+
+/*!
+    \since 6.6
+
+    Returns \c true if adaptive flow control is enabled.
+
+    \sa setAdaptiveFlowControlEnabled
+*/
+bool QHttp2Configuration::adaptiveFlowControlEnabled() const
+{
+    return d->adaptiveFlowControlEnabled;
+}
+
 /*!
     Sets the window size for connection-level flow control.
     \a size cannot be 0 and must not exceed 2147483647 octets.
@@ -283,6 +319,7 @@ bool QHttp2Configuration::isEqual(const QHttp2Configuration &other) const noexce
 
     return d->pushEnabled == other.d->pushEnabled
            && d->huffmanCompressionEnabled == other.d->huffmanCompressionEnabled
+           && d->adaptiveFlowControlEnabled == other.d->adaptiveFlowControlEnabled
            && d->sessionWindowSize == other.d->sessionWindowSize
            && d->streamWindowSize == other.d->streamWindowSize;
 }
@@ -32,6 +32,9 @@ public:
     void setHuffmanCompressionEnabled(bool enable);
     bool huffmanCompressionEnabled() const;
 
+    void setAdaptiveFlowControlEnabled(bool enable);
+    bool adaptiveFlowControlEnabled() const;
+
     bool setSessionReceiveWindowSize(unsigned size);
     unsigned sessionReceiveWindowSize() const;
 
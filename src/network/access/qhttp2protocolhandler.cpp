@@ -147,6 +147,8 @@ QHttp2ProtocolHandler::QHttp2ProtocolHandler(QHttpNetworkConnectionChannel *chan
     maxSessionReceiveWindowSize = h2Config.sessionReceiveWindowSize();
     pushPromiseEnabled = h2Config.serverPushEnabled();
     streamInitialReceiveWindowSize = h2Config.streamReceiveWindowSize();
+    streamReceiveWindowSize = streamInitialReceiveWindowSize;
+    adaptiveFlowControl = h2Config.adaptiveFlowControlEnabled();
     encoder.setCompressStrings(h2Config.huffmanCompressionEnabled());
 
     if (!channel->ssl && m_connection->connectionType() != QHttpNetworkConnection::ConnectionTypeHTTP2Direct) {
@@ -541,6 +543,15 @@ bool QHttp2ProtocolHandler::sendWINDOW_UPDATE(quint32 streamID, quint32 delta)
     return frameWriter.write(*m_socket);
 }
 
+bool QHttp2ProtocolHandler::sendPING(quint64 payload)
+{
+    Q_ASSERT(m_socket);
+
+    frameWriter.start(FrameType::PING, FrameFlag::EMPTY, connectionStreamID);
+    frameWriter.append(payload);
+    return frameWriter.write(*m_socket);
+}
+
 bool QHttp2ProtocolHandler::sendRST_STREAM(quint32 streamID, quint32 errorCode)
 {
     Q_ASSERT(m_socket);
@@ -575,6 +586,8 @@ void QHttp2ProtocolHandler::handleDATA()
         return connectionError(FLOW_CONTROL_ERROR, "Flow control error");
 
     sessionReceiveWindowSize -= inboundFrame.payloadSize();
+    if (adaptiveFlowControl)
+        sampleReceivedData(inboundFrame.payloadSize());
 
     if (activeStreams.contains(streamID)) {
         auto &stream = activeStreams[streamID];
@@ -592,11 +605,11 @@ void QHttp2ProtocolHandler::handleDATA()
             if (inboundFrame.flags().testFlag(FrameFlag::END_STREAM)) {
                 finishStream(stream);
                 deleteActiveStream(stream.streamID);
-            } else if (stream.recvWindow < streamInitialReceiveWindowSize / 2) {
+            } else if (stream.recvWindow < streamReceiveWindowSize / 2) {
                 QMetaObject::invokeMethod(this, "sendWINDOW_UPDATE", Qt::QueuedConnection,
                                           Q_ARG(quint32, stream.streamID),
-                                          Q_ARG(quint32, streamInitialReceiveWindowSize - stream.recvWindow));
-                stream.recvWindow = streamInitialReceiveWindowSize;
+                                          Q_ARG(quint32, streamReceiveWindowSize - stream.recvWindow));
+                stream.recvWindow = streamReceiveWindowSize;
             }
         }
     }
@@ -795,16 +808,65 @@ void QHttp2ProtocolHandler::handlePING()
     if (inboundFrame.streamID() != connectionStreamID)
         return connectionError(PROTOCOL_ERROR, "PING on invalid stream");
 
-    if (inboundFrame.flags() & FrameFlag::ACK)
-        return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
-
     Q_ASSERT(inboundFrame.dataSize() == 8);
 
+    if (inboundFrame.flags() & FrameFlag::ACK) {
+        if (!bdpPingSent || qFromBigEndian<quint64>(inboundFrame.dataBegin()) != bdpPingPayload)
+            return connectionError(PROTOCOL_ERROR, "unexpected PING ACK");
+        bdpPingSent = false;
+        growReceiveWindows();
+        return;
+    }
+
     frameWriter.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
     frameWriter.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
     frameWriter.write(*m_socket);
 }
 
+/*!
+    \internal
+
+    Counts the \a size bytes of DATA received while a PING is in flight. If
+    no PING is in flight, sends one to start a new sample.
+*/
+void QHttp2ProtocolHandler::sampleReceivedData(quint32 size)
+{
+    if (!bdpPingSent) {
+        bdpSample = 0;
+        bdpPingSent = sendPING(++bdpPingPayload);
+    }
+    bdpSample += size;
+}
+
+/*!
+    \internal
+
+    Called when the PING sent by sampleReceivedData() is acknowledged. If the
+    data received during its round trip came close to filling the smaller of
+    the session and stream windows, the windows limited the throughput, and we
+    grow both to twice the estimated bandwidth-delay product.
+*/
+void QHttp2ProtocolHandler::growReceiveWindows()
+{
+    // Like other implementations we do not let a connection buffer more
+    // than this much, even if the link could use it:
+    constexpr qint64 maxAdaptiveWindowSize = 16 * 1024 * 1024;
+
+    const qint64 window = std::min(maxSessionReceiveWindowSize, streamReceiveWindowSize);
+    if (bdpSample * 3 < window * 2)
+        return;
+
+    const qint32 newSize = qint32(std::min(bdpSample * 2, maxAdaptiveWindowSize));
+    if (newSize > streamReceiveWindowSize)
+        streamReceiveWindowSize = newSize;
+    if (newSize > maxSessionReceiveWindowSize) {
+        const qint32 delta = newSize - maxSessionReceiveWindowSize;
+        maxSessionReceiveWindowSize = newSize;
+        sessionReceiveWindowSize += delta;
+        sendWINDOW_UPDATE(connectionStreamID, quint32(delta));
+    }
+}
+
 void QHttp2ProtocolHandler::handleGOAWAY()
 {
     // 6.8 GOAWAY
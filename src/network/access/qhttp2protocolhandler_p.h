@@ -76,6 +76,7 @@ private:
     bool sendHEADERS(Stream &stream);
     bool sendDATA(Stream &stream);
     Q_INVOKABLE bool sendWINDOW_UPDATE(quint32 streamID, quint32 delta);
+    bool sendPING(quint64 payload);
     bool sendRST_STREAM(quint32 streamID, quint32 errorCoder);
     bool sendGOAWAY(quint32 errorCode);
 
@@ -94,6 +95,9 @@ private:
 
     bool acceptSetting(Http2::Settings identifier, quint32 newValue);
 
+    void sampleReceivedData(quint32 size);
+    void growReceiveWindows();
+
     void updateStream(Stream &stream, const HPack::HttpHeader &headers,
                       Qt::ConnectionType connectionType = Qt::DirectConnection);
     void updateStream(Stream &stream, const Http2::Frame &dataFrame,
@@ -154,8 +158,8 @@ private:
     // sending requests and creating streams while maxConcurrentStreams allows).
 
     // This is our (client-side) maximum possible receive window size, we set
-    // it in a ctor from QHttp2Configuration, it does not change after that.
-    // The default is 64Kb:
+    // it in a ctor from QHttp2Configuration, it only grows after that if
+    // adaptive flow control is enabled. The default is 64Kb:
     qint32 maxSessionReceiveWindowSize = Http2::defaultSessionWindowSize;
 
     // Our session current receive window size, updated in a ctor from
@@ -165,6 +169,18 @@ private:
     // Our per-stream receive window size, default is 64 Kb, will be updated
     // from QHttp2Configuration. Again, signed - can become negative.
     qint32 streamInitialReceiveWindowSize = Http2::defaultSessionWindowSize;
+    // The size that WINDOW_UPDATE frames restore the stream windows to. It
+    // starts as streamInitialReceiveWindowSize and, with adaptive flow
+    // control, grows with the bandwidth-delay product:
+    qint32 streamReceiveWindowSize = Http2::defaultSessionWindowSize;
+
+    // Adaptive flow control. We estimate the bandwidth-delay product by
+    // counting the bytes received during the round trip of a PING, and grow
+    // the windows when they are close to being the bottleneck:
+    bool adaptiveFlowControl = false;
+    bool bdpPingSent = false;
+    quint64 bdpPingPayload = 0;
+    qint64 bdpSample = 0;
 
     // These are our peer's receive window sizes, they will be updated by the
     // peer's SETTINGS and WINDOW_UPDATE frames, defaults presumed to be 64Kb.
@@ -11,6 +11,7 @@
 #endif
 
 #include <private/qdecompresshelper_p.h>
+#include <private/qiodevice_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -549,6 +550,29 @@ qint64 QHttpNetworkReplyPrivate::readBodyVeryFast(QAbstractSocket *socket, char
     return haveRead;
 }
 
+// Moves up to maxSize bytes from the socket to out. The blocks in the
+// socket's read buffer are handed over as they are, without copying them.
+static qint64 moveSocketData(QAbstractSocket *socket, qint64 maxSize, QByteDataBuffer *out)
+{
+    const auto socketPrivate = static_cast<QIODevicePrivate *>(QObjectPrivate::get(socket));
+    qint64 bytes = 0;
+    while (bytes < maxSize) {
+        qint64 toRead = qMin(maxSize - bytes, socket->bytesAvailable());
+        if (const qint64 blockSize = socketPrivate->buffer.nextDataBlockSize())
+            toRead = qMin(toRead, blockSize);
+        else
+            toRead = qMin<qint64>(toRead, 128 * 1024);
+        if (toRead <= 0)
+            break;
+        QByteArray data = socket->read(toRead);
+        if (data.isEmpty())
+            break; // ### error checking here
+        bytes += data.size();
+        out->append(std::move(data));
+    }
+    return bytes;
+}
+
 // note this function can only be used for non-chunked, non-compressed with
 // known content length
 qint64 QHttpNetworkReplyPrivate::readBodyFast(QAbstractSocket *socket, QByteDataBuffer *rb)
@@ -561,16 +585,7 @@ qint64 QHttpNetworkReplyPrivate::readBodyFast(QAbstractSocket *socket, QByteData
     if (!toBeRead)
         return 0;
 
-    QByteArray bd;
-    bd.resize(toBeRead);
-    qint64 haveRead = socket->read(bd.data(), toBeRead);
-    if (haveRead == -1) {
-        bd.clear();
-        return 0; // ### error checking here;
-    }
-    bd.resize(haveRead);
-
-    rb->append(bd);
+    const qint64 haveRead = moveSocketData(socket, toBeRead, rb);
 
     if (contentRead + haveRead == bodyLength) {
         state = AllDoneState;
@@ -603,35 +618,12 @@ qint64 QHttpNetworkReplyPrivate::readBody(QAbstractSocket *socket, QByteDataBuff
 
 qint64 QHttpNetworkReplyPrivate::readReplyBodyRaw(QAbstractSocket *socket, QByteDataBuffer *out, qint64 size)
 {
-    // FIXME get rid of this function and just use readBodyFast and give it socket->bytesAvailable()
-    qint64 bytes = 0;
     Q_ASSERT(socket);
     Q_ASSERT(out);
 
-    int toBeRead = qMin<qint64>(128*1024, qMin<qint64>(size, socket->bytesAvailable()));
-
     if (readBufferMaxSize)
-        toBeRead = qMin<qint64>(toBeRead, readBufferMaxSize);
-
-    while (toBeRead > 0) {
-        QByteArray byteData;
-        byteData.resize(toBeRead);
-        qint64 haveRead = socket->read(byteData.data(), byteData.size());
-        if (haveRead <= 0) {
-            // ### error checking here
-            byteData.clear();
-            return bytes;
-        }
-
-        byteData.resize(haveRead);
-        out->append(byteData);
-        bytes += haveRead;
-        size -= haveRead;
-
-        toBeRead = qMin<qint64>(128*1024, qMin<qint64>(size, socket->bytesAvailable()));
-    }
-    return bytes;
-
+        size = qMin(size, readBufferMaxSize);
+    return moveSocketData(socket, size, out);
 }
 
 qint64 QHttpNetworkReplyPrivate::readReplyBodyChunked(QAbstractSocket *socket, QByteDataBuffer *out)
@@ -9,6 +9,12 @@
 #include <QAuthenticator>
 #include <QEventLoop>
 #include <QCryptographicHash>
+#if QT_CONFIG(ssl)
+#include <QSslCipher>
+#include <QSslDiffieHellmanParameters>
+#include <QSslEllipticCurve>
+#include <QSslKey>
+#endif
 
 #include "private/qhttpnetworkreply_p.h"
 #include "private/qnetworkaccesscache_p.h"
@@ -140,6 +146,83 @@ static QByteArray makeCacheKey(QUrl &url, QNetworkProxy *proxy, const QString &p
     return "http-connection:" + std::move(result).toLatin1();
 }
 
+// The connections cached in a thread shared by several managers are handed
+// to all of them, so they may only be reused with the same credentials and
+// SSL configuration.
+static QByteArray makeSharedCacheKey(const QUrl &url,
+                                     QNetworkAccessAuthenticationManager *authenticationManager,
+                                     const QSslConfiguration *sslConfiguration)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const auto addNumber = [&hash](quint64 number) {
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&number), sizeof(number)));
+    };
+    const auto addBytes = [&](QByteArrayView bytes) {
+        addNumber(bytes.size());
+        hash.addData(bytes);
+    };
+
+    addBytes(url.userName().toUtf8());
+    addBytes(url.password().toUtf8());
+    if (authenticationManager) {
+        const QNetworkAuthenticationCredential credential =
+                authenticationManager->fetchCachedCredentials(url);
+        addBytes(credential.user.toUtf8());
+        addBytes(credential.password.toUtf8());
+    }
+
+#if QT_CONFIG(ssl)
+    if (sslConfiguration) {
+        const QSslConfiguration &configuration = *sslConfiguration;
+        const auto addCertificates = [&](const QList<QSslCertificate> &certificates) {
+            addNumber(certificates.size());
+            for (const QSslCertificate &certificate : certificates)
+                addNumber(qHash(certificate));
+        };
+
+        addNumber(configuration.protocol());
+        addNumber(configuration.peerVerifyMode());
+        addNumber(configuration.peerVerifyDepth());
+        for (int option = QSsl::SslOptionDisableEmptyFragments;
+             option <= QSsl::SslOptionEnableKernelTls; option <<= 1) {
+            addNumber(configuration.testSslOption(QSsl::SslOption(option)));
+        }
+        addNumber(configuration.ocspStaplingEnabled());
+        addNumber(configuration.missingCertificateIsFatal());
+        addNumber(configuration.handshakeMustInterruptOnError());
+        addCertificates(configuration.localCertificateChain());
+        addCertificates(configuration.caCertificates());
+        const QSslKey privateKey = configuration.privateKey();
+        addBytes(privateKey.toDer());
+        addNumber(quintptr(privateKey.handle()));
+        const QList<QSslCipher> ciphers = configuration.ciphers();
+        addNumber(ciphers.size());
+        for (const QSslCipher &cipher : ciphers)
+            addBytes(cipher.name().toLatin1());
+        const QList<QSslEllipticCurve> curves = configuration.ellipticCurves();
+        addNumber(curves.size());
+        for (QSslEllipticCurve curve : curves)
+            addNumber(qHash(curve));
+        addNumber(qHash(configuration.diffieHellmanParameters()));
+        addBytes(configuration.preSharedKeyIdentityHint());
+        const QList<QByteArray> protocols = configuration.allowedNextProtocols();
+        addNumber(protocols.size());
+        for (const QByteArray &protocol : protocols)
+            addBytes(protocol);
+        addBytes(configuration.sessionTicket());
+        const QMap<QByteArray, QVariant> backendConfiguration = configuration.backendConfiguration();
+        for (auto it = backendConfiguration.cbegin(); it != backendConfiguration.cend(); ++it) {
+            addBytes(it.key());
+            addBytes(it.value().toString().toUtf8());
+        }
+    }
+#else
+    Q_UNUSED(sslConfiguration);
+#endif
+
+    return ":shared-" + hash.result().toHex();
+}
+
 class QNetworkAccessCachedHttpConnection: public QHttpNetworkConnection,
                                       public QNetworkAccessCache::CacheableObject
 {
@@ -160,11 +243,22 @@ public:
 #endif
         delete this;
     }
+
+    // the identity of the manager that ignored SSL errors on this connection,
+    // if it is in a shared thread
+    quint64 sslErrorsIgnoredBy = 0;
 };
 
 
 QThreadStorage<QNetworkAccessCache *> QHttpThreadDelegate::connections;
 
+// Closes the connections cached for the current thread that no request uses
+void QHttpThreadDelegate::clearUnusedConnections()
+{
+    if (connections.hasLocalData())
+        connections.localData()->clearUnused();
+}
+
 
 QHttpThreadDelegate::~QHttpThreadDelegate()
 {
@@ -292,8 +386,26 @@ void QHttpThreadDelegate::startRequest()
 #endif
         cacheKey = makeCacheKey(urlCopy, nullptr, httpRequest.peerVerifyName());
 
+    if (sharedThread) {
+#if QT_CONFIG(ssl)
+        const QSslConfiguration *sslConfiguration = ssl ? incomingSslConfiguration.data() : nullptr;
+#else
+        const QSslConfiguration *sslConfiguration = nullptr;
+#endif
+        cacheKey += makeSharedCacheKey(httpRequest.url(), authenticationManager.get(),
+                                       sslConfiguration);
+    }
+
     // the http object is actually a QHttpNetworkConnection
     httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    if (httpConnection && httpConnection->sslErrorsIgnoredBy
+        && httpConnection->sslErrorsIgnoredBy != authenticationManager->identity()) {
+        // Another manager accepted the SSL errors of this connection: we
+        // have to see them for ourselves, on a connection of our own.
+        connections.localData()->releaseEntry(cacheKey);
+        cacheKey += ":manager-" + QByteArray::number(authenticationManager->identity());
+        httpConnection = static_cast<QNetworkAccessCachedHttpConnection *>(connections.localData()->requestEntryNow(cacheKey));
+    }
     if (!httpConnection) {
         // no entry in cache; create an object
         // the http object is actually a QHttpNetworkConnection
@@ -680,6 +792,8 @@ void QHttpThreadDelegate::sslErrorsSlot(const QList<QSslError> &errors)
         httpReply->ignoreSslErrors();
     if (!specificErrors.isEmpty())
         httpReply->ignoreSslErrors(specificErrors);
+    if ((ignoreAll || !specificErrors.isEmpty()) && sharedThread && httpConnection)
+        httpConnection->sslErrorsIgnoredBy = authenticationManager->identity();
 }
 
 void QHttpThreadDelegate::preSharedKeyAuthenticationRequiredSlot(QSslPreSharedKeyAuthenticator *authenticator)
@@ -52,6 +52,8 @@ public:
 
     ~QHttpThreadDelegate();
 
+    static void clearUnusedConnections();
+
     // incoming
     bool ssl;
 #ifndef QT_NO_SSL
@@ -71,6 +73,7 @@ public:
     std::shared_ptr<QNetworkAccessAuthenticationManager> authenticationManager;
     bool synchronous;
     qint64 connectionCacheExpiryTimeoutSeconds;
+    bool sharedThread = false; // see QT_NETWORK_SHARED_HTTP_THREADS
 
     // outgoing, Retrieved in the synchronous HTTP case
     QByteArray synchronousDownloadData;
@@ -191,6 +191,17 @@ QNetworkAccessAuthenticationManager::fetchCachedProxyCredentials(const QNetworkP
 
 #endif
 
+static quint64 nextAuthenticationManagerIdentity()
+{
+    Q_CONSTINIT static QBasicAtomicInteger<quint64> lastIdentity = Q_BASIC_ATOMIC_INITIALIZER(0);
+    return lastIdentity.fetchAndAddRelaxed(1) + 1;
+}
+
+QNetworkAccessAuthenticationManager::QNetworkAccessAuthenticationManager()
+    : id(nextAuthenticationManagerIdentity())
+{
+}
+
 void QNetworkAccessAuthenticationManager::cacheCredentials(const QUrl &url,
                                                   const QAuthenticator *authenticator)
 {
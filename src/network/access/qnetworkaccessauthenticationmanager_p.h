@@ -49,7 +49,12 @@ inline bool operator<(const QNetworkAuthenticationCredential &t1, const QNetwork
 class QNetworkAccessAuthenticationManager
 {
 public:
-    QNetworkAccessAuthenticationManager() {}
+    QNetworkAccessAuthenticationManager();
+
+    // Tells the managers apart when they share their connections (see
+    // QHttpThreadDelegate::startRequest()); unlike an address, it is never
+    // reused.
+    quint64 identity() const { return id; }
 
     void cacheCredentials(const QUrl &url, const QAuthenticator *auth);
     QNetworkAuthenticationCredential fetchCachedCredentials(const QUrl &url,
@@ -66,6 +71,9 @@ public:
 protected:
     QNetworkAccessCache authenticationCache;
     QMutex mutex;
+
+private:
+    const quint64 id;
 };
 
 QT_END_NAMESPACE
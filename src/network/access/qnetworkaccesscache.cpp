@@ -91,6 +91,26 @@ void QNetworkAccessCache::clear()
     firstExpiringNode = lastExpiringNode = nullptr;
 }
 
+/*!
+    Removes the entries that are not in use.
+ */
+void QNetworkAccessCache::clearUnused()
+{
+    for (auto it = hash.begin(); it != hash.end(); ) {
+        Node *node = *it;
+        if (node->useCount) {
+            ++it;
+            continue;
+        }
+        unlinkEntry(node->key);
+        node->object->key.clear();
+        node->object->dispose();
+        delete node;
+        it = hash.erase(it);
+    }
+    updateTimer();
+}
+
 /*!
     Appends the entry given by \a key to the end of the linked list.
     (i.e., makes it the newest entry)
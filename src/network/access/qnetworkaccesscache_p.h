@@ -58,6 +58,7 @@ public:
     ~QNetworkAccessCache();
 
     void clear();
+    void clearUnused();
 
     void addEntry(const QByteArray &key, CacheableObject *entry, qint64 connectionCacheExpiryTimeoutSeconds = -1);
     bool hasEntry(const QByteArray &key) const;
@@ -38,8 +38,10 @@
 #include "qhttpmultipart.h"
 #include "qhttpmultipart_p.h"
 #include "qnetworkreplyhttpimpl_p.h"
+#include "qhttpthreaddelegate_p.h"
 #endif
 
+#include "qmutex.h"
 #include "qthread.h"
 
 #include <QHostInfo>
@@ -79,6 +81,96 @@ Q_GLOBAL_STATIC(QNetworkAccessDebugPipeBackendFactory, debugpipeBackend)
 
 Q_APPLICATION_STATIC(QFactoryLoader, qnabfLoader, QNetworkAccessBackendFactory_iid, "/networkaccess"_L1)
 
+namespace {
+// The threads that all QNetworkAccessManager objects share if the
+// QT_NETWORK_SHARED_HTTP_THREADS environment variable is set to their
+// number. The managers are assigned to the threads in turn, and the
+// managers assigned to one thread share the connections cached in it.
+// Requests that may use HTTP/2 are instead sent from the thread picked by
+// their origin, so that all managers multiplex them over the same session.
+class QNetworkAccessSharedThreads
+{
+public:
+    QNetworkAccessSharedThreads()
+        : threads(qBound(1, qEnvironmentVariableIntValue("QT_NETWORK_SHARED_HTTP_THREADS"), 64))
+    {
+    }
+
+    ~QNetworkAccessSharedThreads()
+    {
+        for (const Thread &t : threads) {
+            if (!t.thread)
+                continue;
+            t.thread->quit();
+            t.thread->wait(QDeadlineTimer(5000));
+            if (t.thread->isFinished()) {
+                delete t.context;
+                delete t.thread;
+            } else {
+                QObject::connect(t.thread, &QThread::finished, t.context, &QObject::deleteLater);
+                QObject::connect(t.thread, &QThread::finished, t.thread, &QObject::deleteLater);
+            }
+        }
+    }
+
+    QThread *nextThread()
+    {
+        QMutexLocker locker(&mutex);
+        return thread(next++ % threads.size());
+    }
+
+    QThread *threadForOrigin(const QUrl &url)
+    {
+        const size_t hash = qHashMulti(0, url.scheme(), url.host(), url.port());
+        QMutexLocker locker(&mutex);
+        return thread(hash % threads.size());
+    }
+
+    void clearConnectionCache()
+    {
+#if QT_CONFIG(http)
+        QMutexLocker locker(&mutex);
+        for (const Thread &t : threads) {
+            if (!t.thread)
+                continue;
+            // other managers may be using some of the connections
+            if (t.thread == QThread::currentThread()) {
+                QHttpThreadDelegate::clearUnusedConnections();
+            } else {
+                QMetaObject::invokeMethod(t.context, &QHttpThreadDelegate::clearUnusedConnections,
+                                          Qt::BlockingQueuedConnection);
+            }
+        }
+#endif
+    }
+
+private:
+    // must be called with the mutex locked
+    QThread *thread(size_t index)
+    {
+        Thread &t = threads[index];
+        if (!t.thread) {
+            t.thread = new QThread;
+            t.thread->setObjectName(QStringLiteral("QNetworkAccessManager shared thread %1").arg(index));
+            t.context = new QObject;
+            t.context->moveToThread(t.thread);
+            t.thread->start();
+        }
+        return t.thread;
+    }
+
+    struct Thread {
+        QThread *thread = nullptr;
+        QObject *context = nullptr;     // lives in 'thread'
+    };
+    QMutex mutex;
+    std::vector<Thread> threads;
+    size_t next = 0;
+};
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QNetworkAccessSharedThreads, sharedThreads)
+
 #if defined(Q_OS_MACOS)
 bool getProxyAuth(const QString& proxyHostname, const QString &scheme, QString& username, QString& password)
 {
@@ -180,6 +272,17 @@ static void ensureInitialized()
     QNetworkAccessManager is based on QObject, it can only be used from the
     thread it belongs to.
 
+    By default, every QNetworkAccessManager uses its own thread for HTTP
+    connections. If the \c QT_NETWORK_SHARED_HTTP_THREADS environment variable
+    is set to a number, the managers created afterwards share that many
+    threads instead, as well as the connections cached in them. This saves
+    resources in applications that use many managers. A cached connection is
+    only reused for requests with the same credentials and SSL configuration,
+    and not by other managers once SSL errors were ignored on it. Requests
+    that may use HTTP/2 are sent from the shared thread assigned to their
+    origin (scheme, host and port), so that managers talking to the same
+    server multiplex their requests over one HTTP/2 connection.
+
     Once a QNetworkAccessManager object has been created, the application can
     use it to send requests over the network. A group of standard functions
     are supplied that take a request and optional data, and each return a
@@ -1611,6 +1714,8 @@ void QNetworkAccessManagerPrivate::clearConnectionCache(QNetworkAccessManager *m
 {
     manager->d_func()->objectCache.clear();
     manager->d_func()->destroyThread();
+    if (manager->d_func()->useSharedThreads && sharedThreads.exists())
+        sharedThreads->clearConnectionCache();
 }
 
 QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
@@ -1620,6 +1725,14 @@ QNetworkAccessManagerPrivate::~QNetworkAccessManagerPrivate()
 
 QThread * QNetworkAccessManagerPrivate::createThread()
 {
+    if (!sharedThreadsChecked) {
+        sharedThreadsChecked = true;
+        useSharedThreads = qEnvironmentVariableIntValue("QT_NETWORK_SHARED_HTTP_THREADS") > 0;
+    }
+    if (!thread && useSharedThreads) {
+        if (QNetworkAccessSharedThreads *threads = sharedThreads())
+            thread = threads->nextThread();
+    }
     if (!thread) {
         thread = new QThread;
         thread->setObjectName(QStringLiteral("QNetworkAccessManager thread"));
@@ -1629,9 +1742,22 @@ QThread * QNetworkAccessManagerPrivate::createThread()
     return thread;
 }
 
+QThread *QNetworkAccessManagerPrivate::createThread(const QUrl &origin)
+{
+    createThread();
+    if (useSharedThreads) {
+        if (QNetworkAccessSharedThreads *threads = sharedThreads())
+            return threads->threadForOrigin(origin);
+    }
+    return thread;
+}
+
 void QNetworkAccessManagerPrivate::destroyThread()
 {
-    if (thread) {
+    if (thread && useSharedThreads) {
+        // the thread is shared with other managers
+        thread = nullptr;
+    } else if (thread) {
         thread->quit();
         thread->wait(QDeadlineTimer(5000));
         if (thread->isFinished())
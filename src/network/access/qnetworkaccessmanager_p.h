@@ -56,6 +56,7 @@ public:
     ~QNetworkAccessManagerPrivate();
 
     QThread * createThread();
+    QThread *createThread(const QUrl &origin);
     void destroyThread();
 
     void _q_replyFinished(QNetworkReply *reply);
@@ -102,6 +103,9 @@ public:
     QNetworkCookieJar *cookieJar;
 
     QThread *thread;
+    // whether to use the threads shared by all managers instead of 'thread'
+    bool sharedThreadsChecked = false;
+    bool useSharedThreads = false;
 
 
 #ifndef QT_NO_NETWORKPROXY
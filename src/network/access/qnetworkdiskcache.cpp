@@ -13,16 +13,23 @@
 #include <qdatastream.h>
 #include <qdatetime.h>
 #include <qdiriterator.h>
+#include <qendian.h>
+#include <qset.h>
 #include <qurl.h>
 #include <qcryptographichash.h>
 #include <qdebug.h>
-#include <QMultiMap>
+#if QT_CONFIG(thread)
+#include <qthread.h>
+#endif
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #define CACHE_POSTFIX ".d"_L1
 #define CACHE_VERSION 8
 #define DATA_DIR "data"_L1
+#define INDEX_FILE "index"_L1
 
 #define MAX_COMPRESSION_SIZE (1024 * 1024 * 3)
 
@@ -48,6 +55,13 @@ using namespace Qt::StringLiterals;
     QNetworkDiskCache by default limits the amount of space that the cache will
     use on the system to 50MB.
 
+    The cache keeps an index of its files, with their sizes and the time they
+    were last used, in a journal file inside the cacheDirectory. This lets
+    it find out whether an url is cached, and which files to remove when the
+    cache is full, without looking at the files themselves. The journal is
+    written by a background thread, which also adds cache files that are
+    missing from it to the index after the cache directory is set.
+
     Note you have to set the cache directory before it will work.
 
     A network disk cache can be enabled by:
@@ -83,6 +97,11 @@ QNetworkDiskCache::~QNetworkDiskCache()
     qDeleteAll(d->inserting);
 }
 
+QNetworkDiskCachePrivate::~QNetworkDiskCachePrivate()
+{
+    stopJournal();
+}
+
 /*!
     Returns the location where cached files will be stored.
 */
@@ -110,6 +129,7 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
     Q_D(QNetworkDiskCache);
     if (cacheDir.isEmpty())
         return;
+    const QString oldCacheDirectory = d->cacheDirectory;
     d->cacheDirectory = cacheDir;
     QDir dir(d->cacheDirectory);
     d->cacheDirectory = dir.absolutePath();
@@ -118,6 +138,10 @@ void QNetworkDiskCache::setCacheDirectory(const QString &cacheDir)
 
     d->dataDirectory = d->cacheDirectory + DATA_DIR + QString::number(CACHE_VERSION) + u'/';
     d->prepareLayout();
+    if (d->cacheDirectory != oldCacheDirectory) {
+        d->currentCacheSize = -1;
+        d->startJournal();
+    }
 }
 
 /*!
@@ -131,6 +155,10 @@ qint64 QNetworkDiskCache::cacheSize() const
     Q_D(const QNetworkDiskCache);
     if (d->cacheDirectory.isEmpty())
         return 0;
+    if (d->currentCacheSize >= 0) {
+        // picks up the cache files the journal found after loading the index
+        const_cast<QNetworkDiskCachePrivate *>(d)->cacheIndex();
+    }
     if (d->currentCacheSize < 0) {
         QNetworkDiskCache *that = const_cast<QNetworkDiskCache*>(this);
         that->d_func()->currentCacheSize = that->expire();
@@ -260,8 +288,11 @@ void QNetworkDiskCachePrivate::storeItem(QCacheItem *cacheItem)
         // commit() invalidates the file-engine, and size() will create a new
         // one, pointing at an empty filename.
         qint64 size = cacheItem->file->size();
-        if (cacheItem->file->commit())
-            currentCacheSize += size;
+        if (cacheItem->file->commit()) {
+            if (currentCacheSize >= 0)
+                currentCacheSize += size;
+            indexFile(fileName, size);
+        }
         // Delete and unset the QSaveFile, it's invalid now.
         delete std::exchange(cacheItem->file, nullptr);
     }
@@ -310,12 +341,131 @@ bool QNetworkDiskCachePrivate::removeFile(const QString &file)
         return false;
     qint64 size = info.size();
     if (QFile::remove(file)) {
-        currentCacheSize -= size;
+        if (currentCacheSize >= 0)
+            currentCacheSize -= size;
+        unindexFile(file);
         return true;
     }
+    if (!info.exists())
+        unindexFile(file);
     return false;
 }
 
+/*!
+    Starts reading the index of the cache directory on the journal's
+    thread. The index is waited for when it is first needed.
+ */
+void QNetworkDiskCachePrivate::startJournal()
+{
+    stopJournal();
+    index.clear();
+    indexLoaded = false;
+    journal = new QNetworkDiskCacheJournal(cacheDirectory, dataDirectory + INDEX_FILE);
+#if QT_CONFIG(thread)
+    journalThread = new QThread;
+    journalThread->setObjectName("QNetworkDiskCache"_L1);
+    journal->moveToThread(journalThread);
+    journalThread->start(QThread::LowPriority);
+    QMetaObject::invokeMethod(journal, [journal = journal] { journal->load(); },
+                              Qt::QueuedConnection);
+#else
+    journal->load();
+#endif
+}
+
+void QNetworkDiskCachePrivate::stopJournal()
+{
+    if (!journal)
+        return;
+#if QT_CONFIG(thread)
+    // runs after the records that are already queued have been written
+    QMetaObject::invokeMethod(journal, [journal = journal] {
+        journal->writePendingRecords();
+        QThread::currentThread()->quit();
+    }, Qt::QueuedConnection);
+    journalThread->wait();
+    delete std::exchange(journalThread, nullptr);
+#endif
+    delete std::exchange(journal, nullptr);
+}
+
+QNetworkDiskCacheIndex &QNetworkDiskCachePrivate::cacheIndex()
+{
+    if (!journal)
+        return index;
+    if (!indexLoaded) {
+        index = journal->waitForIndex();
+        indexLoaded = true;
+    }
+    QNetworkDiskCacheIndex::Changes changes;
+    if (journal->takeReconciledChanges(&changes)) {
+        index.apply(changes);
+        if (currentCacheSize >= 0)
+            currentCacheSize = index.totalSize();
+    }
+    return index;
+}
+
+/*!
+    Returns the name of the cache file \a fileName in the index, or an empty
+    string if it is not inside the cache directory.
+ */
+QString QNetworkDiskCachePrivate::indexFileName(const QString &fileName) const
+{
+    if (cacheDirectory.isEmpty() || !fileName.startsWith(cacheDirectory))
+        return QString();
+    return fileName.mid(cacheDirectory.size());
+}
+
+bool QNetworkDiskCachePrivate::isIndexed(const QString &fileName)
+{
+    const QString name = indexFileName(fileName);
+    return !name.isEmpty() && cacheIndex().find(name);
+}
+
+void QNetworkDiskCachePrivate::touchFile(const QString &fileName)
+{
+    const QString name = indexFileName(fileName);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (!name.isEmpty() && cacheIndex().touch(name, now))
+        writeRecord(QNetworkDiskCacheIndex::TouchRecord, name, 0, now);
+}
+
+void QNetworkDiskCachePrivate::indexFile(const QString &fileName, qint64 size)
+{
+    const QString name = indexFileName(fileName);
+    if (name.isEmpty())
+        return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    cacheIndex().insert(name, size, now);
+    writeRecord(QNetworkDiskCacheIndex::InsertRecord, name, size, now);
+}
+
+void QNetworkDiskCachePrivate::unindexFile(const QString &fileName)
+{
+    const QString name = indexFileName(fileName);
+    if (!name.isEmpty() && cacheIndex().remove(name))
+        writeRecord(QNetworkDiskCacheIndex::RemoveRecord, name);
+}
+
+void QNetworkDiskCachePrivate::writeRecord(QNetworkDiskCacheIndex::RecordType type,
+                                           const QString &indexName, qint64 size,
+                                           qint64 lastAccess)
+{
+    if (!journal)
+        return;
+    QByteArray record;
+    QNetworkDiskCacheIndex::appendRecord(&record, type, indexName, size, lastAccess);
+    if (!journal->addRecords(record))
+        return; // a write is already scheduled
+#if QT_CONFIG(thread)
+    QMetaObject::invokeMethod(journal, [journal = journal] { journal->scheduleWrite(); },
+                              Qt::QueuedConnection);
+#else
+    journal->writePendingRecords();
+#endif
+}
+
 /*!
     \reimp
 */
@@ -327,7 +477,15 @@ QNetworkCacheMetaData QNetworkDiskCache::metaData(const QUrl &url)
     Q_D(QNetworkDiskCache);
     if (d->lastItem.metaData.url() == url)
         return d->lastItem.metaData;
-    return fileMetaData(d->cacheFileName(url));
+    const QString fileName = d->cacheFileName(url);
+    if (!d->isIndexed(fileName))
+        return QNetworkCacheMetaData();
+    QNetworkCacheMetaData metaData = fileMetaData(fileName);
+    if (metaData.isValid())
+        d->touchFile(fileName);
+    else
+        d->unindexFile(fileName);
+    return metaData;
 }
 
 /*!
@@ -368,9 +526,14 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
         buffer.reset(new QBuffer);
         buffer->setData(d->lastItem.data.data());
     } else {
-        QScopedPointer<QFile> file(new QFile(d->cacheFileName(url)));
-        if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered))
+        const QString fileName = d->cacheFileName(url);
+        if (!d->isIndexed(fileName))
+            return nullptr;
+        QScopedPointer<QFile> file(new QFile(fileName));
+        if (!file->open(QFile::ReadOnly | QIODevice::Unbuffered)) {
+            d->unindexFile(fileName);
             return nullptr;
+        }
 
         if (!d->lastItem.read(file.data(), true)) {
             file->close();
@@ -385,6 +548,7 @@ QIODevice *QNetworkDiskCache::data(const QUrl &url)
             buffer.reset(new QBuffer);
             buffer->setData(file->readAll());
         }
+        d->touchFile(fileName);
     }
     buffer->open(QBuffer::ReadOnly);
     return buffer.release();
@@ -456,8 +620,9 @@ void QNetworkDiskCache::setMaximumCacheSize(qint64 size)
 
     When the current size of the cache is greater than the maximumCacheSize()
     older cache files are removed until the total size is less then 90% of
-    maximumCacheSize() starting with the oldest ones first using the file
-    creation date to determine how old a cache file is.
+    maximumCacheSize() starting with the least recently used ones first. The
+    cache files are found in the index of the cache, which records when each
+    of them was last used.
 
     Subclasses can reimplement this function to change the order that cache
     files are removed taking into account information in the application
@@ -482,46 +647,23 @@ qint64 QNetworkDiskCache::expire()
     // close file handle to prevent "in use" error when QFile::remove() is called
     d->lastItem.reset();
 
-    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
-    QDirIterator it(cacheDirectory(), filters, QDirIterator::Subdirectories);
-
-    QMultiMap<QDateTime, QString> cacheItems;
-    qint64 totalSize = 0;
-    while (it.hasNext()) {
-        QFileInfo info = it.nextFileInfo();
-        QString path = info.filePath();
-        QString fileName = info.fileName();
-        if (fileName.endsWith(CACHE_POSTFIX)) {
-            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
-            cacheItems.insert(birthTime.isValid() ? birthTime
-                              : info.fileTime(QFile::FileMetadataChangeTime), path);
-            totalSize += info.size();
-        }
-    }
-
+    QNetworkDiskCacheIndex &index = d->cacheIndex();
     [[maybe_unused]] int removedFiles = 0; // used under QNETWORKDISKCACHE_DEBUG
     qint64 goal = (maximumCacheSize() * 9) / 10;
-    QMultiMap<QDateTime, QString>::const_iterator i = cacheItems.constBegin();
-    while (i != cacheItems.constEnd()) {
-        if (totalSize < goal)
-            break;
-        QString name = i.value();
-        QFile file(name);
-
-        qint64 size = file.size();
-        file.remove();
-        totalSize -= size;
+    while (!index.isEmpty() && index.totalSize() >= goal) {
+        const QString fileName = cacheDirectory() + index.leastRecentlyUsed().fileName;
+        QFile::remove(fileName);
+        d->unindexFile(fileName);
         ++removedFiles;
-        ++i;
     }
 #if defined(QNETWORKDISKCACHE_DEBUG)
     if (removedFiles > 0) {
         qDebug() << "QNetworkDiskCache::expire()"
                 << "Removed:" << removedFiles
-                << "Kept:" << cacheItems.count() - removedFiles;
+                << "Kept:" << index.count();
     }
 #endif
-    return totalSize;
+    return index.totalSize();
 }
 
 /*!
@@ -673,6 +815,374 @@ bool QCacheItem::read(QFileDevice *device, bool readData)
     return metaData.isValid() && !metaData.rawHeaders().isEmpty();
 }
 
+QNetworkDiskCacheIndex &QNetworkDiskCacheIndex::operator=(const QNetworkDiskCacheIndex &other)
+{
+    if (this != &other) {
+        clear();
+        for (const Entry &entry : other.entries)
+            insert(entry.fileName, entry.size, entry.lastAccess);
+    }
+    return *this;
+}
+
+const QNetworkDiskCacheIndex::Entry *QNetworkDiskCacheIndex::find(const QString &fileName) const
+{
+    const auto it = lookup.constFind(fileName);
+    return it == lookup.cend() ? nullptr : &*it.value();
+}
+
+void QNetworkDiskCacheIndex::insert(const QString &fileName, qint64 size, qint64 lastAccess)
+{
+    remove(fileName);
+    entries.push_back({ fileName, size, lastAccess });
+    lookup.insert(fileName, std::prev(entries.end()));
+    total += size;
+}
+
+/*!
+    Marks the file \a fileName as the most recently used one. Returns \c false
+    if it is not in the index or already was the most recently used one.
+ */
+bool QNetworkDiskCacheIndex::touch(const QString &fileName, qint64 lastAccess)
+{
+    const auto it = lookup.constFind(fileName);
+    if (it == lookup.cend())
+        return false;
+    const auto entry = it.value();
+    entry->lastAccess = lastAccess;
+    if (std::next(entry) == entries.end())
+        return false;
+    entries.splice(entries.end(), entries, entry);
+    return true;
+}
+
+bool QNetworkDiskCacheIndex::remove(const QString &fileName)
+{
+    const auto it = lookup.constFind(fileName);
+    if (it == lookup.cend())
+        return false;
+    total -= it.value()->size;
+    entries.erase(it.value());
+    lookup.erase(it);
+    return true;
+}
+
+/*!
+    Applies \a changes found by looking at the cache files. The untracked
+    files become the least recently used ones, in the order of \a changes,
+    and the missing ones are removed unless they have been used since.
+ */
+void QNetworkDiskCacheIndex::apply(const Changes &changes)
+{
+    for (const Entry &entry : changes.missing) {
+        const Entry *current = find(entry.fileName);
+        if (current && current->size == entry.size && current->lastAccess == entry.lastAccess)
+            remove(entry.fileName);
+    }
+    for (auto it = changes.untracked.crbegin(); it != changes.untracked.crend(); ++it) {
+        if (find(it->fileName))
+            continue;
+        entries.push_front(*it);
+        lookup.insert(it->fileName, entries.begin());
+        total += it->size;
+    }
+}
+
+void QNetworkDiskCacheIndex::clear()
+{
+    entries.clear();
+    lookup.clear();
+    total = 0;
+}
+
+// The journal starts with JournalMagic. Each record in it has a header of
+// RecordHeaderSize bytes: the record type (1 byte), 1 unused byte, the length
+// of the file name (2 bytes), 4 unused bytes, the size of the file (8 bytes)
+// and the time it was last used (8 bytes), in little-endian. The file name
+// follows in UTF-8.
+static constexpr char JournalMagic[] = { 'Q', 'N', 'D', 'C', 'I', 'D', 'X', '1' };
+static constexpr qsizetype RecordHeaderSize = 24;
+
+void QNetworkDiskCacheIndex::appendRecord(QByteArray *journal, RecordType type,
+                                          const QString &fileName, qint64 size,
+                                          qint64 lastAccess)
+{
+    const QByteArray name = fileName.toUtf8();
+    Q_ASSERT(name.size() <= 0xffff);
+    const qsizetype offset = journal->size();
+    journal->resize(offset + RecordHeaderSize + name.size());
+    char *record = journal->data() + offset;
+    memset(record, 0, RecordHeaderSize);
+    record[0] = char(type);
+    qToLittleEndian<quint16>(quint16(name.size()), record + 2);
+    qToLittleEndian<qint64>(size, record + 8);
+    qToLittleEndian<qint64>(lastAccess, record + 16);
+    memcpy(record + RecordHeaderSize, name.constData(), name.size());
+}
+
+/*!
+    Applies the journal records in \a data to the index and adds their number
+    to \a records. Returns the number of bytes used, which is less than \a size
+    if the records end with an incomplete or invalid one.
+ */
+qsizetype QNetworkDiskCacheIndex::replay(const char *data, qsizetype size, qsizetype *records)
+{
+    qsizetype offset = 0;
+    while (size - offset >= RecordHeaderSize) {
+        const char *record = data + offset;
+        const qsizetype nameSize = qFromLittleEndian<quint16>(record + 2);
+        if (size - offset - RecordHeaderSize < nameSize)
+            break;
+        const QString fileName = QString::fromUtf8(record + RecordHeaderSize, nameSize);
+        switch (record[0]) {
+        case InsertRecord:
+            insert(fileName, qFromLittleEndian<qint64>(record + 8),
+                   qFromLittleEndian<qint64>(record + 16));
+            break;
+        case TouchRecord:
+            touch(fileName, qFromLittleEndian<qint64>(record + 16));
+            break;
+        case RemoveRecord:
+            remove(fileName);
+            break;
+        default:
+            return offset;
+        }
+        offset += RecordHeaderSize + nameSize;
+        if (records)
+            ++*records;
+    }
+    return offset;
+}
+
+/*!
+    Returns the records that recreate the index, least recently used first.
+ */
+QByteArray QNetworkDiskCacheIndex::snapshot() const
+{
+    QByteArray journal;
+    for (const Entry &entry : entries)
+        appendRecord(&journal, InsertRecord, entry.fileName, entry.size, entry.lastAccess);
+    return journal;
+}
+
+QNetworkDiskCacheJournal::QNetworkDiskCacheJournal(const QString &cacheDirectory,
+                                                   const QString &journalFileName)
+    : cacheDirectory(cacheDirectory), file(journalFileName)
+{
+}
+
+/*!
+    Reads the index from the journal file, or from the cache files if there
+    is no valid journal, and hands it over to waitForIndex().
+ */
+void QNetworkDiskCacheJournal::load()
+{
+    bool valid = false;
+    qint64 used = 0;
+    qint64 size = 0;
+    if (file.open(QIODevice::ReadWrite)) {
+        size = file.size();
+        QByteArray contents;
+        const char *data = reinterpret_cast<const char *>(file.map(0, size));
+        if (!data && size) {
+            contents = file.readAll();
+            data = contents.constData();
+        }
+        if (size >= qint64(sizeof(JournalMagic))
+            && memcmp(data, JournalMagic, sizeof(JournalMagic)) == 0) {
+            valid = true;
+            used = sizeof(JournalMagic)
+                    + index.replay(data + sizeof(JournalMagic), size - sizeof(JournalMagic),
+                                   &recordCount);
+        }
+        if (contents.isNull() && data)
+            file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(data)));
+    }
+
+    if (!valid)
+        rebuild();
+    if (!valid || used < size || recordCount > 2 * index.count() + 1024)
+        compact();
+    else
+        file.seek(size);
+
+    {
+        QMutexLocker locker(&mutex);
+        loadedIndex = std::make_unique<QNetworkDiskCacheIndex>(index);
+        loaded = true;
+        indexLoaded.wakeAll();
+    }
+
+    // a rebuilt index already has all the files
+    if (valid)
+        reconcile();
+}
+
+/*!
+    Returns the cache files in the cache directory, oldest first.
+ */
+std::vector<QNetworkDiskCacheJournal::File> QNetworkDiskCacheJournal::cacheFiles() const
+{
+    std::vector<File> files;
+    QDir::Filters filters = QDir::AllDirs | QDir:: Files | QDir::NoDotAndDotDot;
+    QDirIterator it(cacheDirectory, filters, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFileInfo info = it.nextFileInfo();
+        QString path = info.filePath();
+        if (info.fileName().endsWith(CACHE_POSTFIX) && path.startsWith(cacheDirectory)) {
+            const QDateTime birthTime = info.fileTime(QFile::FileBirthTime);
+            files.push_back({ birthTime.isValid() ? birthTime
+                                                  : info.fileTime(QFile::FileMetadataChangeTime),
+                              path.mid(cacheDirectory.size()), info.size() });
+        }
+    }
+    std::stable_sort(files.begin(), files.end(), [](const File &a, const File &b) {
+        return a.time < b.time;
+    });
+    return files;
+}
+
+/*!
+    Builds the index from the cache files, e.g. for a cache written by an
+    older version of Qt. The oldest files are treated as least recently used.
+ */
+void QNetworkDiskCacheJournal::rebuild()
+{
+    index.clear();
+    recordCount = 0;
+    for (const File &f : cacheFiles())
+        index.insert(f.name, f.size, f.time.toMSecsSinceEpoch());
+}
+
+/*!
+    Brings the index read from the journal in line with the cache files,
+    which another cache object or process may have written or removed
+    without recording it. This runs after the index has been handed over,
+    so that it doesn't hold up the first lookup; the cache picks up the
+    changes with takeReconciledChanges().
+ */
+void QNetworkDiskCacheJournal::reconcile()
+{
+    const std::vector<File> files = cacheFiles();
+    QSet<QString> names;
+    names.reserve(qsizetype(files.size()));
+    QNetworkDiskCacheIndex::Changes changes;
+    for (const File &f : files) {
+        names.insert(f.name);
+        if (!index.find(f.name))
+            changes.untracked.push_back({ f.name, f.size, f.time.toMSecsSinceEpoch() });
+    }
+    index.forEach([&](const QNetworkDiskCacheIndex::Entry &entry) {
+        if (!names.contains(entry.fileName))
+            changes.missing.push_back(entry);
+    });
+    if (changes.untracked.empty() && changes.missing.empty())
+        return;
+
+    index.apply(changes);
+    compact();
+
+    QMutexLocker locker(&mutex);
+    reconciledChanges = std::make_unique<QNetworkDiskCacheIndex::Changes>(std::move(changes));
+    hasReconciledChanges.storeRelease(true);
+}
+
+/*!
+    Replaces the journal file by one that only contains the current index.
+ */
+void QNetworkDiskCacheJournal::compact()
+{
+    file.close();
+    QSaveFile out(file.fileName());
+    if (out.open(QIODevice::WriteOnly)) {
+        out.write(JournalMagic, sizeof(JournalMagic));
+        out.write(index.snapshot());
+        out.commit();
+    }
+    recordCount = index.count();
+    file.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+/*!
+    Writes the pending records a little later, so that records added in
+    quick succession are written together.
+ */
+void QNetworkDiskCacheJournal::scheduleWrite()
+{
+    if (!writeTimer.isActive())
+        writeTimer.start(100, this);
+}
+
+void QNetworkDiskCacheJournal::timerEvent(QTimerEvent *event)
+{
+    if (event->timerId() == writeTimer.timerId())
+        writePendingRecords();
+    else
+        QObject::timerEvent(event);
+}
+
+void QNetworkDiskCacheJournal::writePendingRecords()
+{
+    writeTimer.stop();
+    QByteArray records;
+    {
+        QMutexLocker locker(&mutex);
+        records.swap(pendingRecords);
+    }
+    if (records.isEmpty())
+        return;
+
+    index.replay(records.constData(), records.size(), &recordCount);
+    if (recordCount > 2 * index.count() + 1024) {
+        compact();
+    } else if (file.isOpen()) {
+        file.write(records);
+        file.flush();
+    }
+}
+
+/*!
+    Waits until load() has finished and returns the index it read.
+ */
+QNetworkDiskCacheIndex QNetworkDiskCacheJournal::waitForIndex()
+{
+    QMutexLocker locker(&mutex);
+    while (!loaded)
+        indexLoaded.wait(&mutex);
+    Q_ASSERT(loadedIndex);
+    QNetworkDiskCacheIndex result = std::move(*loadedIndex);
+    loadedIndex.reset();
+    return result;
+}
+
+/*!
+    Moves the changes that reconcile() made to the index to \a changes.
+    Returns \c false if there are none (yet).
+ */
+bool QNetworkDiskCacheJournal::takeReconciledChanges(QNetworkDiskCacheIndex::Changes *changes)
+{
+    if (!hasReconciledChanges.loadAcquire())
+        return false;
+    QMutexLocker locker(&mutex);
+    *changes = std::move(*reconciledChanges);
+    reconciledChanges.reset();
+    hasReconciledChanges.storeRelaxed(false);
+    return true;
+}
+
+/*!
+    Queues \a records for writing. Returns \c true if writePendingRecords()
+    needs to be called for them.
+ */
+bool QNetworkDiskCacheJournal::addRecords(const QByteArray &records)
+{
+    QMutexLocker locker(&mutex);
+    const bool wasEmpty = pendingRecords.isEmpty();
+    pendingRecords += records;
+    return wasEmpty;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qnetworkdiskcache.cpp"
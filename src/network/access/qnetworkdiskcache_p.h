@@ -18,9 +18,18 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include "private/qabstractnetworkcache_p.h"
 
+#include <qbasictimer.h>
 #include <qbuffer.h>
+#include <qdatetime.h>
+#include <qfile.h>
 #include <qhash.h>
+#include <qmutex.h>
 #include <qsavefile.h>
+#include <qwaitcondition.h>
+
+#include <list>
+#include <memory>
+#include <vector>
 
 QT_REQUIRE_CONFIG(networkdiskcache);
 
@@ -54,6 +63,112 @@ public:
     bool canCompress() const;
 };
 
+class QNetworkDiskCacheIndex
+{
+public:
+    struct Entry
+    {
+        QString fileName;   // relative to the cache directory
+        qint64 size;
+        qint64 lastAccess;  // msecs since epoch
+    };
+
+    // the cache files that are missing from the index, oldest first, and
+    // the files in the index that are gone
+    struct Changes
+    {
+        std::vector<Entry> untracked;
+        std::vector<Entry> missing;
+    };
+
+    enum RecordType : quint8 {
+        InsertRecord = 1,
+        TouchRecord,
+        RemoveRecord
+    };
+
+    QNetworkDiskCacheIndex() = default;
+    QNetworkDiskCacheIndex(const QNetworkDiskCacheIndex &other) { *this = other; }
+    QNetworkDiskCacheIndex &operator=(const QNetworkDiskCacheIndex &other);
+    QNetworkDiskCacheIndex(QNetworkDiskCacheIndex &&other) noexcept = default;
+    QNetworkDiskCacheIndex &operator=(QNetworkDiskCacheIndex &&other) noexcept = default;
+
+    bool isEmpty() const { return entries.empty(); }
+    qsizetype count() const { return lookup.size(); }
+    qint64 totalSize() const { return total; }
+    const Entry *find(const QString &fileName) const;
+    const Entry &leastRecentlyUsed() const { return entries.front(); }
+    template <typename Function>
+    void forEach(Function f) const
+    {
+        for (const Entry &entry : entries)
+            f(entry);
+    }
+
+    void insert(const QString &fileName, qint64 size, qint64 lastAccess);
+    bool touch(const QString &fileName, qint64 lastAccess);
+    bool remove(const QString &fileName);
+    void apply(const Changes &changes);
+    void clear();
+
+    static void appendRecord(QByteArray *journal, RecordType type, const QString &fileName,
+                             qint64 size = 0, qint64 lastAccess = 0);
+    qsizetype replay(const char *data, qsizetype size, qsizetype *records = nullptr);
+    QByteArray snapshot() const;
+
+private:
+    std::list<Entry> entries;   // least recently used first
+    QHash<QString, std::list<Entry>::iterator> lookup;
+    qint64 total = 0;
+};
+
+// Owns the index journal of a cache directory. All of its file I/O runs on
+// the cache's I/O thread, which keeps a copy of the index to compact it.
+class QNetworkDiskCacheJournal : public QObject
+{
+public:
+    QNetworkDiskCacheJournal(const QString &cacheDirectory, const QString &journalFileName);
+
+    // called on the I/O thread
+    void load();
+    void scheduleWrite();
+    void writePendingRecords();
+
+    // called on the cache's thread
+    QNetworkDiskCacheIndex waitForIndex();
+    bool addRecords(const QByteArray &records);
+    bool takeReconciledChanges(QNetworkDiskCacheIndex::Changes *changes);
+
+protected:
+    void timerEvent(QTimerEvent *event) override;
+
+private:
+    struct File
+    {
+        QDateTime time;
+        QString name;
+        qint64 size;
+    };
+    std::vector<File> cacheFiles() const;
+    void rebuild();
+    void reconcile();
+    void compact();
+
+    QString cacheDirectory;
+    QFile file;
+    QBasicTimer writeTimer;
+    QNetworkDiskCacheIndex index;
+    qsizetype recordCount = 0;
+
+    QMutex mutex;
+    QWaitCondition indexLoaded;
+    std::unique_ptr<QNetworkDiskCacheIndex> loadedIndex;
+    bool loaded = false;
+    QByteArray pendingRecords;
+    std::unique_ptr<QNetworkDiskCacheIndex::Changes> reconciledChanges;
+    QAtomicInteger<bool> hasReconciledChanges = false;
+};
+
 class QNetworkDiskCachePrivate : public QAbstractNetworkCachePrivate
 {
 public:
@@ -62,6 +177,7 @@ public:
         , maximumCacheSize(1024 * 1024 * 50)
         , currentCacheSize(-1)
         {}
+    ~QNetworkDiskCachePrivate();
 
     static QString uniqueFileName(const QUrl &url);
     QString cacheFileName(const QUrl &url) const;
@@ -70,6 +186,17 @@ public:
     void prepareLayout();
     static quint32 crc32(const char *data, uint len);
 
+    void startJournal();
+    void stopJournal();
+    QNetworkDiskCacheIndex &cacheIndex();
+    QString indexFileName(const QString &fileName) const;
+    bool isIndexed(const QString &fileName);
+    void touchFile(const QString &fileName);
+    void indexFile(const QString &fileName, qint64 size);
+    void unindexFile(const QString &fileName);
+    void writeRecord(QNetworkDiskCacheIndex::RecordType type, const QString &indexName,
+                     qint64 size = 0, qint64 lastAccess = 0);
+
     mutable QCacheItem lastItem;
     QString cacheDirectory;
     QString dataDirectory;
@@ -77,6 +204,13 @@ public:
     qint64 currentCacheSize;
 
     QHash<QIODevice*, QCacheItem*> inserting;
+
+    QNetworkDiskCacheIndex index;
+    bool indexLoaded = false;
+    QNetworkDiskCacheJournal *journal = nullptr;
+#if QT_CONFIG(thread)
+    QThread *journalThread = nullptr;
+#endif
     Q_DECLARE_PUBLIC(QNetworkDiskCache)
 };
 
@@ -514,6 +514,30 @@ void QNetworkReply::setReadBufferSize(qint64 size)
     d->readBufferMaxSize = size;
 }
 
+/*!
+    \since 6.6
+
+    Reads the next chunk of the downloaded data and returns it. Returns an
+    empty QByteArray if no data is available for reading.
+
+    The chunks are the blocks in which the data was received from the
+    network. Unlike read() and readAll(), this function returns them without
+    copying their contents, so it can save a copy of every byte of a large
+    download. The data received by HTTP is copied only once on its way from
+    the socket to the returned chunk. The size of the chunks depends on how
+    the data arrives.
+
+    \sa read(), bytesAvailable()
+*/
+QByteArray QNetworkReply::readNextChunk()
+{
+    Q_D(QNetworkReply);
+    if (const qint64 size = d->buffer.nextDataBlockSize())
+        return read(size);
+    // the data is not buffered by QIODevice, e.g. when it is decompressed
+    return read(bytesAvailable());
+}
+
 /*!
     Returns the QNetworkAccessManager that was used to create this
     QNetworkReply object. Initially, it is also the parent object.
@@ -84,6 +84,7 @@ public:
     // like QAbstractSocket:
     qint64 readBufferSize() const;
     virtual void setReadBufferSize(qint64 size);
+    QByteArray readNextChunk();
 
     QNetworkAccessManager *manager() const;
     QNetworkAccessManager::Operation operation() const;
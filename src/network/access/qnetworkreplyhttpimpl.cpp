@@ -615,6 +615,20 @@ QHttpNetworkRequest::Priority QNetworkReplyHttpImplPrivate::convert(const QNetwo
     }
 }
 
+static bool mayUseHttp2(const QNetworkRequest &request)
+{
+    if (request.attribute(QNetworkRequest::Http2DirectAttribute).toBool())
+        return true;
+    if (!request.attribute(QNetworkRequest::Http2AllowedAttribute, true).toBool())
+        return false;
+    const QString scheme = request.url().scheme();
+    if (scheme == "https"_L1 || scheme == "preconnect-https"_L1)
+        return true;
+    const QVariant h2cAttribute = request.attribute(QNetworkRequest::Http2CleartextAllowedAttribute);
+    return h2cAttribute.toBool()
+            || (!h2cAttribute.isValid() && qEnvironmentVariableIsSet("QT_NETWORK_H2C_ALLOWED"));
+}
+
 void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpRequest)
 {
     Q_Q(QNetworkReplyHttpImpl);
@@ -629,7 +643,12 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     } else {
         // We use the manager-global thread.
         // At some point we could switch to having multiple threads if it makes sense.
-        thread = managerPrivate->createThread();
+        // If the manager shares its threads, a request that may use HTTP/2 goes to
+        // the thread of its origin, where the HTTP/2 session to it is cached.
+        if (mayUseHttp2(newHttpRequest))
+            thread = managerPrivate->createThread(newHttpRequest.url());
+        else
+            thread = managerPrivate->createThread();
     }
 
     QUrl url = newHttpRequest.url();
@@ -832,6 +851,7 @@ void QNetworkReplyHttpImplPrivate::postRequest(const QNetworkRequest &newHttpReq
     // The authentication manager is used to avoid the BlockingQueuedConnection communication
     // from HTTP thread to user thread in some cases.
     delegate->authenticationManager = managerPrivate->authenticationManager;
+    delegate->sharedThread = managerPrivate->useSharedThreads;
 
     if (!synchronous) {
         // Tell our zerocopy policy to the delegate
@@ -1278,7 +1298,7 @@ void QNetworkReplyHttpImplPrivate::followRedirect()
     rawHeaders.clear();
     cookedHeaders.clear();
 
-    if (managerPrivate->thread)
+    if (managerPrivate->thread && !managerPrivate->useSharedThreads)
         managerPrivate->thread->disconnect();
 
     QMetaObject::invokeMethod(
@@ -38,11 +38,15 @@ class QDnsLookupReply
 {
 public:
     QDnsLookupReply()
-        : error(QDnsLookup::NoError)
+        : error(QDnsLookup::NoError),
+          negativeTimeToLive(-1)
     { }
 
     QDnsLookup::Error error;
     QString errorString;
+    // For answers without records, from the SOA record that came with them
+    // (RFC 2308), else -1.
+    qint64 negativeTimeToLive;
 
     QList<QDnsDomainNameRecord> canonicalNameRecords;
     QList<QDnsHostAddressRecord> hostAddressRecords;
@@ -108,11 +112,19 @@ public:
     { }
     void run() override;
 
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+    static void queryHostAddresses(const QByteArray &requestName, const QHostAddress &nameserver,
+                                   quint16 port, QDnsLookupReply *reply);
+#endif
+
 signals:
     void finished(const QDnsLookupReply &reply);
 
 private:
     static void query(const int requestType, const QByteArray &requestName, const QHostAddress &nameserver, QDnsLookupReply *reply);
+#if defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+    static void parseReply(unsigned char *response, int responseLength, QDnsLookupReply *reply);
+#endif
     QDnsLookup::Type requestType;
     QByteArray requestName;
     QHostAddress nameserver;
@@ -8,8 +8,13 @@
 #endif
 #include <qvarlengtharray.h>
 #include <qscopedpointer.h>
+#include <qscopeguard.h>
+#include <qdeadlinetimer.h>
+#include <qrandom.h>
 #include <qurl.h>
+#include <private/qcore_unix_p.h>
 #include <private/qnativesocketengine_p.h>
+#include <private/qnet_unix_p.h>
 
 #include <sys/types.h>
 #include <netinet/in.h>
@@ -27,6 +32,7 @@
 #  include <dlfcn.h>
 #endif
 
+#include <algorithm>
 #include <cstring>
 
 QT_BEGIN_NAMESPACE
@@ -107,88 +113,63 @@ static bool resolveLibraryInternal()
 }
 Q_GLOBAL_STATIC_WITH_ARGS(bool, resolveLibrary, (resolveLibraryInternal()))
 
-void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestName, const QHostAddress &nameserver, QDnsLookupReply *reply)
+// Returns the time for which the negative answer in the \a response may be
+// cached, which is the lesser of the TTL and the MINIMUM field of the SOA
+// record in its authority section (RFC 2308), or -1 if there is none.
+static qint64 negativeTimeToLive(const unsigned char *response, int responseLength)
 {
-    // Load dn_expand, res_ninit and res_nquery on demand.
-    resolveLibrary();
-
-    // If dn_expand, res_ninit or res_nquery is missing, fail.
-    if (!local_dn_expand || !local_res_nclose || !local_res_ninit || !local_res_nquery) {
-        reply->error = QDnsLookup::ResolverError;
-        reply->errorString = tr("Resolver functions not found");
-        return;
-    }
-
-    // Initialize state.
-    struct __res_state state;
-    std::memset(&state, 0, sizeof(state));
-    if (local_res_ninit(&state) < 0) {
-        reply->error = QDnsLookup::ResolverError;
-        reply->errorString = tr("Resolver initialization failed");
-        return;
+    const unsigned char *end = response + responseLength;
+    const HEADER *header = reinterpret_cast<const HEADER *>(response);
+    const unsigned char *p = response + sizeof(HEADER);
+    char name[PACKETSZ];
+
+    auto skipName = [&] {
+        const int status = local_dn_expand(response, end, p, name, sizeof(name));
+        if (status < 0)
+            return false;
+        p += status;
+        return true;
+    };
+
+    // Skip the questions and the answers
+    for (int i = 0; i < ntohs(header->qdcount); ++i) {
+        if (!skipName() || end - p < QFIXEDSZ)
+            return -1;
+        p += QFIXEDSZ;
     }
-
-    //Check if a nameserver was set. If so, use it
-    if (!nameserver.isNull()) {
-        if (nameserver.protocol() == QAbstractSocket::IPv4Protocol) {
-            state.nsaddr_list[0].sin_addr.s_addr = htonl(nameserver.toIPv4Address());
-            state.nscount = 1;
-        } else if (nameserver.protocol() == QAbstractSocket::IPv6Protocol) {
-#if defined(Q_OS_LINUX)
-            struct sockaddr_in6 *ns;
-            ns = state._u._ext.nsaddrs[0];
-            // nsaddrs will be NULL if no nameserver is set in /etc/resolv.conf
-            if (!ns) {
-                // Memory allocated here will be free'd in res_close() as we
-                // have done res_init() above.
-                ns = (struct sockaddr_in6*) calloc(1, sizeof(struct sockaddr_in6));
-                Q_CHECK_PTR(ns);
-                state._u._ext.nsaddrs[0] = ns;
-            }
-#ifndef __UCLIBC__
-            // Set nsmap[] to indicate that nsaddrs[0] is an IPv6 address
-            // See: https://sourceware.org/ml/libc-hacker/2002-05/msg00035.html
-            state._u._ext.nsmap[0] = MAXNS + 1;
-#endif
-            state._u._ext.nscount6 = 1;
-            ns->sin6_family = AF_INET6;
-            ns->sin6_port = htons(53);
-            SetSALen::set(ns, sizeof(*ns));
-
-            Q_IPV6ADDR ipv6Address = nameserver.toIPv6Address();
-            for (int i=0; i<16; i++) {
-                ns->sin6_addr.s6_addr[i] = ipv6Address[i];
-            }
-#else
-            qWarning("%s", QDnsLookupPrivate::msgNoIpV6NameServerAdresses);
-            reply->error = QDnsLookup::ResolverError;
-            reply->errorString = tr(QDnsLookupPrivate::msgNoIpV6NameServerAdresses);
-            return;
-#endif
-        }
+    for (int i = 0; i < ntohs(header->ancount); ++i) {
+        if (!skipName() || end - p < RRFIXEDSZ)
+            return -1;
+        const quint16 size = (p[8] << 8) | p[9];
+        p += RRFIXEDSZ + size;
+        if (p > end)
+            return -1;
     }
-#ifdef QDNSLOOKUP_DEBUG
-    state.options |= RES_DEBUG;
-#endif
-    QScopedPointer<struct __res_state, QDnsLookupStateDeleter> state_ptr(&state);
 
-    // Perform DNS query.
-    QVarLengthArray<unsigned char, PACKETSZ> buffer(PACKETSZ);
-    std::memset(buffer.data(), 0, buffer.size());
-    int responseLength = local_res_nquery(&state, requestName, C_IN, requestType, buffer.data(), buffer.size());
-    if (Q_UNLIKELY(responseLength > PACKETSZ)) {
-        buffer.resize(responseLength);
-        std::memset(buffer.data(), 0, buffer.size());
-        responseLength = local_res_nquery(&state, requestName, C_IN, requestType, buffer.data(), buffer.size());
-        if (Q_UNLIKELY(responseLength > buffer.size())) {
-            // Ok, we give up.
-            reply->error = QDnsLookup::ResolverError;
-            reply->errorString.clear(); // We cannot be more specific, alas.
-            return;
+    for (int i = 0; i < ntohs(header->nscount); ++i) {
+        if (!skipName() || end - p < RRFIXEDSZ)
+            return -1;
+        const quint16 type = (p[0] << 8) | p[1];
+        const quint32 ttl = (p[4] << 24) | (p[5] << 16) | (p[6] << 8) | p[7];
+        const quint16 size = (p[8] << 8) | p[9];
+        p += RRFIXEDSZ;
+        if (end - p < size)
+            return -1;
+        if (type == T_SOA) {
+            // MNAME and RNAME, then SERIAL, REFRESH, RETRY, EXPIRE and MINIMUM
+            if (!skipName() || !skipName() || end - p < 20)
+                return -1;
+            const quint32 minimum = (p[16] << 24) | (p[17] << 16) | (p[18] << 8) | p[19];
+            return qMin(ttl, minimum);
         }
+        p += size;
     }
+    return -1;
+}
 
-    unsigned char *response = buffer.data();
+// Extracts the records from the \a response to a query for one name.
+void QDnsLookupRunnable::parseReply(unsigned char *response, int responseLength, QDnsLookupReply *reply)
+{
     // Check the response header. Though res_nquery returns -1 as a
     // responseLength in case of error, we still can extract the
     // exact error code from the response.
@@ -208,6 +189,7 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
     case NXDOMAIN:
         reply->error = QDnsLookup::NotFoundError;
         reply->errorString = tr("Non existent domain");
+        reply->negativeTimeToLive = negativeTimeToLive(response, responseLength);
         return;
     case REFUSED:
         reply->error = QDnsLookup::ServerRefusedError;
@@ -251,6 +233,8 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
 
     // Extract results.
     const int answerCount = ntohs(header->ancount);
+    if (answerCount == 0)
+        reply->negativeTimeToLive = negativeTimeToLive(response, responseLength);
     int answerIndex = 0;
     while ((p < response + responseLength) && (answerIndex < answerCount)) {
         status = local_dn_expand(response, response + responseLength, p, host, sizeof(host));
@@ -394,6 +378,313 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
     }
 }
 
+void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestName, const QHostAddress &nameserver, QDnsLookupReply *reply)
+{
+    // Load dn_expand, res_ninit and res_nquery on demand.
+    resolveLibrary();
+
+    // If dn_expand, res_ninit or res_nquery is missing, fail.
+    if (!local_dn_expand || !local_res_nclose || !local_res_ninit || !local_res_nquery) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("Resolver functions not found");
+        return;
+    }
+
+    // Initialize state.
+    struct __res_state state;
+    std::memset(&state, 0, sizeof(state));
+    if (local_res_ninit(&state) < 0) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("Resolver initialization failed");
+        return;
+    }
+
+    //Check if a nameserver was set. If so, use it
+    if (!nameserver.isNull()) {
+        if (nameserver.protocol() == QAbstractSocket::IPv4Protocol) {
+            state.nsaddr_list[0].sin_addr.s_addr = htonl(nameserver.toIPv4Address());
+            state.nscount = 1;
+        } else if (nameserver.protocol() == QAbstractSocket::IPv6Protocol) {
+#if defined(Q_OS_LINUX)
+            struct sockaddr_in6 *ns;
+            ns = state._u._ext.nsaddrs[0];
+            // nsaddrs will be NULL if no nameserver is set in /etc/resolv.conf
+            if (!ns) {
+                // Memory allocated here will be free'd in res_close() as we
+                // have done res_init() above.
+                ns = (struct sockaddr_in6*) calloc(1, sizeof(struct sockaddr_in6));
+                Q_CHECK_PTR(ns);
+                state._u._ext.nsaddrs[0] = ns;
+            }
+#ifndef __UCLIBC__
+            // Set nsmap[] to indicate that nsaddrs[0] is an IPv6 address
+            // See: https://sourceware.org/ml/libc-hacker/2002-05/msg00035.html
+            state._u._ext.nsmap[0] = MAXNS + 1;
+#endif
+            state._u._ext.nscount6 = 1;
+            ns->sin6_family = AF_INET6;
+            ns->sin6_port = htons(53);
+            SetSALen::set(ns, sizeof(*ns));
+
+            Q_IPV6ADDR ipv6Address = nameserver.toIPv6Address();
+            for (int i=0; i<16; i++) {
+                ns->sin6_addr.s6_addr[i] = ipv6Address[i];
+            }
+#else
+            qWarning("%s", QDnsLookupPrivate::msgNoIpV6NameServerAdresses);
+            reply->error = QDnsLookup::ResolverError;
+            reply->errorString = tr(QDnsLookupPrivate::msgNoIpV6NameServerAdresses);
+            return;
+#endif
+        }
+    }
+#ifdef QDNSLOOKUP_DEBUG
+    state.options |= RES_DEBUG;
+#endif
+    QScopedPointer<struct __res_state, QDnsLookupStateDeleter> state_ptr(&state);
+
+    // Perform DNS query.
+    QVarLengthArray<unsigned char, PACKETSZ> buffer(PACKETSZ);
+    std::memset(buffer.data(), 0, buffer.size());
+    int responseLength = local_res_nquery(&state, requestName, C_IN, requestType, buffer.data(), buffer.size());
+    if (Q_UNLIKELY(responseLength > PACKETSZ)) {
+        buffer.resize(responseLength);
+        std::memset(buffer.data(), 0, buffer.size());
+        responseLength = local_res_nquery(&state, requestName, C_IN, requestType, buffer.data(), buffer.size());
+        if (Q_UNLIKELY(responseLength > buffer.size())) {
+            // Ok, we give up.
+            reply->error = QDnsLookup::ResolverError;
+            reply->errorString.clear(); // We cannot be more specific, alas.
+            return;
+        }
+    }
+
+    parseReply(buffer.data(), responseLength, reply);
+}
+
+// Builds a query for the \a type records of \a name, with recursion desired.
+// Returns an empty array if the name cannot be encoded.
+static QByteArray makeQuery(quint16 id, const QByteArray &name, quint16 type)
+{
+    QByteArray query;
+    query.reserve(HFIXEDSZ + name.size() + 2 + QFIXEDSZ);
+    const char header[HFIXEDSZ] = { char(id >> 8), char(id), 0x01, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+    query.append(header, HFIXEDSZ);
+
+    const QList<QByteArray> labels = name.split('.');
+    for (qsizetype i = 0; i < labels.size(); ++i) {
+        const QByteArray &label = labels.at(i);
+        if (label.isEmpty() && i == labels.size() - 1 && i > 0)
+            break;              // the root label of a fully qualified name
+        if (label.isEmpty() || label.size() > 63)
+            return QByteArray();
+        query.append(char(label.size())).append(label);
+    }
+    query.append('\0');
+    if (query.size() - HFIXEDSZ > MAXCDNAME)
+        return QByteArray();
+
+    query.append(char(type >> 8)).append(char(type)).append('\0').append(char(C_IN));
+    return query;
+}
+
+// Returns true if the question section of the \a response is the one of a
+// query for the \a type records of \a name, which is how RFC 5452 says to
+// tell answers from forged ones, besides the ID.
+static bool answersQuestion(const unsigned char *response, int responseLength,
+                            const QByteArray &name, quint16 type)
+{
+    const HEADER *header = reinterpret_cast<const HEADER *>(response);
+    if (ntohs(header->qdcount) != 1)
+        return false;
+    const unsigned char *end = response + responseLength;
+    const unsigned char *p = response + sizeof(HEADER);
+    char host[PACKETSZ];
+    const int status = local_dn_expand(response, end, p, host, sizeof(host));
+    if (status < 0 || end - p - status < QFIXEDSZ)
+        return false;
+    p += status;
+    const quint16 questionType = (p[0] << 8) | p[1];
+    const quint16 questionClass = (p[2] << 8) | p[3];
+
+    QByteArrayView expected = name;
+    if (expected.endsWith('.'))
+        expected.chop(1);
+    return questionType == type && questionClass == C_IN
+            && expected.compare(host, Qt::CaseInsensitive) == 0;
+}
+
+/*
+    Looks up the A and AAAA records of \a requestName, sending both queries
+    at once over a UDP socket and polling it for the answers, instead of
+    calling res_nquery() once per type. The queries go to \a nameserver on
+    \a port, or else to the nameservers the system resolver is configured
+    with, using its timeout and number of attempts. Like res_nquery(), this
+    blocks the calling thread until it is done.
+
+    Unlike getaddrinfo(), this gives QHostInfo the TTLs of the records, and
+    of negative answers. The hosts file and the search domains are not used.
+*/
+void QDnsLookupRunnable::queryHostAddresses(const QByteArray &requestName, const QHostAddress &nameserver,
+                                            quint16 port, QDnsLookupReply *reply)
+{
+    resolveLibrary();
+    if (!local_dn_expand || !local_res_nclose || !local_res_ninit) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("Resolver functions not found");
+        return;
+    }
+
+    QList<std::pair<QHostAddress, quint16>> nameservers;
+    int timeout;
+    int attempts;
+    {
+        struct __res_state state;
+        std::memset(&state, 0, sizeof(state));
+        if (local_res_ninit(&state) < 0) {
+            reply->error = QDnsLookup::ResolverError;
+            reply->errorString = tr("Resolver initialization failed");
+            return;
+        }
+        QScopedPointer<struct __res_state, QDnsLookupStateDeleter> state_ptr(&state);
+
+        timeout = qMax(state.retrans, 1) * 1000;
+        attempts = qMax(state.retry, 1);
+        if (!nameserver.isNull()) {
+            nameservers.append({ nameserver, port });
+        } else {
+            for (int i = 0; i < state.nscount; ++i) {
+                const sockaddr_in &address = state.nsaddr_list[i];
+                if (address.sin_family == AF_INET) {
+                    nameservers.append({ QHostAddress(ntohl(address.sin_addr.s_addr)),
+                                         ntohs(address.sin_port) });
+                    continue;
+                }
+#if defined(Q_OS_LINUX)
+                // res_ninit() keeps the IPv6 nameservers apart
+                if (const sockaddr_in6 *address6 = state._u._ext.nsaddrs[i];
+                        address6 && address6->sin6_family == AF_INET6) {
+                    nameservers.append({ QHostAddress(address6->sin6_addr.s6_addr),
+                                         ntohs(address6->sin6_port) });
+                }
+#endif
+            }
+        }
+    }
+    if (nameservers.isEmpty()) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("No nameserver to query");
+        return;
+    }
+
+    struct Query {
+        quint16 type;
+        quint16 id;
+        QByteArray data;
+        bool answered;
+    };
+    Query queries[] = { { QDnsLookup::A, 0, {}, false }, { QDnsLookup::AAAA, 0, {}, false } };
+    for (Query &query : queries) {
+        query.id = quint16(QRandomGenerator::system()->generate());
+        query.data = makeQuery(query.id, requestName, query.type);
+        if (query.data.isEmpty()) {
+            reply->error = QDnsLookup::InvalidRequestError;
+            reply->errorString = tr("Invalid domain name");
+            return;
+        }
+    }
+    auto pending = [&queries] {
+        return std::any_of(std::begin(queries), std::end(queries),
+                           [](const Query &query) { return !query.answered; });
+    };
+
+    QVarLengthArray<unsigned char, PACKETSZ> buffer(PACKETSZ);
+    for (int attempt = 0; attempt < attempts * nameservers.size() && pending(); ++attempt) {
+        const auto &[address, serverPort] = nameservers.at(attempt % nameservers.size());
+        union {
+            sockaddr a;
+            sockaddr_in a4;
+            sockaddr_in6 a6;
+        } sa;
+        QT_SOCKLEN_T saSize;
+        std::memset(&sa, 0, sizeof(sa));
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            sa.a4.sin_family = AF_INET;
+            sa.a4.sin_port = htons(serverPort);
+            sa.a4.sin_addr.s_addr = htonl(address.toIPv4Address());
+            saSize = sizeof(sa.a4);
+        } else {
+            sa.a6.sin6_family = AF_INET6;
+            sa.a6.sin6_port = htons(serverPort);
+            std::memcpy(&sa.a6.sin6_addr, address.toIPv6Address().c, sizeof(sa.a6.sin6_addr));
+            saSize = sizeof(sa.a6);
+        }
+
+        // A connected socket only receives datagrams from the nameserver
+        const int fd = qt_safe_socket(sa.a.sa_family, SOCK_DGRAM, 0, O_NONBLOCK);
+        if (fd == -1)
+            continue;
+        const auto closeSocket = qScopeGuard([fd] { qt_safe_close(fd); });
+        if (qt_safe_connect(fd, &sa.a, saSize) == -1)
+            continue;
+        for (const Query &query : queries) {
+            if (!query.answered)
+                ::send(fd, query.data.constData(), query.data.size(), 0);
+        }
+
+        QDeadlineTimer deadline(timeout);
+        while (pending()) {
+            pollfd pfd = qt_make_pollfd(fd, POLLIN);
+            if (qt_poll_msecs(&pfd, 1, int(deadline.remainingTime())) <= 0)
+                break;          // timeout or error, try the next nameserver
+            const ssize_t responseLength = ::recv(fd, buffer.data(), buffer.size(), 0);
+            if (responseLength < ssize_t(sizeof(HEADER)))
+                continue;
+
+            HEADER *header = reinterpret_cast<HEADER *>(buffer.data());
+            const auto query = std::find_if(std::begin(queries), std::end(queries),
+                                            [&](const Query &candidate) {
+                return !candidate.answered && ntohs(header->id) == candidate.id
+                        && answersQuestion(buffer.data(), int(responseLength), requestName,
+                                           candidate.type);
+            });
+            if (!header->qr || query == std::end(queries))
+                continue;       // not an answer to one of our queries
+            if (header->tc) {
+                reply->error = QDnsLookup::ResolverError;
+                reply->errorString = tr("Reply too large");
+                return;
+            }
+            query->answered = true;
+
+            QDnsLookupReply answer;
+            parseReply(buffer.data(), int(responseLength), &answer);
+            if (answer.error != QDnsLookup::NoError) {
+                // NXDOMAIN applies to all the types
+                reply->error = answer.error;
+                reply->errorString = answer.errorString;
+                reply->negativeTimeToLive = answer.negativeTimeToLive;
+                return;
+            }
+            reply->canonicalNameRecords += answer.canonicalNameRecords;
+            reply->hostAddressRecords += answer.hostAddressRecords;
+            if (answer.negativeTimeToLive >= 0) {
+                reply->negativeTimeToLive = reply->negativeTimeToLive < 0
+                        ? answer.negativeTimeToLive
+                        : qMin(reply->negativeTimeToLive, answer.negativeTimeToLive);
+            }
+        }
+    }
+
+    if (pending()) {
+        reply->error = QDnsLookup::ResolverError;
+        reply->errorString = tr("No answer from the nameservers");
+    } else if (reply->hostAddressRecords.isEmpty()) {
+        reply->error = QDnsLookup::NotFoundError;
+        reply->errorString = tr("No address records");
+    }
+}
+
 #else
 void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestName, const QHostAddress &nameserver, QDnsLookupReply *reply)
 {
@@ -405,6 +696,16 @@ void QDnsLookupRunnable::query(const int requestType, const QByteArray &requestN
     return;
 }
 
+void QDnsLookupRunnable::queryHostAddresses(const QByteArray &requestName, const QHostAddress &nameserver,
+                                            quint16 port, QDnsLookupReply *reply)
+{
+    Q_UNUSED(requestName);
+    Q_UNUSED(nameserver);
+    Q_UNUSED(port);
+    reply->error = QDnsLookup::ResolverError;
+    reply->errorString = tr("Resolver library can't be loaded: No runtime library loading support");
+}
+
 #endif /* QT_CONFIG(library) */
 
 QT_END_NAMESPACE
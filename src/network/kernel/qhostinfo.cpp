@@ -349,9 +349,10 @@ QHostInfo QHostInfo::fromName(const QString &name)
 #ifdef Q_OS_WASM
     return QHostInfoAgent::lookup(name);
 #else
-    QHostInfo hostInfo = QHostInfoAgent::fromName(name);
+    qint64 timeToLive;
+    QHostInfo hostInfo = QHostInfoAgent::fromName(name, &timeToLive);
     QHostInfoLookupManager* manager = theHostInfoLookupManager();
-    manager->cache.put(name, hostInfo);
+    manager->cache.put(name, hostInfo, timeToLive);
     return hostInfo;
 #endif
 }
@@ -845,8 +846,9 @@ void QHostInfoRunnable::run()
         hostInfo = manager->cache.get(toBeLookedUp, &valid);
         if (!valid) {
             // not in cache, we need to do the lookup and store the result in the cache
-            hostInfo = QHostInfoAgent::fromName(toBeLookedUp);
-            manager->cache.put(toBeLookedUp, hostInfo);
+            qint64 timeToLive;
+            hostInfo = QHostInfoAgent::fromName(toBeLookedUp, &timeToLive);
+            manager->cache.put(toBeLookedUp, hostInfo, timeToLive);
         }
     } else {
         // cache is not enabled, just do the lookup and continue
@@ -1097,7 +1099,7 @@ void qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolut
 }
 #endif
 
-// cache for 60 seconds
+// cache for 60 seconds, unless the records say less
 // cache 128 items
 QHostInfoCache::QHostInfoCache() : max_age(60), enabled(true), cache(128)
 {
@@ -1112,7 +1114,7 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
 
     *valid = false;
     if (QHostInfoCacheElement *element = cache.object(name)) {
-        if (element->age.elapsed() < max_age*1000)
+        if (element->age.elapsed() < element->maxAge)
             *valid = true;
         return element->info;
 
@@ -1124,16 +1126,34 @@ QHostInfo QHostInfoCache::get(const QString &name, bool *valid)
     return QHostInfo();
 }
 
-void QHostInfoCache::put(const QString &name, const QHostInfo &info)
+void QHostInfoCache::put(const QString &name, const QHostInfo &info, qint64 timeToLive)
 {
-    // if the lookup failed, don't cache
-    if (info.error() != QHostInfo::NoError)
+    qint64 maxAge;
+    switch (info.error()) {
+    case QHostInfo::NoError:
+        maxAge = max_age;
+        break;
+    case QHostInfo::HostNotFound:
+        // only remember that the name does not exist if the nameserver said
+        // for how long, which it only does when QT_HOSTINFO_NAMESERVER is set
+        if (timeToLive < 0)
+            return;
+        maxAge = max_age;
+        break;
+    default:
+        // if the lookup failed otherwise, don't cache
+        return;
+    }
+    if (timeToLive >= 0)
+        maxAge = qMin(maxAge, timeToLive);
+    if (maxAge == 0)
         return;
 
     QHostInfoCacheElement* element = new QHostInfoCacheElement();
     element->info = info;
     element->age = QElapsedTimer();
     element->age.start();
+    element->maxAge = maxAge * 1000;
 
     QMutexLocker locker(&this->mutex);
     cache.insert(name, element); // cache will take ownership
@@ -81,7 +81,9 @@ private:
 class QHostInfoAgent
 {
 public:
-    static QHostInfo fromName(const QString &hostName);
+    // Sets *timeToLive to how long the result may be cached for,
+    // in seconds, if the resolver says, else to -1.
+    static QHostInfo fromName(const QString &hostName, qint64 *timeToLive = nullptr);
     static QHostInfo lookup(const QString &hostName);
     static QHostInfo reverseLookup(const QHostAddress &address);
 };
@@ -113,6 +115,9 @@ QHostInfo Q_NETWORK_EXPORT qt_qhostinfo_lookup(const QString &name, QObject *rec
 void Q_AUTOTEST_EXPORT qt_qhostinfo_clear_cache();
 void Q_AUTOTEST_EXPORT qt_qhostinfo_enable_cache(bool e);
 void Q_AUTOTEST_EXPORT qt_qhostinfo_cache_inject(const QString &hostname, const QHostInfo &resolution);
+#if QT_CONFIG(dnslookup) && defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID) && !defined(Q_OS_WASM)
+void Q_AUTOTEST_EXPORT qt_qhostinfo_set_nameserver(const QHostAddress &address, quint16 port);
+#endif
 
 class QHostInfoCache
 {
@@ -121,7 +126,9 @@ public:
     const int max_age; // seconds
 
     QHostInfo get(const QString &name, bool *valid);
-    void put(const QString &name, const QHostInfo &info);
+    // A timeToLive shorter than the maximum age shortens it. Names that were
+    // not found are only cached if the timeToLive is known.
+    void put(const QString &name, const QHostInfo &info, qint64 timeToLive = -1);
     void clear();
 
     bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
@@ -133,6 +140,7 @@ private:
     struct QHostInfoCacheElement {
         QHostInfo info;
         QElapsedTimer age;
+        qint64 maxAge; // msecs
     };
     QCache<QString,QHostInfoCacheElement> cache;
     QMutex mutex;
@@ -16,6 +16,10 @@
 #include <qurl.h>
 #include <qfile.h>
 #include <private/qnet_unix_p.h>
+#if QT_CONFIG(dnslookup) && !defined(Q_OS_ANDROID) && !defined(Q_OS_WASM)
+#  include <private/qdnslookup_p.h>
+#  define QT_HOSTINFO_DNS_RESOLVER
+#endif
 
 #include "QtCore/qapplicationstatic.h"
 
@@ -137,9 +141,124 @@ static void resolveLibrary(LibResolvFeature)
 }
 #endif // QT_CONFIG(library) || Q_OS_QNX
 
-QHostInfo QHostInfoAgent::fromName(const QString &hostName)
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+namespace {
+struct DnsResolverConfig
+{
+    DnsResolverConfig();
+
+    QMutex mutex;
+    QHostAddress nameserver;
+    quint16 port = 53;
+    bool enabled = false;
+};
+}
+
+Q_GLOBAL_STATIC(DnsResolverConfig, dnsResolverConfig)
+
+// QT_HOSTINFO_NAMESERVER is "system" to ask the nameservers from
+// resolv.conf, or the address of a nameserver, with an optional port.
+DnsResolverConfig::DnsResolverConfig()
+{
+    const QString value = qEnvironmentVariable("QT_HOSTINFO_NAMESERVER");
+    if (value.isEmpty())
+        return;
+    if (value == "system"_L1) {
+        enabled = true;
+        return;
+    }
+
+    const QUrl url(u"dns://"_s + value);
+    if (nameserver.setAddress(url.host()) && url.port(53) > 0) {
+        port = quint16(url.port(53));
+        enabled = true;
+    } else {
+        nameserver.clear();
+        qWarning("QHostInfo: ignoring invalid QT_HOSTINFO_NAMESERVER '%ls'", qUtf16Printable(value));
+    }
+}
+
+#ifdef QT_BUILD_INTERNAL
+void qt_qhostinfo_set_nameserver(const QHostAddress &address, quint16 port)
+{
+    DnsResolverConfig *config = dnsResolverConfig();
+    QMutexLocker locker(&config->mutex);
+    config->nameserver = address;
+    config->port = port;
+    config->enabled = !address.isNull();
+}
+#endif
+
+/*
+    Asks the nameservers for the addresses of \a hostName directly if
+    QT_HOSTINFO_NAMESERVER is set, so as to know for how long the answer
+    may be cached. Returns false if the system resolver should be asked
+    instead, which it is for names that may be in the hosts file or need
+    the search domains, like "localhost", and when no nameserver answered.
+
+    The nameservers don't know about the hosts file, other sources of the
+    name service switch, or the search domains either, so when they say
+    that the name has no addresses, the system resolver is asked as well.
+    \a timeToLive is then set to for how long that answer may be cached,
+    should the system resolver agree.
+*/
+static bool lookupWithNameserver(const QString &hostName, QHostInfo *results, qint64 *timeToLive)
+{
+    QHostAddress nameserver;
+    quint16 port;
+    {
+        DnsResolverConfig *config = dnsResolverConfig();
+        QMutexLocker locker(&config->mutex);
+        if (!config->enabled)
+            return false;
+        nameserver = config->nameserver;
+        port = config->port;
+    }
+
+    if (!hostName.contains(u'.'))
+        return false;
+    const QByteArray aceHostname = QUrl::toAce(hostName);
+    if (aceHostname.isEmpty())
+        return false;
+
+    QDnsLookupReply reply;
+    QDnsLookupRunnable::queryHostAddresses(aceHostname, nameserver, port, &reply);
+    switch (reply.error) {
+    case QDnsLookup::NoError:
+        break;
+    case QDnsLookup::NotFoundError:
+        *timeToLive = reply.negativeTimeToLive;
+        return false;
+    default:
+#if defined(QHOSTINFO_DEBUG)
+        qDebug("QHostInfoAgent::fromName(): %s, using the system resolver",
+               reply.errorString.toLatin1().constData());
+#endif
+        return false;
+    }
+
+    QList<QHostAddress> addresses;
+    qint64 ttl = -1;
+    for (const QDnsHostAddressRecord &record : std::as_const(reply.hostAddressRecords)) {
+        if (!addresses.contains(record.value()))
+            addresses.append(record.value());
+        ttl = ttl < 0 ? record.timeToLive() : qMin(ttl, qint64(record.timeToLive()));
+    }
+    for (const QDnsDomainNameRecord &record : std::as_const(reply.canonicalNameRecords))
+        ttl = qMin(ttl, qint64(record.timeToLive()));
+
+    results->setHostName(hostName);
+    results->setAddresses(addresses);
+    *timeToLive = ttl;
+    return true;
+}
+#endif // QT_HOSTINFO_DNS_RESOLVER
+
+QHostInfo QHostInfoAgent::fromName(const QString &hostName, qint64 *timeToLive)
 {
     QHostInfo results;
+    if (timeToLive)
+        *timeToLive = -1;
 
 #if defined(QHOSTINFO_DEBUG)
     qDebug("QHostInfoAgent::fromName(%s) looking up...",
@@ -157,7 +276,21 @@ QHostInfo QHostInfoAgent::fromName(const QString &hostName)
     if (address.setAddress(hostName))
         return reverseLookup(address);
 
+#ifdef QT_HOSTINFO_DNS_RESOLVER
+    qint64 ttl = -1;
+    if (lookupWithNameserver(hostName, &results, &ttl)) {
+        if (timeToLive)
+            *timeToLive = ttl;
+        return results;
+    }
+
+    results = lookup(hostName);
+    if (timeToLive && results.error() == QHostInfo::HostNotFound)
+        *timeToLive = ttl;
+    return results;
+#else
     return lookup(hostName);
+#endif
 }
 
 QString QHostInfo::localDomainName()
@@ -19,10 +19,13 @@ QT_BEGIN_NAMESPACE
 #define NI_MAXHOST 1024
 #endif
 
-QHostInfo QHostInfoAgent::fromName(const QString &hostName)
+QHostInfo QHostInfoAgent::fromName(const QString &hostName, qint64 *timeToLive)
 {
     QSysInfo::machineHostName();        // this initializes ws2_32.dll
 
+    if (timeToLive)
+        *timeToLive = -1;
+
     QHostInfo results;
 
 #if defined(QHOSTINFO_DEBUG)
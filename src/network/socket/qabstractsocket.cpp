@@ -759,11 +759,20 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
-
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    qint64 written;
+    if (socketType == QAbstractSocket::TcpSocket) {
+        // Attempt to write all the chunks of the buffer at once.
+        constexpr qsizetype MaxBlocks = 64;
+        const char *blocks[MaxBlocks];
+        qint64 sizes[MaxBlocks];
+        const int count = int(writeBuffer.dataBlocks(blocks, sizes, MaxBlocks));
+        written = count ? socketEngine->writeBlocks(blocks, sizes, count) : Q_INT64_C(0);
+    } else {
+        // Write one chunk at a time, keeping message boundaries.
+        qint64 nextSize = writeBuffer.nextDataBlockSize();
+        const char *ptr = writeBuffer.readPointer();
+        written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    }
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -1161,9 +1170,14 @@ bool QAbstractSocketPrivate::readFromSocket()
                bytesToRead);
 #endif
 
-        // Read from the socket, store data in the read buffer.
-        char *ptr = buffer.reserve(bytesToRead);
-        qint64 readBytes = socketEngine->read(ptr, bytesToRead);
+        // Read from the socket, store data in the read buffer. The space
+        // left in the buffer's last chunk is filled before a new one is
+        // allocated, so the data may be read into two chunks at once.
+        char *blocks[2];
+        qint64 sizes[2];
+        const int count = int(buffer.reserveBlocks(bytesToRead, blocks, sizes));
+        qint64 readBytes = count == 1 ? socketEngine->read(blocks[0], sizes[0])
+                                      : socketEngine->readBlocks(blocks, sizes, count);
         if (readBytes == -2) {
             // No bytes currently available for reading.
             buffer.chop(bytesToRead);
@@ -233,6 +233,97 @@ int QAbstractSocketEngine::outboundStreamCount() const
     return d_func()->outboundStreamCount;
 }
 
+/*!
+    Reads into the \a count blocks of \a sizes bytes at \a data, in order,
+    and returns the number of bytes read, or what read() returned if nothing
+    could be read.
+
+    This implementation calls read() for each block until one is not filled;
+    engines that can read into several blocks in one system call reimplement
+    it.
+*/
+qint64 QAbstractSocketEngine::readBlocks(char *const *data, const qint64 *sizes, int count)
+{
+    qint64 total = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 readBytes = read(data[i], sizes[i]);
+        if (readBytes < 0)
+            return total ? total : readBytes;
+        total += readBytes;
+        if (readBytes < sizes[i])
+            break;
+    }
+    return total;
+}
+
+/*!
+    Writes the \a count blocks of \a sizes bytes at \a data, in order, and
+    returns the number of bytes written, or what write() returned if nothing
+    could be written.
+
+    This implementation calls write() for each block until one is not
+    written entirely; engines that can write several blocks in one system
+    call reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeBlocks(const char *const *data, const qint64 *sizes, int count)
+{
+    qint64 total = 0;
+    for (int i = 0; i < count; ++i) {
+        const qint64 written = write(data[i], sizes[i]);
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < sizes[i])
+            break;
+    }
+    return total;
+}
+
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a maxCount datagrams, the i-th one into the \a maxlen bytes
+    at \a data + i * \a maxlen, storing its size in \a sizes[i] and its IP
+    header fields in \a headers[i] according to \a options. Returns the number
+    of datagrams read, or what readDatagram() returned if none could be read.
+
+    This implementation calls readDatagram() for each datagram; engines that
+    can receive several datagrams in one system call reimplement it.
+*/
+int QAbstractSocketEngine::readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *sizes,
+                                         QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    int count = 0;
+    while (count < maxCount && (count == 0 || hasPendingDatagrams())) {
+        qint64 size = readDatagram(data + count * maxlen, maxlen,
+                                   options == WantNone ? nullptr : headers + count, options);
+        if (size < 0)
+            return count ? count : int(size);
+        sizes[count++] = size;
+    }
+    return count;
+}
+
+/*!
+    Writes the \a count \a datagrams to the socket, each one to the
+    destination in its header. Returns the number of datagrams written, or
+    what writeDatagram() returned if none could be written.
+
+    This implementation calls writeDatagram() for each datagram; engines that
+    can send several datagrams in one system call reimplement it.
+*/
+int QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        const QNetworkDatagramPrivate *datagram = datagrams[i];
+        qint64 sent = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                    datagram->header);
+        if (sent < 0)
+            return i ? i : int(sent);
+    }
+    return count;
+}
+#endif // QT_NO_UDPSOCKET
+
 QT_END_NAMESPACE
 
 #include "moc_qabstractsocketengine_p.cpp"
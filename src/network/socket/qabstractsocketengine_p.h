@@ -105,6 +105,8 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 readBlocks(char *const *data, const qint64 *sizes, int count);
+    virtual qint64 writeBlocks(const char *const *data, const qint64 *sizes, int count);
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -123,6 +125,11 @@ public:
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
                                 PacketHeaderOptions = WantNone) = 0;
     virtual qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &header) = 0;
+#ifndef QT_NO_UDPSOCKET
+    virtual int readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *sizes,
+                              QIpPacketHeader *headers, PacketHeaderOptions = WantNone);
+    virtual int writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count);
+#endif
     virtual qint64 bytesToWrite() const = 0;
 
     virtual int option(SocketOption option) const = 0;
@@ -866,6 +866,60 @@ qint64 QNativeSocketEngine::writeDatagram(const char *data, qint64 size, const Q
     return d->nativeSendDatagram(data, size, header);
 }
 
+#ifndef QT_NO_UDPSOCKET
+/*!
+    Reads up to \a maxCount datagrams from the socket, the i-th one into the
+    \a maxSize bytes at \a data + i * \a maxSize. Its size is stored in
+    \a sizes[i], and its IP header fields in \a headers[i] according to
+    \a options. On Linux, all of them are read with a single system call.
+
+    Returns the number of datagrams read, -2 if none was pending, or -1 if an
+    error occurred.
+
+    \sa readDatagram()
+*/
+int QNativeSocketEngine::readDatagrams(char *data, qint64 maxSize, int maxCount, qint64 *sizes,
+                                       QIpPacketHeader *headers, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeReceiveDatagrams(data, maxSize, maxCount, sizes, headers, options);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::readDatagrams(data, maxSize, maxCount, sizes, headers, options);
+#endif
+}
+
+/*!
+    Writes the \a count \a datagrams to the socket, each one to the
+    destination contained in its header, and returns the number of datagrams
+    written, -2 if none could be written without blocking, or -1 if an error
+    occurred. On Linux, they are written with a single system call, and runs
+    of datagrams of the same size to the same destination are handed to the
+    kernel as one buffer to segment if it supports UDP segmentation offload.
+
+    \sa writeDatagram()
+*/
+int QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+#ifdef Q_OS_LINUX
+    return d->nativeSendDatagrams(datagrams, count);
+#else
+    Q_UNUSED(d);
+    return QAbstractSocketEngine::writeDatagrams(datagrams, count);
+#endif
+}
+#endif // QT_NO_UDPSOCKET
+
 /*!
     Writes a block of \a size bytes from \a data to the socket.
     Returns the number of bytes written, or -1 if an error occurred.
@@ -898,7 +952,57 @@ qint64 QNativeSocketEngine::read(char *data, qint64 maxSize)
     Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::read(), -1);
     Q_CHECK_STATES(QNativeSocketEngine::read(), QAbstractSocket::ConnectedState, QAbstractSocket::BoundState, -1);
 
-    qint64 readBytes = d->nativeRead(data, maxSize);
+    return checkReadResult(d->nativeRead(data, maxSize));
+}
+
+/*!
+    Reads into the \a count blocks of \a sizes bytes at \a data, in order.
+    Returns the number of bytes read, or -1 if an error occurred. On Unix,
+    all the blocks are filled with a single system call.
+
+    \sa read()
+*/
+qint64 QNativeSocketEngine::readBlocks(char *const *data, const qint64 *sizes, int count)
+{
+#ifndef Q_OS_WIN
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readBlocks(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readBlocks(), QAbstractSocket::ConnectedState, QAbstractSocket::BoundState, -1);
+
+    return checkReadResult(d->nativeReadBlocks(data, sizes, count));
+#else
+    return QAbstractSocketEngine::readBlocks(data, sizes, count);
+#endif
+}
+
+/*!
+    Writes the \a count blocks of \a sizes bytes at \a data, in order.
+    Returns the number of bytes written, or -1 if an error occurred. On Unix,
+    all the blocks are written with a single system call.
+
+    \sa write()
+*/
+qint64 QNativeSocketEngine::writeBlocks(const char *const *data, const qint64 *sizes, int count)
+{
+#ifndef Q_OS_WIN
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeBlocks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeBlocks(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteBlocks(data, sizes, count);
+#else
+    return QAbstractSocketEngine::writeBlocks(data, sizes, count);
+#endif
+}
+
+/*!
+    \internal
+
+    Handles the result \a readBytes of reading from the socket: closes the
+    socket if the peer closed the connection or an error occurred.
+*/
+qint64 QNativeSocketEngine::checkReadResult(qint64 readBytes)
+{
+    Q_D(QNativeSocketEngine);
 
     // Handle remote close
     if (readBytes == 0 && (d->socketType == QAbstractSocket::TcpSocket
@@ -71,6 +71,8 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+    qint64 readBlocks(char *const *data, const qint64 *sizes, int count) override;
+    qint64 writeBlocks(const char *const *data, const qint64 *sizes, int count) override;
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -89,6 +91,11 @@ public:
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
                         PacketHeaderOptions = WantNone) override;
     qint64 writeDatagram(const char *data, qint64 len, const QIpPacketHeader &) override;
+#ifndef QT_NO_UDPSOCKET
+    int readDatagrams(char *data, qint64 maxlen, int maxCount, qint64 *sizes,
+                      QIpPacketHeader *headers, PacketHeaderOptions = WantNone) override;
+    int writeDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count) override;
+#endif
     qint64 bytesToWrite() const override;
 
 #if 0   // currently unused
@@ -120,6 +127,8 @@ public Q_SLOTS:
     void connectionNotification();
 
 private:
+    qint64 checkReadResult(qint64 readBytes);
+
     Q_DECLARE_PRIVATE(QNativeSocketEngine)
     Q_DISABLE_COPY_MOVE(QNativeSocketEngine)
 };
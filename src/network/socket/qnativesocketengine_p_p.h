@@ -144,8 +144,17 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#ifdef Q_OS_LINUX
+    int nativeReceiveDatagrams(char *data, qint64 maxLength, int maxCount, qint64 *sizes,
+                               QIpPacketHeader *headers, QAbstractSocketEngine::PacketHeaderOptions options);
+    int nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, int count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#ifndef Q_OS_WIN
+    qint64 nativeReadBlocks(char *const *data, const qint64 *sizes, int count);
+    qint64 nativeWriteBlocks(const char *const *data, const qint64 *sizes, int count);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -155,6 +164,20 @@ public:
     bool checkProxy(const QHostAddress &address);
     bool fetchConnectionParameters();
 
+#ifndef Q_OS_WIN
+    void parseDatagramHeader(msghdr *msg, const qt_sockaddr *aa, QIpPacketHeader *header) const;
+    int receiveDatagramError(int error);
+    void setDatagramMessageHeader(msghdr *msg, qt_sockaddr *aa, quintptr *cbuf,
+                                  const QIpPacketHeader &header);
+    int sendDatagramError(int error);
+    qint64 readError(int error);
+    qint64 writeError(int error);
+#endif
+#ifdef Q_OS_LINUX
+    // set once the kernel refused UDP segmentation offload on this socket
+    bool segmentationOffloadFailed = false;
+#endif
+
 #if QT_CONFIG(networkinterface)
     static uint scopeIdFromString(const QString &scopeid)
     { return QNetworkInterface::interfaceIndexFromName(scopeid); }
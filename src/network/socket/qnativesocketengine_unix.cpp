@@ -30,15 +30,16 @@
 #ifdef Q_OS_BSD4
 #include <net/if_dl.h>
 #endif
-#ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
-#endif
 
 #if defined QNATIVESOCKETENGINE_DEBUG
 #include <private/qdebug_p.h>
 #endif
 
 #include <netinet/tcp.h>
+#ifdef Q_OS_LINUX
+#include <netinet/udp.h>
+#endif
 #ifndef QT_NO_SCTP
 #include <sys/types.h>
 #include <sys/socket.h>
@@ -876,19 +877,112 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
-{
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+// The ancillary data of a datagram we receive; we use quintptr to force the alignment
+typedef quintptr DatagramReceiveControlBuffer[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
-                   + CMSG_SPACE(sizeof(sockaddr_dl))
+                                               + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
 #ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+                                               + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+                                               + sizeof(quintptr) - 1) / sizeof(quintptr)];
+
+/*
+    Fills in \a header from the sender address \a aa and the ancillary data
+    of \a msg, for a datagram just received.
+*/
+void QNativeSocketEnginePrivate::parseDatagramHeader(msghdr *msg, const qt_sockaddr *aa,
+                                                     QIpPacketHeader *header) const
+{
+    qt_socket_getPortAndAddress(aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
+        }
+
+#ifdef IP_PKTINFO
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
+#else
+#  ifdef IP_RECVDSTADDR
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
+#  endif
+#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
+#  endif
+#endif
+
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
+
+#ifndef QT_NO_SCTP
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+
+            header->streamNumber = int(rcvInfo->sinfo_stream);
+        }
+#endif
+    }
+}
+
+// Sets the error for a datagram that could not be received. Returns -2 if
+// no datagram was available for reading, else -1.
+int QNativeSocketEnginePrivate::receiveDatagramError(int error)
+{
+    switch (error) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    DatagramReceiveControlBuffer cbuf;
     struct msghdr msg;
     struct iovec vec;
     qt_sockaddr aa;
@@ -917,87 +1011,12 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     } while (recvResult == -1 && errno == EINTR);
 
     if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
-        }
+        recvResult = receiveDatagramError(errno);
         if (header)
             header->clear();
     } else if (options != QAbstractSocketEngine::WantNone) {
         Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
-
-#ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
-#else
-#  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
-#  endif
-#  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
-#  endif
-#endif
-
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
-
-#ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
-
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
-        }
+        parseDatagramHeader(&msg, &aa, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1012,37 +1031,35 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
-{
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+// The ancillary data of a datagram we send; we use quintptr to force the alignment
+typedef quintptr DatagramControlBuffer[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+                                        + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+                                        + sizeof(quintptr) - 1) / sizeof(quintptr)];
 
+/*
+    Sets the destination of \a msg to \a aa, and its ancillary data in \a cbuf,
+    as \a header says, for sending a datagram.
+*/
+void QNativeSocketEnginePrivate::setDatagramMessageHeader(msghdr *msg, qt_sockaddr *aa, quintptr *cbuf,
+                                                          const QIpPacketHeader &header)
+{
     struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
 
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    memset(aa, 0, sizeof(*aa));
+    msg->msg_control = cbuf;
+    msg->msg_controllen = 0;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
+        msg->msg_name = &aa->a;
         setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+                          aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(aa->a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1052,7 +1069,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1064,7 +1081,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1086,7 +1103,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1097,7 +1114,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1106,28 +1123,49 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
 
-    if (sentBytes < 0) {
-        switch (errno) {
+// Sets the error for a datagram that could not be sent. Returns -2 if
+// sending would have blocked, else -1.
+int QNativeSocketEnginePrivate::sendDatagramError(int error)
+{
+    switch (error) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+        break;
+    default:
+        setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
     }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    DatagramControlBuffer cbuf;
+    struct msghdr msg;
+    struct iovec vec;
+    qt_sockaddr aa;
+
+    memset(&msg, 0, sizeof(msg));
+    vec.iov_base = const_cast<char *>(data);
+    vec.iov_len = len;
+    msg.msg_iov = &vec;
+    msg.msg_iovlen = 1;
+    setDatagramMessageHeader(&msg, &aa, cbuf, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = sendDatagramError(errno);
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
@@ -1139,6 +1177,194 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#ifdef Q_OS_LINUX
+// The kernel handles at most UIO_MAXIOV messages per recvmmsg()/sendmmsg() call
+static constexpr int MaxDatagramBatch = 1024;
+
+int QNativeSocketEnginePrivate::nativeReceiveDatagrams(char *data, qint64 maxSize, int maxCount,
+                                                       qint64 *sizes, QIpPacketHeader *headers,
+                                                       QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    struct Slot {
+        qt_sockaddr aa;
+        iovec vec;
+        DatagramReceiveControlBuffer cbuf;
+        char c;
+    };
+
+    maxCount = qMin(maxCount, MaxDatagramBatch);
+    if (maxCount <= 0)
+        return 0;
+
+    const bool wantControl = options & (QAbstractSocketEngine::WantDatagramHopLimit
+                                        | QAbstractSocketEngine::WantDatagramDestination
+                                        | QAbstractSocketEngine::WantStreamNumber);
+    QVarLengthArray<Slot, 16> slotData(maxCount);
+    QVarLengthArray<mmsghdr, 16> msgs(maxCount);
+    memset(msgs.data(), 0, msgs.size() * sizeof(mmsghdr));
+    for (int i = 0; i < maxCount; ++i) {
+        Slot &slot = slotData[i];
+        msghdr &msg = msgs[i].msg_hdr;
+
+        // we need to receive at least one byte, even if our user isn't interested in it
+        slot.vec.iov_base = maxSize ? data + i * maxSize : &slot.c;
+        slot.vec.iov_len = maxSize ? maxSize : 1;
+        msg.msg_iov = &slot.vec;
+        msg.msg_iovlen = 1;
+        if (options & QAbstractSocketEngine::WantDatagramSender) {
+            memset(&slot.aa, 0, sizeof(slot.aa));
+            msg.msg_name = &slot.aa;
+            msg.msg_namelen = sizeof(slot.aa);
+        }
+        if (wantControl) {
+            msg.msg_control = slot.cbuf;
+            msg.msg_controllen = sizeof(slot.cbuf);
+        }
+    }
+
+    int count = qt_safe_recvmmsg(socketDescriptor, msgs.data(), maxCount, 0);
+    if (count < 0) {
+        count = receiveDatagramError(errno);
+        if (headers)
+            headers->clear();
+        return count;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        sizes[i] = maxSize ? qint64(msgs[i].msg_len) : 0;
+        if (options != QAbstractSocketEngine::WantNone) {
+            Q_ASSERT(headers);
+            parseDatagramHeader(&msgs[i].msg_hdr, &slotData[i].aa, headers + i);
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli, %i) == %i",
+           data, maxSize, maxCount, count);
+#endif
+
+    return count;
+}
+
+#if defined(UDP_SEGMENT) && defined(SOL_UDP)
+// Whether the datagram can be part of a buffer segmented by the kernel:
+// UDP segmentation offload sends all segments with the same ancillary data.
+static bool canSegmentDatagram(const QIpPacketHeader &header)
+{
+    return header.hopLimit == -1 && header.ifindex == 0 && header.senderAddress.isNull()
+            && header.streamNumber == -1;
+}
+#endif
+
+int QNativeSocketEnginePrivate::nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                    int count)
+{
+    struct Slot {
+        qt_sockaddr aa;
+        DatagramControlBuffer cbuf;
+    };
+
+    count = qMin(count, MaxDatagramBatch);
+    if (count <= 0)
+        return 0;
+
+    QVarLengthArray<iovec, 16> vecs(count);
+    for (int i = 0; i < count; ++i) {
+        vecs[i].iov_base = const_cast<char *>(datagrams[i]->data.constData());
+        vecs[i].iov_len = datagrams[i]->data.size();
+    }
+
+    QVarLengthArray<Slot, 16> slotData(count);
+    QVarLengthArray<mmsghdr, 16> msgs(count);
+    // the number of datagrams in each message
+    QVarLengthArray<int, 16> segments(count);
+    bool offload = !segmentationOffloadFailed;
+    int messageCount;
+    int sent;
+    forever {
+        bool segmented = false;
+        messageCount = 0;
+        memset(msgs.data(), 0, msgs.size() * sizeof(mmsghdr));
+        for (int i = 0; i < count; ++messageCount) {
+            const QIpPacketHeader &header = datagrams[i]->header;
+            msghdr *msg = &msgs[messageCount].msg_hdr;
+            int n = 1;
+#if defined(UDP_SEGMENT) && defined(SOL_UDP)
+            // Hand a run of datagrams of the same size to the same destination to
+            // the kernel as one buffer to cut into segments; only the last one may
+            // be shorter. The kernel limits the number of segments, and the buffer
+            // must fit into a single UDP datagram.
+            const size_t segmentSize = vecs[i].iov_len;
+            if (offload && segmentSize && canSegmentDatagram(header)) {
+                constexpr int MaxSegments = 64;
+                constexpr size_t MaxSegmentedSize = 65507;
+                size_t total = segmentSize;
+                while (i + n < count && n < MaxSegments) {
+                    const QIpPacketHeader &next = datagrams[i + n]->header;
+                    const size_t size = vecs[i + n].iov_len;
+                    if (size == 0 || size > segmentSize || total + size > MaxSegmentedSize
+                            || next.destinationPort != header.destinationPort
+                            || next.destinationAddress != header.destinationAddress
+                            || !canSegmentDatagram(next)) {
+                        break;
+                    }
+                    total += size;
+                    ++n;
+                    if (size < segmentSize)
+                        break;
+                }
+            }
+#endif
+            msg->msg_iov = &vecs[i];
+            msg->msg_iovlen = n;
+            setDatagramMessageHeader(msg, &slotData[messageCount].aa, slotData[messageCount].cbuf,
+                                     header);
+#if defined(UDP_SEGMENT) && defined(SOL_UDP)
+            if (n > 1) {
+                msg->msg_control = slotData[messageCount].cbuf;
+                msg->msg_controllen = CMSG_SPACE(sizeof(quint16));
+                struct cmsghdr *cmsgptr = CMSG_FIRSTHDR(msg);
+                cmsgptr->cmsg_level = SOL_UDP;
+                cmsgptr->cmsg_type = UDP_SEGMENT;
+                cmsgptr->cmsg_len = CMSG_LEN(sizeof(quint16));
+                const quint16 size = quint16(segmentSize);
+                memcpy(CMSG_DATA(cmsgptr), &size, sizeof(size));
+                segmented = true;
+            }
+#endif
+            segments[messageCount] = n;
+            i += n;
+        }
+
+        sent = qt_safe_sendmmsg(socketDescriptor, msgs.data(), messageCount, 0);
+        if (sent >= 0 || !segmented || errno == EAGAIN || errno == EWOULDBLOCK)
+            break;
+
+        // The kernel refused the segmented buffer: EIO means the device cannot
+        // compute the checksums, and EINVAL that the kernel or the socket options
+        // do not allow segmentation, so don't try again on this socket. Send
+        // this batch one datagram per message.
+        if (errno == EIO || errno == EINVAL)
+            segmentationOffloadFailed = true;
+        offload = false;
+    }
+
+    if (sent < 0)
+        return sendDatagramError(errno);
+
+    int datagramCount = 0;
+    for (int i = 0; i < sent; ++i)
+        datagramCount += segments[i];
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%p, %i) == %i (%i messages)",
+           datagrams, count, datagramCount, sent);
+#endif
+
+    return datagramCount;
+}
+#endif // Q_OS_LINUX
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1270,31 +1496,36 @@ void QNativeSocketEnginePrivate::nativeClose()
     qt_safe_close(socketDescriptor);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
+// Sets the error for data that could not be written. Returns 0 if writing
+// would have blocked, else -1.
+qint64 QNativeSocketEnginePrivate::writeError(int error)
 {
     Q_Q(QNativeSocketEngine);
 
+    switch (error) {
+    case EPIPE:
+    case ECONNRESET:
+        setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+        q->close();
+        break;
+    case EAGAIN:
+        return 0;
+    case EMSGSIZE:
+        setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
+        break;
+    default:
+        break;
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
+{
     ssize_t writtenBytes;
     writtenBytes = qt_safe_write_nosignal(socketDescriptor, data, len);
 
-    if (writtenBytes < 0) {
-        switch (errno) {
-        case EPIPE:
-        case ECONNRESET:
-            writtenBytes = -1;
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            q->close();
-            break;
-        case EAGAIN:
-            writtenBytes = 0;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        default:
-            break;
-        }
-    }
+    if (writtenBytes < 0)
+        writtenBytes = writeError(errno);
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEnginePrivate::nativeWrite(%p \"%s\", %llu) == %i", data,
@@ -1305,6 +1536,40 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 }
 /*
 */
+// Sets the error for a failed read. Returns -2 if no data was available for
+// reading, 0 if the peer reset the connection, else -1.
+qint64 QNativeSocketEnginePrivate::readError(int error)
+{
+    qint64 r = -1;
+    switch (error) {
+#if EWOULDBLOCK-0 && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No data was available for reading
+        r = -2;
+        break;
+    case ECONNRESET:
+#if defined(Q_OS_VXWORKS)
+    case ESHUTDOWN:
+#endif
+        r = 0;
+        break;
+    case ETIMEDOUT:
+        socketError = QAbstractSocket::SocketTimeoutError;
+        break;
+    default:
+        socketError = QAbstractSocket::NetworkError;
+        break;
+    }
+
+    if (r == -1) {
+        hasSetSocketError = true;
+        socketErrorString = qt_error_string(error);
+    }
+    return r;
+}
+
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
 {
     Q_Q(QNativeSocketEngine);
@@ -1316,44 +1581,74 @@ qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
     ssize_t r = 0;
     r = qt_safe_read(socketDescriptor, data, maxSize);
 
-    if (r < 0) {
-        r = -1;
-        switch (errno) {
-#if EWOULDBLOCK-0 && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No data was available for reading
-            r = -2;
-            break;
-        case ECONNRESET:
-#if defined(Q_OS_VXWORKS)
-        case ESHUTDOWN:
+    if (r < 0)
+        r = readError(errno);
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeRead(%p \"%s\", %llu) == %zd", data,
+           QtDebugUtils::toPrintable(data, r, 16).constData(), maxSize, r);
 #endif
-            r = 0;
-            break;
-        case ETIMEDOUT:
-            socketError = QAbstractSocket::SocketTimeoutError;
-            break;
-        default:
-            socketError = QAbstractSocket::NetworkError;
-            break;
-        }
 
-        if (r == -1) {
-            hasSetSocketError = true;
-            socketErrorString = qt_error_string();
-        }
+    return qint64(r);
+}
+
+// The most blocks passed to a single readv() or sendmsg() call, well below IOV_MAX
+static constexpr int MaxIoBlocks = 64;
+
+qint64 QNativeSocketEnginePrivate::nativeReadBlocks(char *const *data, const qint64 *sizes, int count)
+{
+    Q_Q(QNativeSocketEngine);
+    if (!q->isValid()) {
+        qWarning("QNativeSocketEngine::nativeReadBlocks: Invalid socket");
+        return -1;
+    }
+
+    iovec vecs[MaxIoBlocks];
+    count = qMin(count, MaxIoBlocks);
+    for (int i = 0; i < count; ++i) {
+        vecs[i].iov_base = data[i];
+        vecs[i].iov_len = sizes[i];
     }
 
+    ssize_t r;
+    EINTR_LOOP(r, ::readv(socketDescriptor, vecs, count));
+    if (r < 0)
+        r = readError(errno);
+
 #if defined (QNATIVESOCKETENGINE_DEBUG)
-    qDebug("QNativeSocketEnginePrivate::nativeRead(%p \"%s\", %llu) == %zd", data,
-           QtDebugUtils::toPrintable(data, r, 16).constData(), maxSize, r);
+    qDebug("QNativeSocketEnginePrivate::nativeReadBlocks(%p, %i) == %zd", data, count, r);
 #endif
 
     return qint64(r);
 }
 
+qint64 QNativeSocketEnginePrivate::nativeWriteBlocks(const char *const *data, const qint64 *sizes,
+                                                     int count)
+{
+    iovec vecs[MaxIoBlocks];
+    count = qMin(count, MaxIoBlocks);
+    for (int i = 0; i < count; ++i) {
+        vecs[i].iov_base = const_cast<char *>(data[i]);
+        vecs[i].iov_len = sizes[i];
+    }
+
+    // sendmsg() rather than writev(), for MSG_NOSIGNAL
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vecs;
+    msg.msg_iovlen = count;
+    ssize_t writtenBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (writtenBytes < 0)
+        writtenBytes = writeError(errno);
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteBlocks(%p, %i) == %zd", data, count,
+           writtenBytes);
+#endif
+
+    return qint64(writtenBytes);
+}
+
 int QNativeSocketEnginePrivate::nativeSelect(int timeout, bool selectForRead) const
 {
     bool dummy;
@@ -33,6 +33,10 @@
     pendingDatagramSize() to obtain the size of the first pending
     datagram, and readDatagram() or receiveDatagram() to read it.
 
+    Applications that handle many datagrams can send and receive them in
+    batches with writeDatagrams() and receiveDatagrams(), which saves a system
+    call per datagram on platforms that support it.
+
     \note An incoming datagram should be read when you receive the readyRead()
     signal, otherwise this signal will not be emitted for the next datagram.
 
@@ -66,6 +70,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -89,6 +94,11 @@ public:
 
     inline bool ensureInitialized(const QHostAddress &remoteAddress)
     { return doEnsureInitialized(QHostAddress(), 0, remoteAddress); }
+
+    // receiveDatagrams() reads into this buffer, reused from one call to the
+    // next, with room for receiveBatchSize datagrams
+    QByteArray datagramBuffer;
+    int receiveBatchSize = 8;
 };
 
 bool QUdpSocketPrivate::doEnsureInitialized(const QHostAddress &bindAddress, quint16 bindPort,
@@ -395,6 +405,154 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.6
+
+    Sends the \a datagrams, each one to the host address and port number
+    contained in it, as writeDatagram() does. On Linux, the datagrams are
+    handed to the operating system with a single system call where possible,
+    which is faster than calling writeDatagram() for each of them.
+
+    Returns the number of datagrams sent, which can be less than the size of
+    \a datagrams if the socket's send buffer filled up, or -1 if none could be
+    sent. bytesWritten() is emitted once, with the total size of the datagrams
+    sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qint64 QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld datagrams)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.first().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> list;
+    list.reserve(datagrams.size());
+    for (const QNetworkDatagram &datagram : datagrams)
+        list.append(datagram.d);
+
+    qsizetype count = 0;
+    qint64 bytes = 0;
+    int sent = 0;
+    while (count < list.size()) {
+        sent = d->socketEngine->writeDatagrams(list.constData() + count,
+                                               int(qMin(list.size() - count, qsizetype(INT_MAX))));
+        if (sent <= 0)
+            break;
+        for (int i = 0; i < sent; ++i)
+            bytes += list[count + i]->data.size();
+        count += sent;
+    }
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (count)
+        emit bytesWritten(bytes);
+    if (sent == -1 || count == 0) {
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        if (count == 0)
+            return -1;
+    }
+    return count;
+}
+
+/*!
+    \since 6.6
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them along with their IP header fields, as
+    receiveDatagram() does. On Linux, all of them are read with a single system
+    call, which is faster than calling receiveDatagram() for each of them.
+
+    If \a maxSize is -1 (the default), each datagram is read entirely. The
+    datagrams are read into a buffer kept by the socket, whose size is bounded
+    and follows the number of datagrams the previous calls read; this function
+    may return fewer than \a maxCount datagrams even if more are pending,
+    in particular at the start of a burst or with large values of \a maxSize.
+
+    Returns an empty list if no datagram is pending or an error occurred.
+
+    \sa receiveDatagram(), hasPendingDatagrams(), writeDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(int maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%d, %lld)", maxCount, maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    // the largest datagram UDP over IPv6 can carry, and the size of the buffer
+    // beyond which fewer datagrams are read
+    constexpr qint64 MaxDatagramSize = 65536;
+    constexpr qint64 MaxBufferSize = 4 * 1024 * 1024;
+    if (maxSize < 0)
+        maxSize = MaxDatagramSize;
+    maxCount = int(qMin(qint64(maxCount), qMax(MaxBufferSize / qMax(maxSize, qint64(1)), qint64(1))));
+    if (maxCount <= 0)
+        return QList<QNetworkDatagram>();
+
+    // The buffer holds as many datagrams as the previous call read, doubling
+    // when they filled it, so that it grows during a burst and is released
+    // once the burst is over.
+    maxCount = qMin(maxCount, d->receiveBatchSize);
+    const qint64 bufferSize = maxCount * maxSize;
+    if (d->datagramBuffer.size() < bufferSize || d->datagramBuffer.size() > 4 * bufferSize)
+        d->datagramBuffer = QByteArray(bufferSize, Qt::Uninitialized);
+    QVarLengthArray<qint64, 64> sizes(maxCount);
+    QVarLengthArray<QIpPacketHeader, 64> headers(maxCount);
+    char *buffer = d->datagramBuffer.data();
+    int count = d->socketEngine->readDatagrams(buffer, maxSize, maxCount, sizes.data(),
+                                               headers.data(), QAbstractSocketEngine::WantAll);
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    if (count < 0) {
+        if (count == -1)
+            d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+        return QList<QNetworkDatagram>();
+    }
+
+    if (count == maxCount && maxCount == d->receiveBatchSize)
+        d->receiveBatchSize = int(qMin(2 * qint64(maxCount), MaxBufferSize / qMax(maxSize, qint64(1))));
+    else if (count < d->receiveBatchSize / 4)
+        d->receiveBatchSize = qMax(d->receiveBatchSize / 2, 1);
+    if (count == 0)
+        return QList<QNetworkDatagram>();
+
+    // The datagrams share a single allocation, each followed by the null
+    // byte that terminates QByteArray data.
+    qint64 totalSize = 0;
+    for (int i = 0; i < count; ++i)
+        totalSize += sizes[i] + 1;
+    QByteArray data(totalSize, Qt::Uninitialized);
+    char *out = data.data();
+    for (int i = 0; i < count; ++i) {
+        memcpy(out, buffer + i * maxSize, sizes[i]);
+        out[sizes[i]] = '\0';
+        out += sizes[i] + 1;
+    }
+
+    QList<QNetworkDatagram> result;
+    result.reserve(count);
+    out = data.data();
+    for (int i = 0; i < count; ++i) {
+        QByteArray::DataPointer slice(data.data_ptr());
+        slice.ptr = out;
+        slice.size = sizes[i];
+        out += sizes[i] + 1;
+        result.append(QNetworkDatagram(*new QNetworkDatagramPrivate(QByteArray(std::move(slice)),
+                                                                    headers[i])));
+    }
+    return result;
+}
+
 /*!
     \since 5.8
 
@@ -117,7 +117,10 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     option can allow connections for legacy servers, but it introduces the
     possibility that an attacker could inject plaintext into the SSL session.
     \value SslOptionDisableSessionSharing Disables SSL session sharing via
-    the session ID handshake attribute.
+    the session ID handshake attribute. With the OpenSSL backend, client
+    sockets otherwise share their sessions through a process-wide cache, so
+    that a new connection to the same peer and port, with the same
+    configuration, can resume the session of an earlier one (since Qt 6.6).
     \value SslOptionDisableSessionPersistence Disables storing the SSL session
     in ASN.1 format as returned by QSslConfiguration::sessionTicket(). Enabling
     this feature adds memory overhead of approximately 1K per used session
@@ -126,6 +129,13 @@ Q_LOGGING_CATEGORY(lcSsl, "qt.network.ssl");
     chosen based on the servers preferences rather than the order ciphers were
     sent by the client. This option is only relevant to server sockets, and is
     only honored by the OpenSSL backend.
+    \value SslOptionEnableKernelTls Lets the kernel encrypt the data sent once
+    the handshake is complete (since Qt 6.6). This option is only honored by
+    the OpenSSL backend on Linux, with OpenSSL 3.0 or later built with kernel
+    TLS support, and for connections that do not go through a proxy. If the
+    kernel cannot encrypt the data, for example because its \c tls module is
+    not available or does not support the negotiated cipher, OpenSSL encrypts
+    it as usual.
 
     By default, SslOptionDisableEmptyFragments is turned on since this causes
     problems with a large number of servers. SslOptionDisableLegacyRenegotiation
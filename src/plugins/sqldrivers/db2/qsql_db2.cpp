@@ -1571,6 +1571,9 @@ bool QDB2Driver::hasFeature(DriverFeature f) const
         case SimpleLocking:
         case EventNotifications:
         case CancelQuery:
+        case BatchFetch:
+        case PipelinedBatches:
+        case BulkInsert:
             return false;
         case BLOB:
         case Transactions:
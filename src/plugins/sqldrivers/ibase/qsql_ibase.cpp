@@ -1395,6 +1395,9 @@ bool QIBaseDriver::hasFeature(DriverFeature f) const
     case FinishQuery:
     case MultipleResultSets:
     case CancelQuery:
+    case BatchFetch:
+    case PipelinedBatches:
+    case BulkInsert:
         return false;
     case Transactions:
     case PreparedQueries:
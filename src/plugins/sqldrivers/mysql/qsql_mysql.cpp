@@ -59,7 +59,18 @@ class QMYSQLDriverPrivate : public QSqlDriverPrivate
 
 public:
     QMYSQLDriverPrivate() : QSqlDriverPrivate(QSqlDriver::MySqlServer)
-    {}
+    {
+#if QT_CONFIG(thread)
+        canExecInThread = true;
+#endif
+    }
+
+#if QT_CONFIG(thread)
+    // Every thread that calls the client library must initialize it.
+    void execThreadStarted() override { mysql_thread_init(); }
+    void execThreadFinished() override { mysql_thread_end(); }
+#endif
+
     MYSQL *mysql = nullptr;
     QString dbName;
     bool preparedQuerysEnabled = false;
@@ -1124,6 +1135,9 @@ bool QMYSQLDriver::hasFeature(DriverFeature f) const
     case EventNotifications:
     case FinishQuery:
     case CancelQuery:
+    case BatchFetch:
+    case PipelinedBatches:
+    case BulkInsert:
         return false;
     case QuerySize:
     case BLOB:
@@ -2176,6 +2176,9 @@ bool QOCIDriver::hasFeature(DriverFeature f) const
     case EventNotifications:
     case FinishQuery:
     case CancelQuery:
+    case BatchFetch:
+    case PipelinedBatches:
+    case BulkInsert:
     case MultipleResultSets:
         return false;
     case Unicode:
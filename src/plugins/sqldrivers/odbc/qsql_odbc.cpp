@@ -19,6 +19,7 @@
 #include <qvarlengtharray.h>
 #include <QDebug>
 #include <QSqlQuery>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtSql/private/qsqlresult_p.h>
 
@@ -201,6 +202,10 @@ public:
 
     bool isStmtHandleValid() const;
     void updateStmtHandleState();
+    void fetchBatch(QSqlColumnBatch *batch, int maxRows);
+    void appendBatchValue(QSqlColumnBatchPrivate *batch, int column);
+
+    QByteArray batchBuffer;
 };
 
 bool QODBCResultPrivate::isStmtHandleValid() const
@@ -1865,8 +1870,101 @@ bool QODBCResult::nextResult()
     return true;
 }
 
+// Appends the value of column in the current row to batch. ODBC converts
+// numbers for us, and narrow strings are copied without going through QString.
+void QODBCResultPrivate::appendBatchValue(QSqlColumnBatchPrivate *batch, int column)
+{
+    SQLLEN lengthIndicator = 0;
+    SQLRETURN r = SQL_ERROR;
+    switch (batch->columnType(column)) {
+    case QSqlColumnBatch::Int64: {
+        SQLBIGINT value = 0;
+        r = SQLGetData(hStmt, column + 1, SQL_C_SBIGINT, (SQLPOINTER)&value, sizeof(value),
+                       &lengthIndicator);
+        if ((r == SQL_SUCCESS || r == SQL_SUCCESS_WITH_INFO) && lengthIndicator != SQL_NULL_DATA)
+            batch->appendInt64(column, qint64(value));
+        else
+            batch->appendNull(column);
+        return;
+    }
+    case QSqlColumnBatch::Double: {
+        SQLDOUBLE value = 0;
+        r = SQLGetData(hStmt, column + 1, SQL_C_DOUBLE, (SQLPOINTER)&value, sizeof(value),
+                       &lengthIndicator);
+        if ((r == SQL_SUCCESS || r == SQL_SUCCESS_WITH_INFO) && lengthIndicator != SQL_NULL_DATA)
+            batch->appendDouble(column, double(value));
+        else
+            batch->appendNull(column);
+        return;
+    }
+    case QSqlColumnBatch::Bytes:
+        break;
+    }
+
+    const QSqlField info = rInf.field(column);
+    if (info.metaType().id() == QMetaType::QByteArray || unicode) {
+        const QVariant value = info.metaType().id() == QMetaType::QByteArray
+                ? qGetBinaryData(hStmt, column)
+                : qGetStringData(hStmt, column, info.length(), unicode);
+        batch->appendValue(column, value);
+        return;
+    }
+
+    // As in qGetStringData(), the driver sends UTF-8.
+    batchBuffer.resize(0);
+    char chunk[4096];
+    while (true) {
+        r = SQLGetData(hStmt, column + 1, SQL_C_CHAR, (SQLPOINTER)chunk, sizeof(chunk),
+                       &lengthIndicator);
+        if (r == SQL_NO_DATA)
+            break;
+        if ((r != SQL_SUCCESS && r != SQL_SUCCESS_WITH_INFO) || lengthIndicator == SQL_NULL_DATA) {
+            batch->appendNull(column);
+            return;
+        }
+        // A truncated chunk is terminated by \0, and lengthIndicator is the
+        // length of the whole value (or SQL_NO_TOTAL).
+        const bool truncated = lengthIndicator == SQL_NO_TOTAL
+                || lengthIndicator >= SQLLEN(sizeof(chunk));
+        qsizetype size = truncated ? qsizetype(sizeof(chunk)) - 1 : qsizetype(lengthIndicator);
+        // Remove any trailing \0 as some drivers misguidedly append one
+        if (!truncated && size > 0 && chunk[size - 1] == 0)
+            --size;
+        batchBuffer.append(chunk, size);
+        if (!truncated)
+            break;
+    }
+    batch->appendBytes(column, batchBuffer.constData(), batchBuffer.size());
+}
+
+void QODBCResultPrivate::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_Q(QODBCResult);
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(*batch);
+    b->reset(rInf, q->numericalPrecisionPolicy(), maxRows);
+    const int columnCount = int(b->columns.size());
+    while (b->rowCount < maxRows) {
+        if (!(q->at() == QSql::BeforeFirstRow ? q->fetchFirst() : q->fetchNext())) {
+            q->setAt(QSql::AfterLastRow);
+            break;
+        }
+        b->beginRow();
+        // Columns are read in order, which is all some drivers support.
+        for (int i = 0; i < columnCount; ++i)
+            appendBatchValue(b, i);
+        b->endRow();
+    }
+}
+
 void QODBCResult::virtual_hook(int id, void *data)
 {
+    Q_D(QODBCResult);
+    if (id == FetchColumnBatch && d->hStmt && !d->rInf.isEmpty()) {
+        auto *fetch = static_cast<QSqlColumnBatchFetch *>(data);
+        d->fetchBatch(fetch->batch, fetch->maxRows);
+        fetch->handled = true;
+        return;
+    }
     QSqlResult::virtual_hook(id, data);
 }
 
@@ -1927,12 +2025,15 @@ bool QODBCDriver::hasFeature(DriverFeature f) const
     case PositionalPlaceholders:
     case FinishQuery:
     case LowPrecisionNumbers:
+    case BatchFetch:
         return true;
     case QuerySize:
     case NamedPlaceholders:
     case BatchOperations:
     case SimpleLocking:
     case EventNotifications:
+    case PipelinedBatches:
+    case BulkInsert:
     case CancelQuery:
         return false;
     case LastInsertId:
@@ -15,6 +15,9 @@
 #include <qsocketnotifier.h>
 #include <qstringlist.h>
 #include <qlocale.h>
+#include <quuid.h>
+#include <QtCore/qendian.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqlresult_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <QtCore/private/qlocale_tools_p.h>
@@ -25,12 +28,20 @@
 #include <pg_config.h>
 
 #include <cmath>
+#include <cstring>
 
 // workaround for postgres defining their OIDs in a private header file
 #define QBOOLOID 16
+#define QNAMEOID 19
 #define QINT8OID 20
 #define QINT2OID 21
 #define QINT4OID 23
+#define QTEXTOID 25
+#define QJSONOID 114
+#define QBPCHAROID 1042
+#define QVARCHAROID 1043
+#define QUUIDOID 2950
+#define QJSONBOID 3802
 #define QNUMERICOID 1700
 #define QFLOAT4OID 700
 #define QFLOAT8OID 701
@@ -77,6 +88,21 @@ inline void qPQfreemem(void *buffer)
 static const int PGRES_SINGLE_TUPLE = 9;
 #endif
 
+// Whether result holds some of the rows of a result set read by a
+// forward-only query, with more to come.
+static bool qIsPartialResult(const PGresult *result)
+{
+    switch (PQresultStatus(result)) {
+    case PGRES_SINGLE_TUPLE:
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    case PGRES_TUPLES_CHUNK:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
 typedef int StatementId;
 static const StatementId InvalidStatementId = 0;
 
@@ -109,6 +135,7 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+    bool execBatch(bool arrayBind) override;
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -123,6 +150,7 @@ public:
     QPSQLDriver::Protocol pro = QPSQLDriver::Version6;
     StatementId currentStmtId = InvalidStatementId;
     int stmtCount = 0;
+    int fetchSize = 1; // the rows forward-only queries receive at a time
     mutable bool pendingNotifyCheck = false;
     bool hasBackslashEscape = false;
     bool isUtf8 = false;
@@ -194,6 +222,13 @@ bool QPSQLDriverPrivate::setSingleRowMode() const
     // Activates single-row mode for last sent query, see:
     // https://www.postgresql.org/docs/9.2/static/libpq-single-row-mode.html
     // This method should be called immediately after the sendQuery() call.
+    // With a fetch size, libpq 17 and later deliver the rows in chunks of
+    // that many rows instead. This path has not been run against a libpq
+    // that provides chunked mode yet.
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    if (fetchSize > 1)
+        return PQsetChunkedRowsMode(connection, fetchSize) > 0;
+#endif
 #if defined PG_VERSION_NUM && PG_VERSION_NUM-0 >= 90200
     return PQsetSingleRowMode(connection) > 0;
 #else
@@ -264,10 +299,28 @@ public:
     PGresult *result = nullptr;
     StatementId stmtId = InvalidStatementId;
     int currentSize = -1;
+    int resultRow = 0; // the row of result a forward-only query is on
+    int batchRowsAffected = -1; // the rows changed by the last pipelined execBatch()
     bool canFetchMoreRows = false;
     bool preparedQueriesEnabled = false;
 
     bool processResults();
+    void fetchBatch(QSqlColumnBatch *batch, int maxRows);
+    bool boundColumns(QList<QVariantList> *columns);
+    bool copyIn(const QString &tableName, const QStringList &fieldNames);
+#if defined(LIBPQ_HAS_PIPELINING)
+    bool execPipelined();
+#endif
+#if QT_CONFIG(future)
+    bool execAsync(const QString *query, QPromise<bool> &promise);
+    void readAsyncResults();
+    void finishAsync(bool success);
+
+    QPromise<bool> asyncPromise;
+    QSocketNotifier *asyncNotifier = nullptr; // unless the driver's one for notifications is used
+    QMetaObject::Connection asyncConnection;
+    bool asyncPending = false;
+#endif
 };
 
 static QSqlError qMakeError(const QString &err, QSqlError::ErrorType type,
@@ -307,6 +360,9 @@ bool QPSQLResultPrivate::processResults()
         canFetchMoreRows = false;
         return true;
     case PGRES_SINGLE_TUPLE:
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    case PGRES_TUPLES_CHUNK:
+#endif
         q->setSelect(true);
         q->setActive(true);
         currentSize = -1;
@@ -414,6 +470,10 @@ QVariant QPSQLResult::handle() const
 void QPSQLResult::cleanup()
 {
     Q_D(QPSQLResult);
+#if QT_CONFIG(future)
+    if (d->asyncPending)
+        d->finishAsync(false);
+#endif
     if (d->result)
         PQclear(d->result);
     d->result = nullptr;
@@ -428,6 +488,8 @@ void QPSQLResult::cleanup()
     d->stmtId = InvalidStatementId;
     setAt(QSql::BeforeFirstRow);
     d->currentSize = -1;
+    d->resultRow = 0;
+    d->batchRowsAffected = -1;
     d->canFetchMoreRows = false;
     setActive(false);
 }
@@ -459,7 +521,7 @@ bool QPSQLResult::fetch(int i)
 
 bool QPSQLResult::fetchFirst()
 {
-    Q_D(const QPSQLResult);
+    Q_D(QPSQLResult);
     if (!isActive())
         return false;
     if (at() == 0)
@@ -470,6 +532,7 @@ bool QPSQLResult::fetchFirst()
             // First result has been already fetched by exec() or
             // nextResult(), just check it has at least one row.
             if (d->result && PQntuples(d->result) > 0) {
+                d->resultRow = 0;
                 setAt(0);
                 return true;
             }
@@ -515,6 +578,12 @@ bool QPSQLResult::fetchNext()
         return false;
 
     if (isForwardOnly()) {
+        if (d->resultRow + 1 < PQntuples(d->result)) {
+            // Next row of the current chunk
+            ++d->resultRow;
+            setAt(currentRow + 1);
+            return true;
+        }
         if (!d->canFetchMoreRows)
             return false;
         PQclear(d->result);
@@ -528,13 +597,17 @@ bool QPSQLResult::fetchNext()
         int status = PQresultStatus(d->result);
         switch (status) {
         case PGRES_SINGLE_TUPLE:
-            // Fetched next row of current result set
-            Q_ASSERT(PQntuples(d->result) == 1);
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+        case PGRES_TUPLES_CHUNK:
+#endif
+            // Fetched next row, or chunk of rows, of current result set
+            Q_ASSERT(PQntuples(d->result) > 0);
             Q_ASSERT(d->canFetchMoreRows);
+            d->resultRow = 0;
             setAt(currentRow + 1);
             return true;
         case PGRES_TUPLES_OK:
-            // In single-row mode PGRES_TUPLES_OK means end of current result set
+            // In single-row and chunked mode PGRES_TUPLES_OK means end of current result set
             Q_ASSERT(PQntuples(d->result) == 0);
             d->canFetchMoreRows = false;
             return false;
@@ -559,11 +632,12 @@ bool QPSQLResult::nextResult()
         return false;
 
     setAt(QSql::BeforeFirstRow);
+    d->resultRow = 0;
 
     if (isForwardOnly()) {
         if (d->canFetchMoreRows) {
             // Skip all rows from current result set
-            while (d->result && PQresultStatus(d->result) == PGRES_SINGLE_TUPLE) {
+            while (d->result && qIsPartialResult(d->result)) {
                 PQclear(d->result);
                 d->result = d->drv_d_func()->getResult(d->stmtId);
             }
@@ -589,6 +663,23 @@ bool QPSQLResult::nextResult()
     return d->processResults();
 }
 
+static bool qParsePSQLDouble(const char *val, double *dbl)
+{
+    bool ok;
+    *dbl = qstrtod(val, nullptr, &ok);
+    if (ok)
+        return true;
+    if (qstricmp(val, "NaN") == 0)
+        *dbl = qQNaN();
+    else if (qstricmp(val, "Infinity") == 0)
+        *dbl = qInf();
+    else if (qstricmp(val, "-Infinity") == 0)
+        *dbl = -qInf();
+    else
+        return false;
+    return true;
+}
+
 QVariant QPSQLResult::data(int i)
 {
     Q_D(const QPSQLResult);
@@ -596,7 +687,7 @@ QVariant QPSQLResult::data(int i)
         qWarning("QPSQLResult::data: column %d out of range", i);
         return QVariant();
     }
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = isForwardOnly() ? d->resultRow : at();
     int ptype = PQftype(d->result, i);
     QMetaType type = qDecodePSQLType(ptype);
     if (PQgetisnull(d->result, currentRow, i))
@@ -619,18 +710,9 @@ QVariant QPSQLResult::data(int i)
             if (numericalPrecisionPolicy() == QSql::HighPrecision)
                 return QString::fromLatin1(val);
         }
-        bool ok;
-        double dbl = qstrtod(val, nullptr, &ok);
-        if (!ok) {
-            if (qstricmp(val, "NaN") == 0)
-                dbl = qQNaN();
-            else if (qstricmp(val, "Infinity") == 0)
-                dbl = qInf();
-            else if (qstricmp(val, "-Infinity") == 0)
-                dbl = -qInf();
-            else
-                return QVariant();
-        }
+        double dbl;
+        if (!qParsePSQLDouble(val, &dbl))
+            return QVariant();
         if (ptype == QNUMERICOID) {
             if (numericalPrecisionPolicy() == QSql::LowPrecisionInt64)
                 return QVariant((qlonglong)dbl);
@@ -673,10 +755,88 @@ QVariant QPSQLResult::data(int i)
     return QVariant();
 }
 
+// Reads the rows from the text PostgreSQL sent straight into the column
+// buffers of batch, the way data() would convert them.
+void QPSQLResultPrivate::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_Q(QPSQLResult);
+    const int columnCount = PQnfields(result);
+    QVarLengthArray<Oid> oids(columnCount);
+    QVarLengthArray<int> metaTypes(columnCount);
+    QList<QSqlColumnBatch::ColumnType> types(columnCount);
+    for (int i = 0; i < columnCount; ++i) {
+        oids[i] = PQftype(result, i);
+        const QMetaType metaType = qDecodePSQLType(oids[i]);
+        metaTypes[i] = metaType.id();
+        types[i] = QSqlColumnBatchPrivate::columnType(metaType, q->numericalPrecisionPolicy());
+    }
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(*batch);
+    b->reset(types, maxRows);
+    const bool isUtf8 = drv_d_func()->isUtf8;
+
+    while (b->rowCount < maxRows) {
+        // In single-row and chunked mode, this may replace result with the
+        // next rows'.
+        if (!q->fetchNext()) {
+            q->setAt(QSql::AfterLastRow);
+            break;
+        }
+        const int row = q->isForwardOnly() ? resultRow : q->at();
+        b->beginRow();
+        for (int i = 0; i < columnCount; ++i) {
+            if (PQgetisnull(result, row, i)) {
+                b->appendNull(i);
+                continue;
+            }
+            const char *val = PQgetvalue(result, row, i);
+            switch (b->columnType(i)) {
+            case QSqlColumnBatch::Int64:
+                if (metaTypes[i] == QMetaType::Bool) {
+                    b->appendInt64(i, val[0] == 't');
+                } else if (metaTypes[i] == QMetaType::Double) {
+                    // with a low precision integer policy
+                    double dbl;
+                    if (qParsePSQLDouble(val, &dbl))
+                        b->appendInt64(i, qint64(dbl));
+                    else
+                        b->appendNull(i);
+                } else {
+                    b->appendInt64(i, std::strtoll(val, nullptr, 10));
+                }
+                break;
+            case QSqlColumnBatch::Double: {
+                double dbl;
+                if (qParsePSQLDouble(val, &dbl))
+                    b->appendDouble(i, dbl);
+                else
+                    b->appendNull(i);
+                break;
+            }
+            case QSqlColumnBatch::Bytes:
+                if (oids[i] == QBYTEAOID) {
+                    size_t len;
+                    unsigned char *data =
+                            PQunescapeBytea(reinterpret_cast<const unsigned char *>(val), &len);
+                    b->appendBytes(i, reinterpret_cast<const char *>(data), qsizetype(len));
+                    qPQfreemem(data);
+                } else if (isUtf8) {
+                    b->appendBytes(i, val, PQgetlength(result, row, i));
+                } else {
+                    const QByteArray utf8 =
+                            QString::fromLatin1(val, PQgetlength(result, row, i)).toUtf8();
+                    b->appendBytes(i, utf8.constData(), utf8.size());
+                }
+                break;
+            }
+        }
+        b->endRow();
+    }
+}
+
 bool QPSQLResult::isNull(int field)
 {
     Q_D(const QPSQLResult);
-    const int currentRow = isForwardOnly() ? 0 : at();
+    const int currentRow = isForwardOnly() ? d->resultRow : at();
     return PQgetisnull(d->result, currentRow, field);
 }
 
@@ -717,6 +877,8 @@ int QPSQLResult::size()
 int QPSQLResult::numRowsAffected()
 {
     Q_D(const QPSQLResult);
+    if (d->batchRowsAffected >= 0)
+        return d->batchRowsAffected;
     const char *tuples = PQcmdTuples(d->result);
     return QByteArray::fromRawData(tuples, qstrlen(tuples)).toInt();
 }
@@ -810,6 +972,26 @@ QSqlRecord QPSQLResult::record() const
 void QPSQLResult::virtual_hook(int id, void *data)
 {
     Q_ASSERT(data);
+    Q_D(QPSQLResult);
+    if (id == FetchColumnBatch && d->result) {
+        auto *fetch = static_cast<QSqlColumnBatchFetch *>(data);
+        d->fetchBatch(fetch->batch, fetch->maxRows);
+        fetch->handled = true;
+        return;
+    }
+    if (id == BulkInsertColumns) {
+        auto *insert = static_cast<QSqlBulkInsert *>(data);
+        insert->result = d->copyIn(insert->tableName, insert->fieldNames);
+        insert->handled = true;
+        return;
+    }
+#if QT_CONFIG(future)
+    if (id == ExecAsync) {
+        auto *exec = static_cast<QSqlAsyncExec *>(data);
+        exec->handled = d->execAsync(exec->query, exec->promise);
+        return;
+    }
+#endif
     QSqlResult::virtual_hook(id, data);
 }
 
@@ -833,6 +1015,13 @@ static QString qCreateParamString(const QList<QVariant> &boundValues, const QSql
     return params;
 }
 
+static QString qMakeExecuteStmt(const QString &preparedStmtId, const QString &params)
+{
+    if (params.isEmpty())
+        return QStringLiteral("EXECUTE %1").arg(preparedStmtId);
+    return QStringLiteral("EXECUTE %1 (%2)").arg(preparedStmtId, params);
+}
+
 QString qMakePreparedStmtId()
 {
     Q_CONSTINIT static QBasicAtomicInt qPreparedStmtCount = Q_BASIC_ATOMIC_INITIALIZER(0);
@@ -877,13 +1066,8 @@ bool QPSQLResult::exec()
 
     cleanup();
 
-    QString stmt;
-    const QString params = qCreateParamString(boundValues(), driver());
-    if (params.isEmpty())
-        stmt = QStringLiteral("EXECUTE %1").arg(d->preparedStmtId);
-    else
-        stmt = QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
-
+    const QString stmt = qMakeExecuteStmt(d->preparedStmtId,
+                                          qCreateParamString(boundValues(), driver()));
     d->stmtId = d->drv_d_func()->sendQuery(stmt);
     if (d->stmtId == InvalidStatementId) {
         setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
@@ -903,6 +1087,618 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+#if QT_CONFIG(future)
+bool QPSQLResultPrivate::execAsync(const QString *query, QPromise<bool> &promise)
+{
+    Q_Q(QPSQLResult);
+    // Without server-side prepared statements, QSqlResult::exec() replaces
+    // the placeholders; leave that to a thread.
+    if (!query && !preparedQueriesEnabled)
+        return false;
+    QPSQLDriverPrivate *drv = drv_d_func();
+    if (!drv || !q->driver()->isOpen() || q->driver()->isOpenError())
+        return false;
+    const int socket = PQsocket(drv->connection);
+    if (socket == -1)
+        return false;
+
+    q->cleanup();
+    asyncPromise = std::move(promise);
+    asyncPromise.start();
+    asyncPending = true;
+
+    const QString stmt = query ? *query
+                               : qMakeExecuteStmt(preparedStmtId,
+                                                  qCreateParamString(q->boundValues(), q->driver()));
+    stmtId = drv->sendQuery(stmt);
+    if (stmtId == InvalidStatementId) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to send query"), QSqlError::StatementError, drv));
+        finishAsync(false);
+        return true;
+    }
+
+    if (q->isForwardOnly())
+        q->setForwardOnly(drv->setSingleRowMode());
+
+    // Only one notifier may watch the socket, so share the driver's if it
+    // listens for notifications.
+    QSocketNotifier *notifier = drv->sn;
+    if (!notifier)
+        notifier = asyncNotifier = new QSocketNotifier(socket, QSocketNotifier::Read);
+    asyncConnection = QObject::connect(notifier, &QSocketNotifier::activated,
+                                       [this] { readAsyncResults(); });
+    return true;
+}
+
+void QPSQLResultPrivate::readAsyncResults()
+{
+    Q_Q(QPSQLResult);
+    QPSQLDriverPrivate *drv = drv_d_func();
+    if (!drv || stmtId != drv->currentStmtId) {
+        // processResults() reports the results as lost
+        finishAsync(drv && processResults());
+        return;
+    }
+    if (!PQconsumeInput(drv->connection)) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to receive results"), QSqlError::ConnectionError, drv));
+        finishAsync(false);
+        return;
+    }
+
+    // Like reset(), take the first result set of a forward-only query and
+    // all of them otherwise, as far as they have arrived.
+    while (!PQisBusy(drv->connection)) {
+        PGresult *nextResult = drv->getResult(stmtId);
+        if (!result) {
+            result = nextResult;
+            if (!result || q->isForwardOnly()) {
+                finishAsync(processResults());
+                return;
+            }
+        } else if (nextResult) {
+            nextResultSets.push(nextResult);
+        } else {
+            finishAsync(processResults());
+            return;
+        }
+    }
+}
+
+void QPSQLResultPrivate::finishAsync(bool success)
+{
+    QObject::disconnect(asyncConnection);
+    if (asyncNotifier) {
+        // We may be in a slot connected to it
+        asyncNotifier->setEnabled(false);
+        asyncNotifier->deleteLater();
+        asyncNotifier = nullptr;
+    }
+    asyncPending = false;
+    // Continuations may execute the next query right away.
+    QPromise<bool> promise(std::move(asyncPromise));
+    promise.addResult(success);
+    promise.finish();
+}
+#endif // QT_CONFIG(future)
+
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+#if defined(LIBPQ_HAS_PIPELINING)
+    Q_D(QPSQLResult);
+    if (d->preparedQueriesEnabled && !d->preparedStmtId.isEmpty() && !d->values.isEmpty())
+        return d->execPipelined();
+#endif
+    return QSqlResult::execBatch(arrayBind);
+}
+
+// Converts the bound lists once; they must all have the same size.
+bool QPSQLResultPrivate::boundColumns(QList<QVariantList> *columns)
+{
+    Q_Q(QPSQLResult);
+    columns->reserve(values.size());
+    for (const QVariant &value : std::as_const(values)) {
+        columns->append(value.toList());
+        if (columns->constLast().size() != columns->constFirst().size()) {
+            q->setLastError(QSqlError(QCoreApplication::translate("QPSQLResult",
+                            "Batch columns differ in size"), QString(),
+                            QSqlError::StatementError));
+            return false;
+        }
+    }
+    return !columns->isEmpty();
+}
+
+// Returns value in the text format the server reads for a parameter or
+// COPY field of the given type, before escaping.
+static QByteArray qCopyText(const QVariant &value, int type, bool isUtf8)
+{
+    switch (value.typeId()) {
+    case QMetaType::Bool:
+        return value.toBool() ? "t" : "f";
+    case QMetaType::Float:
+    case QMetaType::Double: {
+        const double number = value.toDouble();
+        if (qIsNaN(number))
+            return "NaN";
+        if (qIsInf(number))
+            return number < 0 ? "-Infinity" : "Infinity";
+        return QByteArray::number(number, 'g', QLocale::FloatingPointShortest);
+    }
+    case QMetaType::QByteArray:
+        if (type == QBYTEAOID)
+            return "\\x" + value.toByteArray().toHex();
+        return value.toByteArray();
+#if QT_CONFIG(datestring)
+    case QMetaType::QDateTime: {
+        const QDateTime dateTime = value.toDateTime();
+        if (type == QTIMESTAMPOID)
+            return QLocale::c().toString(dateTime.toLocalTime(), u"yyyy-MM-ddThh:mm:ss.zzz").toLatin1();
+        return QLocale::c().toString(dateTime.toUTC(), u"yyyy-MM-ddThh:mm:ss.zzz").toLatin1() + 'Z';
+    }
+    case QMetaType::QTime:
+        return value.toTime().toString(u"hh:mm:ss.zzz").toLatin1();
+#endif
+    default: {
+        const QString text = value.toString();
+        return isUtf8 ? text.toUtf8() : text.toLocal8Bit();
+    }
+    }
+}
+
+#if defined(LIBPQ_HAS_PIPELINING)
+// The number of rows sent before reading their results, which keeps the
+// results the server cannot send yet from filling up the socket buffers.
+static constexpr qsizetype PipelineChunkSize = 1000;
+
+// Executes the prepared statement with the values of every row of the bound
+// lists as text parameters in pipeline mode, so that a batch costs a single
+// round trip per chunk of rows. The rows run in one implicit transaction:
+// if one fails, none of them is kept.
+bool QPSQLResultPrivate::execPipelined()
+{
+    Q_Q(QPSQLResult);
+    QList<QVariantList> columns;
+    if (!boundColumns(&columns))
+        return false;
+
+    q->cleanup();
+    QPSQLDriverPrivate *driverPrivate = drv_d_func();
+    PGconn *connection = driverPrivate->connection;
+    driverPrivate->discardResults();
+    // results of forward-only queries still pending are lost now
+    driverPrivate->currentStmtId = driverPrivate->generateStatementId();
+
+    // The rows are sent as text parameters, which need the parameter types
+    // to pick the text format of byte arrays and timestamps.
+    const QByteArray stmtName = preparedStmtId.toUtf8();
+    QList<int> paramTypes;
+    PGresult *description = PQdescribePrepared(connection, stmtName.constData());
+    if (PQresultStatus(description) != PGRES_COMMAND_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to describe statement"), QSqlError::StatementError,
+                        driverPrivate, description));
+        PQclear(description);
+        return false;
+    }
+    for (int i = 0; i < PQnparams(description); ++i)
+        paramTypes.append(PQparamtype(description, i));
+    PQclear(description);
+
+    if (PQenterPipelineMode(connection) != 1) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to enter pipeline mode"), QSqlError::StatementError,
+                        driverPrivate));
+        return false;
+    }
+
+    const qsizetype rowCount = columns.constFirst().size();
+    QList<QByteArray> rowValues(columns.size());
+    QList<const char *> paramValues(columns.size());
+    QSqlError error;
+    int rowsAffected = 0;
+    qsizetype sent = 0;
+    qsizetype received = 0;
+    while (received < rowCount && !error.isValid()) {
+        for (const qsizetype end = qMin(sent + PipelineChunkSize, rowCount); sent < end; ++sent) {
+            for (qsizetype i = 0; i < columns.size(); ++i) {
+                const QVariant &value = columns.at(i).at(sent);
+                if (QSqlResultPrivate::isVariantNull(value)) {
+                    paramValues[i] = nullptr;
+                } else {
+                    rowValues[i] = qCopyText(value, paramTypes.value(i), driverPrivate->isUtf8);
+                    paramValues[i] = rowValues.at(i).constData();
+                }
+            }
+            if (!PQsendQueryPrepared(connection, stmtName.constData(), int(columns.size()),
+                                     paramValues.constData(), nullptr, nullptr, 0)) {
+                error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to send query"), QSqlError::StatementError,
+                                   driverPrivate);
+                break;
+            }
+        }
+        // have the server send the results of the chunk without ending the pipeline
+        if (!error.isValid() && (PQsendFlushRequest(connection) != 1 || PQflush(connection) != 0)) {
+            error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                               "Unable to send query"), QSqlError::StatementError,
+                               driverPrivate);
+        }
+        for (; received < sent && !error.isValid(); ++received) {
+            PGresult *rowResult = PQgetResult(connection);
+            switch (rowResult ? PQresultStatus(rowResult) : PGRES_FATAL_ERROR) {
+            case PGRES_COMMAND_OK:
+            case PGRES_TUPLES_OK:
+                rowsAffected += atoi(PQcmdTuples(rowResult));
+                break;
+            default:
+                error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to execute row %1 of the batch").arg(received),
+                                   QSqlError::StatementError, driverPrivate, rowResult);
+                break;
+            }
+            PQclear(rowResult);
+            // the results of each query end with a null result
+            if (rowResult)
+                PQclear(PQgetResult(connection));
+        }
+    }
+
+    // The sync ends the implicit transaction, committing it unless a row
+    // failed; the results of the rows after a failing one are skipped.
+    if (PQpipelineSync(connection) == 1) {
+        for (;;) {
+            PGresult *syncResult = PQgetResult(connection);
+            if (!syncResult) {
+                if (PQstatus(connection) != CONNECTION_OK)
+                    break;
+                continue;
+            }
+            const ExecStatusType status = PQresultStatus(syncResult);
+            if (status == PGRES_FATAL_ERROR && !error.isValid()) {
+                error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                                   "Unable to execute batch"), QSqlError::StatementError,
+                                   driverPrivate, syncResult);
+            }
+            PQclear(syncResult);
+            if (status == PGRES_PIPELINE_SYNC)
+                break;
+        }
+    } else if (!error.isValid()) {
+        error = qMakeError(QCoreApplication::translate("QPSQLResult",
+                           "Unable to send query"), QSqlError::StatementError, driverPrivate);
+    }
+    PQexitPipelineMode(connection);
+    driverPrivate->checkPendingNotifications();
+
+    if (error.isValid()) {
+        q->setLastError(error);
+        batchRowsAffected = 0;
+        return false;
+    }
+    batchRowsAffected = rowsAffected;
+    q->setSelect(false);
+    q->setActive(true);
+    return true;
+}
+#endif // LIBPQ_HAS_PIPELINING
+
+// COPY FROM STDIN sends the data in messages of about this size.
+static constexpr qsizetype CopyBufferSize = 64 * 1024;
+
+// 2000-01-01, the origin of dates and timestamps in the binary format.
+static constexpr qint64 PostgresEpochJulianDay = 2451545;
+static constexpr qint64 PostgresEpochMSecs = Q_INT64_C(946684800000);
+
+template <typename T>
+static void qAppendBigEndian(QByteArray *buffer, T value)
+{
+    const T bigEndian = qToBigEndian(value);
+    buffer->append(reinterpret_cast<const char *>(&bigEndian), sizeof(T));
+}
+
+static void qAppendCopyField(QByteArray *buffer, const QByteArray &data)
+{
+    qAppendBigEndian<qint32>(buffer, qint32(data.size()));
+    buffer->append(data);
+}
+
+static bool qHasBinaryCopyFormat(int type)
+{
+    switch (type) {
+    case QBOOLOID:
+    case QINT2OID:
+    case QINT4OID:
+    case QINT8OID:
+    case QFLOAT4OID:
+    case QFLOAT8OID:
+    case QDATEOID:
+    case QTIMEOID:
+    case QTIMESTAMPOID:
+    case QTIMESTAMPTZOID:
+    case QBYTEAOID:
+    case QUUIDOID:
+    case QNAMEOID:
+    case QTEXTOID:
+    case QBPCHAROID:
+    case QVARCHAROID:
+    case QJSONOID:
+    case QJSONBOID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Appends value as a field of the given type in the binary COPY format.
+// Timestamps without time zone are stored in local time, which is how
+// data() reads them. Returns false if value does not fit the type.
+static bool qAppendCopyBinary(QByteArray *buffer, int type, const QVariant &value, bool isUtf8)
+{
+    bool ok = true;
+    switch (type) {
+    case QBOOLOID:
+        qAppendBigEndian<qint32>(buffer, 1);
+        buffer->append(char(value.toBool()));
+        return true;
+    case QINT2OID:
+    case QINT4OID:
+    case QINT8OID: {
+        const qint64 integer = value.toLongLong(&ok);
+        if (!ok)
+            return false;
+        if (type == QINT8OID) {
+            qAppendBigEndian<qint32>(buffer, 8);
+            qAppendBigEndian<qint64>(buffer, integer);
+        } else if (type == QINT4OID) {
+            if (integer != qint32(integer))
+                return false;
+            qAppendBigEndian<qint32>(buffer, 4);
+            qAppendBigEndian<qint32>(buffer, qint32(integer));
+        } else {
+            if (integer != qint16(integer))
+                return false;
+            qAppendBigEndian<qint32>(buffer, 2);
+            qAppendBigEndian<qint16>(buffer, qint16(integer));
+        }
+        return true;
+    }
+    case QFLOAT4OID: {
+        const float number = value.toFloat(&ok);
+        quint32 bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        qAppendBigEndian<qint32>(buffer, 4);
+        qAppendBigEndian<quint32>(buffer, bits);
+        return ok;
+    }
+    case QFLOAT8OID: {
+        const double number = value.toDouble(&ok);
+        quint64 bits;
+        std::memcpy(&bits, &number, sizeof(bits));
+        qAppendBigEndian<qint32>(buffer, 8);
+        qAppendBigEndian<quint64>(buffer, bits);
+        return ok;
+    }
+    case QDATEOID: {
+        const QDate date = value.toDate();
+        if (!date.isValid())
+            return false;
+        qAppendBigEndian<qint32>(buffer, 4);
+        qAppendBigEndian<qint32>(buffer, qint32(date.toJulianDay() - PostgresEpochJulianDay));
+        return true;
+    }
+    case QTIMEOID: {
+        const QTime time = value.toTime();
+        if (!time.isValid())
+            return false;
+        qAppendBigEndian<qint32>(buffer, 8);
+        qAppendBigEndian<qint64>(buffer, qint64(time.msecsSinceStartOfDay()) * 1000);
+        return true;
+    }
+    case QTIMESTAMPOID:
+    case QTIMESTAMPTZOID: {
+        const QDateTime dateTime = value.toDateTime();
+        if (!dateTime.isValid())
+            return false;
+        qint64 msecs;
+        if (type == QTIMESTAMPTZOID) {
+            msecs = dateTime.toMSecsSinceEpoch() - PostgresEpochMSecs;
+        } else {
+            const QDateTime localTime = dateTime.toLocalTime();
+            msecs = (localTime.date().toJulianDay() - PostgresEpochJulianDay) * 86400000
+                    + localTime.time().msecsSinceStartOfDay();
+        }
+        qAppendBigEndian<qint32>(buffer, 8);
+        qAppendBigEndian<qint64>(buffer, msecs * 1000);
+        return true;
+    }
+    case QBYTEAOID:
+        qAppendCopyField(buffer, value.toByteArray());
+        return true;
+    case QUUIDOID: {
+        const QUuid uuid = value.toUuid();
+        if (uuid.isNull() && value.typeId() != QMetaType::QUuid) {
+            // toUuid() also returns the nil UUID for strings it cannot parse
+            const QString text = value.toString();
+            if (text != QUuid().toString(QUuid::WithBraces)
+                && text != QUuid().toString(QUuid::WithoutBraces)
+                && text != QUuid().toString(QUuid::Id128)) {
+                return false;
+            }
+        }
+        qAppendCopyField(buffer, uuid.toRfc4122());
+        return true;
+    }
+    case QJSONBOID: {
+        // jsonb starts with its version
+        const QByteArray text = value.toString().toUtf8();
+        qAppendBigEndian<qint32>(buffer, qint32(text.size() + 1));
+        buffer->append(char(1));
+        buffer->append(text);
+        return true;
+    }
+    case QNAMEOID:
+    case QTEXTOID:
+    case QBPCHAROID:
+    case QVARCHAROID:
+    case QJSONOID: {
+        const QString text = value.toString();
+        qAppendCopyField(buffer, isUtf8 ? text.toUtf8() : text.toLocal8Bit());
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static void qAppendCopyText(QByteArray *buffer, const QByteArray &text)
+{
+    for (const char c : text) {
+        switch (c) {
+        case '\\':
+            buffer->append("\\\\", 2);
+            break;
+        case '\n':
+            buffer->append("\\n", 2);
+            break;
+        case '\r':
+            buffer->append("\\r", 2);
+            break;
+        case '\t':
+            buffer->append("\\t", 2);
+            break;
+        default:
+            buffer->append(c);
+            break;
+        }
+    }
+}
+
+// Loads the bound lists into fieldNames of tableName with COPY FROM STDIN,
+// in the binary format if there is one for the types of all fields, and in
+// the text format otherwise.
+bool QPSQLResultPrivate::copyIn(const QString &tableName, const QStringList &fieldNames)
+{
+    Q_Q(QPSQLResult);
+    QList<QVariantList> columns;
+    if (!boundColumns(&columns))
+        return false;
+
+    q->cleanup();
+    QPSQLDriverPrivate *driverPrivate = drv_d_func();
+    PGconn *connection = driverPrivate->connection;
+    const QSqlDriver *driver = q->driver();
+    const QString table = driver->isIdentifierEscaped(tableName, QSqlDriver::TableName)
+            ? tableName : driver->escapeIdentifier(tableName, QSqlDriver::TableName);
+    QStringList fields;
+    fields.reserve(fieldNames.size());
+    for (const QString &fieldName : fieldNames) {
+        fields.append(driver->isIdentifierEscaped(fieldName, QSqlDriver::FieldName)
+                      ? fieldName : driver->escapeIdentifier(fieldName, QSqlDriver::FieldName));
+    }
+    const QString fieldList = fields.join(", "_L1);
+
+    PGresult *copyResult = driverPrivate->exec(QStringLiteral("SELECT %1 FROM %2 LIMIT 0")
+                                               .arg(fieldList, table));
+    if (PQresultStatus(copyResult) != PGRES_TUPLES_OK) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to copy rows"), QSqlError::StatementError, driverPrivate,
+                        copyResult));
+        PQclear(copyResult);
+        return false;
+    }
+    QList<int> types;
+    bool binary = driverPrivate->pro >= QPSQLDriver::Version9;
+    for (int i = 0; i < PQnfields(copyResult); ++i) {
+        types.append(PQftype(copyResult, i));
+        binary = binary && qHasBinaryCopyFormat(types.constLast());
+    }
+    PQclear(copyResult);
+
+    copyResult = driverPrivate->exec(QStringLiteral("COPY %1 (%2) FROM STDIN%3")
+                                     .arg(table, fieldList,
+                                          binary ? " (FORMAT binary)"_L1 : ""_L1));
+    if (PQresultStatus(copyResult) != PGRES_COPY_IN) {
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to copy rows"), QSqlError::StatementError, driverPrivate,
+                        copyResult));
+        PQclear(copyResult);
+        return false;
+    }
+    PQclear(copyResult);
+    stmtId = driverPrivate->currentStmtId;
+
+    QByteArray buffer;
+    buffer.reserve(CopyBufferSize * 2);
+    if (binary) {
+        buffer.append("PGCOPY\n\377\r\n\0", 11);
+        qAppendBigEndian<qint32>(&buffer, 0); // flags
+        qAppendBigEndian<qint32>(&buffer, 0); // header extension length
+    }
+    const qsizetype rowCount = columns.constFirst().size();
+    QString conversionError;
+    bool sent = true;
+    for (qsizetype row = 0; row < rowCount && sent && conversionError.isEmpty(); ++row) {
+        if (binary)
+            qAppendBigEndian<qint16>(&buffer, qint16(columns.size()));
+        for (qsizetype i = 0; i < columns.size(); ++i) {
+            const QVariant &value = columns.at(i).at(row);
+            const bool isNull = QSqlResultPrivate::isVariantNull(value);
+            if (binary) {
+                if (isNull) {
+                    qAppendBigEndian<qint32>(&buffer, -1);
+                } else if (!qAppendCopyBinary(&buffer, types.at(i), value,
+                                              driverPrivate->isUtf8)) {
+                    conversionError = QCoreApplication::translate("QPSQLResult",
+                            "Unable to convert the value of %1 in row %2")
+                            .arg(fieldNames.at(i)).arg(row);
+                    break;
+                }
+            } else {
+                if (i > 0)
+                    buffer.append('\t');
+                if (isNull)
+                    buffer.append("\\N", 2);
+                else
+                    qAppendCopyText(&buffer, qCopyText(value, types.at(i), driverPrivate->isUtf8));
+            }
+        }
+        if (!binary)
+            buffer.append('\n');
+        if (buffer.size() >= CopyBufferSize) {
+            sent = PQputCopyData(connection, buffer.constData(), int(buffer.size())) == 1;
+            buffer.resize(0);
+        }
+    }
+    if (sent && conversionError.isEmpty()) {
+        if (binary)
+            qAppendBigEndian<qint16>(&buffer, -1); // trailer
+        sent = PQputCopyData(connection, buffer.constData(), int(buffer.size())) == 1;
+    }
+    // ending the COPY with an error message discards all rows
+    const QByteArray errorMessage = conversionError.toUtf8();
+    if (sent) {
+        sent = PQputCopyEnd(connection, conversionError.isEmpty() ? nullptr
+                                                                  : errorMessage.constData()) == 1;
+    }
+
+    result = driverPrivate->getResult(stmtId);
+    if (!sent || PQresultStatus(result) != PGRES_COMMAND_OK) {
+        if (conversionError.isEmpty()) {
+            q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                            "Unable to copy rows"), QSqlError::StatementError, driverPrivate,
+                            result));
+        } else {
+            q->setLastError(QSqlError(conversionError, QString(), QSqlError::StatementError));
+        }
+        return false;
+    }
+    q->setSelect(false);
+    q->setActive(true);
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -1125,10 +1921,18 @@ bool QPSQLDriver::hasFeature(DriverFeature f) const
     case EventNotifications:
     case MultipleResultSets:
     case BLOB:
+    case BatchFetch:
+    case BulkInsert:
         return true;
     case PreparedQueries:
     case PositionalPlaceholders:
         return d->pro >= QPSQLDriver::Version8_2;
+    case PipelinedBatches:
+#if defined(LIBPQ_HAS_PIPELINING)
+        return d->pro >= QPSQLDriver::Version8_2;
+#else
+        return false;
+#endif
     case BatchOperations:
     case NamedPlaceholders:
     case SimpleLocking:
@@ -1177,10 +1981,24 @@ bool QPSQLDriver::open(const QString &db,
         connectString.append(" port="_L1).append(qQuote(QString::number(port)));
 
     // add any connect options - the server will handle error detection
+    d->fetchSize = 1;
     if (!connOpts.isEmpty()) {
-        QString opt = connOpts;
-        opt.replace(';'_L1, ' '_L1, Qt::CaseInsensitive);
-        connectString.append(u' ').append(opt);
+        QStringList options;
+        for (const QString &option : connOpts.split(u';')) {
+            QStringView fetchSize = QStringView(option).trimmed();
+            if (fetchSize.startsWith("QPSQL_FETCH_SIZE"_L1)) {
+                fetchSize = fetchSize.mid(16).trimmed();
+                if (fetchSize.startsWith(u'=')) {
+                    bool ok;
+                    const int size = fetchSize.mid(1).trimmed().toInt(&ok);
+                    if (ok && size > 0)
+                        d->fetchSize = size;
+                }
+            } else {
+                options.append(option);
+            }
+        }
+        connectString.append(u' ').append(options.join(u' '));
     }
 
     d->connection = PQconnectdb(std::move(connectString).toLocal8Bit().constData());
@@ -12,6 +12,7 @@
 #include <qsqlindex.h>
 #include <qsqlquery.h>
 #include <QtSql/private/qsqlcachedresult_p.h>
+#include <QtSql/private/qsqlcolumnbatch_p.h>
 #include <QtSql/private/qsqldriver_p.h>
 #include <qstringlist.h>
 #include <qvariant.h>
@@ -19,7 +20,6 @@
 #include <qcache.h>
 #include <qregularexpression.h>
 #endif
-#include <QScopedValueRollback>
 
 #if defined Q_OS_WIN
 # include <qt_windows.h>
@@ -29,6 +29,7 @@
 
 #include <sqlite3.h>
 #include <functional>
+#include <vector>
 
 Q_DECLARE_OPAQUE_POINTER(sqlite3*)
 Q_DECLARE_METATYPE(sqlite3*)
@@ -82,6 +83,133 @@ static QSqlError qMakeError(sqlite3 *access, const QString &descr, QSqlError::Er
                      type, QString::number(errorCode));
 }
 
+// Binds value to the parameter at index of stmt. Strings and byte arrays are
+// not copied: value must outlive the execution of stmt.
+static int qBindValue(sqlite3_stmt *stmt, int index, const QVariant &value)
+{
+    if (QSqlResultPrivate::isVariantNull(value))
+        return sqlite3_bind_null(stmt, index);
+
+    switch (value.userType()) {
+    case QMetaType::QByteArray: {
+        const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
+        return sqlite3_bind_blob(stmt, index, ba->constData(), ba->size(), SQLITE_STATIC);
+    }
+    case QMetaType::Int:
+    case QMetaType::Bool:
+        return sqlite3_bind_int(stmt, index, value.toInt());
+    case QMetaType::Double:
+        return sqlite3_bind_double(stmt, index, value.toDouble());
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        return sqlite3_bind_int64(stmt, index, value.toLongLong());
+    case QMetaType::QDateTime: {
+        const QDateTime dateTime = value.toDateTime();
+        const QString str = dateTime.toString(Qt::ISODateWithMs);
+        return sqlite3_bind_text16(stmt, index, str.data(),
+                                   int(str.size() * sizeof(ushort)),
+                                   SQLITE_TRANSIENT);
+    }
+    case QMetaType::QTime: {
+        const QTime time = value.toTime();
+        const QString str = time.toString(u"hh:mm:ss.zzz");
+        return sqlite3_bind_text16(stmt, index, str.data(),
+                                   int(str.size() * sizeof(ushort)),
+                                   SQLITE_TRANSIENT);
+    }
+    case QMetaType::QString: {
+        // lifetime of string == lifetime of its qvariant
+        const QString *str = static_cast<const QString*>(value.constData());
+        return sqlite3_bind_text16(stmt, index, str->unicode(),
+                                   int(str->size()) * sizeof(QChar),
+                                   SQLITE_STATIC);
+    }
+    default: {
+        const QString str = value.toString();
+        // SQLITE_TRANSIENT makes sure that sqlite buffers the data
+        return sqlite3_bind_text16(stmt, index, str.data(),
+                                   int(str.size()) * sizeof(QChar),
+                                   SQLITE_TRANSIENT);
+    }
+    }
+}
+
+// One bound column of QSQLiteResult::execBatch(). Lists of the types we can
+// bind directly are read where they are, anything else is converted to a
+// QVariantList once.
+class QSQLiteBatchColumn
+{
+public:
+    explicit QSQLiteBatchColumn(const QVariant &value)
+    {
+        const QMetaType type = value.metaType();
+        if (type == QMetaType::fromType<QVariantList>()) {
+            setList(Variants, static_cast<const QVariantList *>(value.constData()));
+        } else if (type == QMetaType::fromType<QStringList>()) {
+            setList(Strings, static_cast<const QStringList *>(value.constData()));
+        } else if (type == QMetaType::fromType<QByteArrayList>()) {
+            setList(ByteArrays, static_cast<const QByteArrayList *>(value.constData()));
+        } else if (type == QMetaType::fromType<QList<int>>()) {
+            setList(Ints, static_cast<const QList<int> *>(value.constData()));
+        } else if (type == QMetaType::fromType<QList<qint64>>()) {
+            setList(Int64s, static_cast<const QList<qint64> *>(value.constData()));
+        } else if (type == QMetaType::fromType<QList<double>>()) {
+            setList(Doubles, static_cast<const QList<double> *>(value.constData()));
+        } else {
+            converted = value.toList();
+            setList(Variants, &converted);
+        }
+    }
+
+    qsizetype size() const { return count; }
+
+    int bind(sqlite3_stmt *stmt, int index, qsizetype row) const
+    {
+        switch (type) {
+        case Variants:
+            return qBindValue(stmt, index, at<QVariant>(row));
+        case Strings: {
+            const QString &str = at<QString>(row);
+            if (str.isNull())
+                return sqlite3_bind_null(stmt, index);
+            return sqlite3_bind_text16(stmt, index, str.unicode(),
+                                       int(str.size()) * sizeof(QChar), SQLITE_STATIC);
+        }
+        case ByteArrays: {
+            const QByteArray &ba = at<QByteArray>(row);
+            if (ba.isNull())
+                return sqlite3_bind_null(stmt, index);
+            return sqlite3_bind_blob(stmt, index, ba.constData(), ba.size(), SQLITE_STATIC);
+        }
+        case Ints:
+            return sqlite3_bind_int(stmt, index, at<int>(row));
+        case Int64s:
+            return sqlite3_bind_int64(stmt, index, at<qint64>(row));
+        case Doubles:
+            return sqlite3_bind_double(stmt, index, at<double>(row));
+        }
+        return SQLITE_MISUSE;
+    }
+
+private:
+    enum Type { Variants, Strings, ByteArrays, Ints, Int64s, Doubles };
+
+    template <typename T>
+    void setList(Type listType, const QList<T> *list)
+    {
+        type = listType;
+        data = list->constData();
+        count = list->size();
+    }
+    template <typename T>
+    const T &at(qsizetype row) const { return static_cast<const T *>(data)[row]; }
+
+    QVariantList converted;
+    const void *data = nullptr;
+    qsizetype count = 0;
+    Type type = Variants;
+};
+
 class QSQLiteResultPrivate;
 
 class QSQLiteResult : public QSqlCachedResult
@@ -113,7 +241,13 @@ class QSQLiteDriverPrivate : public QSqlDriverPrivate
     Q_DECLARE_PUBLIC(QSQLiteDriver)
 
 public:
-    inline QSQLiteDriverPrivate() : QSqlDriverPrivate(QSqlDriver::SQLite) {}
+    inline QSQLiteDriverPrivate() : QSqlDriverPrivate(QSqlDriver::SQLite)
+    {
+#if QT_CONFIG(thread)
+        // SQLite allows a connection to be used by any thread, one at a time.
+        canExecInThread = true;
+#endif
+    }
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
@@ -129,6 +263,7 @@ public:
     using QSqlCachedResultPrivate::QSqlCachedResultPrivate;
     void cleanup();
     bool fetchNext(QSqlCachedResult::ValueCache &values, int idx, bool initialFetch);
+    void fetchBatch(QSqlColumnBatch *batch, int maxRows);
     // initializes the recordInfo and the cache
     void initColumns(bool emptyResultset);
     void finalize();
@@ -138,6 +273,7 @@ public:
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
     bool skipRow = false; // skip the next fetchNext()?
+    int batchRowsAffected = -1; // the rows changed by the last execBatch()
 };
 
 void QSQLiteResultPrivate::cleanup()
@@ -147,6 +283,7 @@ void QSQLiteResultPrivate::cleanup()
     rInf.clear();
     skippedStatus = false;
     skipRow = false;
+    batchRowsAffected = -1;
     q->setAt(QSql::BeforeFirstRow);
     q->setActive(false);
     q->cleanup();
@@ -314,6 +451,80 @@ bool QSQLiteResultPrivate::fetchNext(QSqlCachedResult::ValueCache &values, int i
     return false;
 }
 
+// Steps through the rows of a forward-only query, reading the values straight
+// into the column buffers of batch.
+void QSQLiteResultPrivate::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_Q(QSQLiteResult);
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(*batch);
+    b->reset(rInf, q->numericalPrecisionPolicy(), maxRows);
+    const int columnCount = int(b->columns.size());
+    int lastRow = q->at();
+
+    if (skipRow) {
+        // exec() already stepped to the first row
+        skipRow = false;
+        if (!skippedStatus) {
+            atEnd = true;
+            q->setAt(QSql::AfterLastRow);
+            return;
+        }
+        b->beginRow();
+        for (int i = 0; i < columnCount; ++i)
+            b->appendValue(i, firstRow.at(i));
+        b->endRow();
+        lastRow = 0;
+    }
+
+    while (b->rowCount < maxRows) {
+        int res = sqlite3_step(stmt);
+        if (res != SQLITE_ROW) {
+            if (res == SQLITE_DONE) {
+                sqlite3_reset(stmt);
+            } else if (res == SQLITE_CONSTRAINT || res == SQLITE_ERROR) {
+                // see fetchNext()
+                res = sqlite3_reset(stmt);
+                q->setLastError(qMakeError(drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
+                                "Unable to fetch row"), QSqlError::ConnectionError, res));
+            } else {
+                q->setLastError(qMakeError(drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
+                                "Unable to fetch row"), QSqlError::ConnectionError, res));
+                sqlite3_reset(stmt);
+            }
+            atEnd = true;
+            q->setAt(QSql::AfterLastRow);
+            return;
+        }
+        b->beginRow();
+        for (int i = 0; i < columnCount; ++i) {
+            const int type = sqlite3_column_type(stmt, i);
+            if (type == SQLITE_NULL) {
+                b->appendNull(i);
+                continue;
+            }
+            switch (b->columnType(i)) {
+            case QSqlColumnBatch::Int64:
+                b->appendInt64(i, sqlite3_column_int64(stmt, i));
+                break;
+            case QSqlColumnBatch::Double:
+                b->appendDouble(i, sqlite3_column_double(stmt, i));
+                break;
+            case QSqlColumnBatch::Bytes: {
+                // sqlite3_column_bytes() must be called after the conversion
+                const char *data = type == SQLITE_BLOB
+                        ? static_cast<const char *>(sqlite3_column_blob(stmt, i))
+                        : reinterpret_cast<const char *>(sqlite3_column_text(stmt, i));
+                b->appendBytes(i, data, sqlite3_column_bytes(stmt, i));
+                break;
+            }
+            }
+        }
+        b->endRow();
+        ++lastRow;
+    }
+    q->setAt(lastRow);
+}
+
 QSQLiteResult::QSQLiteResult(const QSQLiteDriver* db)
     : QSqlCachedResult(*new QSQLiteResultPrivate(this, db))
 {
@@ -331,6 +542,15 @@ QSQLiteResult::~QSQLiteResult()
 
 void QSQLiteResult::virtual_hook(int id, void *data)
 {
+    Q_D(QSQLiteResult);
+    if (id == FetchColumnBatch && isForwardOnly() && d->stmt && !d->atEnd) {
+        // A query that is not forward-only keeps the rows it fetched in the
+        // cache, which only QSqlCachedResult fills.
+        auto *fetch = static_cast<QSqlColumnBatchFetch *>(data);
+        d->fetchBatch(fetch->batch, fetch->maxRows);
+        fetch->handled = true;
+        return;
+    }
     QSqlCachedResult::virtual_hook(id, data);
 }
 
@@ -376,27 +596,130 @@ bool QSQLiteResult::prepare(const QString &query)
     return true;
 }
 
+// Binds the columns of the batch straight from the bound lists and steps the
+// prepared statement once per row, all in a single transaction unless one is
+// already open.
 bool QSQLiteResult::execBatch(bool arrayBind)
 {
     Q_UNUSED(arrayBind);
-    Q_D(QSqlResult);
-    QScopedValueRollback<QList<QVariant>> valuesScope(d->values);
-    QList<QVariant> values = d->values;
+    Q_D(QSQLiteResult);
+    // keeps the bound lists, and the strings we bind without copying, alive
+    const QList<QVariant> values = d->values;
     if (values.size() == 0)
         return false;
 
-    for (int i = 0; i < values.at(0).toList().size(); ++i) {
-        d->values.clear();
-        QScopedValueRollback<QHash<QString, QList<int>>> indexesScope(d->indexes);
-        auto it = d->indexes.constBegin();
-        while (it != d->indexes.constEnd()) {
-            bindValue(it.key(), values.at(it.value().first()).toList().at(i), QSql::In);
-            ++it;
+    d->skippedStatus = false;
+    d->skipRow = false;
+    d->rInf.clear();
+    d->batchRowsAffected = -1;
+    clearValues();
+    setLastError(QSqlError());
+
+    sqlite3 *access = d->drv_d_func()->access;
+    int res = sqlite3_reset(d->stmt);
+    if (res != SQLITE_OK) {
+        setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                     "Unable to reset statement"), QSqlError::StatementError, res));
+        d->finalize();
+        return false;
+    }
+
+    // The index in values of each parameter of the statement; SQLite binds a
+    // named placeholder used more than once only once.
+    const int paramCount = sqlite3_bind_parameter_count(d->stmt);
+    QList<int> valueIndexes;
+    valueIndexes.reserve(paramCount);
+    if (paramCount == values.size()) {
+        for (int i = 0; i < paramCount; ++i)
+            valueIndexes.append(i);
+    }
+#if (SQLITE_VERSION_NUMBER >= 3003011)
+    else if (paramCount >= 1 && paramCount < values.size()) {
+        for (int i = 0; i < paramCount; ++i) {
+            const char *parameterName = sqlite3_bind_parameter_name(d->stmt, i + 1);
+            const QList<int> indexes = parameterName
+                    ? d->indexes.value(QString::fromUtf8(parameterName)) : QList<int>();
+            if (indexes.isEmpty())
+                break;
+            valueIndexes.append(indexes.first());
+        }
+    }
+#endif
+    if (paramCount == 0 || valueIndexes.size() != paramCount) {
+        setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                        "Parameter count mismatch"), QString(), QSqlError::StatementError));
+        return false;
+    }
+
+    std::vector<QSQLiteBatchColumn> columns;
+    columns.reserve(paramCount);
+    for (int index : std::as_const(valueIndexes))
+        columns.emplace_back(values.at(index));
+    const qsizetype rowCount = columns.front().size();
+    for (const QSQLiteBatchColumn &column : columns) {
+        if (column.size() != rowCount) {
+            setLastError(QSqlError(QCoreApplication::translate("QSQLiteResult",
+                            "Batch columns differ in size"), QString(),
+                            QSqlError::StatementError));
+            return false;
         }
-        if (!exec())
+    }
+
+    const bool ownTransaction = sqlite3_get_autocommit(access);
+    if (ownTransaction) {
+        res = sqlite3_exec(access, "BEGIN", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to begin transaction"), QSqlError::TransactionError, res));
             return false;
+        }
     }
-    return true;
+
+    const int changes = sqlite3_total_changes(access);
+    for (qsizetype row = 0; row < rowCount; ++row) {
+        for (int i = 0; i < paramCount; ++i) {
+            res = columns[i].bind(d->stmt, i + 1, row);
+            if (res != SQLITE_OK) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to bind parameters of row %1").arg(row),
+                             QSqlError::StatementError, res));
+                break;
+            }
+        }
+        if (res != SQLITE_OK)
+            break;
+        res = sqlite3_step(d->stmt);
+        if (res != SQLITE_DONE && res != SQLITE_ROW) {
+            // as in fetchNext(), sqlite3_reset() tells the specific error
+            res = sqlite3_reset(d->stmt);
+            setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                         "Unable to execute row %1 of the batch").arg(row),
+                         QSqlError::StatementError, res));
+            break;
+        }
+        sqlite3_reset(d->stmt);
+    }
+    sqlite3_reset(d->stmt);
+    sqlite3_clear_bindings(d->stmt);
+    d->batchRowsAffected = sqlite3_total_changes(access) - changes;
+
+    // The rows before a failing one are kept, as if each had been executed
+    // on its own.
+    if (ownTransaction) {
+        res = sqlite3_exec(access, "COMMIT", nullptr, nullptr, nullptr);
+        if (res != SQLITE_OK) {
+            if (!lastError().isValid()) {
+                setLastError(qMakeError(access, QCoreApplication::translate("QSQLiteResult",
+                             "Unable to commit transaction"), QSqlError::TransactionError, res));
+            }
+            sqlite3_exec(access, "ROLLBACK", nullptr, nullptr, nullptr);
+            d->batchRowsAffected = 0;
+        }
+    }
+
+    setSelect(false);
+    setActive(!lastError().isValid());
+    return isActive();
 }
 
 bool QSQLiteResult::exec()
@@ -407,6 +730,7 @@ bool QSQLiteResult::exec()
     d->skippedStatus = false;
     d->skipRow = false;
     d->rInf.clear();
+    d->batchRowsAffected = -1;
     clearValues();
     setLastError(QSqlError());
 
@@ -462,61 +786,7 @@ bool QSQLiteResult::exec()
 
     if (paramCountIsValid) {
         for (int i = 0; i < paramCount; ++i) {
-            res = SQLITE_OK;
-            const QVariant &value = values.at(i);
-
-            if (QSqlResultPrivate::isVariantNull(value)) {
-                res = sqlite3_bind_null(d->stmt, i + 1);
-            } else {
-                switch (value.userType()) {
-                case QMetaType::QByteArray: {
-                    const QByteArray *ba = static_cast<const QByteArray*>(value.constData());
-                    res = sqlite3_bind_blob(d->stmt, i + 1, ba->constData(),
-                                            ba->size(), SQLITE_STATIC);
-                    break; }
-                case QMetaType::Int:
-                case QMetaType::Bool:
-                    res = sqlite3_bind_int(d->stmt, i + 1, value.toInt());
-                    break;
-                case QMetaType::Double:
-                    res = sqlite3_bind_double(d->stmt, i + 1, value.toDouble());
-                    break;
-                case QMetaType::UInt:
-                case QMetaType::LongLong:
-                    res = sqlite3_bind_int64(d->stmt, i + 1, value.toLongLong());
-                    break;
-                case QMetaType::QDateTime: {
-                    const QDateTime dateTime = value.toDateTime();
-                    const QString str = dateTime.toString(Qt::ISODateWithMs);
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.data(),
-                                              int(str.size() * sizeof(ushort)),
-                                              SQLITE_TRANSIENT);
-                    break;
-                }
-                case QMetaType::QTime: {
-                    const QTime time = value.toTime();
-                    const QString str = time.toString(u"hh:mm:ss.zzz");
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.data(),
-                                              int(str.size() * sizeof(ushort)),
-                                              SQLITE_TRANSIENT);
-                    break;
-                }
-                case QMetaType::QString: {
-                    // lifetime of string == lifetime of its qvariant
-                    const QString *str = static_cast<const QString*>(value.constData());
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str->unicode(),
-                                              int(str->size()) * sizeof(QChar),
-                                              SQLITE_STATIC);
-                    break; }
-                default: {
-                    const QString str = value.toString();
-                    // SQLITE_TRANSIENT makes sure that sqlite buffers the data
-                    res = sqlite3_bind_text16(d->stmt, i + 1, str.data(),
-                                              int(str.size()) * sizeof(QChar),
-                                              SQLITE_TRANSIENT);
-                    break; }
-                }
-            }
+            res = qBindValue(d->stmt, i + 1, values.at(i));
             if (res != SQLITE_OK) {
                 setLastError(qMakeError(d->drv_d_func()->access, QCoreApplication::translate("QSQLiteResult",
                              "Unable to bind parameters"), QSqlError::StatementError, res));
@@ -554,6 +824,8 @@ int QSQLiteResult::size()
 int QSQLiteResult::numRowsAffected()
 {
     Q_D(const QSQLiteResult);
+    if (d->batchRowsAffected >= 0)
+        return d->batchRowsAffected;
     return sqlite3_changes(d->drv_d_func()->access);
 }
 
@@ -658,11 +930,14 @@ bool QSQLiteDriver::hasFeature(DriverFeature f) const
     case FinishQuery:
     case LowPrecisionNumbers:
     case EventNotifications:
+    case BatchFetch:
         return true;
     case QuerySize:
     case BatchOperations:
     case MultipleResultSets:
     case CancelQuery:
+    case PipelinedBatches:
+    case BulkInsert:
         return false;
     case NamedPlaceholders:
 #if (SQLITE_VERSION_NUMBER < 3003011)
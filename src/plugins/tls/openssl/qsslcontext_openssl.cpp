@@ -19,6 +19,13 @@
 
 #include <QtNetwork/private/qssldiffiehellmanparameters_p.h>
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrandom.h>
+
+#include <algorithm>
+#include <array>
 #include <vector>
 
 QT_BEGIN_NAMESPACE
@@ -63,6 +70,68 @@ static inline QString msgErrorSettingEllipticCurves(const QString &why)
     return QSslSocket::tr("Error when setting the elliptic curves (%1)").arg(why);
 }
 
+namespace {
+
+// The session ID context of a server: a session (or ticket) is only resumed
+// by a server whose configuration would have negotiated it, too.
+QByteArray serverSessionIdContext(const QSslConfiguration &configuration)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    for (const QSslCertificate &certificate : configuration.localCertificateChain())
+        hash.addData(certificate.toDer());
+    for (const QSslCertificate &certificate : configuration.caCertificates())
+        hash.addData(certificate.toDer());
+    for (const QSslCipher &cipher : configuration.ciphers())
+        hash.addData(cipher.name().toLatin1());
+    const int parameters[] = { int(configuration.protocol()),
+                               int(configuration.peerVerifyMode()),
+                               configuration.peerVerifyDepth() };
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(parameters), sizeof parameters));
+    return hash.result(); // SSL_MAX_SID_CTX_LENGTH bytes
+}
+
+// The session ticket keys of the servers with the same session ID context.
+// They are replaced after KeyLifetime; the tickets encrypted with the old
+// keys are then rejected, and their clients do a full handshake.
+class ServerTicketKeys
+{
+public:
+    using Keys = std::array<quint32, 20>; // Key name, HMAC secret and AES key.
+
+    Keys keys(const QByteArray &sessionIdContext)
+    {
+        const QMutexLocker locker(&mutex);
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const Entry &entry) { return entry.expiry.hasExpired(); }),
+                      entries.end());
+        for (const Entry &entry : entries) {
+            if (entry.sessionIdContext == sessionIdContext)
+                return entry.keys;
+        }
+        Entry entry{sessionIdContext, {}, QDeadlineTimer(KeyLifetime)};
+        QRandomGenerator::system()->fillRange(entry.keys.data(), entry.keys.size());
+        entries.push_back(entry);
+        return entry.keys;
+    }
+
+private:
+    static constexpr std::chrono::hours KeyLifetime{1};
+
+    struct Entry
+    {
+        QByteArray sessionIdContext;
+        Keys keys;
+        QDeadlineTimer expiry;
+    };
+
+    QMutex mutex;
+    std::vector<Entry> entries;
+};
+
+Q_GLOBAL_STATIC(ServerTicketKeys, serverTicketKeys)
+
+} // unnamed namespace
+
 qssloptions QSslContext::setupOpenSslOptions(QSsl::SslProtocol protocol, QSsl::SslOptions sslOptions)
 {
     qssloptions options;
@@ -113,6 +182,12 @@ QT_WARNING_POP
     if (!(sslOptions & QSsl::SslOptionDisableServerCipherPreference))
         options |= SSL_OP_CIPHER_SERVER_PREFERENCE;
 
+#ifdef SSL_OP_ENABLE_KTLS
+    // The same bit means something else before OpenSSL 3.0.
+    if ((sslOptions & QSsl::SslOptionEnableKernelTls) && q_OpenSSL_version_num() >= 0x30000000L)
+        options |= SSL_OP_ENABLE_KTLS;
+#endif
+
     return options;
 }
 
@@ -672,6 +747,24 @@ QT_WARNING_POP
 
 #endif // TLS1_3_VERSION
 
+    // Session tickets: OpenSSL encrypts them with random keys of the context,
+    // and every server socket has a context of its own, so clients could
+    // never resume their sessions. Share the keys between the contexts of
+    // the servers with the same configuration that do not require a valid
+    // peer certificate (a session resumed elsewhere would skip that
+    // verification).
+    if (mode == QSslSocket::SslServerMode && !isDtls
+        && sslContext->sslConfiguration.peerVerifyMode() != QSslSocket::VerifyPeer
+        && !sslContext->sslConfiguration.testSslOption(QSsl::SslOptionDisableSessionTickets)) {
+        const QByteArray sessionIdContext = serverSessionIdContext(sslContext->sslConfiguration);
+        auto ticketKeys = serverTicketKeys()->keys(sessionIdContext);
+        q_SSL_CTX_ctrl(sslContext->ctx, SSL_CTRL_SET_TLSEXT_TICKET_KEYS, long(sizeof ticketKeys),
+                       ticketKeys.data());
+        q_SSL_CTX_set_session_id_context(
+                sslContext->ctx, reinterpret_cast<const unsigned char *>(sessionIdContext.constData()),
+                uint(sessionIdContext.size()));
+    }
+
 #if QT_CONFIG(dtls)
     // DTLS cookies:
     if (mode == QSslSocket::SslServerMode && isDtls && configuration.dtlsCookieVerificationEnabled()) {
@@ -109,6 +109,7 @@ DEFINEFUNC2(int, OPENSSL_init_ssl, uint64_t opts, opts, const OPENSSL_INIT_SETTI
 DEFINEFUNC2(int, OPENSSL_init_crypto, uint64_t opts, opts, const OPENSSL_INIT_SETTINGS *settings, settings, return 0, return)
 DEFINEFUNC(BIO *, BIO_new, const BIO_METHOD *a, a, return nullptr, return)
 DEFINEFUNC(const BIO_METHOD *, BIO_s_mem, void, DUMMYARG, return nullptr, return)
+DEFINEFUNC2(BIO *, BIO_new_socket, int sock, sock, int close_flag, close_flag, return nullptr, return)
 DEFINEFUNC2(int, BN_is_word, BIGNUM *a, a, BN_ULONG w, w, return 0, return)
 DEFINEFUNC(int, EVP_CIPHER_CTX_reset, EVP_CIPHER_CTX *c, c, return 0, return)
 DEFINEFUNC(int, EVP_PKEY_up_ref, EVP_PKEY *a, a, return 0, return)
@@ -285,6 +286,7 @@ DEFINEFUNC3(long, SSL_CTX_callback_ctrl, SSL_CTX *ctx, ctx, int dst, dst, Generi
 DEFINEFUNC(int, SSL_CTX_set_default_verify_paths, SSL_CTX *a, a, return -1, return)
 DEFINEFUNC3(void, SSL_CTX_set_verify, SSL_CTX *a, a, int b, b, int (*c)(int, X509_STORE_CTX *), c, return, DUMMYARG)
 DEFINEFUNC2(void, SSL_CTX_set_verify_depth, SSL_CTX *a, a, int b, b, return, DUMMYARG)
+DEFINEFUNC3(int, SSL_CTX_set_session_id_context, SSL_CTX *a, a, const unsigned char *b, b, unsigned int c, c, return 0, return)
 DEFINEFUNC2(int, SSL_CTX_use_certificate, SSL_CTX *a, a, X509 *b, b, return -1, return)
 DEFINEFUNC3(int, SSL_CTX_use_certificate_file, SSL_CTX *a, a, const char *b, b, int c, c, return -1, return)
 DEFINEFUNC2(int, SSL_CTX_use_PrivateKey, SSL_CTX *a, a, EVP_PKEY *b, b, return -1, return)
@@ -318,6 +320,7 @@ DEFINEFUNC(SSL_CTX *, SSL_get_SSL_CTX, SSL *a, a, return nullptr, return)
 DEFINEFUNC4(long, SSL_ctrl, SSL *a, a, int cmd, cmd, long larg, larg, void *parg, parg, return -1, return)
 DEFINEFUNC3(int, SSL_read, SSL *a, a, void *b, b, int c, c, return -1, return)
 DEFINEFUNC3(void, SSL_set_bio, SSL *a, a, BIO *b, b, BIO *c, c, return, DUMMYARG)
+DEFINEFUNC2(void, SSL_set0_wbio, SSL *a, a, BIO *b, b, return, DUMMYARG)
 DEFINEFUNC(void, SSL_set_accept_state, SSL *a, a, return, DUMMYARG)
 DEFINEFUNC(void, SSL_set_connect_state, SSL *a, a, return, DUMMYARG)
 DEFINEFUNC(int, SSL_shutdown, SSL *a, a, return -1, return)
@@ -967,6 +970,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(BIO_free)
         RESOLVEFUNC(BIO_new)
         RESOLVEFUNC(BIO_new_mem_buf)
+        RESOLVEFUNC(BIO_new_socket)
         RESOLVEFUNC(BIO_read)
         RESOLVEFUNC(BIO_s_mem)
         RESOLVEFUNC(BIO_write)
@@ -1033,6 +1037,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_CTX_set_default_verify_paths)
         RESOLVEFUNC(SSL_CTX_set_verify)
         RESOLVEFUNC(SSL_CTX_set_verify_depth)
+        RESOLVEFUNC(SSL_CTX_set_session_id_context)
         RESOLVEFUNC(SSL_CTX_use_certificate)
         RESOLVEFUNC(SSL_CTX_use_certificate_file)
         RESOLVEFUNC(SSL_CTX_use_PrivateKey)
@@ -1121,6 +1126,7 @@ bool q_resolveOpenSslSymbols()
         RESOLVEFUNC(SSL_read)
         RESOLVEFUNC(SSL_set_accept_state)
         RESOLVEFUNC(SSL_set_bio)
+        RESOLVEFUNC(SSL_set0_wbio)
         RESOLVEFUNC(SSL_set_connect_state)
         RESOLVEFUNC(SSL_shutdown)
         RESOLVEFUNC(SSL_in_init)
@@ -13,15 +13,21 @@
 #include <QtNetwork/private/qsslcertificate_p.h>
 #include <QtNetwork/private/qocspresponse_p.h>
 #include <QtNetwork/private/qsslsocket_p.h>
+#include <QtNetwork/private/qabstractsocket_p.h>
 
 #include <QtNetwork/qsslpresharedkeyauthenticator.h>
 
 #include <QtCore/qscopedvaluerollback.h>
+#include <QtCore/qsocketnotifier.h>
 #include <QtCore/qscopeguard.h>
 
 #include <algorithm>
 #include <cstring>
 
+#ifdef Q_OS_LINUX
+#include <signal.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -107,6 +113,57 @@ QSslCertificate findCertificateToFetch(const QList<QSslError> &tlsErrors, bool c
 
 #endif // Q_OS_WIN
 
+// Unlike QAbstractSocket, the socket BIO we use for kernel TLS writes without
+// MSG_NOSIGNAL: a peer that went away would kill us with SIGPIPE. So we
+// block the signal while OpenSSL may write, and discard it if it was raised.
+class SocketBioSigPipeBlocker
+{
+public:
+    Q_DISABLE_COPY_MOVE(SocketBioSigPipeBlocker)
+
+    explicit SocketBioSigPipeBlocker(bool writeBioIsSocket)
+#ifdef Q_OS_LINUX
+        : active(writeBioIsSocket)
+    {
+        if (!active)
+            return;
+        sigemptyset(&sigPipe);
+        sigaddset(&sigPipe, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        wasPending = sigismember(&pending, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &sigPipe, &oldMask);
+    }
+#else
+    {
+        Q_UNUSED(writeBioIsSocket);
+    }
+#endif
+
+#ifdef Q_OS_LINUX
+    ~SocketBioSigPipeBlocker()
+    {
+        if (!active)
+            return;
+        if (!wasPending) {
+            sigset_t pending;
+            sigpending(&pending);
+            if (sigismember(&pending, SIGPIPE)) {
+                const timespec noWait = {};
+                sigtimedwait(&sigPipe, nullptr, &noWait);
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+    }
+
+private:
+    sigset_t sigPipe;
+    sigset_t oldMask;
+    bool active;
+    bool wasPending = false;
+#endif
+};
+
 } // unnamed namespace
 
 namespace QTlsPrivate {
@@ -562,7 +619,11 @@ bool TlsCryptographOpenSSL::startHandshake()
     q_SSL_set_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData + socketOffsetInExData, this);
     q_SSL_set_info_callback(ssl, qt_AlertInfoCallback);
 
-    int result = (mode == QSslSocket::SslClientMode) ? q_SSL_connect(ssl) : q_SSL_accept(ssl);
+    int result = 0;
+    {
+        const SocketBioSigPipeBlocker sigPipeBlocker(writeBioIsSocket);
+        result = (mode == QSslSocket::SslClientMode) ? q_SSL_connect(ssl) : q_SSL_accept(ssl);
+    }
     q_SSL_set_ex_data(ssl, QTlsBackendOpenSSL::s_indexForSSLExtraData + errorOffsetInExData, nullptr);
     // Note, unlike errors as external data on SSL object, we do not unset
     // a callback/ex-data if alert notifications are enabled: an alert can
@@ -595,9 +656,13 @@ bool TlsCryptographOpenSSL::startHandshake()
     if (result <= 0) {
         switch (q_SSL_get_error(ssl, result)) {
         case SSL_ERROR_WANT_READ:
-        case SSL_ERROR_WANT_WRITE:
             // The handshake is not yet complete.
             break;
+        case SSL_ERROR_WANT_WRITE:
+            // Only the socket BIO can refuse what OpenSSL writes.
+            if (writeBioIsSocket)
+                waitForSocketBioWritable();
+            break;
         default:
             QString errorString = QTlsBackendOpenSSL::msgErrorsDuringHandshake();
 #ifdef QSSLSOCKET_DEBUG
@@ -769,6 +834,19 @@ void TlsCryptographOpenSSL::continueHandshake()
     if (q_SSL_session_reused(ssl))
         QTlsBackend::setPeerSessionShared(d, true);
 
+#ifdef BIO_CTRL_GET_KTLS_SEND
+    if (writeBioIsSocket) {
+        // From now on, what we write to the plain socket gets encrypted by
+        // the kernel, unless OpenSSL could not enable kernel TLS (for example
+        // if the kernel lacks support for the cipher): then we go on with
+        // the memory BIO, as usual.
+        if (q_BIO_ctrl(writeBio, BIO_CTRL_GET_KTLS_SEND, 0, nullptr) > 0)
+            kernelTlsSend = true;
+        else
+            releaseSocketBio();
+    }
+#endif
+
 #ifdef QT_DECRYPT_SSL_TRAFFIC
     if (q_SSL_get_session(ssl)) {
         size_t master_key_len = q_SSL_SESSION_get_master_key(q_SSL_get_session(ssl), nullptr, 0);
@@ -803,6 +881,13 @@ void TlsCryptographOpenSSL::continueHandshake()
     const auto &configuration = q->sslConfiguration();
     // Cache this SSL session inside the QSslContext
     if (!(configuration.testSslOption(QSsl::SslOptionDisableSessionSharing))) {
+        // ... and for other sockets connecting to the same peer. TLS 1.3
+        // sessions are only resumable once we get a ticket, see
+        // handleNewSessionTicket().
+        if (canCacheSession()) {
+            TlsSessionCacheOpenSSL::instance()->insert(sessionCacheKey, ssl,
+                                                       q->peerCertificateChain());
+        }
         if (!sslContextPointer->cacheSession(ssl)) {
             sslContextPointer.reset(); // we could not cache the session
         } else {
@@ -888,6 +973,16 @@ void TlsCryptographOpenSSL::transmit()
             qint64 totalBytesWritten = 0;
             int nextDataBlockSize;
             while ((nextDataBlockSize = writeBuffer.nextDataBlockSize()) > 0) {
+                if (kernelTlsSend) {
+                    if (plainSocket->write(writeBuffer.readPointer(), nextDataBlockSize) < 0) {
+                        const ScopedBool bg(inSetAndEmitError, true);
+                        setErrorAndEmit(d, plainSocket->error(), plainSocket->errorString());
+                        return;
+                    }
+                    writeBuffer.free(nextDataBlockSize);
+                    totalBytesWritten += nextDataBlockSize;
+                    continue;
+                }
                 int writtenBytes = q_SSL_write(ssl, writeBuffer.readPointer(), nextDataBlockSize);
                 if (writtenBytes <= 0) {
                     int error = q_SSL_get_error(ssl, writtenBytes);
@@ -1030,7 +1125,11 @@ void TlsCryptographOpenSSL::transmit()
             }
             // Don't use SSL_pending(). It's very unreliable.
             inSslRead = true;
-            readBytes = q_SSL_read(ssl, buffer.reserve(bytesToRead), bytesToRead);
+            {
+                // Post-handshake messages may make OpenSSL write a reply.
+                const SocketBioSigPipeBlocker sigPipeBlocker(writeBioIsSocket);
+                readBytes = q_SSL_read(ssl, buffer.reserve(bytesToRead), bytesToRead);
+            }
             inSslRead = false;
             if (renegotiated) {
                 renegotiated = false;
@@ -1113,19 +1212,39 @@ void TlsCryptographOpenSSL::transmit()
 
 void TlsCryptographOpenSSL::disconnectFromHost()
 {
+    Q_ASSERT(d);
+    auto *plainSocket = d->plainTcpSocket();
+    Q_ASSERT(plainSocket);
     if (ssl) {
         if (!shutdown && !q_SSL_in_init(ssl) && !systemOrSslErrorDetected) {
-            if (q_SSL_shutdown(ssl) != 1) {
+            // With kernel TLS, OpenSSL writes the alert to the socket itself,
+            // so it has to wait for the data the plain socket still has to
+            // send. We get called again as it gets written.
+            if (kernelTlsSend && plainSocket->bytesToWrite() > 0
+                && plainSocket->state() == QAbstractSocket::ConnectedState) {
+                return;
+            }
+            int result = 0;
+            {
+                const SocketBioSigPipeBlocker sigPipeBlocker(writeBioIsSocket);
+                result = q_SSL_shutdown(ssl);
+            }
+            if (result != 1) {
                 // Some error may be queued, clear it.
                 QTlsBackendOpenSSL::clearErrorQueue();
+                // The socket BIO could not take the alert yet; we try again
+                // when the socket is writable.
+                if (writeBioIsSocket && q_SSL_get_error(ssl, result) == SSL_ERROR_WANT_WRITE
+                    && plainSocket->state() == QAbstractSocket::ConnectedState) {
+                    shutdownWantsWrite = true;
+                    waitForSocketBioWritable();
+                    return;
+                }
             }
             shutdown = true;
             transmit();
         }
     }
-    Q_ASSERT(d);
-    auto *plainSocket = d->plainTcpSocket();
-    Q_ASSERT(plainSocket);
     plainSocket->disconnectFromHost();
 }
 
@@ -1135,6 +1254,7 @@ void TlsCryptographOpenSSL::disconnected()
     auto *plainSocket = d->plainTcpSocket();
     Q_ASSERT(plainSocket);
     d->setEncrypted(false);
+    releaseSocketBio();
 
     if (plainSocket->bytesAvailable() <= 0) {
         destroySslContext();
@@ -1219,6 +1339,99 @@ bool TlsCryptographOpenSSL::checkSslErrors()
     return true;
 }
 
+// OpenSSL can only enable kernel TLS when it writes to the socket itself,
+// which only works for connections that do not go through a proxy, and
+// with nothing left to send in the plain socket.
+bool TlsCryptographOpenSSL::canUseKernelTls() const
+{
+#if defined(Q_OS_LINUX) && defined(SSL_OP_ENABLE_KTLS) && defined(BIO_CTRL_GET_KTLS_SEND)
+    Q_ASSERT(q);
+    Q_ASSERT(d);
+
+    if (!q->sslConfiguration().testSslOption(QSsl::SslOptionEnableKernelTls)
+        || q_OpenSSL_version_num() < 0x30000000L) {
+        return false;
+    }
+
+    auto *plainSocket = d->plainTcpSocket();
+    Q_ASSERT(plainSocket);
+    if (plainSocket->socketDescriptor() == -1 || plainSocket->bytesToWrite() > 0)
+        return false;
+#ifndef QT_NO_NETWORKPROXY
+    // A socket that was given its descriptor has not resolved any proxy.
+    const auto *socketPrivate =
+            static_cast<const QAbstractSocketPrivate *>(QObjectPrivate::get(plainSocket));
+    const auto proxyType = socketPrivate->proxyInUse.type();
+    if (proxyType != QNetworkProxy::NoProxy && proxyType != QNetworkProxy::DefaultProxy)
+        return false;
+#endif
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Makes OpenSSL write to a memory BIO again, either because the kernel does
+// not encrypt for us after all, or because the plain socket's descriptor may
+// be closed (and reused) from now on.
+void TlsCryptographOpenSSL::releaseSocketBio()
+{
+    if (!ssl || (!writeBioIsSocket && !kernelTlsSend))
+        return;
+
+    BIO *memoryBio = q_BIO_new(q_BIO_s_mem());
+    if (!memoryBio)
+        return;
+    q_SSL_set0_wbio(ssl, memoryBio);
+    writeBio = memoryBio;
+    writeBioIsSocket = false;
+    kernelTlsSend = false;
+    shutdownWantsWrite = false;
+    if (socketBioNotifier)
+        socketBioNotifier->setEnabled(false);
+}
+
+// The socket BIO fails with SSL_ERROR_WANT_WRITE when the socket's send
+// buffer is full. The plain socket has nothing to write of its own then
+// (see canUseKernelTls() and disconnectFromHost()), so it does not watch the
+// descriptor: we do, until OpenSSL can go on.
+void TlsCryptographOpenSSL::waitForSocketBioWritable()
+{
+    Q_ASSERT(d);
+
+    if (!socketBioNotifier) {
+        socketBioNotifier = new QSocketNotifier(QSocketNotifier::Write, this);
+        connect(socketBioNotifier, &QSocketNotifier::activated,
+                this, [this] { socketBioWritable(); });
+    }
+    socketBioNotifier->setSocket(d->plainTcpSocket()->socketDescriptor());
+    socketBioNotifier->setEnabled(true);
+}
+
+void TlsCryptographOpenSSL::socketBioWritable()
+{
+    socketBioNotifier->setEnabled(false);
+    if (!ssl || !writeBioIsSocket)
+        return;
+
+    if (shutdownWantsWrite) {
+        shutdownWantsWrite = false;
+        disconnectFromHost();
+    } else {
+        transmit();
+    }
+}
+
+// Only sessions we trust may be resumed by other sockets, which would not
+// see the errors the application chose to ignore for this one. Nor can we
+// share them when OCSP stapling is enabled: a resumed handshake has no
+// stapled response to check.
+bool TlsCryptographOpenSSL::canCacheSession() const
+{
+    return sessionCacheKey.isValid() && sslErrors.isEmpty()
+           && !q->sslConfiguration().ocspStaplingEnabled();
+}
+
 int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
 {
     // If we return 1, this means we own the session, but we don't.
@@ -1229,6 +1442,11 @@ int TlsCryptographOpenSSL::handleNewSessionTicket(SSL *connection)
     Q_ASSERT(q);
     Q_ASSERT(d);
 
+    if (q_SSL_version(connection) >= 0x304 && q->isEncrypted() && canCacheSession()) {
+        TlsSessionCacheOpenSSL::instance()->insert(sessionCacheKey, connection,
+                                                   q->peerCertificateChain());
+    }
+
     if (q->sslConfiguration().testSslOption(QSsl::SslOptionDisableSessionPersistence)) {
         // We silently ignore, do nothing, remove from cache.
         return 0;
@@ -1369,6 +1587,8 @@ bool TlsCryptographOpenSSL::initSslContext()
     // create a new one.
     const auto mode = d->tlsMode();
     const auto configuration = q->sslConfiguration();
+    sessionCacheKey = {};
+    resumedPeerCertificateChain.clear();
     if (!sslContextPointer)
         sslContextPointer = QSslContext::sharedFromConfiguration(mode, configuration, d->isRootsOnDemandAllowed());
 
@@ -1403,6 +1623,19 @@ bool TlsCryptographOpenSSL::initSslContext()
             if (!q_SSL_ctrl(ssl, SSL_CTRL_SET_TLSEXT_HOSTNAME, TLSEXT_NAMETYPE_host_name, ace.data()))
                 qCWarning(lcTlsBackend, "could not set SSL_CTRL_SET_TLSEXT_HOSTNAME, Server Name Indication disabled");
         }
+
+        // Unless the application manages the sessions itself, try to resume
+        // one from an earlier connection to the same peer. Not with OCSP
+        // stapling, see canCacheSession().
+        if (!configuration.testSslOption(QSsl::SslOptionDisableSessionSharing)
+            && configuration.sessionTicket().isEmpty()
+            && !configuration.ocspStaplingEnabled()) {
+            sessionCacheKey = {tlsHostName, q->peerPort(), configuration};
+            if (!q_SSL_get_session(ssl)) {
+                TlsSessionCacheOpenSSL::instance()->resume(sessionCacheKey, ssl,
+                                                           &resumedPeerCertificateChain);
+            }
+        }
     }
 
     // Clear the session.
@@ -1424,6 +1657,21 @@ bool TlsCryptographOpenSSL::initSslContext()
     // Assign the bios.
     q_SSL_set_bio(ssl, readBio, writeBio);
 
+    // For kernel TLS, OpenSSL has to write to the socket itself, so that it
+    // can hand the keys to the kernel at the end of the handshake (see
+    // continueHandshake()).
+    writeBioIsSocket = false;
+    kernelTlsSend = false;
+    shutdownWantsWrite = false;
+    if (canUseKernelTls()) {
+        const auto descriptor = int(d->plainTcpSocket()->socketDescriptor());
+        if (BIO *socketBio = q_BIO_new_socket(descriptor, BIO_NOCLOSE)) {
+            q_SSL_set0_wbio(ssl, socketBio);
+            writeBio = socketBio;
+            writeBioIsSocket = true;
+        }
+    }
+
     if (mode == QSslSocket::SslClientMode)
         q_SSL_set_connect_state(ssl);
     else
@@ -1489,6 +1737,7 @@ bool TlsCryptographOpenSSL::initSslContext()
 void TlsCryptographOpenSSL::destroySslContext()
 {
     if (ssl) {
+        releaseSocketBio();
         if (!q_SSL_in_init(ssl) && !systemOrSslErrorDetected) {
             // We do not send a shutdown alert here. Just mark the session as
             // resumable for qhttpnetworkconnection's "optimization", otherwise
@@ -1523,6 +1772,12 @@ void TlsCryptographOpenSSL::storePeerCertificates()
         peerCertificateChain = QTlsPrivate::X509CertificateOpenSSL::stackOfX509ToQSslCertificates(q_SSL_get_peer_cert_chain(ssl));
         if (!peerCertificate.isNull() && d->tlsMode() == QSslSocket::SslServerMode)
             peerCertificateChain.prepend(peerCertificate);
+        // A session resumed from TlsSessionCacheOpenSSL only has the peer
+        // certificate; the cache kept the rest of the chain.
+        if (q_SSL_session_reused(ssl) && !resumedPeerCertificateChain.isEmpty()
+            && resumedPeerCertificateChain.first() == peerCertificate) {
+            peerCertificateChain = resumedPeerCertificateChain;
+        }
         QTlsBackend::storePeerCertificateChain(d, peerCertificateChain);
     }
 }
@@ -19,6 +19,7 @@
 
 #include "qtlsbackend_openssl_p.h"
 #include "qsslcontext_openssl_p.h"
+#include "qtlssessioncache_openssl_p.h"
 #include "qopenssl_p.h"
 
 #include <QtNetwork/qsslcertificate.h>
@@ -31,6 +32,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QSocketNotifier;
+
 namespace QTlsPrivate {
 
 class TlsCryptographOpenSSL : public TlsCryptograph
@@ -99,15 +102,26 @@ private:
     // easier (see qsslsocket_openssl.cpp, while it exists).
     bool initSslContext();
     void destroySslContext();
+    bool canCacheSession() const;
+    bool canUseKernelTls() const;
+    void releaseSocketBio();
+    void waitForSocketBioWritable();
+    void socketBioWritable();
 
     std::shared_ptr<QSslContext> sslContextPointer;
     SSL *ssl = nullptr; // TLSTODO: RAII.
+    TlsSessionCacheOpenSSL::Key sessionCacheKey;
+    QList<QSslCertificate> resumedPeerCertificateChain;
 
     QList<QSslErrorEntry> errorList;
     QList<QSslError> sslErrors;
 
     BIO *readBio = nullptr;
     BIO *writeBio = nullptr;
+    bool writeBioIsSocket = false;
+    bool kernelTlsSend = false; // the kernel encrypts what the plain socket sends
+    bool shutdownWantsWrite = false;
+    QSocketNotifier *socketBioNotifier = nullptr;
 
     QList<QOcspResponse> ocspResponses;
 
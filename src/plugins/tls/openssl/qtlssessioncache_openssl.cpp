@@ -0,0 +1,92 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qtlssessioncache_openssl_p.h"
+#include "qsslsocket_openssl_symbols_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace QTlsPrivate {
+
+Q_GLOBAL_STATIC(TlsSessionCacheOpenSSL, globalSessionCache)
+
+TlsSessionCacheOpenSSL *TlsSessionCacheOpenSSL::instance()
+{
+    return globalSessionCache();
+}
+
+// Sets the session cached for \a key on \a ssl, which must not have started
+// its handshake yet, and stores the peer certificate chain of the session in
+// \a peerCertificateChain. Returns false if there is no such session.
+bool TlsSessionCacheOpenSSL::resume(const Key &key, SSL *ssl,
+                                    QList<QSslCertificate> *peerCertificateChain)
+{
+    Q_ASSERT(ssl);
+    Q_ASSERT(peerCertificateChain);
+
+    if (!key.isValid())
+        return false;
+
+    QByteArray sessionAsn1;
+    {
+        const QMutexLocker locker(&mutex);
+        for (qsizetype i = entries.size() - 1; i >= 0; --i) {
+            if (entries.at(i).key.matches(key)) {
+                sessionAsn1 = entries.at(i).sessionAsn1;
+                *peerCertificateChain = entries.at(i).peerCertificateChain;
+                entries.move(i, entries.size() - 1);
+                break;
+            }
+        }
+    }
+    if (sessionAsn1.isEmpty())
+        return false;
+
+    const auto *data = reinterpret_cast<const unsigned char *>(sessionAsn1.constData());
+    SSL_SESSION *session = q_d2i_SSL_SESSION(nullptr, &data, sessionAsn1.size());
+    if (!session)
+        return false;
+    // SSL_set_session() takes its own reference to the session.
+    const bool resumed = q_SSL_set_session(ssl, session);
+    q_SSL_SESSION_free(session);
+    return resumed;
+}
+
+// Stores the session negotiated by \a ssl, with the \a peerCertificateChain
+// the peer sent, replacing the one we had for \a key, if any. Evicts the
+// least recently used entry when full.
+void TlsSessionCacheOpenSSL::insert(const Key &key, SSL *ssl,
+                                    const QList<QSslCertificate> &peerCertificateChain)
+{
+    Q_ASSERT(ssl);
+
+    if (!key.isValid())
+        return;
+
+    SSL_SESSION *session = q_SSL_get_session(ssl);
+    if (!session || !q_SSL_SESSION_is_resumable(session))
+        return;
+
+    const int sessionSize = q_i2d_SSL_SESSION(session, nullptr);
+    if (sessionSize <= 0)
+        return;
+    QByteArray sessionAsn1(sessionSize, Qt::Uninitialized);
+    auto *data = reinterpret_cast<unsigned char *>(sessionAsn1.data());
+    if (!q_i2d_SSL_SESSION(session, &data))
+        return;
+
+    const QMutexLocker locker(&mutex);
+    for (qsizetype i = 0; i < entries.size(); ++i) {
+        if (entries.at(i).key.matches(key)) {
+            entries.removeAt(i);
+            break;
+        }
+    }
+    if (entries.size() == MaxEntries)
+        entries.removeFirst();
+    entries.append({key, std::move(sessionAsn1), peerCertificateChain});
+}
+
+} // namespace QTlsPrivate
+
+QT_END_NAMESPACE
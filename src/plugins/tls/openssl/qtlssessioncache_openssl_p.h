@@ -0,0 +1,81 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QTLSSESSIONCACHE_OPENSSL_P_H
+#define QTLSSESSIONCACHE_OPENSSL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtNetwork/private/qtnetworkglobal_p.h>
+
+#include <QtNetwork/qsslcertificate.h>
+#include <QtNetwork/qsslconfiguration.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qlist.h>
+
+#include <openssl/ssl.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QTlsPrivate {
+
+// A process-wide cache of client sessions, shared by all sockets, so that
+// a new connection to a peer we already talked to can do an abbreviated
+// handshake. Sessions are only ever resumed for the same peer name, port and
+// configuration they were negotiated with.
+class TlsSessionCacheOpenSSL
+{
+public:
+    struct Key
+    {
+        QString peerName;
+        quint16 port = 0;
+        QSslConfiguration configuration;
+
+        bool isValid() const { return !peerName.isEmpty(); }
+        bool matches(const Key &other) const
+        {
+            return port == other.port && peerName == other.peerName
+                   && configuration == other.configuration;
+        }
+    };
+
+    static TlsSessionCacheOpenSSL *instance();
+
+    bool resume(const Key &key, SSL *ssl, QList<QSslCertificate> *peerCertificateChain);
+    void insert(const Key &key, SSL *ssl, const QList<QSslCertificate> &peerCertificateChain);
+
+private:
+    struct Entry
+    {
+        Key key;
+        // Each connection gets a session object of its own: OpenSSL marks
+        // the one of a connection that was not shut down as not resumable.
+        QByteArray sessionAsn1;
+        // The ASN.1 form only has the peer certificate, not its chain.
+        QList<QSslCertificate> peerCertificateChain;
+    };
+
+    static constexpr qsizetype MaxEntries = 64;
+
+    QMutex mutex;
+    QList<Entry> entries; // the most recently used entry is the last one
+};
+
+} // namespace QTlsPrivate
+
+QT_END_NAMESPACE
+
+#endif // QTLSSESSIONCACHE_OPENSSL_P_H
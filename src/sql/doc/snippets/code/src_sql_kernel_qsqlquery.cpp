@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR BSD-3-Clause
 #include <QSqlDatabase>
 #include <QSqlQuery>
+#include <QSqlColumnBatch>
 #include <QSqlDriver>
 #include <QDebug>
 
@@ -33,3 +34,46 @@ if (!q.execBatch())
     qDebug() << q.lastError();
 //! [2]
 }
+
+void sumSalaries()
+{
+//! [4]
+QSqlQuery q;
+q.setForwardOnly(true);
+q.exec("select salary from employees");
+
+QSqlColumnBatch batch;
+qint64 sum = 0;
+while (q.fetchBatch(&batch, 1024)) {
+    const qint64 *salaries = batch.int64Data(0);
+    for (int row = 0; row < batch.rowCount(); ++row) {
+        if (!batch.isNull(row, 0))
+            sum += salaries[row];
+    }
+}
+//! [4]
+}
+
+void bulkInsert()
+{
+//! [5]
+QSqlQuery q;
+const QList<int> ids = { 1, 2, 3, 4 };
+const QStringList names = { "Harald", "Boris", "Trond", QString() };
+if (!q.bulkInsert("myTable", { "id", "name" }, { QVariant::fromValue(ids), names }))
+    qDebug() << q.lastError();
+//! [5]
+}
+
+void countEmployees(QObject *context)
+{
+//! [6]
+auto q = std::make_shared<QSqlQuery>();
+q->execAsync("select count(*) from employees").then(context, [q](bool ok) {
+    if (ok && q->next())
+        qDebug() << "Number of employees:" << q->value(0).toInt();
+    else
+        qDebug() << q->lastError();
+});
+//! [6]
+}
@@ -0,0 +1,342 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsqlcolumnbatch.h"
+#include "qsqlcolumnbatch_p.h"
+
+#include "qsqlfield.h"
+#include "qsqlrecord.h"
+#include "qvariant.h"
+
+QT_BEGIN_NAMESPACE
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QSqlColumnBatchPrivate)
+
+// Reserving more than this for a batch is left to the growth of the lists.
+static constexpr int MaxReservedRows = 65536;
+
+QSqlColumnBatch::ColumnType QSqlColumnBatchPrivate::columnType(QMetaType type,
+                                                              QSql::NumericalPrecisionPolicy policy)
+{
+    switch (type.id()) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return QSqlColumnBatch::Int64;
+    case QMetaType::Float:
+    case QMetaType::Double:
+        switch (policy) {
+        case QSql::LowPrecisionInt32:
+        case QSql::LowPrecisionInt64:
+            return QSqlColumnBatch::Int64;
+        case QSql::LowPrecisionDouble:
+            return QSqlColumnBatch::Double;
+        case QSql::HighPrecision:
+            return QSqlColumnBatch::Bytes;
+        }
+        return QSqlColumnBatch::Double;
+    default:
+        return QSqlColumnBatch::Bytes;
+    }
+}
+
+void QSqlColumnBatchPrivate::reset(const QSqlRecord &record,
+                                   QSql::NumericalPrecisionPolicy policy, int expectedRows)
+{
+    QList<QSqlColumnBatch::ColumnType> types;
+    types.reserve(record.count());
+    for (int i = 0; i < record.count(); ++i)
+        types.append(columnType(record.field(i).metaType(), policy));
+    reset(types, expectedRows);
+}
+
+void QSqlColumnBatchPrivate::reset(const QList<QSqlColumnBatch::ColumnType> &types,
+                                   int expectedRows)
+{
+    const int reservedRows = qBound(0, expectedRows, MaxReservedRows);
+    rowCount = 0;
+    columns.resize(types.size());
+    for (qsizetype i = 0; i < types.size(); ++i) {
+        Column &column = columns[i];
+        column.type = types.at(i);
+        // clear() keeps the capacity of a list we do not share
+        column.nulls.clear();
+        column.nulls.reserve((reservedRows + 7) / 8);
+        column.int64Values.clear();
+        column.doubleValues.clear();
+        column.offsets.clear();
+        column.bytes.resize(0);
+        switch (column.type) {
+        case QSqlColumnBatch::Int64:
+            column.int64Values.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::Double:
+            column.doubleValues.reserve(reservedRows);
+            break;
+        case QSqlColumnBatch::Bytes:
+            column.offsets.reserve(reservedRows + 1);
+            column.offsets.append(0);
+            break;
+        }
+    }
+}
+
+void QSqlColumnBatchPrivate::appendNull(int column)
+{
+    Column &c = columns[column];
+    c.nulls[rowCount / 8] |= uchar(1u << (rowCount % 8));
+    switch (c.type) {
+    case QSqlColumnBatch::Int64:
+        c.int64Values.append(0);
+        break;
+    case QSqlColumnBatch::Double:
+        c.doubleValues.append(0);
+        break;
+    case QSqlColumnBatch::Bytes:
+        c.offsets.append(c.bytes.size());
+        break;
+    }
+}
+
+void QSqlColumnBatchPrivate::appendValue(int column, const QVariant &value)
+{
+    if (value.isNull()) {
+        appendNull(column);
+        return;
+    }
+    switch (columns.at(column).type) {
+    case QSqlColumnBatch::Int64:
+        appendInt64(column, value.toLongLong());
+        break;
+    case QSqlColumnBatch::Double:
+        appendDouble(column, value.toDouble());
+        break;
+    case QSqlColumnBatch::Bytes: {
+        const QByteArray bytes = value.typeId() == QMetaType::QByteArray
+                ? value.toByteArray() : value.toString().toUtf8();
+        appendBytes(column, bytes.constData(), bytes.size());
+        break;
+    }
+    }
+}
+
+/*!
+    \class QSqlColumnBatch
+    \brief The QSqlColumnBatch class holds a block of rows of a query result,
+    column by column.
+
+    \ingroup database
+    \ingroup shared
+    \inmodule QtSql
+    \since 6.6
+
+    QSqlQuery::fetchBatch() fills a QSqlColumnBatch with many rows at a time.
+    Unlike QSqlQuery::value(), it does not create a QVariant for every value:
+    each column stores its values in one contiguous buffer of a single type,
+    which makes reading large result sets considerably faster.
+
+    The type of a column, columnType(), follows from the type of the field
+    in QSqlQuery::record():
+
+    \list
+    \li Boolean and integer fields are Int64 columns. int64Data() points to
+        rowCount() values.
+    \li Floating point and decimal fields are Double columns, where
+        doubleData() points to rowCount() values. That is, unless
+        QSqlQuery::numericalPrecisionPolicy() is one of the low precision
+        integer policies, which make them Int64 columns, or
+        QSql::HighPrecision, which makes them Bytes columns holding the
+        numbers as text.
+    \li All other fields are Bytes columns: bytes() returns binary values
+        as they are and all others as UTF-8 encoded text.
+    \endlist
+
+    A NULL value is flagged in the nullBitmap() of its column, and its value
+    in the column's buffer is 0 or empty.
+
+    Call QSqlQuery::fetchBatch() with the same QSqlColumnBatch for all
+    batches of a query to reuse the memory of the buffers.
+
+    \sa QSqlQuery::fetchBatch()
+*/
+
+/*!
+    \enum QSqlColumnBatch::ColumnType
+
+    This enum describes how the values of a column are stored.
+
+    \value Int64 64-bit integers, see int64Data() and int64Value().
+    \value Double Double precision floating point numbers, see doubleData()
+           and doubleValue().
+    \value Bytes Variable length byte strings, see bytes().
+*/
+
+/*!
+    Constructs an empty batch.
+*/
+QSqlColumnBatch::QSqlColumnBatch() = default;
+
+/*!
+    Destroys the batch.
+*/
+QSqlColumnBatch::~QSqlColumnBatch() = default;
+
+/*!
+    Constructs a copy of \a other.
+*/
+QSqlColumnBatch::QSqlColumnBatch(const QSqlColumnBatch &other) noexcept = default;
+
+/*!
+    \fn QSqlColumnBatch::QSqlColumnBatch(QSqlColumnBatch &&other)
+
+    Move-constructs a batch from \a other.
+*/
+
+/*!
+    Assigns \a other to this batch.
+*/
+QSqlColumnBatch &QSqlColumnBatch::operator=(const QSqlColumnBatch &other) noexcept = default;
+
+/*!
+    \fn QSqlColumnBatch &QSqlColumnBatch::operator=(QSqlColumnBatch &&other)
+
+    Move-assigns \a other to this batch.
+*/
+
+/*!
+    \fn void QSqlColumnBatch::swap(QSqlColumnBatch &other)
+
+    Swaps this batch with \a other. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Returns the number of rows in the batch.
+*/
+int QSqlColumnBatch::rowCount() const
+{
+    return d ? d->rowCount : 0;
+}
+
+/*!
+    Returns the number of columns in the batch, which is the number of fields
+    of the query that filled it.
+*/
+int QSqlColumnBatch::columnCount() const
+{
+    return d ? int(d->columns.size()) : 0;
+}
+
+/*!
+    Returns how the values of \a column are stored.
+*/
+QSqlColumnBatch::ColumnType QSqlColumnBatch::columnType(int column) const
+{
+    if (column < 0 || column >= columnCount())
+        return Bytes;
+    return d->columns.at(column).type;
+}
+
+/*!
+    Returns \c true if the value in \a row and \a column is NULL or does not
+    exist.
+*/
+bool QSqlColumnBatch::isNull(int row, int column) const
+{
+    if (row < 0 || row >= rowCount() || column < 0 || column >= columnCount())
+        return true;
+    return d->columns.at(column).nulls.at(row / 8) & (1u << (row % 8));
+}
+
+/*!
+    Returns the NULL flags of \a column: bit \c{row % 8} of byte \c{row / 8}
+    is set if the value in \c row is NULL. Returns \nullptr if there is no
+    such column.
+*/
+const uchar *QSqlColumnBatch::nullBitmap(int column) const
+{
+    if (column < 0 || column >= columnCount())
+        return nullptr;
+    return d->columns.at(column).nulls.constData();
+}
+
+/*!
+    Returns the rowCount() values of \a column, or \nullptr if it is not an
+    Int64 column.
+*/
+const qint64 *QSqlColumnBatch::int64Data(int column) const
+{
+    if (columnType(column) != Int64 || columnCount() <= column)
+        return nullptr;
+    return d->columns.at(column).int64Values.constData();
+}
+
+/*!
+    Returns the rowCount() values of \a column, or \nullptr if it is not a
+    Double column.
+*/
+const double *QSqlColumnBatch::doubleData(int column) const
+{
+    if (columnType(column) != Double || columnCount() <= column)
+        return nullptr;
+    return d->columns.at(column).doubleValues.constData();
+}
+
+/*!
+    Returns the value in \a row of the Int64 column \a column, or 0 if there
+    is no such value.
+*/
+qint64 QSqlColumnBatch::int64Value(int row, int column) const
+{
+    const qint64 *values = int64Data(column);
+    if (!values || row < 0 || row >= rowCount())
+        return 0;
+    return values[row];
+}
+
+/*!
+    Returns the value in \a row of the Double column \a column, or 0 if there
+    is no such value.
+*/
+double QSqlColumnBatch::doubleValue(int row, int column) const
+{
+    const double *values = doubleData(column);
+    if (!values || row < 0 || row >= rowCount())
+        return 0;
+    return values[row];
+}
+
+/*!
+    Returns the value in \a row of the Bytes column \a column, or an empty
+    view if there is no such value. The view remains valid until the batch
+    is modified or destroyed.
+*/
+QByteArrayView QSqlColumnBatch::bytes(int row, int column) const
+{
+    if (column < 0 || column >= columnCount() || columnType(column) != Bytes
+        || row < 0 || row >= rowCount()) {
+        return {};
+    }
+    const QSqlColumnBatchPrivate::Column &c = d->columns.at(column);
+    const qsizetype begin = c.offsets.at(row);
+    return QByteArrayView(c.bytes.constData() + begin, c.offsets.at(row + 1) - begin);
+}
+
+/*!
+    Removes all rows and columns from the batch, and frees its memory.
+*/
+void QSqlColumnBatch::clear()
+{
+    d.reset();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,56 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLCOLUMNBATCH_H
+#define QSQLCOLUMNBATCH_H
+
+#include <QtSql/qtsqlglobal.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qshareddata.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlColumnBatchPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QSqlColumnBatchPrivate, Q_SQL_EXPORT)
+
+class Q_SQL_EXPORT QSqlColumnBatch
+{
+public:
+    enum ColumnType { Int64, Double, Bytes };
+
+    QSqlColumnBatch();
+    ~QSqlColumnBatch();
+
+    QSqlColumnBatch(const QSqlColumnBatch &other) noexcept;
+    QSqlColumnBatch &operator=(const QSqlColumnBatch &other) noexcept;
+
+    QSqlColumnBatch(QSqlColumnBatch &&other) noexcept = default;
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QSqlColumnBatch)
+    void swap(QSqlColumnBatch &other) noexcept
+    { d.swap(other.d); }
+
+    int rowCount() const;
+    int columnCount() const;
+    ColumnType columnType(int column) const;
+
+    bool isNull(int row, int column) const;
+    const uchar *nullBitmap(int column) const;
+
+    const qint64 *int64Data(int column) const;
+    const double *doubleData(int column) const;
+    qint64 int64Value(int row, int column) const;
+    double doubleValue(int row, int column) const;
+    QByteArrayView bytes(int row, int column) const;
+
+    void clear();
+
+private:
+    friend class QSqlColumnBatchPrivate;
+    QExplicitlySharedDataPointer<QSqlColumnBatchPrivate> d;
+};
+
+Q_DECLARE_SHARED(QSqlColumnBatch)
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBATCH_H
@@ -0,0 +1,101 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSQLCOLUMNBATCH_P_H
+#define QSQLCOLUMNBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of the Qt SQL drivers.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtSql/private/qtsqlglobal_p.h>
+#include "qsqlcolumnbatch.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmetatype.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlRecord;
+class QVariant;
+
+class Q_SQL_EXPORT QSqlColumnBatchPrivate : public QSharedData
+{
+public:
+    struct Column
+    {
+        QSqlColumnBatch::ColumnType type = QSqlColumnBatch::Bytes;
+        QList<uchar> nulls; // bit (row % 8) of byte (row / 8) is set for NULL
+        QList<qint64> int64Values;
+        QList<double> doubleValues;
+        QList<qsizetype> offsets; // row i is in bytes[offsets[i], offsets[i + 1])
+        QByteArray bytes;
+    };
+
+    static QSqlColumnBatchPrivate *get(QSqlColumnBatch &batch)
+    {
+        if (!batch.d)
+            batch.d.reset(new QSqlColumnBatchPrivate);
+        batch.d.detach();
+        return batch.d.data();
+    }
+
+    static QSqlColumnBatch::ColumnType columnType(QMetaType type,
+                                                  QSql::NumericalPrecisionPolicy policy);
+
+    // Clears the values, keeping the memory, and sets up the columns for the
+    // fields of record, or the given types.
+    void reset(const QSqlRecord &record, QSql::NumericalPrecisionPolicy policy,
+               int expectedRows);
+    void reset(const QList<QSqlColumnBatch::ColumnType> &types, int expectedRows);
+
+    // A driver appends one value (or NULL) to every column between
+    // beginRow() and endRow().
+    void beginRow()
+    {
+        if (rowCount % 8 == 0) {
+            for (Column &column : columns)
+                column.nulls.append(0);
+        }
+    }
+    void endRow() { ++rowCount; }
+
+    QSqlColumnBatch::ColumnType columnType(int column) const { return columns.at(column).type; }
+
+    void appendNull(int column);
+    void appendInt64(int column, qint64 value) { columns[column].int64Values.append(value); }
+    void appendDouble(int column, double value) { columns[column].doubleValues.append(value); }
+    void appendBytes(int column, const char *data, qsizetype size)
+    {
+        Column &c = columns[column];
+        c.bytes.append(data, size);
+        c.offsets.append(c.bytes.size());
+    }
+    // Converts value to the type of column; this is what drivers without
+    // native support end up with.
+    void appendValue(int column, const QVariant &value);
+
+    QList<Column> columns;
+    int rowCount = 0;
+};
+
+// The argument of QSqlResult::virtual_hook(QSqlResult::FetchColumnBatch).
+// A driver that fetches the rows itself sets handled.
+struct QSqlColumnBatchFetch
+{
+    QSqlColumnBatch *batch = nullptr;
+    int maxRows = 0;
+    bool handled = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSQLCOLUMNBATCH_P_H
@@ -1154,6 +1154,7 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li tty
     \li requiressl
     \li service
+    \li QPSQL_FETCH_SIZE
     \endlist
 
     \header \li DB2 \li OCI
@@ -159,6 +159,15 @@ bool QSqlDriver::isOpenError() const
     \value FinishQuery Whether the driver can do any low-level resource cleanup when QSqlQuery::finish() is called.
     \value MultipleResultSets Whether the driver can access multiple result sets returned from batched statements or stored procedures.
     \value CancelQuery Whether the driver allows cancelling a running query.
+    \value [since 6.6] BatchFetch Whether the driver fills a QSqlColumnBatch
+           in QSqlQuery::fetchBatch() without converting each value to a
+           QVariant first.
+    \value [since 6.6] PipelinedBatches Whether QSqlQuery::execBatch() sends
+           all rows of a batch to the database before it waits for their
+           results.
+    \value [since 6.6] BulkInsert Whether the driver loads the rows of
+           QSqlQuery::bulkInsert() with a bulk loading mechanism of the
+           database, instead of executing an INSERT statement for each row.
 
     More information about supported features can be found in the
     \l{sql-driver.html}{Qt SQL driver} documentation.
@@ -32,7 +32,8 @@ public:
     enum DriverFeature { Transactions, QuerySize, BLOB, Unicode, PreparedQueries,
                          NamedPlaceholders, PositionalPlaceholders, LastInsertId,
                          BatchOperations, SimpleLocking, LowPrecisionNumbers,
-                         EventNotifications, FinishQuery, MultipleResultSets, CancelQuery };
+                         EventNotifications, FinishQuery, MultipleResultSets, CancelQuery,
+                         BatchFetch, PipelinedBatches, BulkInsert };
 
     enum StatementType { WhereStatement, SelectStatement, UpdateStatement,
                          InsertStatement, DeleteStatement };
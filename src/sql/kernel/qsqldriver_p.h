@@ -17,6 +17,11 @@
 
 #include <QtSql/private/qtsqlglobal_p.h>
 #include "private/qobject_p.h"
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <memory>
 #include "qsqldriver.h"
 #include "qsqlerror.h"
 
@@ -37,6 +42,18 @@ public:
     QSqlDriver::DbmsType dbmsType;
     bool isOpen = false;
     bool isOpenError = false;
+#if QT_CONFIG(thread)
+    // Drivers that cannot wait for results without blocking, and whose
+    // connections may be used by another thread than the one that opened
+    // them, set this to run their asynchronous queries in asyncExecPool, one
+    // at a time. The others execute them right away.
+    bool canExecInThread = false;
+    std::unique_ptr<QThreadPool> asyncExecPool;
+
+    // called in the thread of asyncExecPool around each query
+    virtual void execThreadStarted() {}
+    virtual void execThreadFinished() {}
+#endif
 };
 
 QT_END_NAMESPACE
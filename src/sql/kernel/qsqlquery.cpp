@@ -9,11 +9,14 @@
 #include "qdebug.h"
 #include "qelapsedtimer.h"
 #include "qmap.h"
+#include "qsqlcolumnbatch.h"
+#include "qsqlfield.h"
 #include "qsqlrecord.h"
 #include "qsqlresult.h"
 #include "qsqldriver.h"
 #include "qsqldatabase.h"
 #include "private/qsqlnulldriver_p.h"
+#include "private/qsqlresult_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -26,6 +29,7 @@ public:
     QSqlResult* sqlResult;
 
     static QSqlQueryPrivate* shared_null();
+    void waitForThreadedExec();
 };
 
 Q_GLOBAL_STATIC_WITH_ARGS(QSqlQueryPrivate, nullQueryPrivate, (nullptr))
@@ -54,9 +58,19 @@ QSqlQueryPrivate::~QSqlQueryPrivate()
     QSqlResult *nr = nullResult();
     if (!nr || sqlResult == nr)
         return;
+    waitForThreadedExec();
     delete sqlResult;
 }
 
+// Waits for the query that execAsync() runs in a thread of the driver,
+// which uses the result until it is done.
+void QSqlQueryPrivate::waitForThreadedExec()
+{
+#if QT_CONFIG(future)
+    sqlResult->d_func()->threadedExec.waitForFinished();
+#endif
+}
+
 /*!
     \class QSqlQuery
     \brief The QSqlQuery class provides a means of executing and
@@ -372,6 +386,22 @@ bool QSqlQuery::exec(const QString& query)
     QElapsedTimer t;
     t.start();
 #endif
+    if (!beginExec(query))
+        return false;
+
+    bool retval = d->sqlResult->reset(query);
+#ifdef QT_DEBUG_SQL
+    qDebug().nospace() << "Executed query (" << t.elapsed() << "ms, " << d->sqlResult->size()
+                       << " results, " << d->sqlResult->numRowsAffected()
+                       << " affected): " << d->sqlResult->lastQuery();
+#endif
+    return retval;
+}
+
+// Prepares the result for executing query, as exec() and execAsync() do.
+bool QSqlQuery::beginExec(const QString &query)
+{
+    d->waitForThreadedExec();
     if (!driver()) {
         qWarning("QSqlQuery::exec: called before driver has been set up");
         return false;
@@ -397,15 +427,44 @@ bool QSqlQuery::exec(const QString& query)
         qWarning("QSqlQuery::exec: empty query");
         return false;
     }
+    return true;
+}
 
-    bool retval = d->sqlResult->reset(query);
-#ifdef QT_DEBUG_SQL
-    qDebug().nospace() << "Executed query (" << t.elapsed() << "ms, " << d->sqlResult->size()
-                       << " results, " << d->sqlResult->numRowsAffected()
-                       << " affected): " << d->sqlResult->lastQuery();
-#endif
-    return retval;
+#if QT_CONFIG(future)
+/*!
+    \since 6.6
+
+    Starts executing the SQL in \a query without waiting for it, and
+    returns a future that finishes with the value exec() would have
+    returned once the query has been executed. The query is then
+    positioned before the first record, as after exec().
+
+    The PostgreSQL driver sends the query and receives its results in the
+    event loop of the calling thread. The SQLite and MySQL drivers execute
+    the query in a worker thread; the queries of a database connection run
+    one at a time, in the order in which they were started. To keep several
+    queries in flight at once, execute them on different connections. All
+    other drivers execute the query before execAsync() returns. For a
+    forward-only query, the future may finish as soon as the first record
+    has arrived, and fetching the following records can block as it does
+    after exec().
+
+    Until the future has finished, neither this query nor its database
+    connection may be used. Destroying the query waits for a query that
+    is executed in a worker thread to finish, and abandons one that is
+    executed in the event loop.
+
+    \snippet code/src_sql_kernel_qsqlquery.cpp 6
+
+    \sa exec(), QFuture::then()
+*/
+QFuture<bool> QSqlQuery::execAsync(const QString &query)
+{
+    if (!beginExec(query))
+        return QtFuture::makeReadyFuture(false);
+    return d->sqlResult->resetAsync(query);
 }
+#endif // QT_CONFIG(future)
 
 /*!
     Returns the value of field \a index in the current record.
@@ -666,6 +725,41 @@ bool QSqlQuery::next()
     }
 }
 
+/*!
+  \since 6.6
+
+  Retrieves up to \a maxRows records following the current one into
+  \a batch, which stores them column by column. This is much faster than
+  calling next() and value() for every record when reading many records,
+  since no QVariant is created for the values. Drivers that support
+  QSqlDriver::BatchFetch fill the batch directly from their own buffers.
+  For a forward-only query, this is the fastest way of reading all rows.
+
+  The previous contents of \a batch are replaced, but its memory is reused.
+  The query must be \l{isActive()}{active} and isSelect() must return
+  true, otherwise the batch is left empty and false is returned.
+
+  Afterwards, the query is positioned on the last record in \a batch, or
+  after the last record if there were fewer than \a maxRows records left.
+  The values of a record that was fetched into a batch are not available
+  through value().
+
+  Returns \c true if at least one record was retrieved.
+
+  \snippet code/src_sql_kernel_qsqlquery.cpp 4
+
+  \sa next(), QSqlColumnBatch, QSqlDriver::hasFeature()
+*/
+bool QSqlQuery::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    Q_ASSERT(batch);
+    if (!isSelect() || !isActive() || at() == QSql::AfterLastRow || maxRows <= 0) {
+        batch->clear();
+        return false;
+    }
+    return d->sqlResult->fetchBatch(batch, maxRows);
+}
+
 /*!
 
   Retrieves the previous record in the result, if available, and
@@ -962,6 +1056,7 @@ void QSqlQuery::clear()
 */
 bool QSqlQuery::prepare(const QString& query)
 {
+    d->waitForThreadedExec();
     if (d->ref.loadRelaxed() != 1) {
         bool fo = isForwardOnly();
         *this = QSqlQuery(driver()->createResult());
@@ -1006,6 +1101,7 @@ bool QSqlQuery::exec()
     QElapsedTimer t;
     t.start();
 #endif
+    d->waitForThreadedExec();
     d->sqlResult->resetBindCount();
 
     if (d->sqlResult->lastError().isValid())
@@ -1020,6 +1116,29 @@ bool QSqlQuery::exec()
     return retval;
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.6
+    \overload
+
+    Starts executing the previously prepared query without waiting for it,
+    and returns a future that finishes with the value exec() would have
+    returned once the query has been executed.
+
+    \sa prepare(), exec()
+*/
+QFuture<bool> QSqlQuery::execAsync()
+{
+    d->waitForThreadedExec();
+    d->sqlResult->resetBindCount();
+
+    if (d->sqlResult->lastError().isValid())
+        d->sqlResult->setLastError(QSqlError());
+
+    return d->sqlResult->execAsync();
+}
+#endif // QT_CONFIG(future)
+
 /*! \enum QSqlQuery::BatchExecutionMode
 
     \value ValuesAsRows - Updates multiple rows. Treats every entry in a QVariantList as a value for updating the next row.
@@ -1075,6 +1194,52 @@ bool QSqlQuery::execBatch(BatchExecutionMode mode)
     return d->sqlResult->execBatch(mode == ValuesAsColumns);
 }
 
+/*!
+  \since 6.6
+
+  Inserts rows into the table \a tableName, setting the fields
+  \a fieldNames to the values in \a columns. Each entry of \a columns
+  is a list, for example a QVariantList or a QStringList, of the values
+  for the field at the same position in \a fieldNames, as the bound
+  values of execBatch() are. All lists must have the same size.
+
+  Drivers that support QSqlDriver::BulkInsert load the rows with the bulk
+  loading mechanism of their database, which is much faster than
+  inserting the rows one by one; the PostgreSQL driver uses \c{COPY FROM
+  STDIN}, for example. Other drivers prepare an INSERT statement for the
+  fields, see QSqlDriver::sqlStatement(), and execute it with execBatch().
+
+  Returns \c true if all rows were inserted; otherwise returns \c false
+  and sets lastError(). numRowsAffected() returns the number of rows
+  inserted.
+
+  \snippet code/src_sql_kernel_qsqlquery.cpp 5
+
+  \sa execBatch(), QSqlDriver::hasFeature()
+*/
+bool QSqlQuery::bulkInsert(const QString &tableName, const QStringList &fieldNames,
+                           const QVariantList &columns)
+{
+    if (!driver()) {
+        qWarning("QSqlQuery::bulkInsert: called before driver has been set up");
+        return false;
+    }
+    if (fieldNames.isEmpty() || fieldNames.size() != columns.size()) {
+        qWarning("QSqlQuery::bulkInsert: there must be one column for each field");
+        return false;
+    }
+
+    QSqlRecord record;
+    for (const QString &fieldName : fieldNames)
+        record.append(QSqlField(fieldName));
+    if (!prepare(driver()->sqlStatement(QSqlDriver::InsertStatement, tableName, record, true)))
+        return false;
+    for (const QVariant &column : columns)
+        addBindValue(column);
+    d->sqlResult->resetBindCount();
+    return d->sqlResult->bulkInsert(tableName, fieldNames);
+}
+
 /*!
   Set the placeholder \a placeholder to be bound to value \a val in
   the prepared statement. Note that the placeholder mark (e.g \c{:})
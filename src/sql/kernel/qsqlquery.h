@@ -8,6 +8,9 @@
 #include <QtSql/qsqldatabase.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qvariant.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -16,6 +19,7 @@ class QSqlDriver;
 class QSqlError;
 class QSqlResult;
 class QSqlRecord;
+class QSqlColumnBatch;
 class QSqlQueryPrivate;
 
 
@@ -63,6 +67,9 @@ public:
 
     void setForwardOnly(bool forward);
     bool exec(const QString& query);
+#if QT_CONFIG(future)
+    QFuture<bool> execAsync(const QString &query);
+#endif
     QVariant value(int i) const;
     QVariant value(const QString& name) const;
 
@@ -74,11 +81,17 @@ public:
     bool previous();
     bool first();
     bool last();
+    bool fetchBatch(QSqlColumnBatch *batch, int maxRows);
+    bool bulkInsert(const QString &tableName, const QStringList &fieldNames,
+                    const QVariantList &columns);
 
     void clear();
 
     // prepared query support
     bool exec();
+#if QT_CONFIG(future)
+    QFuture<bool> execAsync();
+#endif
     enum BatchExecutionMode { ValuesAsRows, ValuesAsColumns };
     bool execBatch(BatchExecutionMode mode = ValuesAsRows);
     bool prepare(const QString& query);
@@ -95,6 +108,8 @@ public:
     bool nextResult();
 
 private:
+    bool beginExec(const QString &query);
+
     QSqlQueryPrivate* d;
 };
 
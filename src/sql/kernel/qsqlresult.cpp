@@ -6,6 +6,8 @@
 #include "qhash.h"
 #include "qlist.h"
 #include "qpointer.h"
+#include "qsqlcolumnbatch.h"
+#include "qsqlcolumnbatch_p.h"
 #include "qsqldriver.h"
 #include "qsqlerror.h"
 #include "qsqlfield.h"
@@ -915,6 +917,141 @@ void QSqlResult::virtual_hook(int, void *)
 {
 }
 
+/*! \internal
+    \since 6.6
+
+    Fetches up to \a maxRows rows following the current one into \a batch.
+    Drivers fill the batch from their own buffers in virtual_hook() for
+    FetchColumnBatch; for all others, the values are taken from data().
+
+    Returns \c true if at least one row was fetched.
+*/
+bool QSqlResult::fetchBatch(QSqlColumnBatch *batch, int maxRows)
+{
+    QSqlColumnBatchFetch fetch;
+    fetch.batch = batch;
+    fetch.maxRows = maxRows;
+    virtual_hook(FetchColumnBatch, &fetch);
+    if (fetch.handled)
+        return batch->rowCount() > 0;
+
+    QSqlColumnBatchPrivate *b = QSqlColumnBatchPrivate::get(*batch);
+    b->reset(record(), numericalPrecisionPolicy(), maxRows);
+    const int columnCount = int(b->columns.size());
+    while (b->rowCount < maxRows) {
+        if (!(at() == QSql::BeforeFirstRow ? fetchFirst() : fetchNext())) {
+            setAt(QSql::AfterLastRow);
+            break;
+        }
+        b->beginRow();
+        for (int i = 0; i < columnCount; ++i) {
+            if (isNull(i))
+                b->appendNull(i);
+            else
+                b->appendValue(i, data(i));
+        }
+        b->endRow();
+    }
+    return b->rowCount > 0;
+}
+
+/*! \internal
+    \since 6.6
+
+    Inserts the bound values, one list for each field in \a fieldNames, into
+    \a tableName. The query is already prepared as an INSERT statement for
+    these fields. Drivers with a bulk loading mechanism use it in
+    virtual_hook() for BulkInsertColumns; for all others, the prepared
+    statement is executed with execBatch().
+*/
+bool QSqlResult::bulkInsert(const QString &tableName, const QStringList &fieldNames)
+{
+    QSqlBulkInsert insert{tableName, fieldNames};
+    virtual_hook(BulkInsertColumns, &insert);
+    if (insert.handled)
+        return insert.result;
+    return execBatch(false);
+}
+
+#if QT_CONFIG(future)
+QFuture<bool> QSqlResultPrivate::execAsync(const QString *query)
+{
+    Q_Q(QSqlResult);
+    QSqlAsyncExec exec;
+    exec.query = query;
+    QFuture<bool> future = exec.promise.future();
+    q->virtual_hook(QSqlResult::ExecAsync, &exec);
+    if (exec.handled)
+        return future;
+
+    exec.promise.start();
+    if (!sqldriver) {
+        exec.promise.addResult(false);
+        exec.promise.finish();
+        return future;
+    }
+
+#if QT_CONFIG(thread)
+    // A connection must not be used by several threads at once, so the
+    // queries of a driver run one after the other in a single thread.
+    QSqlDriverPrivate *drv = sqldriver->d_func();
+    if (drv->canExecInThread) {
+        if (!drv->asyncExecPool) {
+            drv->asyncExecPool = std::make_unique<QThreadPool>();
+            drv->asyncExecPool->setMaxThreadCount(1);
+        }
+        auto promise = std::make_shared<QPromise<bool>>(std::move(exec.promise));
+        drv->asyncExecPool->start([q, drv, promise, prepared = !query,
+                                   sqlquery = query ? *query : QString()] {
+            drv->execThreadStarted();
+            promise->addResult(prepared ? q->exec() : q->reset(sqlquery));
+            drv->execThreadFinished();
+            promise->finish();
+        });
+        threadedExec = future;
+        return future;
+    }
+#endif
+
+    exec.promise.addResult(query ? q->reset(*query) : q->exec());
+    exec.promise.finish();
+    return future;
+}
+
+/*! \internal
+    \since 6.6
+
+    Starts executing \a sqlquery like reset(), and returns a future that
+    finishes with the result of reset() once the query has been executed.
+    Drivers that can wait for the results without blocking do so in
+    virtual_hook() for ExecAsync. For drivers that allow it, reset() is
+    called in a thread that runs the queries of the driver one at a time;
+    for all others, it is called right away.
+
+    \sa execAsync()
+*/
+QFuture<bool> QSqlResult::resetAsync(const QString &sqlquery)
+{
+    Q_D(QSqlResult);
+    return d->execAsync(&sqlquery);
+}
+
+/*! \internal
+    \since 6.6
+
+    Starts executing the prepared query like exec(), and returns a future
+    that finishes with the result of exec() once the query has been
+    executed.
+
+    \sa resetAsync()
+*/
+QFuture<bool> QSqlResult::execAsync()
+{
+    Q_D(QSqlResult);
+    return d->execAsync(nullptr);
+}
+#endif // QT_CONFIG(future)
+
 /*! \internal
     \since 4.2
 
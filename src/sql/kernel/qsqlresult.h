@@ -7,6 +7,9 @@
 #include <QtSql/qtsqlglobal.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qcontainerfwd.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#endif
 
 // for testing:
 class tst_QSqlQuery;
@@ -20,11 +23,13 @@ class QVariant;
 class QSqlDriver;
 class QSqlError;
 class QSqlResultPrivate;
+class QSqlColumnBatch;
 
 class Q_SQL_EXPORT QSqlResult
 {
     Q_DECLARE_PRIVATE(QSqlResult)
     friend class QSqlQuery;
+    friend class QSqlQueryPrivate;
     friend class QSqlTableModelPrivate;
     // for testing:
     friend class ::tst_QSqlQuery;
@@ -90,7 +95,7 @@ protected:
     virtual QSqlRecord record() const;
     virtual QVariant lastInsertId() const;
 
-    enum VirtualHookOperation { };
+    enum VirtualHookOperation { FetchColumnBatch = 1, BulkInsertColumns = 2, ExecAsync = 3 };
     virtual void virtual_hook(int id, void *data);
     virtual bool execBatch(bool arrayBind = false);
     virtual void detachFromResultSet();
@@ -98,6 +103,12 @@ protected:
     QSql::NumericalPrecisionPolicy numericalPrecisionPolicy() const;
     virtual bool nextResult();
     void resetBindCount(); // HACK
+    bool fetchBatch(QSqlColumnBatch *batch, int maxRows);
+    bool bulkInsert(const QString &tableName, const QStringList &fieldNames);
+#if QT_CONFIG(future)
+    QFuture<bool> resetAsync(const QString &sqlquery);
+    QFuture<bool> execAsync();
+#endif
 
     QSqlResultPrivate *d_ptr;
 
@@ -18,6 +18,9 @@
 #include <QtSql/private/qtsqlglobal_p.h>
 #include <QtCore/qpointer.h>
 #include <QtCore/qhash.h>
+#if QT_CONFIG(future)
+#include <QtCore/qpromise.h>
+#endif
 #include "qsqlerror.h"
 #include "qsqlresult.h"
 #include "qsqldriver.h"
@@ -76,6 +79,9 @@ public:
     QString positionalToNamedBinding(const QString &query) const;
     QString namedToPositionalBinding(const QString &query);
     QString holderAt(int index) const;
+#if QT_CONFIG(future)
+    QFuture<bool> execAsync(const QString *query);
+#endif
 
     QSqlResult *q_ptr = nullptr;
     QPointer<QSqlDriver> sqldriver;
@@ -98,10 +104,37 @@ public:
     bool active = false;
     bool isSel = false;
     bool forwardOnly = false;
+#if QT_CONFIG(future)
+    QFuture<bool> threadedExec; // the last execAsync() run in a thread of the driver
+#endif
 
     static bool isVariantNull(const QVariant &variant);
 };
 
+// The argument of QSqlResult::virtual_hook(QSqlResult::BulkInsertColumns).
+// The bound values are the columns for fieldNames; a driver that inserts
+// them itself sets handled and result.
+struct QSqlBulkInsert
+{
+    const QString &tableName;
+    const QStringList &fieldNames;
+    bool handled = false;
+    bool result = false;
+};
+
+#if QT_CONFIG(future)
+// The argument of QSqlResult::virtual_hook(QSqlResult::ExecAsync). A driver
+// that can wait for the results of query, or of the prepared statement if
+// query is null, without blocking sends it, sets handled and finishes
+// promise once the results have arrived.
+struct QSqlAsyncExec
+{
+    const QString *query = nullptr;
+    QPromise<bool> promise;
+    bool handled = false;
+};
+#endif
+
 QT_END_NAMESPACE
 
 #endif // QSQLRESULT_P_H
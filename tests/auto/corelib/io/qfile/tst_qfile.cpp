@@ -267,6 +267,9 @@ private slots:
 
     void openDirectory();
     void writeNothing();
+#if QT_CONFIG(io_uring)
+    void ioUringWrites();
+#endif
 
     void invalidFile_data();
     void invalidFile();
@@ -3556,6 +3559,58 @@ void tst_QFile::writeNothing()
     }
 }
 
+#if QT_CONFIG(io_uring)
+void tst_QFile::ioUringWrites()
+{
+    // The io_uring instance is created, if at all, on the first unbuffered
+    // write in a thread, so do the writing in a new thread.
+    qputenv("QT_ENABLE_IO_URING", "1");
+    auto restoreEnv = qScopeGuard([] { qunsetenv("QT_ENABLE_IO_URING"); });
+
+    const QString fileName = m_temporaryDir.path() + "/iouring.txt";
+    QByteArray expected;
+    for (int i = 0; i < 1000; ++i)
+        expected += QByteArray::number(i) + '\n';
+
+    QString failure;
+    QScopedPointer<QThread> thr(QThread::create([&] {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate | QIODevice::Unbuffered)) {
+            failure = "open: " + file.errorString();
+            return;
+        }
+        for (qsizetype i = 0; i < expected.size(); i += 4) {
+            const QByteArray chunk = expected.mid(i, 4);
+            if (file.write(chunk) != chunk.size()) {
+                failure = "write: " + file.errorString();
+                return;
+            }
+        }
+        if (file.pos() != expected.size() || file.size() != expected.size()) {
+            failure = u"pos %1, size %2"_s.arg(file.pos()).arg(file.size());
+            return;
+        }
+        if (!file.seek(0) || file.readAll() != expected) {
+            failure = "contents differ after reading back";
+            return;
+        }
+        if (!file.seek(10) || file.write("XYZ") != 3) {
+            failure = "overwriting failed";
+            return;
+        }
+        expected.replace(10, 3, "XYZ");
+        file.close();
+    }));
+    thr->start();
+    QVERIFY(thr->wait());
+    QVERIFY2(failure.isEmpty(), qPrintable(failure));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), expected);
+}
+#endif
+
 void tst_QFile::resize_data()
 {
     QTest::addColumn<int>("filetype");
@@ -2835,6 +2835,188 @@ void tst_QSortFilterProxyModel::sortStable()
     QCOMPARE(lastItemData, filterModel->index(2,0, firstRoot).data());
 }
 
+void tst_QSortFilterProxyModel::parallelSorting_data()
+{
+    QTest::addColumn<Qt::SortOrder>("order");
+    QTest::addColumn<Qt::CaseSensitivity>("caseSensitivity");
+
+    QTest::newRow("ascending") << Qt::AscendingOrder << Qt::CaseSensitive;
+    QTest::newRow("descending") << Qt::DescendingOrder << Qt::CaseSensitive;
+    QTest::newRow("ascending, case-insensitive") << Qt::AscendingOrder << Qt::CaseInsensitive;
+    QTest::newRow("descending, case-insensitive") << Qt::DescendingOrder << Qt::CaseInsensitive;
+}
+
+void tst_QSortFilterProxyModel::parallelSorting()
+{
+    QFETCH(Qt::SortOrder, order);
+    QFETCH(Qt::CaseSensitivity, caseSensitivity);
+
+    // large enough to be sorted on multiple threads, with many equal keys
+    // to check that the sort is stable
+    QStringList strings;
+    for (int i = 0; i < 100000; ++i) {
+        QString s = QLatin1String("Item ") + QString::number((i * 7919) % 1000);
+        strings.append(i % 2 ? s : s.toUpper());
+    }
+    QStringListModel model(strings);
+
+    QSortFilterProxyModel reference;
+    reference.setSortCaseSensitivity(caseSensitivity);
+    reference.setSourceModel(&model);
+    reference.sort(0, order);
+
+    QSortFilterProxyModel proxy;
+    proxy.setSortCaseSensitivity(caseSensitivity);
+    proxy.setParallelSortingEnabled(true);
+    proxy.setSourceModel(&model);
+    proxy.sort(0, order);
+
+    const auto compareWithReference = [&] {
+        QCOMPARE(proxy.rowCount(), reference.rowCount());
+        for (int row = 0; row < proxy.rowCount(); ++row)
+            QCOMPARE(proxy.mapToSource(proxy.index(row, 0)).row(),
+                     reference.mapToSource(reference.index(row, 0)).row());
+    };
+    compareWithReference();
+    if (QTest::currentTestFailed())
+        return;
+
+    // inserted and changed rows are moved into place
+    QVERIFY(model.insertRows(500, 3));
+    model.setData(model.index(500, 0), QLatin1String("Item 500"));
+    model.setData(model.index(501, 0), QLatin1String("a"));
+    model.setData(model.index(502, 0), QLatin1String("ITEM 42"));
+    model.setData(model.index(10, 0), QLatin1String("zzz"));
+    compareWithReference();
+}
+
+void tst_QSortFilterProxyModel::asynchronousFiltering()
+{
+    QStringList strings;
+    for (int i = 0; i < 50000; ++i)
+        strings.append(QString::number(i));
+    QStringListModel model(strings);
+
+    QSortFilterProxyModel reference;
+    reference.setSourceModel(&model);
+    reference.sort(0);
+
+    QSortFilterProxyModel proxy;
+    proxy.setAsynchronousFilteringEnabled(true);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+
+    const auto compareWithReference = [&] {
+        QTRY_COMPARE(proxy.rowCount(), reference.rowCount());
+        for (int row = 0; row < proxy.rowCount(); ++row)
+            QCOMPARE(proxy.index(row, 0).data(), reference.index(row, 0).data());
+    };
+
+    reference.setFilterRegularExpression(QStringLiteral("7$"));
+    proxy.setFilterRegularExpression(QStringLiteral("7$"));
+    compareWithReference();
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(proxy.rowCount(), 5000);
+
+    // a new filter cancels the pass in progress
+    proxy.setFilterRegularExpression(QStringLiteral("^1"));
+    proxy.setFilterRegularExpression(QStringLiteral("3"));
+    reference.setFilterRegularExpression(QStringLiteral("3"));
+    compareWithReference();
+    if (QTest::currentTestFailed())
+        return;
+
+    // changes to the source model while a pass is in progress
+    reference.setFilterFixedString(QStringLiteral("99"));
+    proxy.setFilterFixedString(QStringLiteral("99"));
+    QVERIFY(model.insertRows(100, 2));
+    model.setData(model.index(100, 0), QStringLiteral("x99"));
+    model.setData(model.index(101, 0), QStringLiteral("x98"));
+    model.setData(model.index(20000, 0), QStringLiteral("y99"));
+    QVERIFY(model.removeRows(30000, 5));
+    QVERIFY(model.insertRows(model.rowCount(), 1));
+    model.setData(model.index(model.rowCount() - 1, 0), QStringLiteral("z99"));
+    compareWithReference();
+    if (QTest::currentTestFailed())
+        return;
+
+    // disabling the mode completes a pass synchronously
+    reference.setFilterRegularExpression(QStringLiteral("5"));
+    proxy.setFilterRegularExpression(QStringLiteral("5"));
+    proxy.setAsynchronousFilteringEnabled(false);
+    QCOMPARE(proxy.rowCount(), reference.rowCount());
+}
+
+void tst_QSortFilterProxyModel::asynchronousFilteringDeleteSourceModel()
+{
+    QStringList strings;
+    for (int i = 0; i < 200000; ++i)
+        strings.append(QString::number(i));
+
+    // Passes canceled by a new filter may still be running when the source
+    // model goes away, while the proxy model is destroyed or is given a new
+    // source model.
+    for (int round = 0; round < 3; ++round) {
+        auto *model = new QStringListModel(strings);
+        auto *proxy = new QSortFilterProxyModel;
+        proxy->setAsynchronousFilteringEnabled(true);
+        proxy->setSourceModel(model);
+        for (const char *pattern : { "1", "2$", "^3", "4.*4", "5" })
+            proxy->setFilterRegularExpression(QLatin1String(pattern));
+
+        switch (round) {
+        case 0:
+            delete model;
+            QCOMPARE(proxy->rowCount(), 0);
+            QTest::qWait(50);
+            QCOMPARE(proxy->rowCount(), 0);
+            delete proxy;
+            break;
+        case 1:
+            delete proxy;
+            delete model;
+            break;
+        case 2: {
+            QStringListModel other(QStringList { QStringLiteral("5"), QStringLiteral("6") });
+            proxy->setSourceModel(&other);
+            delete model;
+            QTRY_COMPARE(proxy->rowCount(), 1);
+            delete proxy;
+            break;
+        }
+        }
+    }
+}
+
+void tst_QSortFilterProxyModel::asynchronousFilteringReimplemented()
+{
+    class OddRowsProxyModel : public QSortFilterProxyModel
+    {
+    public:
+        bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override
+        {
+            return sourceRow % 2 && QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
+        }
+    };
+
+    QStringList strings;
+    for (int i = 0; i < 10000; ++i)
+        strings.append(QString::number(i));
+    QStringListModel model(strings);
+
+    // the worker threads can't call a reimplemented filterAcceptsRow(), so
+    // the proxy model filters synchronously
+    OddRowsProxyModel proxy;
+    proxy.setAsynchronousFilteringEnabled(true);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), 5000);
+    proxy.setFilterRegularExpression(QStringLiteral("7$"));
+    QCOMPARE(proxy.rowCount(), 1000);
+    proxy.setFilterFixedString(QStringLiteral("99"));
+    QCOMPARE(proxy.rowCount(), 185);
+}
+
 void tst_QSortFilterProxyModel::hiddenColumns()
 {
     class MyStandardItemModel : public QStandardItemModel
@@ -5361,6 +5543,22 @@ void tst_QSortFilterProxyModel::autoAcceptChildRowsBinding()
                                                                            "autoAcceptChildRows");
 }
 
+void tst_QSortFilterProxyModel::parallelSortingEnabledBinding()
+{
+    QSortFilterProxyModel proxyModel;
+    QCOMPARE(proxyModel.isParallelSortingEnabled(), false);
+    QTestPrivate::testReadWritePropertyBasics<QSortFilterProxyModel, bool>(proxyModel, true, false,
+                                                                           "parallelSortingEnabled");
+}
+
+void tst_QSortFilterProxyModel::asynchronousFilteringEnabledBinding()
+{
+    QSortFilterProxyModel proxyModel;
+    QCOMPARE(proxyModel.isAsynchronousFilteringEnabled(), false);
+    QTestPrivate::testReadWritePropertyBasics<QSortFilterProxyModel, bool>(
+            proxyModel, true, false, "asynchronousFilteringEnabled");
+}
+
 void tst_QSortFilterProxyModel::filterCaseSensitivityBinding()
 {
     QSortFilterProxyModel proxyModel;
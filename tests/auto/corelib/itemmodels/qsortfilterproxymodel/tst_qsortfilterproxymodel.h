@@ -89,6 +89,11 @@ private slots:
     void sortColumnTracking2();
 
     void sortStable();
+    void parallelSorting_data();
+    void parallelSorting();
+    void asynchronousFiltering();
+    void asynchronousFilteringDeleteSourceModel();
+    void asynchronousFilteringReimplemented();
 
     void hiddenColumns();
     void insertRowsSort();
@@ -150,6 +155,8 @@ private slots:
     void filterRoleBinding();
     void recursiveFilteringEnabledBinding();
     void autoAcceptChildRowsBinding();
+    void parallelSortingEnabledBinding();
+    void asynchronousFilteringEnabledBinding();
     void filterCaseSensitivityBinding();
     void filterRegularExpressionBinding();
 
@@ -314,6 +314,51 @@ void tst_QCoreApplication::postEvent()
     QCOMPARE(spy.recordedEvents, expected);
 }
 
+// queued meta calls bypass the mutex of the posted event list; make sure they
+// are still delivered in order with respect to the other posted events
+void tst_QCoreApplication::postEventWithMetaCalls()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    QObject receiver;
+    QList<int> recorded;
+    EventSpy spy;
+    receiver.installEventFilter(&spy);
+
+    auto record = [&recorded](int value) {
+        return [&recorded, value] { recorded << value; };
+    };
+
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::Type(QEvent::User + 1)));
+    QMetaObject::invokeMethod(&receiver, record(1), Qt::QueuedConnection);
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::Type(QEvent::User + 2)));
+    QMetaObject::invokeMethod(&receiver, record(2), Qt::QueuedConnection);
+    QCoreApplication::postEvent(&receiver, new QEvent(QEvent::Type(QEvent::User + 3)), 1);
+    QMetaObject::invokeMethod(&receiver, record(3), Qt::QueuedConnection);
+
+    QCoreApplication::sendPostedEvents();
+
+    const QList<int> expected = {
+        QEvent::User + 3,
+        QEvent::User + 1,
+        QEvent::MetaCall,
+        QEvent::User + 2,
+        QEvent::MetaCall,
+        QEvent::MetaCall,
+    };
+    QCOMPARE(spy.recordedEvents, expected);
+    QCOMPARE(recorded, QList<int>({ 1, 2, 3 }));
+
+    // removing the posted events also covers the ones not merged yet
+    recorded.clear();
+    QMetaObject::invokeMethod(&receiver, record(4), Qt::QueuedConnection);
+    QCoreApplication::removePostedEvents(&receiver);
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(recorded.isEmpty());
+}
+
 void tst_QCoreApplication::removePostedEvents()
 {
     int argc = 1;
@@ -507,6 +552,41 @@ void tst_QCoreApplication::deliverInDefinedOrder()
     QObject::connect(&obj, SIGNAL(done()), &app, SLOT(quit()));
     app.exec();
 }
+
+void tst_QCoreApplication::postMetaCallsFromManyThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    constexpr int ThreadCount = 16;
+    constexpr int CallCount = 2000;
+
+    QObject receiver;
+    std::array<int, ThreadCount> received = {};
+    bool inOrder = true;
+
+    QList<QThread *> threads;
+    for (int i = 0; i < ThreadCount; ++i) {
+        threads << QThread::create([&, i] {
+            for (int j = 0; j < CallCount; ++j) {
+                QMetaObject::invokeMethod(&receiver, [&, i, j] {
+                    inOrder = inOrder && received[i] == j;
+                    ++received[i];
+                }, Qt::QueuedConnection);
+            }
+        });
+        threads.last()->start();
+    }
+    for (QThread *thread : std::as_const(threads))
+        QVERIFY(thread->wait());
+    qDeleteAll(threads);
+
+    QCoreApplication::sendPostedEvents();
+    QVERIFY(inOrder);
+    for (int count : received)
+        QCOMPARE(count, CallCount);
+}
 #endif // QT_CONFIG(thread)
 
 void tst_QCoreApplication::applicationPid()
@@ -17,9 +17,11 @@ private slots:
     void qAppVersion();
     void argc();
     void postEvent();
+    void postEventWithMetaCalls();
     void removePostedEvents();
 #if QT_CONFIG(thread)
     void deliverInDefinedOrder();
+    void postMetaCallsFromManyThreads();
 #endif
     void applicationPid();
 #ifdef QT_BUILD_INTERNAL
@@ -17,6 +17,11 @@
 #include <private/qnet_unix_p.h>
 #include <sys/select.h>
 #endif
+#if QT_CONFIG(epoll)
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QThread>
+#include <private/qeventdispatcher_epoll_p.h>
+#endif
 #include <limits>
 
 #if defined (Q_CC_MSVC) && defined(max)
@@ -39,6 +44,10 @@ private slots:
     void activationReason_data();
     void activationReason();
     void legacyConnect();
+#if QT_CONFIG(epoll)
+    void epollDispatcher_data();
+    void epollDispatcher();
+#endif
 
 protected slots:
     void async_readDatagramSlot();
@@ -448,6 +457,83 @@ void tst_QSocketNotifier::legacyConnect()
     QVERIFY(receivedInt);
 }
 
+#if QT_CONFIG(epoll)
+void tst_QSocketNotifier::epollDispatcher_data()
+{
+    QTest::addColumn<QEventDispatcherEpoll::TriggerMode>("mode");
+    QTest::addRow("level") << QEventDispatcherEpoll::LevelTriggered;
+    QTest::addRow("edge") << QEventDispatcherEpoll::EdgeTriggered;
+}
+
+void tst_QSocketNotifier::epollDispatcher()
+{
+    QFETCH(QEventDispatcherEpoll::TriggerMode, mode);
+
+    int pipefds[2];
+    QCOMPARE(qt_safe_pipe(pipefds, O_NONBLOCK), 0);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+
+    QThread thread;
+    thread.setEventDispatcher(new QEventDispatcherEpoll(mode));
+    thread.start();
+    QObject context;
+    context.moveToThread(&thread);
+
+    QAtomicInt pipeActivations;
+    QAtomicInt fileActivations;
+    QSocketNotifier *pipeNotifier = nullptr;
+    QSocketNotifier *fileNotifier = nullptr;
+    auto runInThread = [&context](auto &&f) {
+        QMetaObject::invokeMethod(&context, f, Qt::BlockingQueuedConnection);
+    };
+
+    runInThread([&] {
+        pipeNotifier = new QSocketNotifier(pipefds[0], QSocketNotifier::Read);
+        connect(pipeNotifier, &QSocketNotifier::activated, pipeNotifier, [&] {
+            char c;
+            while (qt_safe_read(pipefds[0], &c, 1) == 1)
+                ;
+            pipeActivations.ref();
+        });
+    });
+
+    QCOMPARE(qt_safe_write(pipefds[1], "a", 1), 1);
+    QTRY_COMPARE(pipeActivations.loadRelaxed(), 1);
+    QCOMPARE(qt_safe_write(pipefds[1], "b", 1), 1);
+    QTRY_COMPARE(pipeActivations.loadRelaxed(), 2);
+
+    // a disabled notifier must be removed from the interest set...
+    runInThread([&] { pipeNotifier->setEnabled(false); });
+    QCOMPARE(qt_safe_write(pipefds[1], "c", 1), 1);
+    QTest::qWait(50);
+    QCOMPARE(pipeActivations.loadRelaxed(), 2);
+
+    // ...and re-enabling it reports data that arrived in the meantime
+    runInThread([&] { pipeNotifier->setEnabled(true); });
+    QTRY_COMPARE(pipeActivations.loadRelaxed(), 3);
+
+    // regular files can't be watched by epoll but are always readable
+    runInThread([&] {
+        fileNotifier = new QSocketNotifier(file.handle(), QSocketNotifier::Read);
+        connect(fileNotifier, &QSocketNotifier::activated, fileNotifier, [&] {
+            fileActivations.ref();
+            fileNotifier->setEnabled(false);
+        });
+    });
+    QTRY_COMPARE(fileActivations.loadRelaxed(), 1);
+
+    runInThread([&] {
+        delete pipeNotifier;
+        delete fileNotifier;
+    });
+    thread.quit();
+    QVERIFY(thread.wait());
+
+    qt_safe_close(pipefds[0]);
+    qt_safe_close(pipefds[1]);
+}
+#endif
 
 QTEST_MAIN(tst_QSocketNotifier)
 #include <tst_qsocketnotifier.moc>
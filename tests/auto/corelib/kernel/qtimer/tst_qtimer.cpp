@@ -62,6 +62,9 @@ private slots:
     void timerOrder_data();
     void timerOrderBackgroundThread();
     void timerOrderBackgroundThread_data() { timerOrder_data(); }
+    void timeoutOrderAcrossIntervals();
+    void waitForNearestTimerAcrossSlots();
+    void nestedLoopInTimerEvent();
 
     void dontBlockEvents();
     void postedEventsShouldNotStarveTimers();
@@ -1242,6 +1245,63 @@ void tst_QTimer::timerOrderBackgroundThread()
 #endif
 }
 
+void tst_QTimer::timeoutOrderAcrossIntervals()
+{
+    // the intervals straddle the granularity boundaries of the timer wheel,
+    // so timers have to be cascaded from the coarser levels before firing
+    const QList<int> intervals = { 140, 10, 64, 0, 70, 300, 58, 1, 128, 4100, 120 };
+    QList<int> fired;
+    for (int interval : intervals) {
+        QTimer::singleShot(interval, Qt::PreciseTimer, this, [&fired, interval] {
+            fired << interval;
+        });
+    }
+
+    QList<int> expected = intervals;
+    std::sort(expected.begin(), expected.end());
+    QTRY_COMPARE_WITH_TIMEOUT(fired.size(), expected.size(), 10000);
+    QCOMPARE(fired, expected);
+}
+
+void tst_QTimer::waitForNearestTimerAcrossSlots()
+{
+    // Both timers are on the same level of the timer wheel, and the farther
+    // one is a full rotation ahead, in the level's current slot; the event
+    // loop must not sleep until that one is due.
+    QEventLoop loop;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    QTimer::singleShot(4095, Qt::PreciseTimer, &loop, [] {});
+    QTimer::singleShot(200, Qt::PreciseTimer, &loop, &QEventLoop::quit);
+    QTimer::singleShot(10000, Qt::PreciseTimer, &loop, &QEventLoop::quit);
+    loop.exec();
+    QCOMPARE_LT(elapsed.elapsed(), 2000);
+}
+
+void tst_QTimer::nestedLoopInTimerEvent()
+{
+    // Both timers expire at the same time; the first one to fire waits for
+    // the other in a nested event loop, which must still activate it.
+    int fired = 0;
+    QEventLoop nestedLoop;
+    QElapsedTimer elapsed;
+    auto onTimeout = [&] {
+        if (++fired == 1) {
+            QTimer::singleShot(3000, &nestedLoop, &QEventLoop::quit);
+            elapsed.start();
+            nestedLoop.exec();
+            QCOMPARE(fired, 2);
+            QCOMPARE_LT(elapsed.elapsed(), 2000);
+        } else {
+            nestedLoop.quit();
+        }
+    };
+    QTimer::singleShot(20, Qt::PreciseTimer, this, onTimeout);
+    QTimer::singleShot(20, Qt::PreciseTimer, this, onTimeout);
+
+    QTRY_COMPARE(fired, 2);
+}
+
 struct StaticSingleShotUser
 {
     StaticSingleShotUser()
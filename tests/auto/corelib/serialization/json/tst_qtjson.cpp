@@ -88,6 +88,7 @@ private Q_SLOTS:
     void fromJsonErrors();
     void parseNumbers();
     void parseStrings();
+    void parseLongRuns();
     void parseDuplicateKeys();
     void testParser();
 
@@ -2348,6 +2349,51 @@ void tst_QtJson::parseNumbers()
     }
 }
 
+// The parser skips whitespace and plain string characters in blocks; place
+// the interesting bytes at every offset of such a block and past its end.
+void tst_QtJson::parseLongRuns()
+{
+    for (int length = 0; length < 80; ++length) {
+        const QByteArray spaces = QByteArray(" \t\r\n").repeated(length).left(length);
+        QByteArray json = spaces + '[' + spaces + "true" + spaces + ',' + spaces + "1" + spaces
+                + ']' + spaces;
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(doc.array(), QJsonArray({ true, 1 }));
+
+        json = "[" + spaces + "\x01" + spaces + "]";
+        doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::IllegalNumber);
+
+        const QByteArray plain = QByteArray("abcdefghijklmnopqrstuvwxyz0123456789").repeated(3).left(length);
+        for (int pos = 0; pos <= length; ++pos) {
+            const QByteArray head = plain.left(pos);
+            const QByteArray tail = plain.mid(pos);
+
+            json = "[\"" + head + "\\\"" + tail + "\"]";
+            doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(), QString::fromLatin1(head + '"' + tail));
+
+            json = "[\"" + head + "\xc3\xa9" + tail + "\"]";
+            doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().at(0).toString(),
+                     QString::fromLatin1(head) + QChar(0xe9) + QString::fromLatin1(tail));
+
+            json = "[\"" + head + "\xff" + tail + "\"]";
+            doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+            QCOMPARE(error.offset, 2 + pos);
+        }
+
+        json = "[\"" + plain;
+        doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+    }
+}
+
 void tst_QtJson::parseStrings()
 {
     const char *strings [] =
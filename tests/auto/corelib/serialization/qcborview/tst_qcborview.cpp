@@ -0,0 +1,423 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QCborView>
+#include <QTemporaryFile>
+
+using namespace Qt::StringLiterals;
+
+class tst_QCborView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars();
+    void floatingPoint();
+    void tags();
+    void strings();
+    void chunkedStrings();
+    void arrays();
+    void maps();
+    void indefiniteContainers();
+    void iteration();
+    void compareWithValue_data();
+    void compareWithValue();
+    void mappedFile();
+    void malformed();
+};
+
+static bool pointsInto(const void *ptr, const QByteArray &data)
+{
+    auto p = static_cast<const char *>(ptr);
+    return p >= data.constBegin() && p < data.constEnd();
+}
+
+void tst_QCborView::scalars()
+{
+    const QByteArray data = QCborArray{ 0, 23, 24, -1, -1000000, std::numeric_limits<qint64>::max(),
+                                        std::numeric_limits<qint64>::min(), true, false, nullptr,
+                                        QCborValue(), QCborSimpleType(32) }.toCborValue().toCbor();
+    QCborParserError error;
+    const QCborView view = QCborView::fromCbor(data, &error);
+    QCOMPARE(error.error, QCborError::NoError);
+    QVERIFY(view.isArray());
+    QCOMPARE(view.size(), 12);
+
+    QVERIFY(view[0].isUnsignedInteger());
+    QCOMPARE(view[0].toInteger(), 0);
+    QCOMPARE(view[1].toInteger(), 23);
+    QCOMPARE(view[2].toInteger(), 24);
+    QVERIFY(view[3].isNegativeInteger());
+    QCOMPARE(view[3].toInteger(), -1);
+    QCOMPARE(view[4].toInteger(), -1000000);
+    QCOMPARE(view[5].toInteger(), std::numeric_limits<qint64>::max());
+    QCOMPARE(view[6].toInteger(), std::numeric_limits<qint64>::min());
+    QCOMPARE(view[4].toDouble(), -1000000.);
+    QVERIFY(view[7].isTrue());
+    QVERIFY(view[7].toBool());
+    QVERIFY(view[8].isFalse());
+    QVERIFY(!view[8].toBool(true));
+    QVERIFY(view[9].isNull());
+    QVERIFY(view[10].isUndefined());
+    QCOMPARE(view[11].toSimpleType(), QCborSimpleType(32));
+
+    // wrong types give the default values
+    QCOMPARE(view[7].toInteger(-5), -5);
+    QCOMPARE(view[0].toBool(true), true);
+    QCOMPARE(view[9].toString(u"x"_s), u"x"_s);
+    QCOMPARE(view.toInteger(42), 42);
+    QVERIFY(view[9].at(0).isInvalid());
+    QCOMPARE(view[0].size(), -1);
+
+    // out of range
+    QVERIFY(view[12].isUndefined());
+    QVERIFY(view.at(-1).isUndefined());
+}
+
+void tst_QCborView::floatingPoint()
+{
+    QByteArray data;
+    {
+        QCborStreamWriter writer(&data);
+        writer.startArray();
+        writer.append(qfloat16(1.5));
+        writer.append(2.25f);
+        writer.append(-0.1);
+        writer.append(qInf());
+        writer.endArray();
+    }
+
+    const QCborView view = QCborView::fromCbor(data);
+    QVERIFY(view[0].isFloat16());
+    QCOMPARE(view[0].toDouble(), 1.5);
+    QVERIFY(view[1].isFloat());
+    QCOMPARE(view[1].toDouble(), 2.25);
+    QVERIFY(view[2].isDouble());
+    QCOMPARE(view[2].toDouble(), -0.1);
+    QVERIFY(qIsInf(view[3].toDouble()));
+    QCOMPARE(view[3].toInteger(7), 7);
+}
+
+void tst_QCborView::tags()
+{
+    const QByteArray data = QCborValue(QCborKnownTags::Signature,
+                                       QCborValue(QCborTag(1000), "tagged"_L1)).toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+    QVERIFY(view.isTag());
+    QCOMPARE(view.tag(), QCborTag(QCborKnownTags::Signature));
+    const QCborView inner = view.taggedValue();
+    QVERIFY(inner.isTag());
+    QCOMPARE(inner.tag(), QCborTag(1000));
+    QCOMPARE(inner.taggedValue().toString(), "tagged"_L1);
+    QVERIFY(inner.taggedValue().taggedValue().isInvalid());
+    QCOMPARE(view.rawData().size(), data.size());
+}
+
+void tst_QCborView::strings()
+{
+    const QString text = u"héllo \U0001F600"_s;
+    const QByteArray bytes("\0\1\2binary", 9);
+    const QByteArray data = QCborArray{ text, bytes, ""_L1, QByteArray() }.toCborValue().toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+
+    const QCborView str = view[0];
+    QVERIFY(str.isString());
+    QVERIFY(str.isLengthKnown());
+    const QUtf8StringView sv = str.toStringView();
+    QCOMPARE(sv.size(), text.toUtf8().size());
+    QVERIFY(pointsInto(sv.data(), data));
+    QCOMPARE(sv.toString(), text);
+    QCOMPARE(str.toString(), text);
+    QVERIFY(str.toByteArrayView().isNull());
+
+    const QCborView ba = view[1];
+    QVERIFY(ba.isByteArray());
+    QVERIFY(pointsInto(ba.toByteArrayView().data(), data));
+    QCOMPARE(ba.toByteArrayView().toByteArray(), bytes);
+    QCOMPARE(ba.toByteArray(), bytes);
+    QVERIFY(ba.toStringView().isNull());
+
+    QVERIFY(view[2].isString());
+    QVERIFY(view[2].toStringView().isEmpty());
+    QVERIFY(!view[2].toString().isNull());
+    QVERIFY(view[3].isByteArray());
+    QVERIFY(view[3].toByteArrayView().isEmpty());
+}
+
+void tst_QCborView::chunkedStrings()
+{
+    // ["ab" "c", h'01' h'0203']
+    const QByteArray data = "\x82\x7f\x62" "ab" "\x61" "c" "\xff\x5f\x41\x01\x42\x02\x03\xff"_ba;
+    const QCborView view = QCborView::fromCbor(data);
+    QCOMPARE(view.size(), 2);
+
+    QVERIFY(view[0].isString());
+    QVERIFY(!view[0].isLengthKnown());
+    QVERIFY(view[0].toStringView().isNull());
+    QCOMPARE(view[0].toString(), "abc"_L1);
+
+    QVERIFY(view[1].isByteArray());
+    QVERIFY(view[1].toByteArrayView().isNull());
+    QCOMPARE(view[1].toByteArray(), "\x01\x02\x03"_ba);
+
+    QCOMPARE(view.toCborValue(), QCborValue(QCborArray{ "abc"_L1, "\x01\x02\x03"_ba }));
+}
+
+void tst_QCborView::arrays()
+{
+    const QCborArray array{ 1, QCborArray{ 2, QCborArray{ 3 } }, "four"_L1, QCborMap{ { 5, 6 } } };
+    const QByteArray data = array.toCborValue().toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+
+    QVERIFY(view.isArray());
+    QVERIFY(view.isLengthKnown());
+    QCOMPARE(view.size(), 4);
+    QCOMPARE(view.at(0).toInteger(), 1);
+    QCOMPARE(view[1][0].toInteger(), 2);
+    QCOMPARE(view[1][1][0].toInteger(), 3);
+    QVERIFY(view[1][1][1].isUndefined());
+    QCOMPARE(view[2].toString(), "four"_L1);
+    QCOMPARE(view[3][5].toInteger(), 6);
+    QCOMPARE(view.toCborValue(), QCborValue(array));
+    QCOMPARE(view[1].toCborValue(), array.at(1));
+    QCOMPARE(view.rawData().toByteArray(), data);
+
+    // an empty array
+    const QByteArray empty = QCborArray().toCborValue().toCbor();
+    const QCborView emptyView = QCborView::fromCbor(empty);
+    QCOMPARE(emptyView.size(), 0);
+    QVERIFY(emptyView.begin() == emptyView.end());
+    QVERIFY(emptyView[0].isUndefined());
+}
+
+void tst_QCborView::maps()
+{
+    const QCborMap map{
+        { "name"_L1, "value"_L1 },
+        { u"été"_s, 1 },
+        { 42, "answer"_L1 },
+        { -7, QCborMap{ { "nested"_L1, QCborArray{ true } } } },
+    };
+    const QByteArray data = map.toCborValue().toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+
+    QVERIFY(view.isMap());
+    QCOMPARE(view.size(), 4);
+    QCOMPARE(view["name"_L1].toString(), "value"_L1);
+    QCOMPARE(view[u"name"].toString(), "value"_L1);
+    QCOMPARE(view.value(QUtf8StringView("name")).toString(), "value"_L1);
+    QCOMPARE(view[u"été"].toInteger(), 1);
+    QCOMPARE(view.value(QUtf8StringView("\xc3\xa9t\xc3\xa9")).toInteger(), 1);
+    QCOMPARE(view[42].toString(), "answer"_L1);
+    QCOMPARE(view[-7]["nested"_L1][0].toBool(), true);
+
+    QVERIFY(view["missing"_L1].isUndefined());
+    QVERIFY(view[43].isUndefined());
+    QVERIFY(view["answer"_L1].isUndefined());
+    QVERIFY(view[42]["x"_L1].isInvalid());
+
+    QCOMPARE(view.toCborValue(), QCborValue(map));
+}
+
+void tst_QCborView::indefiniteContainers()
+{
+    QByteArray data;
+    {
+        QCborStreamWriter writer(&data);
+        writer.startMap();
+        writer.append("list"_L1);
+        writer.startArray();
+        for (int i = 0; i < 10; ++i)
+            writer.append(i * i);
+        writer.endArray();
+        writer.append("empty"_L1);
+        writer.startArray();
+        writer.endArray();
+        writer.append("after"_L1);
+        writer.append(true);
+        writer.endMap();
+    }
+
+    const QCborView view = QCborView::fromCbor(data);
+    QVERIFY(view.isMap());
+    QVERIFY(!view.isLengthKnown());
+    QCOMPARE(view.size(), 3);
+
+    const QCborView list = view["list"_L1];
+    QVERIFY(!list.isLengthKnown());
+    QCOMPARE(list.size(), 10);
+    QCOMPARE(list[9].toInteger(), 81);
+    QVERIFY(list[10].isUndefined());
+
+    QCOMPARE(view["empty"_L1].size(), 0);
+    QVERIFY(view["empty"_L1].begin() == view["empty"_L1].end());
+    QVERIFY(view["after"_L1].isTrue());
+    QCOMPARE(view.rawData().size(), data.size());
+}
+
+void tst_QCborView::iteration()
+{
+    const QCborMap map{ { "a"_L1, 1 }, { "b"_L1, QCborArray{ 2, 3 } }, { "c"_L1, 4 } };
+    const QByteArray data = map.toCborValue().toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+
+    QStringList keys;
+    qint64 sum = 0;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        keys << it.key().toString();
+        if (it.value().isArray()) {
+            for (QCborView element : it.value())
+                sum += element.toInteger();
+        } else {
+            sum += (*it).toInteger();
+        }
+    }
+    QCOMPARE(keys, QStringList({ "a", "b", "c" }));
+    QCOMPARE(sum, 10);
+
+    auto it = view.begin();
+    auto copy = it++;
+    QCOMPARE(copy.key().toString(), "a"_L1);
+    QCOMPARE(it.key().toString(), "b"_L1);
+    QVERIFY(copy != it);
+    QVERIFY(QCborView().begin() == QCborView().end());
+    QVERIFY(view["a"_L1].begin() == view.end());
+}
+
+static QCborValue toValue(const QCborView &view)
+{
+    switch (view.type()) {
+    case QCborStreamReader::UnsignedInteger:
+    case QCborStreamReader::NegativeInteger:
+        return view.toInteger();
+    case QCborStreamReader::ByteArray:
+        return view.toByteArray();
+    case QCborStreamReader::String:
+        return view.toString();
+    case QCborStreamReader::Array: {
+        QCborArray array;
+        for (QCborView element : view)
+            array.append(toValue(element));
+        return array;
+    }
+    case QCborStreamReader::Map: {
+        QCborMap map;
+        for (auto it = view.begin(); it != view.end(); ++it)
+            map.insert(toValue(it.key()), toValue(it.value()));
+        return map;
+    }
+    case QCborStreamReader::Tag:
+        return QCborValue(view.tag(), toValue(view.taggedValue()));
+    case QCborStreamReader::SimpleType:
+        return view.toSimpleType();
+    case QCborStreamReader::Float16:
+    case QCborStreamReader::Float:
+    case QCborStreamReader::Double:
+        return view.toDouble();
+    case QCborStreamReader::Invalid:
+        break;
+    }
+    return QCborValue(QCborValue::Invalid);
+}
+
+void tst_QCborView::compareWithValue_data()
+{
+    QTest::addColumn<QCborValue>("value");
+
+    QTest::newRow("integer") << QCborValue(1234567);
+    QTest::newRow("string") << QCborValue("text"_L1);
+    QTest::newRow("nested") << QCborValue(QCborMap{
+            { "array"_L1, QCborArray{ 1, 2.5, "x"_L1, QByteArray("y"), nullptr, QCborValue() } },
+            { 1, QCborMap{ { "deep"_L1, QCborArray{ QCborArray{ QCborArray{ false } } } } } },
+            { "tagged"_L1, QCborValue(QCborTag(99), -1) } });
+
+    QCborArray large;
+    for (int i = 0; i < 1000; ++i)
+        large.append(QCborMap{ { "id"_L1, i }, { "name"_L1, QString::number(i) } });
+    QTest::newRow("large") << QCborValue(large);
+}
+
+void tst_QCborView::compareWithValue()
+{
+    QFETCH(QCborValue, value);
+
+    const QByteArray data = value.toCbor();
+    const QCborView view = QCborView::fromCbor(data);
+    QCOMPARE(toValue(view), value);
+    QCOMPARE(view.toCborValue(), value);
+    QCOMPARE(view.rawData().size(), data.size());
+}
+
+void tst_QCborView::mappedFile()
+{
+    QCborArray records;
+    for (int i = 0; i < 100; ++i)
+        records.append(QCborMap{ { "id"_L1, i }, { "name"_L1, u"record "_s + QString::number(i) } });
+    const QCborMap root{ { "version"_L1, 2 }, { "records"_L1, records } };
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(root.toCborValue().toCbor());
+    QVERIFY(file.flush());
+
+    uchar *map = file.map(0, file.size());
+    QVERIFY(map);
+    const QCborView view = QCborView::fromCbor(QByteArrayView(map, file.size()));
+    QCOMPARE(view["version"_L1].toInteger(), 2);
+
+    const QUtf8StringView name = view["records"_L1][57]["name"_L1].toStringView();
+    QCOMPARE(name.toString(), u"record 57"_s);
+    QVERIFY(name.data() >= reinterpret_cast<const char *>(map));
+    QVERIFY(name.data() < reinterpret_cast<const char *>(map) + file.size());
+
+    QVERIFY(file.unmap(map));
+}
+
+void tst_QCborView::malformed()
+{
+    QCborParserError error;
+    QVERIFY(QCborView::fromCbor(QByteArrayView(), &error).isInvalid());
+    QCOMPARE(error.error, QCborError::EndOfFile);
+
+    // break byte outside of an indefinite-length container
+    QVERIFY(QCborView::fromCbor("\xff"_ba, &error).isInvalid());
+    QVERIFY(error.error != QCborError::NoError);
+    QCOMPARE(error.offset, 0);
+
+    // the offset is that of the element following the tags
+    QVERIFY(QCborView::fromCbor("\xc1\xc2\xff"_ba, &error).isInvalid());
+    QVERIFY(error.error != QCborError::NoError);
+    QCOMPARE(error.offset, 2);
+    QVERIFY(QCborView::fromCbor("\xc1\x19\x01"_ba, &error).isInvalid());
+    QCOMPARE(error.error, QCborError::EndOfFile);
+    QCOMPARE(error.offset, 1);
+
+    // truncated: the array claims three elements and the string is cut short
+    const QByteArray truncated = "\x83\x01\x65" "ab"_ba;
+    const QCborView view = QCborView::fromCbor(truncated, &error);
+    QCOMPARE(error.error, QCborError::NoError);
+    QVERIFY(view.isArray());
+    QCOMPARE(view[0].toInteger(), 1);
+    QVERIFY(view[1].isString());
+    QVERIFY(view[1].toStringView().isNull());
+    QCOMPARE(view[1].toString(u"default"_s), u"default"_s);
+    QVERIFY(view[2].isUndefined());
+    QCOMPARE(view.size(), 3);
+    QVERIFY(view.rawData().isNull());
+    QVERIFY(view.toCborValue().isInvalid());
+
+    // a map with a key but no value
+    const QByteArray oddMap = "\xbf\x61" "k" "\xff"_ba;
+    const QCborView mapView = QCborView::fromCbor(oddMap);
+    QVERIFY(mapView.begin() == mapView.end());
+    QVERIFY(mapView["k"_L1].isUndefined());
+}
+
+QTEST_GUILESS_MAIN(tst_QCborView)
+
+#include "tst_qcborview.moc"
@@ -0,0 +1,508 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+
+#include <functional>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars_data();
+    void scalars();
+    void documents_data();
+    void documents();
+    void documentsIncremental_data() { documents_data(); }
+    void documentsIncremental();
+    void documentsFromDevice_data() { documents_data(); }
+    void documentsFromDevice();
+    void stringChunks();
+    void objectKeys();
+    void skipping();
+    void leaveContainer();
+    void ndjson();
+    void prematureEnd();
+    void clearWhileSkipping_data();
+    void clearWhileSkipping();
+    void errors_data();
+    void errors();
+};
+
+enum Mode { Whole, ByteByByte, Device };
+
+// Calls feed() and reparse() for as long as the reader is waiting for data
+static bool recover(QJsonStreamReader &reader, const std::function<bool()> &feed)
+{
+    while (reader.lastError().error == QJsonParseError::PrematureEndOfDocument) {
+        if (!feed())
+            return false;
+        reader.reparse();
+    }
+    return reader.lastError().error == QJsonParseError::NoError;
+}
+
+static QString readString(QJsonStreamReader &reader, const std::function<bool()> &feed)
+{
+    QString result;
+    for (;;) {
+        auto r = reader.readString();
+        if (r.status == QJsonStreamReader::Ok) {
+            // chunks never split a surrogate pair
+            if (r.data.back().isHighSurrogate())
+                return QString();
+            result += r.data;
+        } else if (r.status == QJsonStreamReader::EndOfString) {
+            break;
+        } else if (reader.lastError().error != QJsonParseError::PrematureEndOfDocument
+                   || !feed()) {
+            return QString();
+        }
+    }
+    recover(reader, feed);
+    return result.isNull() ? ""_L1 : result;
+}
+
+static QJsonValue readValue(QJsonStreamReader &reader, const std::function<bool()> &feed)
+{
+    if (!recover(reader, feed))
+        return QJsonValue::Undefined;
+
+    QJsonValue result;
+    switch (reader.type()) {
+    case QJsonStreamReader::Null:
+        result = QJsonValue::Null;
+        break;
+    case QJsonStreamReader::Bool:
+        result = reader.toBool();
+        break;
+    case QJsonStreamReader::Integer:
+        result = reader.toInteger();
+        break;
+    case QJsonStreamReader::Double:
+        result = reader.toDouble();
+        break;
+    case QJsonStreamReader::String:
+        return readString(reader, feed);
+    case QJsonStreamReader::Array: {
+        QJsonArray array;
+        reader.enterContainer();
+        while (recover(reader, feed) && reader.hasNext())
+            array.append(readValue(reader, feed));
+        reader.leaveContainer();
+        recover(reader, feed);
+        return array;
+    }
+    case QJsonStreamReader::Object: {
+        QJsonObject object;
+        reader.enterContainer();
+        while (recover(reader, feed) && reader.hasNext()) {
+            const QString key = readString(reader, feed);
+            object.insert(key, readValue(reader, feed));
+        }
+        reader.leaveContainer();
+        recover(reader, feed);
+        return object;
+    }
+    case QJsonStreamReader::Invalid:
+        return QJsonValue::Undefined;
+    }
+
+    reader.next();
+    recover(reader, feed);
+    return result;
+}
+
+void tst_QJsonStreamReader::scalars_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QJsonStreamReader::Type>("type");
+    QTest::addColumn<QJsonValue>("expected");
+
+    QTest::newRow("null") << "null"_ba << QJsonStreamReader::Null << QJsonValue(QJsonValue::Null);
+    QTest::newRow("true") << "true"_ba << QJsonStreamReader::Bool << QJsonValue(true);
+    QTest::newRow("false") << " false "_ba << QJsonStreamReader::Bool << QJsonValue(false);
+    QTest::newRow("zero") << "0"_ba << QJsonStreamReader::Integer << QJsonValue(0);
+    QTest::newRow("negative") << "-42"_ba << QJsonStreamReader::Integer << QJsonValue(-42);
+    QTest::newRow("int64-max") << "9223372036854775807"_ba << QJsonStreamReader::Integer
+                               << QJsonValue(std::numeric_limits<qint64>::max());
+    QTest::newRow("integral-double") << "1e3"_ba << QJsonStreamReader::Integer << QJsonValue(1000);
+    QTest::newRow("double") << "1.5"_ba << QJsonStreamReader::Double << QJsonValue(1.5);
+    QTest::newRow("negative-exponent") << "-2.5e-3"_ba << QJsonStreamReader::Double
+                                       << QJsonValue(-2.5e-3);
+    QTest::newRow("string") << "\"hello\""_ba << QJsonStreamReader::String << QJsonValue("hello");
+    QTest::newRow("empty-string") << "\"\""_ba << QJsonStreamReader::String << QJsonValue(""_L1);
+    QTest::newRow("escapes") << R"("\"\\\/\b\f\n\r\t")"_ba << QJsonStreamReader::String
+                             << QJsonValue("\"\\/\b\f\n\r\t");
+    QTest::newRow("unicode-escape") << R"("\u00e9\u20AC")"_ba << QJsonStreamReader::String
+                                    << QJsonValue(u"é€"_s);
+    QTest::newRow("surrogate-escape") << R"("\ud83d\ude00")"_ba << QJsonStreamReader::String
+                                      << QJsonValue(u"\U0001F600"_s);
+    QTest::newRow("utf8") << "\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\""_ba
+                          << QJsonStreamReader::String << QJsonValue(u"é€\U0001F600"_s);
+}
+
+void tst_QJsonStreamReader::scalars()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QJsonStreamReader::Type, type);
+    QFETCH(QJsonValue, expected);
+
+    QJsonStreamReader reader(data);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.type(), type);
+    QVERIFY(reader.hasNext());
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Invalid);
+
+    switch (type) {
+    case QJsonStreamReader::Bool:
+        QCOMPARE(reader.toBool(), expected.toBool());
+        QCOMPARE(reader.isTrue(), expected.toBool());
+        QCOMPARE(reader.isFalse(), !expected.toBool());
+        break;
+    case QJsonStreamReader::Integer:
+        QCOMPARE(reader.toInteger(), expected.toInteger());
+        QCOMPARE(reader.toDouble(), expected.toDouble());
+        break;
+    case QJsonStreamReader::Double:
+        QCOMPARE(reader.toDouble(), expected.toDouble());
+        break;
+    case QJsonStreamReader::String:
+        QCOMPARE(reader.readAllString(), expected.toString());
+        QVERIFY(!reader.hasNext());
+        return;
+    default:
+        break;
+    }
+
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::documents_data()
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("empty-array") << "[]"_ba;
+    QTest::newRow("empty-object") << "{}"_ba;
+    QTest::newRow("array") << "[1, 2.5, \"three\", true, false, null]"_ba;
+    QTest::newRow("object") << R"({"a": 1, "b": "two", "c": [3], "d": {}})"_ba;
+    QTest::newRow("nested") << R"([[[]], {"x": [{"y": {"z": [1, [2, [3]]]}}]}, []])"_ba;
+    QTest::newRow("whitespace") << " \n\t[ 1 ,\r\n { \"k\" : \"v\" } ] \n"_ba;
+    QTest::newRow("escaped-keys") << R"({"A\n": "\\", "\"": [ "\/" ]})"_ba;
+    QTest::newRow("utf8") << "{\"\xc3\xa9t\xc3\xa9\": [\"\xe2\x82\xac\", \"\xf0\x9f\x98\x80\"]}"_ba;
+
+    QByteArray large = "[";
+    for (int i = 0; i < 5000; ++i) {
+        if (i)
+            large += ',';
+        large += R"({"id":)" + QByteArray::number(i) + R"(,"name":"item )" + QByteArray::number(i)
+                + R"(","value":)" + QByteArray::number(i / 7.0) + R"(,"tags":["a","b\n"]})";
+    }
+    large += ']';
+    QTest::newRow("large") << large;
+
+    QByteArray longString = "[\"" + QByteArray(200000, 'x') + "\\u00e9" + QByteArray(100000, 'y')
+            + "\", \"" + QByteArray(70000, '\xc3').replace("\xc3", "\xc3\xa9") + "\"]";
+    QTest::newRow("long-strings") << longString;
+
+    // the surrogate pair straddles the end of a chunk
+    const QByteArray surrogateString =
+            "[\"" + QByteArray(65535, 'x') + "\\ud83d\\ude00y\"]";
+    QTest::newRow("surrogate-pair-chunks") << surrogateString;
+}
+
+static void checkDocument(const QByteArray &data, Mode mode)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
+    QCOMPARE(parseError.error, QJsonParseError::NoError);
+    const QJsonValue expected = doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object());
+
+    QBuffer buffer;
+    QJsonStreamReader reader;
+    qsizetype fed = 0;
+    std::function<bool()> feed = [] { return false; };
+    switch (mode) {
+    case Whole:
+        reader.addData(data);
+        reader.reparse();
+        break;
+    case ByteByByte:
+        feed = [&] {
+            if (fed == data.size())
+                return false;
+            reader.addData(data.constData() + fed++, 1);
+            return true;
+        };
+        // leading whitespace is not an incomplete value
+        while (reader.isInvalid() && feed())
+            reader.reparse();
+        break;
+    case Device:
+        buffer.setData(data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        reader.setDevice(&buffer);
+        break;
+    }
+
+    const QJsonValue value = readValue(reader, feed);
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(value, expected);
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.containerDepth(), 0);
+}
+
+void tst_QJsonStreamReader::documents()
+{
+    QFETCH(QByteArray, data);
+    checkDocument(data, Whole);
+}
+
+void tst_QJsonStreamReader::documentsIncremental()
+{
+    QFETCH(QByteArray, data);
+    if (data.size() > 100000)
+        QSKIP("Too slow when fed one byte at a time");
+    checkDocument(data, ByteByByte);
+}
+
+void tst_QJsonStreamReader::documentsFromDevice()
+{
+    QFETCH(QByteArray, data);
+    checkDocument(data, Device);
+}
+
+void tst_QJsonStreamReader::stringChunks()
+{
+    // a string that is incomplete comes out in chunks, without splitting
+    // UTF-8 or escape sequences
+    QJsonStreamReader reader("[\"ab\xc3"_ba);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isString());
+
+    auto r = reader.readString();
+    QCOMPARE(r.status, QJsonStreamReader::Ok);
+    QCOMPARE(r.data, "ab"_L1);
+    r = reader.readString();
+    QCOMPARE(r.status, QJsonStreamReader::Error);
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+
+    reader.addData("\xa9\\u00"_ba);
+    r = reader.readString();
+    QCOMPARE(r.status, QJsonStreamReader::Ok);
+    QCOMPARE(r.data, u"é"_s);
+
+    reader.addData("41\"]"_ba);
+    r = reader.readString();
+    QCOMPARE(r.status, QJsonStreamReader::Ok);
+    QCOMPARE(r.data, "A"_L1);
+    r = reader.readString();
+    QCOMPARE(r.status, QJsonStreamReader::EndOfString);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.currentOffset(), 14);
+}
+
+void tst_QJsonStreamReader::objectKeys()
+{
+    QJsonStreamReader reader(R"({"a": [1], "b": null})"_ba);
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.parentContainerType(), QJsonStreamReader::Object);
+    QCOMPARE(reader.containerDepth(), 1);
+
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readAllString(), "a"_L1);
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isString());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isNull());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(!reader.hasNext());
+}
+
+void tst_QJsonStreamReader::skipping()
+{
+    QJsonStreamReader reader(R"([{"a": "]}\"[{", "b": [[], {}]}, "x\\", 7])"_ba);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isObject());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isString());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 7);
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::leaveContainer()
+{
+    QJsonStreamReader reader(R"([[1, [2, "]"], {"k": [3]}], 4])"_ba);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.containerDepth(), 2);
+    QCOMPARE(reader.toInteger(), 1);
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.containerDepth(), 1);
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 4);
+    QVERIFY(reader.leaveContainer());
+    QVERIFY(!reader.hasNext());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::ndjson()
+{
+    const QByteArray data = "{\"n\": 1}\n{\"n\": 2}\n[3]\n\"four\"\n5\n"_ba;
+    QBuffer buffer;
+    buffer.setData(data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QJsonStreamReader reader(&buffer);
+    QJsonArray values;
+    while (reader.hasNext())
+        values.append(readValue(reader, [] { return false; }));
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+
+    const QJsonArray expected = {
+        QJsonObject{ { "n", 1 } }, QJsonObject{ { "n", 2 } }, QJsonArray{ 3 }, "four", 5
+    };
+    QCOMPARE(values, expected);
+    QCOMPARE(reader.currentOffset(), data.size());
+}
+
+void tst_QJsonStreamReader::prematureEnd()
+{
+    QJsonStreamReader reader("[1, 2"_ba);
+    QVERIFY(reader.enterContainer());
+    QCOMPARE(reader.toInteger(), 1);
+    // the number could continue
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    QCOMPARE(reader.lastError().offset, 4);
+    QVERIFY(!reader.hasNext());
+
+    reader.addData("5, tr"_ba);
+    reader.reparse();
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(reader.toInteger(), 25);
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    reader.addData("ue]"_ba);
+    reader.reparse();
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+    QVERIFY(reader.isTrue());
+    QVERIFY(reader.next());
+    QVERIFY(!reader.hasNext());
+    QVERIFY(reader.leaveContainer());
+
+    // skipping resumes where it stopped
+    QJsonStreamReader skipReader(R"([["a", "b)"_ba);
+    QVERIFY(skipReader.enterContainer());
+    QVERIFY(!skipReader.next());
+    QCOMPARE(skipReader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    skipReader.addData(R"(]"], 3])"_ba);
+    skipReader.reparse();
+    QCOMPARE(skipReader.lastError().error, QJsonParseError::NoError);
+    QCOMPARE(skipReader.toInteger(), 3);
+
+    QBuffer buffer;
+    buffer.setData(R"({"a": ["x"], "b": 12)"_ba);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QJsonStreamReader deviceReader(&buffer);
+    QVERIFY(deviceReader.enterContainer());
+    QVERIFY(deviceReader.next());
+    QVERIFY(deviceReader.isArray());
+    QVERIFY(deviceReader.next());
+    QVERIFY(!deviceReader.next());
+    QCOMPARE(deviceReader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+    QCOMPARE(deviceReader.lastError().offset, 18);
+}
+
+void tst_QJsonStreamReader::clearWhileSkipping_data()
+{
+    QTest::addColumn<QByteArray>("incomplete");
+
+    // each stops skipping right after a backslash
+    QTest::newRow("string") << R"(["a\)"_ba;
+    QTest::newRow("array") << R"([["a\)"_ba;
+    QTest::newRow("object") << R"([{"a\)"_ba;
+}
+
+void tst_QJsonStreamReader::clearWhileSkipping()
+{
+    QFETCH(QByteArray, incomplete);
+
+    QJsonStreamReader reader(incomplete);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.lastError().error, QJsonParseError::PrematureEndOfDocument);
+
+    // nothing of the skipping is left after clear()
+    reader.clear();
+    reader.addData(R"([["\"]", "]"], 2])"_ba);
+    reader.reparse();
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isArray());
+    QVERIFY(reader.next());
+    QVERIFY(reader.isInteger());
+    QCOMPARE(reader.toInteger(), 2);
+    QVERIFY(reader.next());
+    QVERIFY(reader.leaveContainer());
+    QCOMPARE(reader.lastError().error, QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+    QTest::addColumn<int>("offset");
+
+    QTest::newRow("missing-comma") << "[1 2]"_ba << QJsonParseError::MissingValueSeparator << 3;
+    QTest::newRow("missing-colon") << R"({"a" 1})"_ba << QJsonParseError::MissingNameSeparator << 5;
+    QTest::newRow("trailing-comma") << "[1,]"_ba << QJsonParseError::MissingObject << 3;
+    QTest::newRow("trailing-comma-object") << R"({"a":1,})"_ba << QJsonParseError::MissingObject << 7;
+    QTest::newRow("non-string-key") << "{1: 2}"_ba << QJsonParseError::UnterminatedObject << 1;
+    QTest::newRow("bad-literal") << "[tru]"_ba << QJsonParseError::IllegalValue << 1;
+    QTest::newRow("bad-value") << "[@]"_ba << QJsonParseError::IllegalValue << 1;
+    QTest::newRow("bad-number") << "[1.2.3]"_ba << QJsonParseError::IllegalNumber << 1;
+    QTest::newRow("bad-utf8") << "[\"a\xff\"]"_ba << QJsonParseError::IllegalUTF8String << 2;
+    QTest::newRow("bad-escape") << R"(["\u12g4"])"_ba << QJsonParseError::IllegalEscapeSequence << 2;
+    QTest::newRow("unterminated-string") << "[\"abc"_ba
+                                         << QJsonParseError::PrematureEndOfDocument << 5;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, data);
+    QFETCH(QJsonParseError::ParseError, error);
+    QFETCH(int, offset);
+
+    QJsonStreamReader reader(data);
+    readValue(reader, [] { return false; });
+    QCOMPARE(reader.lastError().error, error);
+    QCOMPARE(reader.lastError().offset, offset);
+    QVERIFY(!reader.lastError().errorString().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(tst_QJsonStreamReader)
+
+#include "tst_qjsonstreamreader.moc"
@@ -0,0 +1,246 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamWriter>
+
+#include <limits>
+
+using namespace Qt::StringLiterals;
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void scalars_data();
+    void scalars();
+    void containers();
+    void jsonValues_data();
+    void jsonValues();
+    void ndjson();
+    void mismatchedContainers();
+    void nonStringKeys();
+    void deviceBuffering();
+};
+
+void tst_QJsonStreamWriter::scalars_data()
+{
+    QTest::addColumn<QVariant>("value");
+    QTest::addColumn<QByteArray>("expected");
+
+    QTest::newRow("null") << QVariant::fromValue(nullptr) << "null"_ba;
+    QTest::newRow("true") << QVariant(true) << "true"_ba;
+    QTest::newRow("false") << QVariant(false) << "false"_ba;
+    QTest::newRow("int") << QVariant(-17) << "-17"_ba;
+    QTest::newRow("int64") << QVariant(std::numeric_limits<qint64>::min())
+                           << "-9223372036854775808"_ba;
+    QTest::newRow("double") << QVariant(0.1) << "0.1"_ba;
+    QTest::newRow("large-double") << QVariant(1e300) << "1e+300"_ba;
+    QTest::newRow("inf") << QVariant(qInf()) << "null"_ba;
+    QTest::newRow("nan") << QVariant(qQNaN()) << "null"_ba;
+    QTest::newRow("string") << QVariant("hello"_L1) << "\"hello\""_ba;
+    QTest::newRow("escapes") << QVariant(u"\"\\\b\f\n\r\t\x01"_s)
+                             << R"("\"\\\b\f\n\r\t\u0001")"_ba;
+    QTest::newRow("non-ascii") << QVariant(u"é€\U0001F600"_s)
+                               << "\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\""_ba;
+}
+
+void tst_QJsonStreamWriter::scalars()
+{
+    QFETCH(QVariant, value);
+    QFETCH(QByteArray, expected);
+
+    QByteArray output;
+    {
+        QJsonStreamWriter writer(&output);
+        switch (value.userType()) {
+        case QMetaType::Nullptr:
+            writer.append(nullptr);
+            break;
+        case QMetaType::Bool:
+            writer.append(value.toBool());
+            break;
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+            writer.append(value.toLongLong());
+            break;
+        case QMetaType::Double:
+            writer.append(value.toDouble());
+            break;
+        default:
+            writer.append(value.toString());
+            break;
+        }
+    }
+    QCOMPARE(output, expected + '\n');
+}
+
+void tst_QJsonStreamWriter::containers()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.startObject();
+    writer.append("empty"_L1);
+    writer.startArray();
+    QVERIFY(writer.endArray());
+    writer.append(u"list"_s);
+    writer.startArray();
+    writer.append(1);
+    writer.append(2.5);
+    writer.startObject();
+    QVERIFY(writer.endObject());
+    writer.appendNull();
+    QVERIFY(writer.endArray());
+    writer.append("key");
+    writer.append("value");
+    QVERIFY(writer.endObject());
+
+    QCOMPARE(output, R"({"empty":[],"list":[1,2.5,{},null],"key":"value"})"_ba + '\n');
+
+    QJsonParseError error;
+    const QJsonDocument doc = QJsonDocument::fromJson(output, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(doc.object().value("list"_L1).toArray().size(), 4);
+}
+
+void tst_QJsonStreamWriter::jsonValues_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+
+    QTest::newRow("null") << QJsonValue(QJsonValue::Null);
+    QTest::newRow("number") << QJsonValue(42);
+    QTest::newRow("string") << QJsonValue("text\n"_L1);
+    QTest::newRow("array") << QJsonValue(QJsonArray{ 1, "two", QJsonArray{ true }, QJsonObject{} });
+    QTest::newRow("object") << QJsonValue(QJsonObject{
+            { "a", 1 }, { "b", QJsonArray{ 2, 3 } }, { "c", QJsonObject{ { "d", "e" } } } });
+}
+
+void tst_QJsonStreamWriter::jsonValues()
+{
+    QFETCH(QJsonValue, value);
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.startArray();
+    writer.append(value);
+    writer.append(value);
+    QVERIFY(writer.endArray());
+
+    const QJsonDocument doc = QJsonDocument::fromJson(output);
+    QCOMPARE(doc.array(), QJsonArray({ value, value }));
+}
+
+void tst_QJsonStreamWriter::ndjson()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    for (int i = 0; i < 3; ++i) {
+        writer.startObject();
+        writer.append("n"_L1);
+        writer.append(i);
+        QVERIFY(writer.endObject());
+    }
+    writer.append("end"_L1);
+
+    QCOMPARE(output, "{\"n\":0}\n{\"n\":1}\n{\"n\":2}\n\"end\"\n"_ba);
+}
+
+void tst_QJsonStreamWriter::mismatchedContainers()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    QVERIFY(!writer.endArray());
+    QVERIFY(!writer.endObject());
+
+    writer.startArray();
+    QVERIFY(!writer.endObject());
+    QVERIFY(writer.endArray());
+
+    writer.startObject();
+    writer.append("key"_L1);
+    QVERIFY(!writer.endObject());
+    writer.append(true);
+    QVERIFY(!writer.endArray());
+    QVERIFY(writer.endObject());
+
+    QCOMPARE(output, "[]\n{\"key\":true}\n"_ba);
+}
+
+void tst_QJsonStreamWriter::nonStringKeys()
+{
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.startObject();
+    writer.append("key"_L1);
+    writer.append(1);
+    QVERIFY(!writer.hasError());
+
+    // nothing more is written after the error
+    writer.append(2);
+    QVERIFY(writer.hasError());
+    writer.append("key"_L1);
+    writer.append(3);
+    QVERIFY(!writer.endObject());
+    QCOMPARE(output, "{\"key\":1"_ba);
+
+    // also for keys in QJsonValues and containers
+    using AppendKey = void (*)(QJsonStreamWriter &);
+    const AppendKey appendKeys[] = {
+        [](QJsonStreamWriter &w) { w.append(QJsonValue(1)); },
+        [](QJsonStreamWriter &w) { w.startArray(); },
+        [](QJsonStreamWriter &w) { w.appendNull(); },
+    };
+    for (AppendKey appendKey : appendKeys) {
+        output.clear();
+        QJsonStreamWriter writer(&output);
+        writer.startObject();
+        appendKey(writer);
+        QVERIFY(writer.hasError());
+        QCOMPARE(output, "{"_ba);
+    }
+
+    // string keys in QJsonValues are fine
+    output.clear();
+    QJsonStreamWriter valueWriter(&output);
+    valueWriter.startObject();
+    valueWriter.append(QJsonValue(u"key"_s));
+    valueWriter.append(QJsonValue(1));
+    QVERIFY(valueWriter.endObject());
+    QVERIFY(!valueWriter.hasError());
+    QCOMPARE(output, "{\"key\":1}\n"_ba);
+}
+
+void tst_QJsonStreamWriter::deviceBuffering()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    QJsonStreamWriter writer(&buffer);
+    QCOMPARE(writer.device(), &buffer);
+    writer.startArray();
+    writer.append(1);
+    // nothing is written before the top-level value is complete...
+    QCOMPARE(buffer.data(), QByteArray());
+    QVERIFY(writer.flush());
+    QCOMPARE(buffer.data(), "[1"_ba);
+
+    // ...unless enough output accumulated
+    const QString text(1024, u'x');
+    for (int i = 0; i < 32; ++i)
+        writer.append(text);
+    QVERIFY(buffer.data().size() > 16 * 1024);
+
+    QVERIFY(writer.endArray());
+    const QJsonDocument doc = QJsonDocument::fromJson(buffer.data());
+    QCOMPARE(doc.array().size(), 33);
+    QVERIFY(buffer.data().endsWith("]\n"));
+}
+
+QTEST_GUILESS_MAIN(tst_QJsonStreamWriter)
+
+#include "tst_qjsonstreamwriter.moc"
@@ -9,6 +9,7 @@
 #include <qthreadpool.h>
 #include <qstring.h>
 #include <qmutex.h>
+#include <qset.h>
 
 #ifdef Q_OS_UNIX
 #include <unistd.h>
@@ -83,6 +84,8 @@ private slots:
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void workStealing();
+    void workStealingClear();
 
 private:
     QMutex m_functionTestMutex;
@@ -1444,5 +1447,70 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+void tst_QThreadPool::workStealing()
+{
+    TestThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QVERIFY(!pool.isWorkStealingEnabled());
+    pool.setWorkStealingEnabled(true);
+    QVERIFY(pool.isWorkStealingEnabled());
+
+    constexpr int taskCount = 10000;
+    QAtomicInt count;
+    QMutex threadsMutex;
+    QSet<QThread *> threads;
+    QSemaphore started;
+
+    pool.start([&] {
+        for (int i = 0; i < taskCount; ++i) {
+            // tasks with a non-default priority go through the shared queue
+            const int priority = (i % 10 == 0) ? 1 : 0;
+            pool.start([&] {
+                if (count.fetchAndAddRelaxed(1) == 0)
+                    started.release();
+                QThread::usleep(10);
+                QMutexLocker locker(&threadsMutex);
+                threads.insert(QThread::currentThread());
+            }, priority);
+        }
+    });
+
+    QVERIFY(started.tryAcquire(1, 10000));
+    QVERIFY(pool.waitForDone(60000));
+    QCOMPARE(count.loadRelaxed(), taskCount);
+    // other threads must have stolen some of the work
+    QVERIFY(threads.size() > 1);
+}
+
+void tst_QThreadPool::workStealingClear()
+{
+    TestThreadPool pool;
+    pool.setMaxThreadCount(1);
+    pool.setWorkStealingEnabled(true);
+
+    QSemaphore spawned;
+    QSemaphore proceed;
+    QAtomicInt count;
+    std::unique_ptr<QRunnable> task;
+
+    pool.start([&] {
+        task.reset(QRunnable::create([&] { count.ref(); }));
+        task->setAutoDelete(false);
+        pool.start(task.get());
+        for (int i = 0; i < 10; ++i)
+            pool.start([&] { count.ref(); });
+        spawned.release();
+        proceed.acquire();
+    });
+
+    QVERIFY(spawned.tryAcquire(1, 10000));
+    // the tasks are in the worker's local queue and can be taken or cleared
+    QVERIFY(pool.tryTake(task.get()));
+    pool.clear();
+    proceed.release();
+    QVERIFY(pool.waitForDone(10000));
+    QCOMPARE(count.loadRelaxed(), 0);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -25,6 +25,8 @@ private slots:
     void reserveAndRead();
     void reserveAndReadInPacketMode();
     void reserveFrontAndRead();
+    void reserveBlocksAndRead();
+    void dataBlocks();
     void chop();
     void readPointerValidity();
     void ungetChar();
@@ -252,6 +254,66 @@ void tst_QRingBuffer::reserveAndReadInPacketMode()
     QCOMPARE(buffersCount, 255);
 }
 
+void tst_QRingBuffer::reserveBlocksAndRead()
+{
+    QRingBuffer ringBuffer(16);
+    char *data[2];
+    qint64 sizes[2];
+
+    // an empty buffer gets a single block
+    QCOMPARE(ringBuffer.reserveBlocks(10, data, sizes), qsizetype(1));
+    QCOMPARE(sizes[0], Q_INT64_C(10));
+    memcpy(data[0], "0123456789", 10);
+
+    // the rest of the last block is filled before a new one is allocated
+    QCOMPARE(ringBuffer.reserveBlocks(20, data, sizes), qsizetype(2));
+    QCOMPARE(sizes[0], Q_INT64_C(6));
+    QCOMPARE(sizes[1], Q_INT64_C(14));
+    memcpy(data[0], "abcdef", 6);
+    memcpy(data[1], "ghijklmnopqrst", 14);
+    QCOMPARE(ringBuffer.size(), Q_INT64_C(30));
+
+    // unused space is chopped across the blocks
+    QCOMPARE(ringBuffer.reserveBlocks(10, data, sizes), qsizetype(2));
+    QCOMPARE(sizes[0], Q_INT64_C(2));
+    QCOMPARE(sizes[1], Q_INT64_C(8));
+    memcpy(data[0], "uv", 2);
+    ringBuffer.chop(8);
+
+    QCOMPARE(ringBuffer.read(), QByteArray("0123456789abcdef"));
+    QCOMPARE(ringBuffer.read(), QByteArray("ghijklmnopqrstuv"));
+    QVERIFY(ringBuffer.isEmpty());
+
+    // a shared last block is not written to
+    ringBuffer.append(QByteArray("xyz"));
+    QByteArray shared(8, 'a');
+    ringBuffer.append(shared);
+    QCOMPARE(ringBuffer.reserveBlocks(4, data, sizes), qsizetype(1));
+    QCOMPARE(sizes[0], Q_INT64_C(4));
+    QCOMPARE(shared, QByteArray(8, 'a'));
+}
+
+void tst_QRingBuffer::dataBlocks()
+{
+    QRingBuffer ringBuffer;
+    const char *data[4];
+    qint64 sizes[4];
+    QCOMPARE(ringBuffer.dataBlocks(data, sizes, 4), qsizetype(0));
+
+    ringBuffer.append(QByteArray("first"));
+    ringBuffer.append(QByteArray("second"));
+    ringBuffer.append(QByteArray("third"));
+    ringBuffer.free(2);
+
+    QCOMPARE(ringBuffer.dataBlocks(data, sizes, 4), qsizetype(3));
+    QCOMPARE(QByteArrayView(data[0], sizes[0]), "rst");
+    QCOMPARE(QByteArrayView(data[1], sizes[1]), "second");
+    QCOMPARE(QByteArrayView(data[2], sizes[2]), "third");
+
+    QCOMPARE(ringBuffer.dataBlocks(data, sizes, 2), qsizetype(2));
+    QCOMPARE(QByteArrayView(data[1], sizes[1]), "second");
+}
+
 void tst_QRingBuffer::reserveFrontAndRead()
 {
     QRingBuffer ringBuffer;
@@ -10,6 +10,7 @@
 
 #include <QtCore/qbytearray.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 #include <string>
@@ -30,6 +31,8 @@ private Q_SLOTS:
     void bitstreamReadWrite();
     void bitstreamCompression();
     void bitstreamErrors();
+    void huffmanRoundTrip();
+    void huffmanErrors();
 
     void lookupTableConstructor();
 
@@ -45,6 +48,7 @@ private Q_SLOTS:
     void hpackEncodeResponse();
     void hpackDecodeResponse_data();
     void hpackDecodeResponse();
+    void hpackDecodeLiteralName();
 
     // TODO: more-more-more tests needed!
 
@@ -318,6 +322,62 @@ void tst_Hpack::bitstreamErrors()
     }
 }
 
+void tst_Hpack::huffmanRoundTrip()
+{
+    // Strings of all lengths around the lookahead size of the decoder,
+    // with all the octet values, so with codes of all the lengths.
+    for (int length = 0; length < 64; ++length) {
+        for (int i = 0; i < 256; ++i) {
+            QByteArray data(length, Qt::Uninitialized);
+            for (char &c : data)
+                c = char(QRandomGenerator::global()->bounded(256));
+            if (i % 2) {
+                // Mostly short codes, like in real headers.
+                for (char &c : data)
+                    c = 'a' + uchar(c) % 26;
+            }
+
+            std::vector<uchar> buffer;
+            BitOStream out(buffer);
+            out.write(data, true);
+
+            BitIStream in(out.begin(), out.end());
+            QByteArray decoded;
+            QVERIFY(in.read(&decoded));
+            QCOMPARE(decoded, data);
+            QVERIFY(!in.hasMoreBits());
+        }
+    }
+}
+
+void tst_Hpack::huffmanErrors()
+{
+    {
+        // 'a' (00011) padded with more than 7 bits.
+        const uchar bytes[] = {0x82, 0x1f, 0xff};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+    {
+        // 'a' padded with zeroes instead of the EOS prefix.
+        const uchar bytes[] = {0x81, 0x18};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+    {
+        // The EOS symbol itself.
+        const uchar bytes[] = {0x84, 0xff, 0xff, 0xff, 0xfc};
+        BitIStream in(bytes, bytes + sizeof bytes);
+        QByteArray val;
+        QVERIFY(!in.read(&val));
+        QCOMPARE(in.error(), StreamError::CompressionError);
+    }
+}
+
 void tst_Hpack::lookupTableConstructor()
 {
     {
@@ -800,6 +860,31 @@ void tst_Hpack::hpackDecodeResponse()
     }
 }
 
+void tst_Hpack::hpackDecodeLiteralName()
+{
+    // A field without indexing, with the name 'content-type'
+    // as a string literal instead of a reference to the static table:
+    const uchar bytes[] = {0x00,
+                           0x0c, 'c', 'o', 'n', 't', 'e', 'n', 't', '-', 't', 'y', 'p', 'e',
+                           0x0a, 't', 'e', 'x', 't', '/', 'p', 'l', 'a', 'i', 'n'};
+    BitIStream in(bytes, bytes + sizeof bytes);
+    Decoder decoder(FieldLookupTable::DefaultSize);
+    QVERIFY(decoder.decodeHeaderFields(in));
+
+    const auto &decoded = decoder.decodedHeader();
+    QCOMPARE(decoded.size(), size_t(1));
+    QCOMPARE(decoded[0].name, "content-type");
+    QCOMPARE(decoded[0].value, "text/plain");
+
+    // The name was interned:
+    const auto &staticPart = FieldLookupTable::staticPart();
+    const auto pos = std::find_if(staticPart.begin(), staticPart.end(), [](const HeaderField &f) {
+        return f.name == "content-type";
+    });
+    QVERIFY(pos != staticPart.end());
+    QVERIFY(decoded[0].name.isSharedWith(pos->name));
+}
+
 QTEST_MAIN(tst_Hpack)
 
 #include "tst_hpack.moc"
@@ -634,7 +634,7 @@ void Http2Server::handleIncomingFrame()
         // TODO: this is not tested for now.
         break;
     case FrameType::PING:
-        // TODO: this is not tested for now.
+        handlePING();
         break;
     case FrameType::GOAWAY:
         // TODO: this is not tested for now.
@@ -789,6 +789,21 @@ void Http2Server::handleWINDOW_UPDATE()
     sendDATA(streamID, delta);
 }
 
+void Http2Server::handlePING()
+{
+    if (inboundFrame.streamID() != connectionStreamID || inboundFrame.dataSize() != 8
+        || inboundFrame.flags().testFlag(FrameFlag::ACK)) {
+        sendGOAWAY(connectionStreamID, PROTOCOL_ERROR, connectionStreamID);
+        emit invalidFrame();
+        connectionError = true;
+        return;
+    }
+
+    writer.start(FrameType::PING, FrameFlag::ACK, connectionStreamID);
+    writer.append(inboundFrame.dataBegin(), inboundFrame.dataBegin() + 8);
+    writer.write(*socket);
+}
+
 void Http2Server::sendResponse(quint32 streamID, bool emptyBody)
 {
     Q_ASSERT(activeRequests.find(streamID) != activeRequests.end());
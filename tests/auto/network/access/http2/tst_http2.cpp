@@ -29,6 +29,7 @@
 #include <cstdlib>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <QtTest/private/qemulationdetector_p.h>
 
@@ -74,6 +75,8 @@ private slots:
     void singleRequest();
     void multipleRequests();
     void flowControlClientSide();
+    void adaptiveFlowControl();
+    void sharedSession();
     void flowControlServerSide();
     void pushPromise();
     void goaway_data();
@@ -377,6 +380,94 @@ void tst_Http2::flowControlClientSide()
     QVERIFY(windowUpdates > 0);
 }
 
+void tst_Http2::adaptiveFlowControl()
+{
+    // Download a large body through a small stream window, once with the
+    // window fixed and once letting it grow. Our server sends only as much
+    // data as the client's WINDOW_UPDATE frames allow, so a window that grew
+    // results in fewer updates.
+    using namespace Http2;
+
+    const QByteArray respond(int(Http2::defaultSessionWindowSize * 200), 'x');
+    int updates[2] = {};
+    for (bool adaptive : { false, true }) {
+        clearHTTP2State();
+        manager.reset(new QNetworkAccessManager);
+
+        serverPort = 0;
+        nRequests = 1;
+
+        QHttp2Configuration params;
+        params.setSessionReceiveWindowSize(Http2::defaultSessionWindowSize);
+        params.setStreamReceiveWindowSize(Http2::defaultSessionWindowSize);
+        params.setAdaptiveFlowControlEnabled(adaptive);
+
+        ServerPtr srv(newServer(defaultServerSettings, defaultConnectionType(),
+                                qt_H2ConfigurationToSettings(params)));
+        srv->setResponseBody(respond);
+
+        QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+        runEventLoop();
+        QVERIFY(serverPort != 0);
+
+        qint64 received = 0;
+        connect(manager.get(), &QNetworkAccessManager::finished, this,
+                [&received](QNetworkReply *reply) { received = reply->readAll().size(); });
+        sendRequest(0, QNetworkRequest::NormalPriority, {}, params);
+
+        runEventLoop(120000);
+        STOP_ON_FAILURE
+
+        QCOMPARE(nRequests, 0);
+        QVERIFY(prefaceOK);
+        QVERIFY(serverGotSettingsACK);
+        QCOMPARE(received, respond.size());
+        updates[adaptive] = windowUpdates;
+    }
+
+    QVERIFY(updates[false] > 0);
+    QVERIFY2(updates[true] < updates[false] / 2,
+             qPrintable(u"%1 updates with adaptive flow control, %2 without"_s
+                                .arg(updates[true]).arg(updates[false])));
+}
+
+void tst_Http2::sharedSession()
+{
+    // Managers sharing their threads send the requests for one origin over
+    // one HTTP/2 connection. Our server accepts only one connection, so the
+    // requests of all managers succeed only if they share it.
+    clearHTTP2State();
+
+    serverPort = 0;
+    nRequests = 4;
+
+    ServerPtr srv(newServer(defaultServerSettings, H2Type::h2cDirect));
+    QMetaObject::invokeMethod(srv.data(), "startServer", Qt::QueuedConnection);
+    runEventLoop();
+    QVERIFY(serverPort != 0);
+
+    qputenv("QT_NETWORK_SHARED_HTTP_THREADS", "4");
+    auto envCleanup = qScopeGuard([]() { qunsetenv("QT_NETWORK_SHARED_HTTP_THREADS"); });
+
+    std::vector<std::unique_ptr<QNetworkAccessManager>> managers;
+    for (int i = 0; i < nRequests; ++i) {
+        managers.emplace_back(std::make_unique<QNetworkAccessManager>());
+        auto url = requestUrl(H2Type::h2cDirect);
+        url.setPath(QString("/stream%1.html").arg(i));
+        QNetworkRequest request(url);
+        request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+        QNetworkReply *reply = managers.back()->get(request);
+        connect(reply, &QNetworkReply::finished, this, &tst_Http2::replyFinished);
+    }
+
+    runEventLoop();
+    STOP_ON_FAILURE
+
+    QCOMPARE(nRequests, 0);
+    QVERIFY(prefaceOK);
+    QVERIFY(serverGotSettingsACK);
+}
+
 void tst_Http2::flowControlServerSide()
 {
     // Quite aggressive test:
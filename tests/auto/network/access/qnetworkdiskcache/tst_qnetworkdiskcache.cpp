@@ -45,6 +45,8 @@ private slots:
     void updateMetaData();
     void fileMetaData();
     void expire();
+    void index();
+    void untrackedFiles();
 
     void oldCacheVersionFile_data();
     void oldCacheVersionFile();
@@ -264,8 +266,11 @@ static QStringList countFiles(const QString dir)
     QStringList list;
     QDir::Filters filter(QDir::AllEntries | QDir::NoDotAndDotDot);
     QDirIterator it(dir, filter, QDirIterator::Subdirectories);
-    while (it.hasNext())
-        list.append(it.next());
+    while (it.hasNext()) {
+        const QString fileName = it.next();
+        if (it.fileName() != "index") // the journal of the cache's index
+            list.append(fileName);
+    }
     return list;
 }
 
@@ -537,6 +542,143 @@ void tst_QNetworkDiskCache::expire()
     }
 }
 
+static void insertItem(QNetworkDiskCache *cache, const QUrl &url, const QByteArray &data)
+{
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setRawHeaders({ { "content-type", "application/octet-stream" } });
+    QIODevice *device = cache->prepare(metaData);
+    QVERIFY(device);
+    device->write(data);
+    cache->insert(device);
+}
+
+void tst_QNetworkDiskCache::index()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray data(1000, 'a');
+    const QUrl url1("http://localhost:4/1");
+    const QUrl url2("http://localhost:4/2");
+    const QUrl url3("http://localhost:4/3");
+
+    qint64 cacheSize = 0;
+    {
+        SubQNetworkDiskCache cache;
+        cache.setClearCacheOnDestruction(false);
+        cache.setCacheDirectory(dir.path());
+        insertItem(&cache, url1, data);
+        insertItem(&cache, url2, data);
+        insertItem(&cache, url3, data);
+        // makes url2 the least recently used one
+        QVERIFY(cache.metaData(url1).isValid());
+        cacheSize = cache.cacheSize();
+        QVERIFY(cacheSize > 3 * data.size());
+    }
+
+    // the index is read back from its journal
+    const QString journal = dir.path() + "/data8/index";
+    QVERIFY(QFile::exists(journal));
+    {
+        SubQNetworkDiskCache cache;
+        cache.setClearCacheOnDestruction(false);
+        cache.setCacheDirectory(dir.path());
+        QCOMPARE(cache.cacheSize(), cacheSize);
+        QVERIFY(!cache.metaData(QUrl("http://localhost:4/4")).isValid());
+
+        // expire one file
+        cache.setMaximumCacheSize(cacheSize);
+        QVERIFY(cache.call_expire() < cacheSize);
+        QVERIFY(cache.metaData(url1).isValid());
+        QVERIFY(!cache.metaData(url2).isValid());
+        QVERIFY(cache.metaData(url3).isValid());
+        cacheSize = cache.cacheSize();
+    }
+
+    // the index is rebuilt from the cache files
+    QVERIFY(QFile::remove(journal));
+    {
+        SubQNetworkDiskCache cache;
+        cache.setCacheDirectory(dir.path());
+        QCOMPARE(cache.cacheSize(), cacheSize);
+        QIODevice *device = cache.data(url3);
+        QVERIFY(device);
+        QCOMPARE(device->readAll(), data);
+        delete device;
+    }
+    QVERIFY(QFile::exists(journal));
+}
+
+// Writes a cache file for url into cacheDirectory without going through the
+// journal of that directory, like a second cache object would.
+static QString writeUntrackedFile(const QString &cacheDirectory, const QUrl &url,
+                                  const QByteArray &data)
+{
+    QTemporaryDir other;
+    if (!other.isValid())
+        return QString();
+    {
+        SubQNetworkDiskCache cache;
+        cache.setClearCacheOnDestruction(false);
+        cache.setCacheDirectory(other.path());
+        insertItem(&cache, url, data);
+    }
+    QDirIterator it(other.path(), { "*.d" }, QDir::Files, QDirIterator::Subdirectories);
+    if (!it.hasNext())
+        return QString();
+    const QString source = it.next();
+    const QString target = cacheDirectory + source.mid(other.path().size());
+    if (!QDir().mkpath(QFileInfo(target).path()) || !QFile::copy(source, target))
+        return QString();
+    return target;
+}
+
+void tst_QNetworkDiskCache::untrackedFiles()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QByteArray data(1000, 'a');
+    const QUrl url1("http://localhost:4/1");
+    const QUrl url2("http://localhost:4/2");
+    const QUrl url3("http://localhost:4/3");
+
+    {
+        SubQNetworkDiskCache cache;
+        cache.setClearCacheOnDestruction(false);
+        cache.setCacheDirectory(dir.path());
+        insertItem(&cache, url1, data);
+    }
+    QVERIFY(QFile::exists(dir.path() + "/data8/index"));
+
+    // a file written behind the journal's back is indexed when the cache is
+    // opened again, without holding up lookups, so that expire() removes it
+    const QString file2 = writeUntrackedFile(dir.path(), url2, data);
+    QVERIFY(!file2.isEmpty());
+    qint64 cacheSize = 0;
+    {
+        SubQNetworkDiskCache cache;
+        cache.setClearCacheOnDestruction(false);
+        cache.setCacheDirectory(dir.path());
+        QVERIFY(cache.metaData(url1).isValid());
+        QTRY_VERIFY(cache.cacheSize() > 2 * data.size());
+        cache.setMaximumCacheSize(cache.cacheSize());
+        cache.call_expire();
+        QVERIFY(!QFile::exists(file2));
+        QVERIFY(cache.metaData(url1).isValid());
+        QVERIFY(!cache.metaData(url2).isValid());
+        cacheSize = cache.cacheSize();
+    }
+
+    // the size of the cache is not known before the index is read
+    {
+        SubQNetworkDiskCache cache;
+        cache.setCacheDirectory(dir.path());
+        insertItem(&cache, url3, data);
+        // both files have the same size
+        QCOMPARE(cache.cacheSize(), 2 * cacheSize);
+    }
+}
+
 void tst_QNetworkDiskCache::oldCacheVersionFile_data()
 {
     QTest::addColumn<int>("pass");
@@ -413,6 +413,8 @@ private Q_SLOTS:
     void getFromHttpIntoBufferCanReadLine();
 
     void ioGetFromHttpWithoutContentLength();
+    void ioGetFromHttpReadNextChunk_data();
+    void ioGetFromHttpReadNextChunk();
 
     void ioGetFromHttpBrokenChunkedEncoding();
     void qtbug12908compressedHttpReply();
@@ -7049,6 +7051,44 @@ void tst_QNetworkReply::ioGetFromHttpWithoutContentLength()
     QCOMPARE(reply->error(), QNetworkReply::NoError);
 }
 
+void tst_QNetworkReply::ioGetFromHttpReadNextChunk_data()
+{
+    QTest::addColumn<QByteArray>("header");
+
+    QTest::newRow("content-length") << QByteArray("HTTP/1.1 200 OK\r\nContent-Length: 1000000\r\n\r\n");
+    QTest::newRow("no-content-length") << QByteArray("HTTP/1.0 200 OK\r\n\r\n");
+}
+
+void tst_QNetworkReply::ioGetFromHttpReadNextChunk()
+{
+    QFETCH(QByteArray, header);
+
+    QByteArray body(1000000, Qt::Uninitialized);
+    for (qsizetype i = 0; i < body.size(); ++i)
+        body[i] = char(i % 251);
+    MiniHttpServer server(header + body);
+    server.doClose = true;
+
+    QNetworkRequest request(QUrl("http://localhost:" + QString::number(server.serverPort())));
+    QNetworkReplyPtr reply(manager.get(request));
+
+    QByteArray received;
+    connect(reply.data(), &QIODevice::readyRead, this, [&] {
+        while (reply->bytesAvailable()) {
+            const QByteArray chunk = reply->readNextChunk();
+            QVERIFY(!chunk.isEmpty());
+            received += chunk;
+        }
+    });
+
+    QVERIFY2(waitForFinish(reply) == Success, msgWaitForFinished(reply));
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    received += reply->readNextChunk();
+    QCOMPARE(reply->readNextChunk(), QByteArray());
+    QCOMPARE(received.size(), body.size());
+    QVERIFY(received == body);
+}
+
 // Is handled somewhere else too, introduced this special test to have it more accessible
 void tst_QNetworkReply::ioGetFromHttpBrokenChunkedEncoding()
 {
@@ -19,6 +19,9 @@
 #include <QDebug>
 #include <QTcpSocket>
 #include <QTcpServer>
+#include <QUdpSocket>
+#include <QNetworkDatagram>
+#include <QScopeGuard>
 
 #include <private/qthread_p.h>
 
@@ -43,6 +46,118 @@
 
 #define TEST_DOMAIN ".test.qt-project.org"
 
+#if QT_CONFIG(dnslookup) && defined(Q_OS_UNIX) && !defined(Q_OS_ANDROID)
+#  define HAVE_NAMESERVER_LOOKUPS
+
+// A stand-in nameserver, which answers for the hosts it is given and
+// with NXDOMAIN for the other names. If forgedName is set, each query is
+// first answered for that name, and for the other address type.
+class DnsServer : public QUdpSocket
+{
+public:
+    struct Host {
+        QList<QHostAddress> addresses;
+        quint32 ttl;
+    };
+    QHash<QByteArray, Host> hosts;
+    quint32 negativeTtl = 1;
+    QByteArray forgedName;
+    int queryCount = 0;
+
+    DnsServer()
+    {
+        connect(this, &QUdpSocket::readyRead, this, &DnsServer::answer);
+    }
+
+private:
+    static void appendNumber(QByteArray &data, quint32 value, int size)
+    {
+        for (int i = size - 1; i >= 0; --i)
+            data.append(char(value >> (8 * i)));
+    }
+
+    QByteArray makeReply(const QByteArray &id, const QByteArray &name, int type) const
+    {
+        const auto host = hosts.constFind(name);
+        QList<QHostAddress> addresses;
+        if (host != hosts.cend()) {
+            for (const QHostAddress &address : host->addresses) {
+                if ((type == 1) == (address.protocol() == QAbstractSocket::IPv4Protocol))
+                    addresses.append(address);
+            }
+        }
+
+        QByteArray reply = id;
+        appendNumber(reply, host != hosts.cend() ? 0x8180 : 0x8183, 2); // NXDOMAIN
+        appendNumber(reply, 1, 2);
+        appendNumber(reply, addresses.size(), 2);
+        appendNumber(reply, addresses.isEmpty() ? 1 : 0, 2);
+        appendNumber(reply, 0, 2);
+        for (const QByteArray &label : name.split('.'))
+            reply += char(label.size()) + label;
+        reply += '\0';
+        appendNumber(reply, type, 2);
+        appendNumber(reply, 1, 2);
+        for (const QHostAddress &address : std::as_const(addresses)) {
+            reply += "\xc0\x0c";  // the name of the question
+            appendNumber(reply, type, 2);
+            appendNumber(reply, 1, 2);
+            appendNumber(reply, host->ttl, 4);
+            if (type == 1) {
+                appendNumber(reply, 4, 2);
+                appendNumber(reply, address.toIPv4Address(), 4);
+            } else {
+                appendNumber(reply, 16, 2);
+                reply.append(reinterpret_cast<const char *>(address.toIPv6Address().c), 16);
+            }
+        }
+        if (addresses.isEmpty()) {
+            // SOA with root names and MINIMUM as the TTL of negative answers
+            reply += "\xc0\x0c";
+            appendNumber(reply, 6, 2);
+            appendNumber(reply, 1, 2);
+            appendNumber(reply, 3600, 4);
+            appendNumber(reply, 22, 2);
+            reply.append("\0\0", 2);
+            for (quint32 value : { 1u, 3600u, 600u, 86400u, negativeTtl })
+                appendNumber(reply, value, 4);
+        }
+        return reply;
+    }
+
+    void answer()
+    {
+        while (hasPendingDatagrams()) {
+            const QNetworkDatagram query = receiveDatagram();
+            const QByteArray data = query.data();
+            ++queryCount;
+
+            // the question, its name as labels
+            QByteArray name;
+            qsizetype pos = 12;
+            while (pos < data.size() && data.at(pos)) {
+                const int length = data.at(pos);
+                if (!name.isEmpty())
+                    name += '.';
+                name += data.mid(pos + 1, length);
+                pos += length + 1;
+            }
+            pos += 1;
+            if (pos + 4 > data.size())
+                continue;
+            const int type = (uchar(data.at(pos)) << 8) | uchar(data.at(pos + 1));
+
+            const QByteArray id = data.left(2);
+            if (!forgedName.isEmpty()) {
+                writeDatagram(query.makeReply(makeReply(id, forgedName, type)));
+                writeDatagram(query.makeReply(makeReply(id, name, type == 1 ? 28 : 1)));
+            }
+            writeDatagram(query.makeReply(makeReply(id, name, type)));
+        }
+    }
+};
+#endif
+
 
 class tst_QHostInfo : public QObject
 {
@@ -79,8 +194,17 @@ private slots:
     void multipleDifferentLookups();
 
     void cache();
+    void cacheHostNotFound();
 
     void abortHostLookup();
+
+#ifdef HAVE_NAMESERVER_LOOKUPS
+    void nameserverTimeToLive();
+    void nameserverNegativeCache();
+    void nameserverCoalescedLookups();
+    void nameserverForgedAnswers();
+    void nameserverHostsFile();
+#endif
 protected slots:
     void resultsReady(const QHostInfo &);
 
@@ -670,6 +794,194 @@ void tst_QHostInfo::cache()
     QCOMPARE(lookupsDoneCounter, 2);
 }
 
+void tst_QHostInfo::cacheHostNotFound()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    // without a time to live from the nameserver, names that were not found
+    // are looked up again
+    const QString name = QStringLiteral("nonexistent.invalid");
+    QHostInfo notFound;
+    notFound.setHostName(name);
+    notFound.setError(QHostInfo::HostNotFound);
+    qt_qhostinfo_clear_cache();
+    qt_qhostinfo_cache_inject(name, notFound);
+
+    bool valid = true;
+    int id = -1;
+    lookupDone = false;
+    qt_qhostinfo_lookup(name, this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(10);
+    QVERIFY(lookupDone);
+}
+
+#ifdef HAVE_NAMESERVER_LOOKUPS
+void tst_QHostInfo::nameserverTimeToLive()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    DnsServer server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    server.hosts["ttl.example.com"] = { { QHostAddress("192.0.2.1"), QHostAddress("2001:db8::1") }, 1 };
+    server.hosts["v4.example.com"] = { { QHostAddress("192.0.2.2") }, 30 };
+    qt_qhostinfo_set_nameserver(QHostAddress::LocalHost, server.localPort());
+    const auto cleanup = qScopeGuard([] { qt_qhostinfo_set_nameserver(QHostAddress(), 53); });
+
+    bool valid = true;
+    int id = -1;
+    lookupDone = false;
+    qt_qhostinfo_lookup("ttl.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(lookupResults.error(), QHostInfo::NoError);
+    QCOMPARE(lookupResults.addresses(),
+             QList<QHostAddress>({ QHostAddress("192.0.2.1"), QHostAddress("2001:db8::1") }));
+    QCOMPARE(server.queryCount, 2);
+
+    // cached, but only for the TTL of the records
+    QHostInfo result = qt_qhostinfo_lookup("ttl.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.addresses().size(), 2);
+    QTest::qWait(1100);
+    lookupDone = false;
+    qt_qhostinfo_lookup("ttl.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(server.queryCount, 4);
+
+    // the AAAA query gets a negative answer, which does not shorten the TTL of the A record
+    lookupDone = false;
+    qt_qhostinfo_lookup("v4.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(lookupResults.addresses(), QList<QHostAddress>({ QHostAddress("192.0.2.2") }));
+    QTest::qWait(1100);
+    qt_qhostinfo_lookup("v4.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(server.queryCount, 6);
+}
+
+void tst_QHostInfo::nameserverNegativeCache()
+{
+    QFETCH_GLOBAL(bool, cache);
+    if (!cache)
+        return; // test makes only sense when cache enabled
+
+    // the system resolver is asked as well, and has to agree
+    if (QHostInfo::fromName("nonexistent.example.com").error() != QHostInfo::HostNotFound)
+        QSKIP("The system resolver does not answer for nonexistent.example.com");
+
+    DnsServer server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    qt_qhostinfo_set_nameserver(QHostAddress::LocalHost, server.localPort());
+    const auto cleanup = qScopeGuard([] { qt_qhostinfo_set_nameserver(QHostAddress(), 53); });
+
+    bool valid = true;
+    int id = -1;
+    lookupDone = false;
+    qt_qhostinfo_lookup("nonexistent.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(lookupResults.error(), QHostInfo::HostNotFound);
+    QCOMPARE(server.queryCount, 2);
+
+    // the answer is cached for the MINIMUM of the SOA record
+    QHostInfo result = qt_qhostinfo_lookup("nonexistent.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(valid);
+    QCOMPARE(result.error(), QHostInfo::HostNotFound);
+    QTest::qWait(1100);
+    lookupDone = false;
+    qt_qhostinfo_lookup("nonexistent.example.com", this, SLOT(resultsReady(QHostInfo)), &valid, &id);
+    QVERIFY(!valid);
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(server.queryCount, 4);
+}
+
+void tst_QHostInfo::nameserverCoalescedLookups()
+{
+    DnsServer server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    server.hosts["coalesced.example.com"] = { { QHostAddress("192.0.2.3") }, 60 };
+    qt_qhostinfo_set_nameserver(QHostAddress::LocalHost, server.localPort());
+    const auto cleanup = qScopeGuard([] { qt_qhostinfo_set_nameserver(QHostAddress(), 53); });
+
+    // the server only answers when we get back to the event loop,
+    // so all the lookups start while the first one is in progress
+    const int COUNT = 10;
+    lookupsDoneCounter = 0;
+    for (int i = 0; i < COUNT; i++)
+        QHostInfo::lookupHost("coalesced.example.com", this, SLOT(resultsReady(QHostInfo)));
+
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < 10000 && lookupsDoneCounter < COUNT)
+        QTestEventLoop::instance().enterLoop(2);
+    QCOMPARE(lookupsDoneCounter, COUNT);
+    QCOMPARE(lookupResults.addresses(), QList<QHostAddress>({ QHostAddress("192.0.2.3") }));
+    QCOMPARE(server.queryCount, 2);
+}
+
+void tst_QHostInfo::nameserverForgedAnswers()
+{
+    DnsServer server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    server.hosts["forged.example.com"] = { { QHostAddress("198.51.100.1"), QHostAddress("2001:db8::66") }, 60 };
+    server.hosts["genuine.example.com"] = { { QHostAddress("192.0.2.4") }, 60 };
+    server.forgedName = "forged.example.com";
+    qt_qhostinfo_set_nameserver(QHostAddress::LocalHost, server.localPort());
+    const auto cleanup = qScopeGuard([] { qt_qhostinfo_set_nameserver(QHostAddress(), 53); });
+
+    // answers with the right ID but for another name or type are ignored
+    lookupDone = false;
+    QHostInfo::lookupHost("genuine.example.com", this, SLOT(resultsReady(QHostInfo)));
+    QTestEventLoop::instance().enterLoop(5);
+    QVERIFY(lookupDone);
+    QCOMPARE(lookupResults.error(), QHostInfo::NoError);
+    QCOMPARE(lookupResults.addresses(), QList<QHostAddress>({ QHostAddress("192.0.2.4") }));
+}
+
+void tst_QHostInfo::nameserverHostsFile()
+{
+    // a name from the hosts file that the nameservers don't know
+    QString hostName;
+    QFile hosts("/etc/hosts");
+    if (hosts.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (hostName.isEmpty() && !hosts.atEnd()) {
+            const QString line = QString::fromLatin1(hosts.readLine()).section(u'#', 0, 0);
+            const QStringList fields = line.simplified().split(u' ', Qt::SkipEmptyParts);
+            for (qsizetype i = 1; i < fields.size() && hostName.isEmpty(); ++i) {
+                if (fields.at(i).contains(u'.') && !fields.at(i).endsWith(u'.'))
+                    hostName = fields.at(i);
+            }
+        }
+    }
+    if (hostName.isEmpty())
+        QSKIP("No host name with a domain in /etc/hosts");
+    const QHostInfo expected = QHostInfo::fromName(hostName);
+    if (expected.error() != QHostInfo::NoError)
+        QSKIP("The system resolver does not resolve the names in /etc/hosts");
+
+    DnsServer server;
+    QVERIFY(server.bind(QHostAddress::LocalHost));
+    qt_qhostinfo_set_nameserver(QHostAddress::LocalHost, server.localPort());
+    const auto cleanup = qScopeGuard([] { qt_qhostinfo_set_nameserver(QHostAddress(), 53); });
+
+    const QHostInfo result = QHostInfo::fromName(hostName);
+    QCOMPARE(result.error(), QHostInfo::NoError);
+    QCOMPARE(result.addresses(), expected.addresses());
+    QCOMPARE(server.queryCount, 2);
+}
+#endif
+
 void tst_QHostInfo::resultsReady(const QHostInfo &hi)
 {
     QVERIFY(QThread::currentThread() == thread());
@@ -82,6 +82,7 @@ private slots:
     void outOfProcessConnectedClientServerTest();
     void outOfProcessUnconnectedClientServerTest();
     void zeroLengthDatagram();
+    void batchedDatagrams();
     void multicastTtlOption_data();
     void multicastTtlOption();
     void multicastLoopbackOption_data();
@@ -1235,6 +1236,69 @@ void tst_QUdpSocket::zeroLengthDatagram()
     QCOMPARE(receiver.readDatagram(&buf, 1), qint64(0));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 1024 * 1024);
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    // runs of datagrams of the same size, which may be sent as one buffer,
+    // some followed by a shorter one, and datagrams of varying sizes
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < 100; ++i) {
+        const int size = i < 40 ? 1000 : i < 41 ? 300 : i < 70 ? 1 + i * 7 : 512;
+        const QByteArray data(size, char('a' + i % 26));
+        datagrams.append(QNetworkDatagram(data, QHostAddress::LocalHost, receiver.localPort()));
+    }
+    datagrams.append(QNetworkDatagram(QByteArray(), QHostAddress::LocalHost, receiver.localPort()));
+
+    QSignalSpy bytesWrittenSpy(&sender, &QUdpSocket::bytesWritten);
+    QCOMPARE(sender.writeDatagrams(datagrams), qint64(datagrams.size()));
+    QCOMPARE(bytesWrittenSpy.size(), 1);
+    qint64 totalSize = 0;
+    for (const QNetworkDatagram &datagram : std::as_const(datagrams))
+        totalSize += datagram.data().size();
+    QCOMPARE(bytesWrittenSpy.at(0).at(0).toLongLong(), totalSize);
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < datagrams.size()) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        const QList<QNetworkDatagram> batch = receiver.receiveDatagrams(32);
+        QVERIFY(!batch.isEmpty());
+        QVERIFY(batch.size() <= 32);
+        received += batch;
+    }
+
+    QCOMPARE(received.size(), datagrams.size());
+    for (qsizetype i = 0; i < received.size(); ++i) {
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderAddress(), QHostAddress(QHostAddress::LocalHost));
+        QCOMPARE(received.at(i).senderPort(), int(sender.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(receiver.localPort()));
+    }
+
+    // a small maximum size truncates the datagrams
+    QCOMPARE(sender.writeDatagrams(datagrams.mid(0, 3)), qint64(3));
+    received.clear();
+    while (received.size() < 3) {
+        if (!receiver.hasPendingDatagrams())
+            QVERIFY2(receiver.waitForReadyRead(5000), QtNetworkSettings::msgSocketError(receiver).constData());
+        received += receiver.receiveDatagrams(3, 10);
+    }
+    QCOMPARE(received.size(), 3);
+    for (qsizetype i = 0; i < received.size(); ++i)
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data().left(10));
+    QVERIFY(!receiver.hasPendingDatagrams());
+    QVERIFY(receiver.receiveDatagrams(8).isEmpty());
+}
+
 void tst_QUdpSocket::multicastTtlOption_data()
 {
     QTest::addColumn<QHostAddress>("bindAddress");
@@ -19,3 +19,18 @@ openssl req -new -sha512 -nodes -key leaf.key -out leaf.csr -config leaf.conf
 openssl x509 -req -sha512 -days 45 -in leaf.csr -CA inter.crt -CAkey inter.key -CAcreateserial -out leaf.crt
 rm leaf.csr
 rm inter.srl
+
+# generate session-inter.crt and session-leaf.crt, a chain that does not
+# expire, for the tests that need a handshake without errors
+printf 'basicConstraints = critical, CA:TRUE\nkeyUsage = cRLSign, keyCertSign\n' > session-inter.ext
+openssl genrsa -traditional -out session-inter.key 2048
+openssl req -new -sha512 -nodes -key session-inter.key -out session-inter.csr -config inter.conf
+openssl x509 -req -sha512 -days 10000 -in session-inter.csr -CA ca.crt -CAkey ca.key -CAcreateserial -extfile session-inter.ext -out session-inter.crt
+rm session-inter.csr session-inter.ext
+rm ca.srl
+
+openssl genrsa -traditional -out session-leaf.key 2048
+openssl req -new -sha512 -nodes -key session-leaf.key -out session-leaf.csr -config leaf.conf
+openssl x509 -req -sha512 -days 10000 -in session-leaf.csr -CA session-inter.crt -CAkey session-inter.key -CAcreateserial -out session-leaf.crt
+rm session-leaf.csr
+rm session-inter.srl
@@ -9,6 +9,7 @@
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qrandom.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporaryfile.h>
 #include <QtNetwork/qhostaddress.h>
 #include <QtNetwork/qhostinfo.h>
 #include <QtNetwork/qnetworkproxy.h>
@@ -171,6 +172,10 @@ private slots:
     void setLocalCertificate();
     void localCertificateChain();
     void setLocalCertificateChain();
+#if QT_CONFIG(openssl)
+    void sharedSessionPeerCertificateChain();
+    void kernelTls();
+#endif
     void tlsConfiguration();
     void setSocketDescriptor();
     void setSslConfiguration_data();
@@ -1462,6 +1467,7 @@ public:
     QSslSocket *socket;
     QSslConfiguration config;
     QString addCaCertificates;
+    int sendBufferSize = 0;
     bool ignoreSslErrors;
     QSslSocket::PeerVerifyMode peerVerifyMode;
     QSsl::SslProtocol protocol;
@@ -1537,6 +1543,8 @@ protected:
         QVERIFY(socket->peerPort() != 0);
         QVERIFY(!socket->localAddress().isNull());
         QVERIFY(socket->localPort() != 0);
+        if (sendBufferSize > 0)
+            socket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, sendBufferSize);
 
         socket->startServerEncryption();
     }
@@ -1823,6 +1831,112 @@ void tst_QSslSocket::setLocalCertificateChain()
              QByteArray("11:72:34:bc:21:e6:ca:04:24:13:f8:35:48:84:a6:e9:de:96:22:15"));
 }
 
+#if QT_CONFIG(openssl)
+void tst_QSslSocket::sharedSessionPeerCertificateChain()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("The session cache is specific to OpenSSL");
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    SslServer server(testDataDir + "certs/session-leaf.key",
+                     testDataDir + "certs/session-leaf.crt",
+                     testDataDir + "certs/session-inter.crt");
+    server.protocol = QSsl::TlsV1_2;
+    QVERIFY(server.listen());
+
+    const QList<QSslCertificate> expectedChain =
+            QSslCertificate::fromPath(testDataDir + "certs/session-leaf.crt")
+            + QSslCertificate::fromPath(testDataDir + "certs/session-inter.crt");
+    QCOMPARE(expectedChain.size(), 2);
+
+    // The session of the first connection is resumed by the second one, which
+    // must still have the peer certificate chain: OpenSSL does not keep it in
+    // the session.
+    for (int i = 0; i < 2; ++i) {
+        QSslSocket client;
+        auto configuration = client.sslConfiguration();
+        configuration.setProtocol(QSsl::TlsV1_2);
+        configuration.addCaCertificates(testDataDir + "certs/ca.crt");
+        client.setSslConfiguration(configuration);
+        client.setPeerVerifyName(QStringLiteral("networking-tests.qt-project.org"));
+
+        client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                      server.serverPort());
+        QVERIFY2(client.waitForEncrypted(5000), qPrintable(client.errorString()));
+        QVERIFY(client.sslHandshakeErrors().isEmpty());
+        QCOMPARE(QSslConfigurationPrivate::peerSessionWasShared(client.sslConfiguration()), i == 1);
+        QCOMPARE(client.peerCertificateChain(), expectedChain);
+
+        client.disconnectFromHost();
+    }
+}
+
+void tst_QSslSocket::kernelTls()
+{
+    if (!isTestingOpenSsl)
+        QSKIP("Kernel TLS is specific to OpenSSL");
+
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    // With a long certificate chain and a small send buffer, the server's
+    // socket BIO runs out of room during the handshake, which then has to go
+    // on once the socket is writable. Whether the kernel encrypts afterwards
+    // or we fall back to OpenSSL (no tls module), the data must get through.
+    QFile intermediate(testDataDir + "certs/session-inter.crt");
+    QVERIFY(intermediate.open(QIODevice::ReadOnly));
+    QTemporaryFile intermediates;
+    QVERIFY(intermediates.open());
+    intermediates.write(intermediate.readAll().repeated(45));
+    intermediates.close();
+
+    SslServer server(testDataDir + "certs/session-leaf.key",
+                     testDataDir + "certs/session-leaf.crt",
+                     intermediates.fileName());
+    server.config.setSslOption(QSsl::SslOptionEnableKernelTls, true);
+    server.sendBufferSize = 1;
+    QVERIFY(server.listen());
+
+    QSslSocket client;
+    auto configuration = client.sslConfiguration();
+    configuration.setSslOption(QSsl::SslOptionEnableKernelTls, true);
+    client.setSslConfiguration(configuration);
+    connect(&client, &QSslSocket::sslErrors, &client, [&client] { client.ignoreSslErrors(); });
+
+    client.connectToHostEncrypted(QHostAddress(QHostAddress::LocalHost).toString(),
+                                  server.serverPort());
+    QTRY_VERIFY2(client.isEncrypted(), qPrintable(client.errorString()));
+    QTRY_VERIFY(server.socket && server.socket->isEncrypted());
+
+    QByteArray payload(1 << 20, Qt::Uninitialized);
+    for (qsizetype i = 0; i < payload.size(); ++i)
+        payload[i] = char(i * 7);
+    QByteArray receivedByServer;
+    QByteArray receivedByClient;
+    connect(server.socket, &QSslSocket::readyRead, &client, [&] {
+        receivedByServer += server.socket->readAll();
+    });
+    connect(&client, &QSslSocket::readyRead, &client, [&] {
+        receivedByClient += client.readAll();
+    });
+
+    client.write(payload);
+    server.socket->write(payload.first(64 * 1024));
+    QTRY_COMPARE(receivedByServer.size(), payload.size());
+    QCOMPARE(receivedByServer, payload);
+    QTRY_COMPARE(receivedByClient.size(), 64 * 1024);
+    QCOMPARE(receivedByClient, payload.first(64 * 1024));
+
+    client.disconnectFromHost();
+    QTRY_COMPARE(server.socket->state(), QAbstractSocket::UnconnectedState);
+    QCOMPARE(server.socket->error(), QAbstractSocket::RemoteHostClosedError);
+}
+#endif // openssl
+
 void tst_QSslSocket::tlsConfiguration()
 {
     QFETCH_GLOBAL(const bool, setProxy);
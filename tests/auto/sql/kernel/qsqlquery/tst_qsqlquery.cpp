@@ -74,10 +74,14 @@ private slots:
     // forwardOnly mode need special treatment
     void forwardOnly_data() { generic_data(); }
     void forwardOnly();
+    void fetchBatch_data() { generic_data(); }
+    void fetchBatch();
     void forwardOnlyMultipleResultSet_data() { generic_data(); }
     void forwardOnlyMultipleResultSet();
     void psql_forwardOnlyQueryResultsLost_data() { generic_data("QPSQL"); }
     void psql_forwardOnlyQueryResultsLost();
+    void psql_forwardOnlyFetchSize_data() { generic_data("QPSQL"); }
+    void psql_forwardOnlyFetchSize();
 
     // Bug-specific tests:
     void tds_bitField_data() { generic_data("QTDS"); }
@@ -130,6 +134,10 @@ private slots:
     void invalidQuery();
     void batchExec_data() { generic_data(); }
     void batchExec();
+    void bulkInsert_data() { generic_data(); }
+    void bulkInsert();
+    void execAsync_data() { generic_data(); }
+    void execAsync();
     void QTBUG_43874_data() { generic_data(); }
     void QTBUG_43874();
     void oraArrayBind_data() { generic_data("QOCI"); }
@@ -228,6 +236,8 @@ private slots:
 
     void sqlite_real_data() { generic_data("QSQLITE"); }
     void sqlite_real();
+    void sqlite_execBatch_data() { generic_data("QSQLITE"); }
+    void sqlite_execBatch();
 
     void prepared_query_json_row_data() { generic_data(); }
     void prepared_query_json_row();
@@ -1521,6 +1531,65 @@ void tst_QSqlQuery::forwardOnly()
     QCOMPARE(q.at(), QSql::AfterLastRow);
 }
 
+void tst_QSqlQuery::fetchBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString qtest_null(qTableName("qtest_null", __FILE__, db));
+    const QString select = QLatin1String("select id, t_varchar from %1 order by id").arg(qtest_null);
+
+    for (bool forwardOnly : { false, true }) {
+        QSqlQuery q(db);
+        q.setForwardOnly(forwardOnly);
+        QVERIFY_SQL(q, exec(select));
+
+        QSqlColumnBatch batch;
+        QVERIFY(q.fetchBatch(&batch, 3));
+        QCOMPARE(q.at(), 2);
+        QCOMPARE(batch.rowCount(), 3);
+        QCOMPARE(batch.columnCount(), 2);
+        QCOMPARE(batch.columnType(0), QSqlColumnBatch::Int64);
+        QCOMPARE(batch.columnType(1), QSqlColumnBatch::Bytes);
+        for (int row = 0; row < 3; ++row) {
+            QVERIFY(!batch.isNull(row, 0));
+            QCOMPARE(batch.int64Value(row, 0), row);
+        }
+        QVERIFY(batch.isNull(0, 1));
+        QCOMPARE(batch.bytes(1, 1).toByteArray(), QByteArray("n"));
+        QCOMPARE(batch.bytes(2, 1).toByteArray(), QByteArray("i"));
+        QCOMPARE(batch.nullBitmap(1)[0], uchar(0x1));
+        // Out of range columns have no values.
+        QVERIFY(batch.bytes(1, -1).isEmpty());
+        QVERIFY(batch.bytes(1, 2).isEmpty());
+        QVERIFY(!batch.int64Data(-1));
+        QVERIFY(!batch.nullBitmap(2));
+
+        QVERIFY(q.fetchBatch(&batch, 3));
+        QCOMPARE(q.at(), QSql::AfterLastRow);
+        QCOMPARE(batch.rowCount(), 1);
+        QCOMPARE(batch.int64Value(0, 0), 3);
+        QVERIFY(batch.isNull(0, 1));
+        QVERIFY(batch.bytes(0, 1).isEmpty());
+
+        QVERIFY(!q.fetchBatch(&batch, 3));
+        QCOMPARE(batch.rowCount(), 0);
+
+        // Batches and single rows can be mixed.
+        QVERIFY_SQL(q, exec(select));
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), 0);
+        QVERIFY(q.fetchBatch(&batch, 2));
+        QCOMPARE(batch.rowCount(), 2);
+        QCOMPARE(batch.int64Value(0, 0), 1);
+        QCOMPARE(batch.int64Value(1, 0), 2);
+        QVERIFY(q.next());
+        QCOMPARE(q.at(), 3);
+        QCOMPARE(q.value(0).toInt(), 3);
+        QVERIFY(!q.next());
+    }
+}
+
 void tst_QSqlQuery::forwardOnlyMultipleResultSet()
 {
     QFETCH(QString, dbName);
@@ -1729,6 +1798,56 @@ void tst_QSqlQuery::psql_forwardOnlyQueryResultsLost()
     QCOMPARE(q2.value(0).toInt(), 5);
 }
 
+void tst_QSqlQuery::psql_forwardOnlyFetchSize()
+{
+    QFETCH(QString, dbName);
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("fetchSizeTest"); });
+    // Note: destruction of db needs to happen before we call removeDatabase.
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(QSqlDatabase::database(dbName),
+                                                  "fetchSizeTest");
+    CHECK_DATABASE(db);
+    db.setConnectOptions("QPSQL_FETCH_SIZE=100");
+    QVERIFY_SQL(db, open());
+
+    // The rows arrive in chunks (or one by one with libpq before 17), the
+    // last of them partly filled.
+    const QString select("select i, i % 7 = 0 from generate_series(0, 249) as s(i)");
+    QSqlQuery q(db);
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, exec(select));
+    if (!q.isForwardOnly())
+        QSKIP("DBMS doesn't support forward-only queries");
+    for (int i = 0; i < 250; ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.at(), i);
+        QCOMPARE(q.value(0).toInt(), i);
+        QCOMPARE(q.value(1).toBool(), i % 7 == 0);
+    }
+    QVERIFY(!q.next());
+    QCOMPARE(q.at(), QSql::AfterLastRow);
+
+    // Batches that do not line up with the chunks
+    QVERIFY_SQL(q, exec(select));
+    QSqlColumnBatch batch;
+    int rows = 0;
+    while (q.fetchBatch(&batch, 30)) {
+        for (int row = 0; row < batch.rowCount(); ++row)
+            QCOMPARE(batch.int64Value(row, 0), rows + row);
+        rows += batch.rowCount();
+    }
+    QCOMPARE(rows, 250);
+
+    // Moving on to the next result set skips the rest of the chunk.
+    QVERIFY_SQL(q, exec(select + "; select 42"));
+    QVERIFY(q.next());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 1);
+    QVERIFY(q.nextResult());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 42);
+    QVERIFY(!q.next());
+}
+
 void tst_QSqlQuery::query_exec()
 {
     QFETCH(QString, dbName);
@@ -2696,6 +2815,119 @@ void tst_QSqlQuery::batchExec()
     }
 }
 
+void tst_QSqlQuery::bulkInsert()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_bulk", __FILE__, db);
+    tst_Databases::safeDropTable(db, tableName);
+    QVERIFY_SQL(q, exec(QLatin1String("create table %1 (id int, name varchar(20), "
+                                      "num double precision, data %2, amount numeric(10, 2))")
+                        .arg(tableName, tst_Databases::blobTypeName(db))));
+
+    // The text format of COPY needs escaping for tabs, line breaks and backslashes;
+    // numeric has no binary COPY format, so the rows are copied as text
+    const QList<int> ids = { 1, 2, 3 };
+    const QStringList names = { u"a\tb"_s, u"c\\d\ne"_s, QString() };
+    const QVariantList nums = { 1.5, QVariant(QMetaType::fromType<double>()), -2.25 };
+    const QVariantList blobs = { QByteArray("\0\1\2", 3), QByteArray("\\x"),
+                                 QVariant(QMetaType::fromType<QByteArray>()) };
+    const QVariantList amounts = { 12.5, QVariant(QMetaType::fromType<double>()), -0.75 };
+    QVERIFY_SQL(q, bulkInsert(tableName,
+                              { u"id"_s, u"name"_s, u"num"_s, u"data"_s, u"amount"_s },
+                              { QVariant::fromValue(ids), names, nums, blobs, amounts }));
+    QCOMPARE(q.numRowsAffected(), ids.size());
+
+    QVERIFY_SQL(q, exec(QLatin1String("select id, name, num, data, amount from %1 order by id")
+                        .arg(tableName)));
+    for (qsizetype i = 0; i < ids.size(); ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), ids.at(i));
+        QCOMPARE(q.value(1).isNull(), names.at(i).isNull());
+        QCOMPARE(q.value(1).toString(), names.at(i));
+        QCOMPARE(q.value(2).isNull(), nums.at(i).isNull());
+        QCOMPARE(q.value(2).toDouble(), nums.at(i).toDouble());
+        QCOMPARE(q.value(3).isNull(), blobs.at(i).isNull());
+        QCOMPARE(q.value(3).toByteArray(), blobs.at(i).toByteArray());
+        QCOMPARE(q.value(4).isNull(), amounts.at(i).isNull());
+        QCOMPARE(q.value(4).toDouble(), amounts.at(i).toDouble());
+    }
+    QVERIFY(!q.next());
+
+    // Unknown fields fail
+    QVERIFY(!q.bulkInsert(tableName, { u"id"_s, u"nonexistent"_s },
+                          { QVariantList { 4 }, QVariantList { 5 } }));
+    QVERIFY(q.lastError().isValid());
+}
+
+void tst_QSqlQuery::execAsync()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    for (bool forwardOnly : { false, true }) {
+        QSqlQuery q(db);
+        q.setForwardOnly(forwardOnly);
+        QFuture<bool> future = q.execAsync("select id from " + qtest + " order by id");
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result());
+        QVERIFY(q.isActive());
+        QVERIFY(q.isSelect());
+        for (int id = 1; id <= 5; ++id) {
+            QVERIFY(q.next());
+            QCOMPARE(q.value(0).toInt(), id);
+        }
+        QVERIFY(!q.next());
+
+        // Prepared queries, with a continuation that reads the result
+        QVERIFY_SQL(q, prepare("select id from " + qtest + " where id = ?"));
+        q.addBindValue(3);
+        int id = 0;
+        future = q.execAsync().then([&q, &id](bool ok) {
+            if (ok && q.next())
+                id = q.value(0).toInt();
+            return ok;
+        });
+        QTRY_VERIFY(future.isFinished());
+        QVERIFY(future.result());
+        QCOMPARE(id, 3);
+    }
+
+    // Errors are reported like exec() does
+    QSqlQuery q(db);
+    QFuture<bool> future = q.execAsync("select nonexistent from " + qtest);
+    QTRY_VERIFY(future.isFinished());
+    QVERIFY(!future.result());
+    QVERIFY(!q.isActive());
+    QVERIFY(q.lastError().isValid());
+
+    // Queries on a connection run one after the other, and destroying a
+    // query waits for or abandons it.
+    {
+        QSqlQuery pending(db);
+        future = pending.execAsync("select id from " + qtest);
+    }
+    QTRY_VERIFY(future.isFinished());
+    QVERIFY_SQL(q, exec("select count(*) from " + qtest));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 5);
+
+    // Using the query again waits for or abandons its pending execution
+    future = q.execAsync("select id from " + qtest);
+    QVERIFY_SQL(q, prepare("select count(*) from " + qtest + " where id > ?"));
+    QTRY_VERIFY(future.isFinished());
+    q.addBindValue(2);
+    future = q.execAsync();
+    QVERIFY_SQL(q, exec());
+    QTRY_VERIFY(future.isFinished());
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 3);
+}
+
 void tst_QSqlQuery::QTBUG_43874()
 {
     QFETCH(QString, dbName);
@@ -4438,6 +4670,94 @@ void tst_QSqlQuery::sqlite_real()
     QCOMPARE(q.value(0).toDouble(), 5.6);
 }
 
+void tst_QSqlQuery::sqlite_execBatch()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    const QString tableName(qTableName("sqlitebatch", __FILE__, db));
+    tst_Databases::safeDropTable(db, tableName);
+
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec(QLatin1String("CREATE TABLE %1 (id INTEGER PRIMARY KEY, name TEXT, "
+                                      "data BLOB, num REAL, extra INTEGER)").arg(tableName)));
+
+    // Typed lists are bound as they are, together with a QVariantList
+    const QList<int> ids = { 1, 2, 3 };
+    const QStringList names = { u"harald"_s, QString(), u"boris"_s };
+    const QByteArrayList blobs = { "a", "bc", QByteArray() };
+    const QList<double> nums = { 1.5, 2.5, 3.5 };
+    const QVariantList extras = { qint64(1) << 40, QVariant(QMetaType::fromType<int>()), 7 };
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id, name, data, num, extra) "
+                                         "VALUES (?, ?, ?, ?, ?)").arg(tableName)));
+    q.addBindValue(QVariant::fromValue(ids));
+    q.addBindValue(names);
+    q.addBindValue(QVariant::fromValue(blobs));
+    q.addBindValue(QVariant::fromValue(nums));
+    q.addBindValue(extras);
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 3);
+
+    // Duplicated named placeholders
+    const QList<qint64> moreIds = { 4, 5 };
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id, name, extra) "
+                                         "VALUES (:id, :name, :id)").arg(tableName)));
+    q.bindValue(u":id"_s, QVariant::fromValue(moreIds));
+    q.bindValue(u":name"_s, QStringList { u"four"_s, u"five"_s });
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 2);
+
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT id, name, data, num, extra FROM %1 ORDER BY id")
+                        .arg(tableName)));
+    for (qsizetype i = 0; i < ids.size(); ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toInt(), ids.at(i));
+        QCOMPARE(q.value(1).isNull(), names.at(i).isNull());
+        QCOMPARE(q.value(1).toString(), names.at(i));
+        QCOMPARE(q.value(2).isNull(), blobs.at(i).isNull());
+        QCOMPARE(q.value(2).toByteArray(), blobs.at(i));
+        QCOMPARE(q.value(3).toDouble(), nums.at(i));
+        QCOMPARE(q.value(4).isNull(), extras.at(i).isNull());
+        QCOMPARE(q.value(4).toLongLong(), extras.at(i).toLongLong());
+    }
+    for (qsizetype i = 0; i < moreIds.size(); ++i) {
+        QVERIFY(q.next());
+        QCOMPARE(q.value(0).toLongLong(), moreIds.at(i));
+        QCOMPARE(q.value(4).toLongLong(), moreIds.at(i));
+    }
+    QVERIFY(!q.next());
+
+    // The failing row is reported, and the rows before it are kept
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id) VALUES (?)").arg(tableName)));
+    q.addBindValue(QVariantList { 10, 11, 1, 12 });
+    QVERIFY(!q.execBatch());
+    QVERIFY(q.lastError().driverText().contains(u"row 2"_s));
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT id FROM %1 WHERE id >= 10 ORDER BY id")
+                        .arg(tableName)));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 10);
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), 11);
+    QVERIFY(!q.next());
+
+    // Columns of different sizes
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id, name) VALUES (?, ?)")
+                           .arg(tableName)));
+    q.addBindValue(QVariantList { 20, 21 });
+    q.addBindValue(QVariantList { u"x"_s });
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    // Inside a transaction the batch does not commit on its own
+    QVERIFY_SQL(db, transaction());
+    q.addBindValue(QVariantList { 20, 21 });
+    q.addBindValue(QVariantList { u"x"_s, u"y"_s });
+    QVERIFY_SQL(q, execBatch());
+    QVERIFY_SQL(db, rollback());
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT id FROM %1 WHERE id >= 20").arg(tableName)));
+    QVERIFY(!q.next());
+}
+
 void tst_QSqlQuery::prepared_query_json_row()
 {
     QFETCH(QString, dbName);
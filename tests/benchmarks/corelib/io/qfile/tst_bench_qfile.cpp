@@ -5,6 +5,7 @@
 #include <QTemporaryFile>
 #include <QString>
 #include <QDirIterator>
+#include <QThread>
 
 #include <private/qfsfileengine_p.h>
 
@@ -81,6 +82,9 @@ private slots:
     void readBigFile_posix() { readBigFile(); }
     void readBigFile_Win32() { readBigFile(); }
 
+    void writeFile_data();
+    void writeFile();
+
 private:
     void readFile_data(BenchmarkType type, QIODevice::OpenModeFlag t, QIODevice::OpenModeFlag b);
     void readBigFile();
@@ -588,6 +592,50 @@ void tst_qfile::readSmallFiles()
     }
 }
 
+void tst_qfile::writeFile_data()
+{
+    QTest::addColumn<int>("blockSize");
+    QTest::addColumn<bool>("ioUring");
+
+    for (int blockSize : { 512, 4 * 1024, 64 * 1024 }) {
+        QTest::addRow("%d", blockSize) << blockSize << false;
+#if QT_CONFIG(io_uring)
+        QTest::addRow("%d-io_uring", blockSize) << blockSize << true;
+#endif
+    }
+}
+
+void tst_qfile::writeFile()
+{
+    QFETCH(int, blockSize);
+    QFETCH(bool, ioUring);
+
+    // Whether a thread uses io_uring is decided on its first write, so each
+    // run writes the file from a new thread.
+    if (ioUring)
+        qputenv("QT_ENABLE_IO_URING", "1");
+    else
+        qunsetenv("QT_ENABLE_IO_URING");
+
+    constexpr qint64 FileSize = 16 * 1024 * 1024;
+    const QByteArray block(blockSize, 'a');
+    const QString fileName = tempDir.filePath("writeFile");
+    QBENCHMARK {
+        QScopedPointer<QThread> thr(QThread::create([&] {
+            QFile file(fileName);
+            file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered);
+            for (qint64 written = 0; written < FileSize; written += blockSize)
+                file.write(block);
+            file.close();
+        }));
+        thr->start();
+        thr->wait();
+    }
+    qunsetenv("QT_ENABLE_IO_URING");
+    QCOMPARE(QFileInfo(fileName).size(), FileSize);
+    QFile::remove(fileName);
+}
+
 QTEST_MAIN(tst_qfile)
 
 #include "tst_bench_qfile.moc"
@@ -31,6 +31,10 @@ class tst_QSortFilterProxyModel : public QObject
 private slots:
     void clearFilter_data();
     void clearFilter();
+    void sort_data();
+    void sort();
+    void insertSorted_data();
+    void insertSorted();
 
 private:
     QStringList m_numberList; ///< Cache the strings for efficiency.
@@ -93,6 +97,71 @@ void tst_QSortFilterProxyModel::clearFilter()
     QCOMPARE(proxy.rowCount(), itemCount);
 }
 
+void tst_QSortFilterProxyModel::sort_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("parallelSorting");
+
+    for (int thousandItemCount : { 10, 100, 1000, 2000 }) {
+        const auto itemCount = thousandItemCount * 1000;
+        QTest::addRow("lessThan, %dK", thousandItemCount) << itemCount << false;
+        QTest::addRow("parallel, %dK", thousandItemCount) << itemCount << true;
+    }
+}
+
+void tst_QSortFilterProxyModel::sort()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallelSorting);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortingEnabled(parallelSorting);
+    proxy.setSourceModel(&model);
+    QCOMPARE(proxy.rowCount(), itemCount);
+
+    QBENCHMARK_ONCE {
+        proxy.sort(0, Qt::DescendingOrder);
+    }
+    // "1" < "10" < "100" < ... < "2" when compared as strings
+    QCOMPARE(proxy.index(itemCount - 1, 0).data().toString(), u"1");
+}
+
+void tst_QSortFilterProxyModel::insertSorted_data()
+{
+    QTest::addColumn<int>("itemCount");
+    QTest::addColumn<bool>("parallelSorting");
+
+    for (int thousandItemCount : { 100, 1000 }) {
+        const auto itemCount = thousandItemCount * 1000;
+        QTest::addRow("lessThan, %dK", thousandItemCount) << itemCount << false;
+        QTest::addRow("parallel, %dK", thousandItemCount) << itemCount << true;
+    }
+}
+
+void tst_QSortFilterProxyModel::insertSorted()
+{
+    QFETCH(const int, itemCount);
+    QFETCH(const bool, parallelSorting);
+    resizeNumberList(m_numberList, itemCount);
+    QStringListModel model(std::as_const(m_numberList));
+
+    QSortFilterProxyModel proxy;
+    proxy.setParallelSortingEnabled(parallelSorting);
+    proxy.setSourceModel(&model);
+    proxy.sort(0);
+
+    constexpr int InsertCount = 100;
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < InsertCount; ++i) {
+            model.insertRow(0);
+            model.setData(model.index(0, 0), QString::number(i * 7919 % itemCount));
+        }
+    }
+    QCOMPARE(proxy.rowCount(), itemCount + InsertCount);
+}
+
 QTEST_MAIN(tst_QSortFilterProxyModel)
 
 #include "tst_bench_qsortfilterproxymodel.moc"
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include <QTest>
+#include <QElapsedTimer>
 #include <QVariantMap>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
@@ -21,6 +22,8 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseThroughput_data();
+    void parseThroughput();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -93,6 +96,81 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+enum class Content {
+    Compact,
+    Indented,
+    LongStrings,
+    Utf8Strings,
+    EscapedStrings
+};
+
+static QByteArray generateDocument(Content content, qsizetype size)
+{
+    QByteArray json = "[";
+    const QByteArray indent = content == Content::Indented ? "\n        " : "";
+    for (int i = 0; json.size() < size; ++i) {
+        if (i)
+            json += ',';
+        json += indent + "{" + indent + "\"id\":" + indent + QByteArray::number(i) + ',';
+        json += indent + "\"ratio\":" + indent + QByteArray::number(i / 7.0) + ',';
+        json += indent + "\"valid\":" + indent + (i % 2 ? "true" : "false") + ',';
+        json += indent + "\"name\":" + indent + '"';
+        switch (content) {
+        case Content::Compact:
+        case Content::Indented:
+            json += "sensor-" + QByteArray::number(i);
+            break;
+        case Content::LongStrings:
+            json += QByteArray("the quick brown fox jumps over the lazy dog; ").repeated(8);
+            break;
+        case Content::Utf8Strings:
+            json += QByteArray("Gr\xc3\xbc\xc3\x9f""e aus K\xc3\xb6ln, \xe2\x82\xac 12; ").repeated(8);
+            break;
+        case Content::EscapedStrings:
+            json += QByteArray("line one\\nline \\\"two\\\"\\tand a tab; ").repeated(8);
+            break;
+        }
+        json += '"' + indent + '}';
+    }
+    json += ']';
+    return json;
+}
+
+void BenchmarkQtJson::parseThroughput_data()
+{
+    QTest::addColumn<Content>("content");
+
+    QTest::newRow("compact") << Content::Compact;
+    QTest::newRow("indented") << Content::Indented;
+    QTest::newRow("long-strings") << Content::LongStrings;
+    QTest::newRow("utf8-strings") << Content::Utf8Strings;
+    QTest::newRow("escaped-strings") << Content::EscapedStrings;
+}
+
+// Reports the parse throughput in bytes per second for documents of a few
+// megabytes that stress different parts of the parser.
+void BenchmarkQtJson::parseThroughput()
+{
+    QFETCH(Content, content);
+
+    const QByteArray json = generateDocument(content, 8 * 1024 * 1024);
+    QJsonParseError error;
+    QVERIFY(QJsonDocument::fromJson(json, &error).isArray());
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    int iterations = 0;
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        ++iterations;
+    } while (timer.elapsed() < 500);
+
+    const qint64 nsecs = timer.nsecsElapsed();
+    QTest::setBenchmarkResult(qreal(json.size()) * iterations * 1e9 / nsecs,
+                              QTest::BytesPerSecond);
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -10,6 +10,33 @@ Q_OBJECT
 private slots:
     void event_posting_benchmark_data();
     void event_posting_benchmark();
+    void queuedConnectionThroughput_data();
+    void queuedConnectionThroughput();
+};
+
+class Sender : public QObject
+{
+    Q_OBJECT
+signals:
+    void ping();
+};
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    int count = 0;
+    int expected = 0;
+
+public slots:
+    void pong()
+    {
+        if (++count == expected)
+            emit done();
+    }
+
+signals:
+    void done();
 };
 
 void tst_QCoreApplication::event_posting_benchmark_data()
@@ -39,6 +66,52 @@ void tst_QCoreApplication::event_posting_benchmark()
     }
 }
 
+void tst_QCoreApplication::queuedConnectionThroughput_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<int>("emissions");
+
+    for (int producers : { 1, 8, 16, 32 })
+        QTest::addRow("%d producers", producers) << producers << 10000;
+}
+
+// Measures how fast signals emitted in many threads at once are delivered
+// through queued connections to a receiver in the main thread.
+void tst_QCoreApplication::queuedConnectionThroughput()
+{
+    QFETCH(int, producers);
+    QFETCH(int, emissions);
+
+    Sender sender;
+    Receiver receiver;
+    connect(&sender, &Sender::ping, &receiver, &Receiver::pong, Qt::QueuedConnection);
+
+    QEventLoop loop;
+    connect(&receiver, &Receiver::done, &loop, &QEventLoop::quit);
+    receiver.expected = producers * emissions;
+
+    QBENCHMARK {
+        receiver.count = 0;
+
+        QList<QThread *> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads << QThread::create([&sender, emissions] {
+                for (int j = 0; j < emissions; ++j)
+                    emit sender.ping();
+            });
+            threads.last()->start();
+        }
+
+        // the events are only delivered by this thread, so done() can't
+        // have been emitted yet
+        loop.exec();
+
+        for (QThread *thread : std::as_const(threads))
+            thread->wait();
+        qDeleteAll(threads);
+    }
+}
+
 QTEST_MAIN(tst_QCoreApplication)
 
 #include "tst_bench_qcoreapplication.moc"
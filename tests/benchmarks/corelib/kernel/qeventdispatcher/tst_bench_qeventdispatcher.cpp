@@ -0,0 +1,143 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QSemaphore>
+#include <QSocketNotifier>
+#include <QThread>
+
+#include <private/qcore_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
+#if QT_CONFIG(epoll)
+#  include <private/qeventdispatcher_epoll_p.h>
+#endif
+
+#include <sys/resource.h>
+
+enum DispatcherType {
+    Poll,
+    EpollLevelTriggered,
+    EpollEdgeTriggered
+};
+
+class tst_QEventDispatcher : public QObject
+{
+    Q_OBJECT
+private slots:
+    void socketNotifierActivation_data();
+    void socketNotifierActivation();
+};
+
+static QAbstractEventDispatcher *createDispatcher(DispatcherType type)
+{
+    switch (type) {
+    case Poll:
+        return new QEventDispatcherUNIX;
+#if QT_CONFIG(epoll)
+    case EpollLevelTriggered:
+        return new QEventDispatcherEpoll(QEventDispatcherEpoll::LevelTriggered);
+    case EpollEdgeTriggered:
+        return new QEventDispatcherEpoll(QEventDispatcherEpoll::EdgeTriggered);
+#else
+    default:
+        break;
+#endif
+    }
+    return nullptr;
+}
+
+static bool ensureFileLimit(rlim_t needed)
+{
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+        return false;
+    if (limit.rlim_cur >= needed)
+        return true;
+    if (limit.rlim_max != RLIM_INFINITY && limit.rlim_max < needed)
+        return false;
+    limit.rlim_cur = needed;
+    return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+}
+
+void tst_QEventDispatcher::socketNotifierActivation_data()
+{
+    QTest::addColumn<DispatcherType>("dispatcher");
+    QTest::addColumn<int>("notifierCount");
+
+    const struct {
+        DispatcherType type;
+        const char *name;
+    } dispatchers[] = {
+        { Poll, "poll" },
+#if QT_CONFIG(epoll)
+        { EpollLevelTriggered, "epoll-level" },
+        { EpollEdgeTriggered, "epoll-edge" },
+#endif
+    };
+
+    for (const auto &dispatcher : dispatchers) {
+        for (int count : { 1, 10, 100, 1000, 5000, 20000 }) {
+            QTest::addRow("%s:%d", dispatcher.name, count) << dispatcher.type << count;
+        }
+    }
+}
+
+// Measures the round trip of waking up an event loop that watches
+// notifierCount idle pipes by making a single one of them readable.
+void tst_QEventDispatcher::socketNotifierActivation()
+{
+    QFETCH(DispatcherType, dispatcher);
+    QFETCH(int, notifierCount);
+
+    if (!ensureFileLimit(rlim_t(2 * notifierCount + 64)))
+        QSKIP("Not enough file descriptors available");
+
+    QList<std::array<int, 2>> pipes(notifierCount);
+    for (auto &p : pipes)
+        QCOMPARE(qt_safe_pipe(p.data(), O_NONBLOCK), 0);
+
+    QThread thread;
+    thread.setEventDispatcher(createDispatcher(dispatcher));
+    thread.start();
+
+    QObject context;
+    context.moveToThread(&thread);
+
+    QSemaphore activations;
+    QList<QSocketNotifier *> notifiers;
+    QMetaObject::invokeMethod(&context, [&] {
+        for (const auto &p : std::as_const(pipes)) {
+            const int fd = p[0];
+            auto notifier = new QSocketNotifier(fd, QSocketNotifier::Read);
+            QObject::connect(notifier, &QSocketNotifier::activated, notifier, [fd, &activations] {
+                char c;
+                while (::read(fd, &c, 1) == 1)
+                    ;
+                activations.release();
+            });
+            notifiers << notifier;
+        }
+    }, Qt::BlockingQueuedConnection);
+
+    const int writeFd = pipes.last()[1];
+    QBENCHMARK {
+        const char c = 0;
+        qt_safe_write(writeFd, &c, 1);
+        activations.acquire();
+    }
+
+    QMetaObject::invokeMethod(&context, [&] {
+        qDeleteAll(notifiers);
+    }, Qt::BlockingQueuedConnection);
+    thread.quit();
+    thread.wait();
+
+    for (const auto &p : std::as_const(pipes)) {
+        qt_safe_close(p[0]);
+        qt_safe_close(p[1]);
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_QEventDispatcher)
+
+#include "tst_bench_qeventdispatcher.moc"
@@ -0,0 +1,124 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QTest>
+#include <QBasicTimer>
+#include <QObject>
+
+#include <vector>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void armTimers_data();
+    void armTimers();
+    void restartTimers_data();
+    void restartTimers();
+    void activateTimers_data();
+    void activateTimers();
+};
+
+class TimerReceiver : public QObject
+{
+public:
+    int fired = 0;
+
+protected:
+    void timerEvent(QTimerEvent *) override { ++fired; }
+};
+
+static void populateData()
+{
+    QTest::addColumn<int>("timerCount");
+    QTest::addColumn<Qt::TimerType>("timerType");
+
+    for (int count : { 1000, 10000, 100000 }) {
+        QTest::addRow("precise:%d", count) << count << Qt::PreciseTimer;
+        QTest::addRow("coarse:%d", count) << count << Qt::CoarseTimer;
+    }
+}
+
+// spread the timeouts over a range that covers several levels of the wheel
+static int intervalFor(int i)
+{
+    return 1000 + (i * 7919) % 600000;
+}
+
+void tst_QTimer::armTimers_data()
+{
+    populateData();
+}
+
+// Arms and then cancels timerCount timers.
+void tst_QTimer::armTimers()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    TimerReceiver receiver;
+    std::vector<QBasicTimer> timers(timerCount);
+
+    QBENCHMARK {
+        for (int i = 0; i < timerCount; ++i)
+            timers[i].start(intervalFor(i), timerType, &receiver);
+        for (QBasicTimer &timer : timers)
+            timer.stop();
+    }
+}
+
+void tst_QTimer::restartTimers_data()
+{
+    populateData();
+}
+
+// Restarts timerCount armed timers, the typical pattern for idle and
+// keep-alive timeouts that are pushed back on every bit of activity.
+void tst_QTimer::restartTimers()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    TimerReceiver receiver;
+    std::vector<QBasicTimer> timers(timerCount);
+    for (int i = 0; i < timerCount; ++i)
+        timers[i].start(intervalFor(i), timerType, &receiver);
+
+    QBENCHMARK {
+        for (int i = 0; i < timerCount; ++i)
+            timers[i].start(intervalFor(i + 1), timerType, &receiver);
+    }
+
+    for (QBasicTimer &timer : timers)
+        timer.stop();
+    QCOMPARE(receiver.fired, 0);
+}
+
+void tst_QTimer::activateTimers_data()
+{
+    populateData();
+}
+
+// Processes events while timerCount long timers are armed, none of which are
+// due; measures the cost of finding the next timeout.
+void tst_QTimer::activateTimers()
+{
+    QFETCH(int, timerCount);
+    QFETCH(Qt::TimerType, timerType);
+
+    TimerReceiver receiver;
+    std::vector<QBasicTimer> timers(timerCount);
+    for (int i = 0; i < timerCount; ++i)
+        timers[i].start(intervalFor(i), timerType, &receiver);
+
+    QBENCHMARK {
+        QCoreApplication::processEvents();
+    }
+
+    for (QBasicTimer &timer : timers)
+        timer.stop();
+}
+
+QTEST_GUILESS_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
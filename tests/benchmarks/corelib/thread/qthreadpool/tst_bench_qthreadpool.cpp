@@ -15,6 +15,8 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void nestedTasks_data();
+    void nestedTasks();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -50,6 +52,46 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+// Starts a binary tree of tasks, where each task starts its children from
+// within the pool, like a parallel divide-and-conquer algorithm would.
+static void spawnTree(QThreadPool *pool, int depth)
+{
+    if (depth == 0)
+        return;
+    pool->start([pool, depth] { spawnTree(pool, depth - 1); });
+    pool->start([pool, depth] { spawnTree(pool, depth - 1); });
+}
+
+void tst_QThreadPool::nestedTasks_data()
+{
+    QTest::addColumn<int>("threadCount");
+    QTest::addColumn<bool>("workStealing");
+
+    const int idealThreadCount = QThread::idealThreadCount();
+    for (int threads = 1; ; threads *= 2) {
+        threads = qMin(threads, idealThreadCount);
+        QTest::addRow("shared-queue:%d", threads) << threads << false;
+        QTest::addRow("work-stealing:%d", threads) << threads << true;
+        if (threads == idealThreadCount)
+            break;
+    }
+}
+
+void tst_QThreadPool::nestedTasks()
+{
+    QFETCH(int, threadCount);
+    QFETCH(bool, workStealing);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    threadPool.setWorkStealingEnabled(workStealing);
+
+    QBENCHMARK {
+        threadPool.start([&threadPool] { spawnTree(&threadPool, 16); });
+        threadPool.waitForDone();
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
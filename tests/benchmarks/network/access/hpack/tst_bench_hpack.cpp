@@ -0,0 +1,139 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+// This file contains benchmarks for HPACK encoding and decoding of
+// typical HTTP/2 request and response headers.
+
+#include <QTest>
+#include <QtNetwork/private/bitstreams_p.h>
+#include <QtNetwork/private/hpack_p.h>
+
+#include <vector>
+
+using namespace HPack;
+
+class tst_Hpack : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encode_data();
+    void encode();
+    void decode_data() { encode_data(); }
+    void decode();
+    void decodeStrings_data();
+    void decodeStrings();
+
+private:
+    static bool encodeHeader(Encoder &encoder, BitOStream &out, const HttpHeader &header);
+};
+
+static const HttpHeader requestHeader = {
+    { ":method", "GET" },
+    { ":scheme", "https" },
+    { ":authority", "www.example.com" },
+    { ":path", "/assets/js/app.3f9a1c.js?v=20230612" },
+    { "user-agent", "Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+                    "Chrome/114.0.0.0 Safari/537.36" },
+    { "accept", "*/*" },
+    { "accept-encoding", "gzip, deflate, br" },
+    { "accept-language", "en-US,en;q=0.9" },
+    { "referer", "https://www.example.com/products/index.html" },
+    { "cookie", "session=6f1c2a7d3b902b7c6ea19a4e4a458f5d; theme=dark" },
+};
+
+static const HttpHeader responseHeader = {
+    { ":status", "200" },
+    { "content-type", "application/json; charset=utf-8" },
+    { "content-length", "1432" },
+    { "date", "Tue, 13 Jun 2023 10:21:45 GMT" },
+    { "cache-control", "private, max-age=0, no-cache" },
+    { "etag", "\"33a64df551425fcc55e4d42a148795d9f25f89d4\"" },
+    { "server", "nginx/1.24.0" },
+    { "vary", "Accept-Encoding" },
+    { "strict-transport-security", "max-age=31536000; includeSubDomains" },
+    { "x-request-id", "2b7c6ea1-9a4e-4a45-8f5d-6f1c2a7d3b90" },
+    { "x-content-type-options", "nosniff" },
+    { "access-control-allow-origin", "*" },
+};
+
+bool tst_Hpack::encodeHeader(Encoder &encoder, BitOStream &out, const HttpHeader &header)
+{
+    if (header.front().name == ":status")
+        return encoder.encodeResponse(out, header);
+    return encoder.encodeRequest(out, header);
+}
+
+void tst_Hpack::encode_data()
+{
+    QTest::addColumn<HttpHeader>("header");
+    QTest::addColumn<bool>("huffman");
+
+    QTest::newRow("request-huffman") << requestHeader << true;
+    QTest::newRow("request-plain") << requestHeader << false;
+    QTest::newRow("response-huffman") << responseHeader << true;
+    QTest::newRow("response-plain") << responseHeader << false;
+}
+
+// Encodes the header into a new dynamic table, as the first header block
+// of a connection, which gets all its fields added to the table.
+void tst_Hpack::encode()
+{
+    QFETCH(HttpHeader, header);
+    QFETCH(bool, huffman);
+
+    std::vector<uchar> buffer;
+    QBENCHMARK {
+        buffer.clear();
+        Encoder encoder(FieldLookupTable::DefaultSize, huffman);
+        BitOStream out(buffer);
+        QVERIFY(encodeHeader(encoder, out, header));
+    }
+}
+
+void tst_Hpack::decode()
+{
+    QFETCH(HttpHeader, header);
+    QFETCH(bool, huffman);
+
+    std::vector<uchar> buffer;
+    Encoder encoder(FieldLookupTable::DefaultSize, huffman);
+    BitOStream out(buffer);
+    QVERIFY(encodeHeader(encoder, out, header));
+
+    QBENCHMARK {
+        Decoder decoder(FieldLookupTable::DefaultSize);
+        BitIStream in(out.begin(), out.end());
+        QVERIFY(decoder.decodeHeaderFields(in));
+    }
+}
+
+void tst_Hpack::decodeStrings_data()
+{
+    QTest::addColumn<QByteArray>("string");
+
+    QTest::newRow("short") << QByteArray("gzip");
+    QTest::newRow("date") << QByteArray("Tue, 13 Jun 2023 10:21:45 GMT");
+    QTest::newRow("user-agent") << requestHeader[4].value;
+    QTest::newRow("binary") << QByteArray("\x01\xfe\x7f\x80\xc3\x10\x00\xff", 8).repeated(8);
+}
+
+// Decodes a Huffman encoded string literal.
+void tst_Hpack::decodeStrings()
+{
+    QFETCH(QByteArray, string);
+
+    std::vector<uchar> buffer;
+    BitOStream out(buffer);
+    out.write(string, true);
+
+    QBENCHMARK {
+        QByteArray decoded;
+        BitIStream in(out.begin(), out.end());
+        QVERIFY(in.read(&decoded));
+        QCOMPARE(decoded, string);
+    }
+}
+
+QTEST_MAIN(tst_Hpack)
+
+#include "tst_bench_hpack.moc"
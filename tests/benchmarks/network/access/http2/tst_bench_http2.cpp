@@ -0,0 +1,125 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+// This file contains benchmarks for HTTP/2 downloads from a local server.
+
+#include <QTest>
+#include <QTestEventLoop>
+#include <QtCore/QThread>
+#include <QtNetwork/QHttp2Configuration>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/private/http2protocol_p.h>
+
+#include "http2srv.h"
+
+using namespace Qt::StringLiterals;
+
+class tst_Http2 : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void download_data();
+    void download();
+
+private:
+    bool download(const QHttp2Configuration &config);
+
+    QThread serverThread;
+    QByteArray body;
+};
+
+void tst_Http2::initTestCase()
+{
+    body = QByteArray(16 * 1024 * 1024, 'x');
+    serverThread.start();
+}
+
+void tst_Http2::cleanupTestCase()
+{
+    serverThread.quit();
+    serverThread.wait();
+}
+
+void tst_Http2::download_data()
+{
+    QTest::addColumn<quint32>("windowSize");
+    QTest::addColumn<bool>("adaptive");
+
+    for (quint32 windowSize : { quint32(Http2::defaultSessionWindowSize), 1024u * 1024u }) {
+        QTest::addRow("%u-fixed", windowSize) << windowSize << false;
+        QTest::addRow("%u-adaptive", windowSize) << windowSize << true;
+    }
+}
+
+// Downloads the body over a new connection, the server sending only as
+// much data as the client's windows allow.
+bool tst_Http2::download(const QHttp2Configuration &config)
+{
+    // The settings the server expects from the client
+    RawSettings clientSettings;
+    clientSettings[Http2::Settings::ENABLE_PUSH_ID] = config.serverPushEnabled();
+    clientSettings[Http2::Settings::INITIAL_WINDOW_SIZE_ID] = config.streamReceiveWindowSize();
+    const RawSettings serverSettings = {{Http2::Settings::MAX_CONCURRENT_STREAMS_ID, 100}};
+
+    auto *server = new Http2Server(H2Type::h2cDirect, serverSettings, clientSettings);
+    server->setResponseBody(body);
+    quint16 port = 0;
+    connect(server, &Http2Server::serverStarted, this, [&port](quint16 serverPort) {
+        port = serverPort;
+        QTestEventLoop::instance().exitLoop();
+    });
+    connect(server, &Http2Server::receivedRequest, server, [server](quint32 streamID) {
+        QMetaObject::invokeMethod(server, "sendResponse", Qt::QueuedConnection,
+                                  Q_ARG(quint32, streamID), Q_ARG(bool, false));
+    });
+    server->moveToThread(&serverThread);
+    auto cleanup = qScopeGuard([server] {
+        server->stopSendingDATAFrames();
+        QMetaObject::invokeMethod(server, &QObject::deleteLater, Qt::QueuedConnection);
+    });
+
+    QMetaObject::invokeMethod(server, "startServer", Qt::QueuedConnection);
+    QTestEventLoop::instance().enterLoop(5);
+    if (!port)
+        return false;
+
+    QNetworkAccessManager manager;
+    QNetworkRequest request(QUrl(u"http://127.0.0.1:%1/index.html"_s.arg(port)));
+    request.setAttribute(QNetworkRequest::Http2DirectAttribute, true);
+    request.setHttp2Configuration(config);
+    QNetworkReply *reply = manager.get(request);
+    qint64 received = 0;
+    connect(reply, &QNetworkReply::readyRead, reply, [reply, &received] {
+        received += reply->readAll().size();
+    });
+    connect(reply, &QNetworkReply::finished, reply, [] {
+        QTestEventLoop::instance().exitLoop();
+    });
+    QTestEventLoop::instance().enterLoop(60);
+    const bool ok = reply->isFinished() && reply->error() == QNetworkReply::NoError
+            && received == body.size();
+    delete reply;
+    return ok;
+}
+
+void tst_Http2::download()
+{
+    QFETCH(quint32, windowSize);
+    QFETCH(bool, adaptive);
+
+    QHttp2Configuration config;
+    config.setSessionReceiveWindowSize(windowSize);
+    config.setStreamReceiveWindowSize(windowSize);
+    config.setAdaptiveFlowControlEnabled(adaptive);
+
+    QBENCHMARK {
+        QVERIFY(download(config));
+    }
+}
+
+QTEST_MAIN(tst_Http2)
+
+#include "tst_bench_http2.moc"
@@ -0,0 +1,163 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+// This file contains benchmarks for many QNetworkAccessManager objects
+// sending small requests at the same time.
+
+#include <QTest>
+#include <QTestEventLoop>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include <memory>
+#include <vector>
+
+using namespace Qt::StringLiterals;
+
+// Answers every request it gets with a five byte body, in its own thread.
+class HttpServerThread : public QThread
+{
+public:
+    quint16 port()
+    {
+        ready.acquire();
+        ready.release();
+        return serverPort;
+    }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        if (server.listen(QHostAddress::LocalHost))
+            serverPort = server.serverPort();
+        connect(&server, &QTcpServer::newConnection, &server, [&server] {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                auto buffer = std::make_shared<QByteArray>();
+                connect(socket, &QTcpSocket::readyRead, socket, [socket, buffer] {
+                    *buffer += socket->readAll();
+                    qsizetype end;
+                    while ((end = buffer->indexOf("\r\n\r\n")) != -1) {
+                        buffer->remove(0, end + 4);
+                        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello");
+                    }
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        ready.release();
+        exec();
+    }
+
+private:
+    QSemaphore ready;
+    quint16 serverPort = 0;
+};
+
+class tst_QNetworkAccessManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void requests_data();
+    void requests();
+    void latency_data() { requests_data(); }
+    void latency();
+
+private:
+    bool sendRequests(int managerCount, bool shared, qint64 *totalLatency = nullptr);
+
+    static constexpr int RequestCount = 10000;
+    HttpServerThread server;
+    QUrl url;
+};
+
+void tst_QNetworkAccessManager::initTestCase()
+{
+    server.start();
+    const quint16 port = server.port();
+    QVERIFY(port);
+    url = QUrl(u"http://127.0.0.1:%1/"_s.arg(port));
+}
+
+void tst_QNetworkAccessManager::cleanupTestCase()
+{
+    server.quit();
+    server.wait();
+    qunsetenv("QT_NETWORK_SHARED_HTTP_THREADS");
+}
+
+void tst_QNetworkAccessManager::requests_data()
+{
+    QTest::addColumn<int>("managerCount");
+    QTest::addColumn<bool>("shared");
+
+    for (int managerCount : { 1, 16, 64 }) {
+        QTest::addRow("%d-dedicated", managerCount) << managerCount << false;
+        QTest::addRow("%d-shared", managerCount) << managerCount << true;
+    }
+}
+
+// Sends RequestCount requests at once, spread over managerCount managers.
+bool tst_QNetworkAccessManager::sendRequests(int managerCount, bool shared, qint64 *totalLatency)
+{
+    // read by each manager when it sends its first request
+    if (shared)
+        qputenv("QT_NETWORK_SHARED_HTTP_THREADS", "4");
+    else
+        qunsetenv("QT_NETWORK_SHARED_HTTP_THREADS");
+
+    std::vector<std::unique_ptr<QNetworkAccessManager>> managers;
+    for (int i = 0; i < managerCount; ++i)
+        managers.emplace_back(std::make_unique<QNetworkAccessManager>());
+
+    int pending = RequestCount;
+    int failed = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < RequestCount; ++i) {
+        QNetworkReply *reply = managers[i % managerCount]->get(QNetworkRequest(url));
+        const qint64 sent = timer.nsecsElapsed();
+        connect(reply, &QNetworkReply::finished, reply, [&, reply, sent] {
+            if (reply->error() != QNetworkReply::NoError || reply->readAll() != "hello")
+                ++failed;
+            if (totalLatency)
+                *totalLatency += timer.nsecsElapsed() - sent;
+            reply->deleteLater();
+            if (--pending == 0)
+                QTestEventLoop::instance().exitLoop();
+        });
+    }
+    QTestEventLoop::instance().enterLoop(60);
+    return !QTestEventLoop::instance().timeout() && failed == 0;
+}
+
+void tst_QNetworkAccessManager::requests()
+{
+    QFETCH(int, managerCount);
+    QFETCH(bool, shared);
+
+    QBENCHMARK {
+        QVERIFY(sendRequests(managerCount, shared));
+    }
+}
+
+void tst_QNetworkAccessManager::latency()
+{
+    QFETCH(int, managerCount);
+    QFETCH(bool, shared);
+
+    qint64 totalLatency = 0;
+    QVERIFY(sendRequests(managerCount, shared, &totalLatency));
+    QTest::setBenchmarkResult(qreal(totalLatency) / RequestCount, QTest::WalltimeNanoseconds);
+}
+
+QTEST_MAIN(tst_QNetworkAccessManager)
+
+#include "tst_bench_qnetworkaccessmanager.moc"
@@ -18,6 +18,7 @@ enum Numbers { NumFakeCacheObjects   = 200,    //entries in pre-populated cache
                NumInsertions  = 100,           //insertions to be timed
                NumRemovals    = 100,           //removals to be timed
                NumReadContent = 100,           //meta requests to be timed
+               NumLargeCacheObjects = 20000,   //entries in a large pre-populated cache
                HugeCacheLimit = 50*1024*1024,  // max size for a big cache
                TinyCacheLimit = 1*512*1024}; //  max size for a tiny cache
 
@@ -29,7 +30,7 @@ class tst_qnetworkdiskcache : public QObject
 {
     Q_OBJECT
 private:
-    void injectFakeData();
+    void injectFakeData(quint32 count = NumFakeCacheObjects);
     void insertOneItem();
     bool isUrlCached(quint32 id);
     void cleanRecursive(QString &path);
@@ -53,6 +54,8 @@ private slots:
 
     void timeExpiration_data();
     void timeExpiration();
+    void timeExpirationLargeCache_data();
+    void timeExpirationLargeCache();
 };
 
 
@@ -299,11 +302,58 @@ void tst_qnetworkdiskcache::timeExpiration()
     cleanRecursive(cacheDir);
 
 }
+void tst_qnetworkdiskcache::timeExpirationLargeCache_data()
+{
+    QTest::addColumn<QString>("cacheRootDirectory");
+
+    QString cacheLoc = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QTest::newRow("QStandardPaths Cache Location") << cacheLoc;
+}
+
+// Times opening a large cache, looking up an uncached URL and
+// evicting some of the entries
+void tst_qnetworkdiskcache::timeExpirationLargeCache()
+{
+    QFETCH(QString, cacheRootDirectory);
+
+    cacheDir = QString( cacheRootDirectory + QDir::separator() + "man_qndc");
+
+    //Housekeeping
+    initCacheObject();
+    cleanRecursive(cacheDir); // slow op.
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(qint64(HugeCacheLimit));
+    cache->clear();
+
+    injectFakeData(NumLargeCacheObjects); // SLOW
+    const qint64 fullSize = cache->cacheSize();
+    cleanupCacheObject();
+
+    QBENCHMARK_ONCE {
+        initCacheObject();
+        cache->setCacheDirectory(cacheDir);
+        QCOMPARE(cache->cacheSize(), fullSize);
+
+        QString fakeURL;
+        QTextStream stream(&fakeURL);
+        stream << fakeURLbase << NumLargeCacheObjects;
+        QVERIFY(!cache->metaData(QUrl(fakeURL)).isValid());
+
+        //evicts about a fifth of the entries
+        cache->setMaximumCacheSize(fullSize * 8 / 9);
+        QVERIFY(cache->cacheSize() < fullSize);
+        cleanupCacheObject();
+    }
+
+    //Cleanup (slow)
+    cleanRecursive(cacheDir);
+}
+
 // This function simulates a partially or fully occupied disk cache
 // like a normal user of a cache might encounter is real-life browsing.
 // The point of this is to trigger degradation in file-system and media performance
 // that occur due to the quantity and layout of data.
-void tst_qnetworkdiskcache::injectFakeData()
+void tst_qnetworkdiskcache::injectFakeData(quint32 count)
 {
 
     QNetworkCacheMetaData::RawHeaderList headers;
@@ -311,7 +361,7 @@ void tst_qnetworkdiskcache::injectFakeData()
 
 
     //Prep cache dir with fake data using QNetworkDiskCache APIs
-    for (quint32 i = 0; i < NumFakeCacheObjects; i++) {
+    for (quint32 i = 0; i < count; i++) {
 
         //prepare metata for url
         QNetworkCacheMetaData meta;
@@ -385,6 +385,60 @@ public slots:
     }
 };
 
+// Sends dataSize bytes as the body of one HTTP response, as fast as it can.
+class ThreadedHttpDownloadServer : public QThread
+{
+    Q_OBJECT
+    QSemaphore ready;
+    qint64 dataSize;
+    int port;
+public:
+    ThreadedHttpDownloadServer(qint64 size)
+        : dataSize(size), port(-1)
+    {
+        start();
+        ready.acquire();
+    }
+
+    inline int serverPort() const { return port; }
+
+protected:
+    void run() override
+    {
+        QTcpServer server;
+        server.listen(QHostAddress::LocalHost);
+        port = server.serverPort();
+        ready.release();
+
+        if (!server.waitForNewConnection(10*1000))
+            return;
+        QTcpSocket *client = server.nextPendingConnection();
+        QByteArray request;
+        while (!request.contains("\r\n\r\n")) {
+            if (!client->waitForReadyRead(10*1000))
+                return;
+            request += client->readAll();
+        }
+
+        client->write("HTTP/1.1 200 OK\r\nContent-Length: " + QByteArray::number(dataSize)
+                      + "\r\nConnection: close\r\n\r\n");
+        const QByteArray data(1024*1024, '@');
+        for (qint64 sent = 0; sent < dataSize; ) {
+            const qint64 amount = qMin(qint64(data.size()), dataSize - sent);
+            client->write(data.constData(), amount);
+            sent += amount;
+            while (client->bytesToWrite() > 4 * data.size())
+                client->waitForBytesWritten(10*1000);
+        }
+        while (client->bytesToWrite() > 0 && client->waitForBytesWritten(10*1000))
+            ;
+        client->disconnectFromHost();
+        if (client->state() != QAbstractSocket::UnconnectedState)
+            client->waitForDisconnected(10*1000);
+        delete client;
+    }
+};
+
 class HttpDownloadPerformanceClient : QObject {
     Q_OBJECT;
     QIODevice *device;
@@ -432,6 +486,8 @@ private slots:
     void httpDownloadPerformance();
     void httpDownloadPerformanceDownloadBuffer_data();
     void httpDownloadPerformanceDownloadBuffer();
+    void httpDownloadThroughput_data();
+    void httpDownloadThroughput();
     void httpsRequestChain();
     void httpsUpload();
     void preConnect_data();
@@ -780,6 +836,66 @@ void tst_qnetworkreply::httpDownloadPerformanceDownloadBuffer()
 }
 
 
+enum HttpDownloadThroughputReadMode {
+    ReadFixedSize,
+    ReadAll,
+    ReadNextChunk
+};
+Q_DECLARE_METATYPE(HttpDownloadThroughputReadMode)
+
+void tst_qnetworkreply::httpDownloadThroughput_data()
+{
+    QTest::addColumn<HttpDownloadThroughputReadMode>("readMode");
+
+    QTest::newRow("read") << ReadFixedSize;
+    QTest::newRow("readAll") << ReadAll;
+    QTest::newRow("readNextChunk") << ReadNextChunk;
+}
+
+void tst_qnetworkreply::httpDownloadThroughput()
+{
+    QFETCH(HttpDownloadThroughputReadMode, readMode);
+
+    constexpr qint64 DownloadSize = 1024 * MiB;
+
+    ThreadedHttpDownloadServer server(DownloadSize);
+
+    QNetworkAccessManager manager;
+    QNetworkRequest request(QUrl("http://127.0.0.1:" + QString::number(server.serverPort()) + "/"));
+    QNetworkReplyPtr reply(manager.get(request));
+
+    qint64 received = 0;
+    QByteArray buffer(64 * 1024, Qt::Uninitialized);
+    connect(reply.data(), &QIODevice::readyRead, reply.data(), [&] {
+        switch (readMode) {
+        case ReadFixedSize:
+            while (qint64 n = reply->read(buffer.data(), buffer.size()))
+                received += n;
+            break;
+        case ReadAll:
+            received += reply->readAll().size();
+            break;
+        case ReadNextChunk:
+            while (reply->bytesAvailable())
+                received += reply->readNextChunk().size();
+            break;
+        }
+    });
+    connect(reply, SIGNAL(finished()), &QTestEventLoop::instance(), SLOT(exitLoop()), Qt::QueuedConnection);
+
+    QElapsedTimer timer;
+    timer.start();
+    QTestEventLoop::instance().enterLoop(60);
+    const qint64 elapsed = timer.nsecsElapsed();
+    server.wait();
+
+    QVERIFY(!QTestEventLoop::instance().timeout());
+    QCOMPARE(reply->error(), QNetworkReply::NoError);
+    QCOMPARE(received, DownloadSize);
+    QTest::setBenchmarkResult(DownloadSize * 1e9 / elapsed, QTest::BytesPerSecond);
+}
+
+
 class HttpsRequestChainHelper : public QObject {
     Q_OBJECT
 public:
@@ -0,0 +1,85 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+// This file contains benchmarks for pushing many small messages through a
+// QTcpSocket over the loopback interface.
+
+#include <QTest>
+#include <QTestEventLoop>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
+
+#include <memory>
+
+class tst_QTcpSocket : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void messages_data();
+    void messages();
+
+private:
+    QTcpServer server;
+    QTcpSocket client;
+    std::unique_ptr<QTcpSocket> peer;
+};
+
+void tst_QTcpSocket::initTestCase()
+{
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    client.connectToHost(server.serverAddress(), server.serverPort());
+    QVERIFY(client.waitForConnected(5000));
+    QVERIFY(server.waitForNewConnection(5000));
+    peer.reset(server.nextPendingConnection());
+    QVERIFY(peer);
+}
+
+void tst_QTcpSocket::messages_data()
+{
+    QTest::addColumn<int>("headerSize");
+    QTest::addColumn<int>("payloadSize");
+
+    // small messages end up in a few large chunks of the write buffer
+    for (int size : {16, 64, 256})
+        QTest::addRow("%d", size) << size << 0;
+    // framed messages: a small header, then a payload the buffer shares
+    // instead of copying, so the buffer holds many chunks
+    QTest::addRow("framed-4096") << 16 << 4096;
+}
+
+// Writes a burst of messages, each one with its own call, and reads them
+// on the other end of the connection until all have arrived.
+void tst_QTcpSocket::messages()
+{
+    QFETCH(int, headerSize);
+    QFETCH(int, payloadSize);
+    constexpr int Count = 2000;
+
+    const QByteArray header(headerSize, 'h');
+    const QByteArray payload(payloadSize, 'p');
+    const qint64 total = qint64(Count) * (headerSize + payloadSize);
+    qint64 received = 0;
+    connect(peer.get(), &QTcpSocket::readyRead, this, [&] {
+        received += peer->skip(peer->bytesAvailable());
+        if (received == total)
+            QTestEventLoop::instance().exitLoop();
+    });
+    auto cleanup = qScopeGuard([this] { peer->disconnect(this); });
+
+    QBENCHMARK {
+        received = 0;
+        for (int i = 0; i < Count; ++i) {
+            client.write(header);
+            if (payloadSize)
+                client.write(payload);
+        }
+        QTestEventLoop::instance().enterLoop(30);
+        QVERIFY(!QTestEventLoop::instance().timeout());
+        QCOMPARE(received, total);
+    }
+}
+
+QTEST_MAIN(tst_QTcpSocket)
+
+#include "tst_qtcpsocket.moc"
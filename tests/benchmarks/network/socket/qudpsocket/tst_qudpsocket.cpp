@@ -16,6 +16,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void transfer_data();
+    void transfer();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -51,5 +53,55 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::transfer_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("batched");
+    for (int size : {64, 512, 1400}) {
+        QTest::addRow("%d-single", size) << size << false;
+        QTest::addRow("%d-batched", size) << size << true;
+    }
+}
+
+// Sends a burst of datagrams over the loopback interface and reads them all,
+// one call per datagram or in batches.
+void tst_QUdpSocket::transfer()
+{
+    QFETCH(int, size);
+    QFETCH(bool, batched);
+    constexpr int Count = 64;
+
+    QUdpSocket receiver;
+    QVERIFY(receiver.bind(QHostAddress::LocalHost, 0));
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4 * 1024 * 1024);
+    QUdpSocket sender;
+    QVERIFY(sender.bind(QHostAddress::LocalHost, 0));
+
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < Count; ++i)
+        datagrams.append(QNetworkDatagram(QByteArray(size, 'a'), QHostAddress::LocalHost, receiver.localPort()));
+
+    QBENCHMARK {
+        if (batched) {
+            QCOMPARE(sender.writeDatagrams(datagrams), qint64(Count));
+        } else {
+            for (const QNetworkDatagram &datagram : std::as_const(datagrams))
+                QCOMPARE(sender.writeDatagram(datagram), qint64(size));
+        }
+
+        int received = 0;
+        while (received < Count) {
+            if (!receiver.hasPendingDatagrams())
+                QVERIFY(receiver.waitForReadyRead(5000));
+            if (batched) {
+                received += receiver.receiveDatagrams(Count).size();
+            } else {
+                QCOMPARE(receiver.receiveDatagram().data().size(), size);
+                ++received;
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
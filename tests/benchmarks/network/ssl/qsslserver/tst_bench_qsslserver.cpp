@@ -0,0 +1,205 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+// This file contains benchmarks for TLS handshakes with a local QSslServer,
+// with and without resuming the sessions of earlier connections, and for
+// sending data to it.
+
+#include <QTest>
+#include <QtCore/QFile>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtNetwork/QSslCertificate>
+#include <QtNetwork/QSslConfiguration>
+#include <QtNetwork/QSslKey>
+#include <QtNetwork/QSslServer>
+#include <QtNetwork/QSslSocket>
+
+#include <memory>
+
+using namespace Qt::StringLiterals;
+
+static constexpr qint64 TransferSize = 64 * 1024 * 1024;
+
+// Sends one byte on every connection as soon as it's encrypted, and then one
+// for every TransferSize bytes it receives, in its own thread.
+class SslServerThread : public QThread
+{
+public:
+    explicit SslServerThread(const QSslConfiguration &configuration)
+        : configuration(configuration)
+    {
+    }
+
+    quint16 port()
+    {
+        ready.acquire();
+        ready.release();
+        return serverPort;
+    }
+
+protected:
+    void run() override
+    {
+        QSslServer server;
+        server.setSslConfiguration(configuration);
+        if (server.listen(QHostAddress::LocalHost))
+            serverPort = server.serverPort();
+        connect(&server, &QSslServer::pendingConnectionAvailable, &server, [&server] {
+            while (QTcpSocket *socket = server.nextPendingConnection()) {
+                auto received = std::make_shared<qint64>(0);
+                connect(socket, &QTcpSocket::readyRead, socket, [socket, received] {
+                    *received += socket->skip(socket->bytesAvailable());
+                    for (; *received >= TransferSize; *received -= TransferSize)
+                        socket->write("x");
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+                socket->write("x");
+            }
+        });
+        ready.release();
+        exec();
+    }
+
+private:
+    QSslConfiguration configuration;
+    QSemaphore ready;
+    quint16 serverPort = 0;
+};
+
+class tst_QSslServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void handshakes_data();
+    void handshakes();
+    void transfer_data();
+    void transfer();
+
+private:
+    QSslConfiguration clientConfiguration() const;
+    bool connectEncrypted(QSslSocket &socket, const QSslConfiguration &configuration);
+
+    static constexpr int HandshakeCount = 100;
+    std::unique_ptr<SslServerThread> server;
+    QSslCertificate certificate;
+    quint16 port = 0;
+};
+
+void tst_QSslServer::initTestCase()
+{
+    if (!QSslSocket::supportsSsl())
+        QSKIP("No TLS backend available");
+
+    QFile certificateFile(u":/certs/selfsigned-server.crt"_s);
+    QFile keyFile(u":/certs/selfsigned-server.key"_s);
+    QVERIFY(certificateFile.open(QIODevice::ReadOnly));
+    QVERIFY(keyFile.open(QIODevice::ReadOnly));
+    certificate = QSslCertificate(certificateFile.readAll());
+    const QSslKey key(keyFile.readAll(), QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey);
+    QVERIFY(!certificate.isNull());
+    QVERIFY(!key.isNull());
+
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    configuration.setLocalCertificate(certificate);
+    configuration.setPrivateKey(key);
+    server = std::make_unique<SslServerThread>(configuration);
+    server->start();
+    port = server->port();
+    QVERIFY(port);
+}
+
+void tst_QSslServer::cleanupTestCase()
+{
+    if (server) {
+        server->quit();
+        server->wait();
+    }
+}
+
+void tst_QSslServer::handshakes_data()
+{
+    QTest::addColumn<QSsl::SslProtocol>("protocol");
+    QTest::addColumn<bool>("sessionSharing");
+
+    QTest::newRow("TlsV1_2-full") << QSsl::TlsV1_2 << false;
+    QTest::newRow("TlsV1_2-resumed") << QSsl::TlsV1_2 << true;
+    QTest::newRow("TlsV1_3-full") << QSsl::TlsV1_3 << false;
+    QTest::newRow("TlsV1_3-resumed") << QSsl::TlsV1_3 << true;
+}
+
+QSslConfiguration tst_QSslServer::clientConfiguration() const
+{
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    configuration.setCaCertificates({ certificate });
+    return configuration;
+}
+
+bool tst_QSslServer::connectEncrypted(QSslSocket &socket, const QSslConfiguration &configuration)
+{
+    socket.setSslConfiguration(configuration);
+    socket.setPeerVerifyName(u"AusweisApp2"_s);
+    socket.connectToHostEncrypted(u"127.0.0.1"_s, port);
+    if (!socket.waitForEncrypted(5000))
+        return false;
+    // Reading the server's byte also gets us the TLS 1.3 session tickets,
+    // which are sent after the handshake.
+    if (!socket.bytesAvailable() && !socket.waitForReadyRead(5000))
+        return false;
+    return socket.read(1) == "x";
+}
+
+// Connects HandshakeCount times, resuming the first connection's session in
+// all the other ones if sessionSharing is set.
+void tst_QSslServer::handshakes()
+{
+    QFETCH(QSsl::SslProtocol, protocol);
+    QFETCH(bool, sessionSharing);
+
+    QSslConfiguration configuration = clientConfiguration();
+    configuration.setProtocol(protocol);
+    configuration.setSslOption(QSsl::SslOptionDisableSessionSharing, !sessionSharing);
+
+    QBENCHMARK {
+        for (int i = 0; i < HandshakeCount; ++i) {
+            QSslSocket socket;
+            QVERIFY(connectEncrypted(socket, configuration));
+            socket.disconnectFromHost();
+        }
+    }
+}
+
+void tst_QSslServer::transfer_data()
+{
+    QTest::addColumn<bool>("kernelTls");
+
+    QTest::newRow("openssl") << false;
+    QTest::newRow("kernel") << true;
+}
+
+// Sends TransferSize bytes, encrypted by the kernel if kernelTls is set and
+// the system supports it (both rows measure the same otherwise).
+void tst_QSslServer::transfer()
+{
+    QFETCH(bool, kernelTls);
+
+    QSslConfiguration configuration = clientConfiguration();
+    configuration.setSslOption(QSsl::SslOptionEnableKernelTls, kernelTls);
+    QSslSocket socket;
+    QVERIFY(connectEncrypted(socket, configuration));
+
+    const QByteArray chunk(1024 * 1024, 'x');
+    QBENCHMARK {
+        for (qint64 sent = 0; sent < TransferSize; sent += chunk.size())
+            socket.write(chunk);
+        while (!socket.bytesAvailable())
+            QVERIFY(socket.waitForReadyRead(10000));
+        QCOMPARE(socket.read(1), "x");
+    }
+}
+
+QTEST_MAIN(tst_QSslServer)
+
+#include "tst_bench_qsslserver.moc"
@@ -27,6 +27,16 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkFetch_data();
+    void benchmarkFetch();
+    void benchmarkInsert_data();
+    void benchmarkInsert();
+    void benchmarkForwardOnly_data();
+    void benchmarkForwardOnly();
+
+public:
+    enum InsertMethod { Exec, ExecBatch, BulkInsert };
+    Q_ENUM(InsertMethod)
 
 private:
     // returns all database connections
@@ -268,4 +278,246 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+void tst_QSqlQuery::benchmarkFetch_data()
+{
+    QTest::addColumn<QString>("dbName");
+    QTest::addColumn<bool>("batch");
+
+    int count = 0;
+    for (const QString &dbName : std::as_const(dbs.dbNames)) {
+        if (!QSqlDatabase::database(dbName).isValid())
+            continue;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-value"))) << dbName << false;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-fetchBatch"))) << dbName << true;
+        ++count;
+    }
+    if (count == 0)
+        QSKIP("No database drivers are available in this Qt configuration");
+}
+
+// Reads an integer, a floating point and a text column of NUM_ROWS rows, one
+// row at a time with QSqlQuery::value() or in batches with fetchBatch().
+void tst_QSqlQuery::benchmarkFetch()
+{
+    QFETCH(QString, dbName);
+    QFETCH(bool, batch);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark_fetch", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName
+                        + "(id INT NOT NULL, amount REAL, name VARCHAR(20))"));
+
+    const int NUM_ROWS = 100000;
+    qint64 expectedSum = 0;
+    qsizetype expectedLength = 0;
+    QVERIFY(db.transaction());
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        const QString name = QLatin1String("Name") + QString::number(i);
+        q.addBindValue(i);
+        q.addBindValue(i + 0.5);
+        q.addBindValue(name);
+        QVERIFY_SQL(q, exec());
+        expectedSum += i;
+        expectedLength += name.size();
+    }
+    QVERIFY(db.commit());
+
+    q.setForwardOnly(true);
+    QVERIFY_SQL(q, prepare("SELECT id, amount, name FROM " + tableName));
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec());
+        qint64 sum = 0;
+        double amount = 0;
+        qsizetype length = 0;
+
+        if (batch) {
+            QSqlColumnBatch columns;
+            while (q.fetchBatch(&columns, 1024)) {
+                const qint64 *ids = columns.int64Data(0);
+                const double *amounts = columns.doubleData(1);
+                for (int row = 0; row < columns.rowCount(); ++row) {
+                    sum += ids[row];
+                    amount += amounts[row];
+                    length += columns.bytes(row, 2).size();
+                }
+            }
+        } else {
+            while (q.next()) {
+                sum += q.value(0).toLongLong();
+                amount += q.value(1).toDouble();
+                length += q.value(2).toString().size();
+            }
+        }
+
+        QCOMPARE(sum, expectedSum);
+        QCOMPARE(amount, expectedSum + NUM_ROWS * 0.5);
+        QCOMPARE(length, expectedLength);
+    }
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkInsert_data()
+{
+    QTest::addColumn<QString>("dbName");
+    QTest::addColumn<InsertMethod>("method");
+
+    int count = 0;
+    for (const QString &dbName : std::as_const(dbs.dbNames)) {
+        if (!QSqlDatabase::database(dbName).isValid())
+            continue;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-exec"))) << dbName << Exec;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-execBatch"))) << dbName << ExecBatch;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-bulkInsert"))) << dbName << BulkInsert;
+        ++count;
+    }
+    if (count == 0)
+        QSKIP("No database drivers are available in this Qt configuration");
+}
+
+// Inserts NUM_ROWS rows of an integer, a floating point and a text column,
+// executing the prepared statement for every row in one transaction, once
+// with execBatch(), or with bulkInsert().
+void tst_QSqlQuery::benchmarkInsert()
+{
+    QFETCH(QString, dbName);
+    QFETCH(InsertMethod, method);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark_insert", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName
+                        + "(id INT NOT NULL, amount REAL, name VARCHAR(20))"));
+
+    const int NUM_ROWS = 100000;
+    QList<int> ids;
+    QList<double> amounts;
+    QStringList names;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        ids.append(i);
+        amounts.append(i + 0.5);
+        names.append(QLatin1String("Name") + QString::number(i));
+    }
+
+    QSqlQuery deleteQuery(db);
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?, ?)"));
+    QBENCHMARK {
+        QVERIFY_SQL(deleteQuery, exec("DELETE FROM " + tableName));
+        switch (method) {
+        case Exec:
+            QVERIFY(db.transaction());
+            for (int i = 0; i < NUM_ROWS; ++i) {
+                q.addBindValue(ids.at(i));
+                q.addBindValue(amounts.at(i));
+                q.addBindValue(names.at(i));
+                QVERIFY_SQL(q, exec());
+            }
+            QVERIFY(db.commit());
+            break;
+        case ExecBatch:
+            q.addBindValue(QVariant::fromValue(ids));
+            q.addBindValue(QVariant::fromValue(amounts));
+            q.addBindValue(names);
+            QVERIFY_SQL(q, execBatch());
+            break;
+        case BulkInsert:
+            QVERIFY_SQL(q, bulkInsert(tableName, { "id", "amount", "name" },
+                                      { QVariant::fromValue(ids),
+                                        QVariant::fromValue(amounts), names }));
+            break;
+        }
+    }
+
+    QVERIFY_SQL(q, exec("SELECT COUNT(*) FROM " + tableName));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), NUM_ROWS);
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
+void tst_QSqlQuery::benchmarkForwardOnly_data()
+{
+    QTest::addColumn<QString>("dbName");
+    QTest::addColumn<bool>("forwardOnly");
+    QTest::addColumn<int>("fetchSize");
+
+    int count = 0;
+    for (const QString &dbName : std::as_const(dbs.dbNames)) {
+        const QSqlDatabase db = QSqlDatabase::database(dbName);
+        if (!db.isValid())
+            continue;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-scrollable"))) << dbName << false << 0;
+        QTest::newRow(qPrintable(dbName + QLatin1String("-forwardOnly"))) << dbName << true << 0;
+        if (tst_Databases::getDatabaseType(db) == QSqlDriver::PostgreSQL) {
+            for (int fetchSize : { 100, 1000 }) {
+                QTest::newRow(qPrintable(dbName + QLatin1String("-forwardOnly-fetchSize")
+                                         + QString::number(fetchSize)))
+                        << dbName << true << fetchSize;
+            }
+        }
+        ++count;
+    }
+    if (count == 0)
+        QSKIP("No database drivers are available in this Qt configuration");
+}
+
+// Reads NUM_ROWS rows with a scrollable query, which may buffer the whole
+// result set, and with a forward-only one, which may stream it; for QPSQL,
+// also with the rows streamed in chunks of fetchSize rows.
+void tst_QSqlQuery::benchmarkForwardOnly()
+{
+    QFETCH(QString, dbName);
+    QFETCH(bool, forwardOnly);
+    QFETCH(int, fetchSize);
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("fetchSize"); });
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (fetchSize > 0) {
+        db = QSqlDatabase::cloneDatabase(db, "fetchSize");
+        db.setConnectOptions("QPSQL_FETCH_SIZE=" + QString::number(fetchSize));
+        QVERIFY_SQL(db, open());
+    }
+    QSqlQuery q(db);
+    const QString tableName(qTableName("benchmark_forwardonly", __FILE__, db));
+
+    tst_Databases::safeDropTable(db, tableName);
+
+    QVERIFY_SQL(q, exec("CREATE TABLE " + tableName + "(id INT NOT NULL, name VARCHAR(40))"));
+
+    const int NUM_ROWS = 100000;
+    qint64 expectedSum = 0;
+    QVERIFY_SQL(q, prepare("INSERT INTO " + tableName + " VALUES (?, ?)"));
+    QList<int> ids;
+    QStringList names;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        ids.append(i);
+        names.append(QLatin1String("A somewhat longer name ") + QString::number(i));
+        expectedSum += i;
+    }
+    q.addBindValue(QVariant::fromValue(ids));
+    q.addBindValue(names);
+    QVERIFY_SQL(q, execBatch());
+
+    q.setForwardOnly(forwardOnly);
+    QVERIFY_SQL(q, prepare("SELECT id, name FROM " + tableName));
+    QBENCHMARK {
+        QVERIFY_SQL(q, exec());
+        qint64 sum = 0;
+        while (q.next())
+            sum += q.value(0).toLongLong();
+        QCOMPARE(sum, expectedSum);
+    }
+    q.finish();
+
+    tst_Databases::safeDropTable(db, tableName);
+}
+
 #include "main.moc"